@@ -10,18 +10,17 @@
 #define CG3_CONVEXHULL_H
 
 #include "cg3/meshes/dcel/dcel.h"
-#include "cg3/data_structures/graphs/bipartite_graph.h"
 
 
 namespace cg3 {
 
-Dcel convexHull(const Dcel& inputDcel);
+Dcel convexHull(const Dcel& inputDcel, unsigned int nThreads = 0);
 
 template <class InputContainer>
-Dcel convexHull(const InputContainer& points);
+Dcel convexHull(const InputContainer& points, unsigned int nThreads = 0);
 
 template <class InputIterator>
-Dcel convexHull(InputIterator first, InputIterator end);
+Dcel convexHull(InputIterator first, InputIterator end, unsigned int nThreads = 0);
 
 } //namespace cg3
 
@@ -7,28 +7,85 @@
  */
 
 #include "convexhull.h"
-#include <Eigen/Dense>
+
+#include <vector>
+#include <limits>
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+
+#include <cg3/utilities/system.h>
 
 namespace cg3 {
 
 
-/* ----- INTERNAL FUNCTIONS DECLARATION ----- */
+/* ----- INTERNAL STRUCTURES AND FUNCTIONS DECLARATION ----- */
 
 namespace internal {
 
-inline double areCoplanar(const Pointd &p0, const Pointd &p1, const Pointd &p2, const Pointd &p3);
+const unsigned int QUICKHULL_NO_FACE = std::numeric_limits<unsigned int>::max();
+
+//Minimum number of points to be assigned to the faces in parallel
+const unsigned int QUICKHULL_PARALLEL_THRESHOLD = 4096;
+
+/**
+ * @brief Triangle of a convex hull under construction
+ */
+struct QuickHullFace
+{
+    unsigned int v[3]; //Indices of the points, counterclockwise seen from outside
+    unsigned int adj[3]; //adj[i] is the face on the other side of the edge v[i] -> v[(i+1)%3]
+    Vec3 normal; //Unit outer normal
+    double offset; //The face lies on the plane normal.dot(p) == offset
+    std::vector<unsigned int> outside; //Conflict list: indices of the points that see the face
+    bool alive;
+    unsigned int visited; //Last iteration in which the face has been found visible
+};
+
+/**
+ * @brief Convex hull under construction: faces are stored in a vector and
+ * referred by their index, deleted faces are reused
+ */
+struct QuickHullData
+{
+    QuickHullData(const std::vector<Pointd>& points, unsigned int nThreads);
+
+    const std::vector<Pointd>& points;
+    std::vector<QuickHullFace> faces;
+    std::vector<unsigned int> freeFaces; //Indices of the deleted faces
+    std::vector<unsigned int> pending; //Faces which may have a not empty conflict list
+    unsigned int iteration;
+    double eps; //Tolerance on the distance of a point from a plane
+    unsigned int nThreads;
+};
+
+/**
+ * @brief Frame of the depth-first visit of the visible faces
+ */
+struct QuickHullVisit
+{
+    unsigned int face;
+    unsigned int edge; //Next edge to be crossed
+    unsigned int remaining; //Number of edges still to be crossed
+};
+
+inline double quickHullDistance(const QuickHullFace& face, const Pointd& p);
+
+inline unsigned int quickHullAddFace(QuickHullData& data, unsigned int a, unsigned int b, unsigned int c);
 
-inline bool isFaceVisible(const Dcel::Face* f, const Pointd &p);
+inline void quickHullDeleteFace(QuickHullData& data, unsigned int faceId);
 
-inline void insertTet(Dcel &dcel, const Pointd &p0, const Pointd &p1, const Pointd &p2, const Pointd &p3);
+inline std::vector<unsigned int> quickHullExtremePoints(const std::vector<Pointd>& points);
 
-inline void horizonEdgeList(std::vector<Dcel::HalfEdge*> &horizon, const std::set<Dcel::Face*>& visibleFaces, std::set<Dcel::Vertex*>& horizonVertex, const Pointd &next_point);
+inline bool quickHullInitialSimplex(QuickHullData& data, const std::vector<unsigned int>& extremes, unsigned int simplex[]);
 
-inline void calculateP(std::vector<std::set<Pointd> >& P, const BipartiteGraph<Pointd, unsigned int>& cg, std::vector<Dcel::HalfEdge*> &horizonEdges);
+inline void quickHullPartition(QuickHullData& data, const std::vector<unsigned int>& pointIds, const std::vector<unsigned int>& faceIds);
 
-inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertices, const std::set<Dcel::Face*>& visibleFaces, BipartiteGraph<Pointd, unsigned int>& cg);
+inline void quickHullAddPoint(QuickHullData& data, unsigned int faceId);
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<std::set<Pointd> > & P);
+inline void quickHullExpand(QuickHullData& data);
+
+inline Dcel quickHullToDcel(const QuickHullData& data);
 
 } //namespace cg3::internal
 
@@ -36,575 +93,562 @@ inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdge
 
 /* ----- IMPLEMENTATION OF CONVEX HULL 3D ----- */
 
-inline Dcel convexHull(const Dcel& inputDcel)
+/**
+ * @brief Compute the convex hull of the vertices of a Dcel
+ * @param[in] inputDcel Input Dcel
+ * @param[in] nThreads Number of threads, 0 to use all the available ones
+ * @return Convex hull
+ */
+inline Dcel convexHull(const Dcel& inputDcel, unsigned int nThreads)
 {
     std::vector<Pointd> points;
     points.reserve(inputDcel.numberVertices());
     for (const Dcel::Vertex* v : inputDcel.vertexIterator()){
         points.push_back(v->coordinate());
     }
-    return convexHull(points.begin(), points.end());
+    return convexHull(points.begin(), points.end(), nThreads);
 }
 
+/**
+ * @brief Compute the convex hull of a container of points
+ * @param[in] container Input points
+ * @param[in] nThreads Number of threads, 0 to use all the available ones
+ * @return Convex hull
+ */
 template <class InputContainer>
-Dcel convexHull(const InputContainer& container)
+Dcel convexHull(const InputContainer& container, unsigned int nThreads)
 {
-    return convexHull(container.begin(), container.end());
+    return convexHull(container.begin(), container.end(), nThreads);
 }
 
-
+/**
+ * @brief Compute the convex hull of a set of points, using the QuickHull algorithm.
+ *
+ * The points extreme along 14 directions are hulled first (Akl-Toussaint heuristic):
+ * all the points inside their hull are discarded in a single linear pass. The
+ * remaining points are stored in index-based conflict lists of the faces, and they
+ * are assigned to the faces in parallel.
+ *
+ * The faces of the returned Dcel are triangles. If all the points are coplanar,
+ * the returned Dcel is empty.
+ * @param[in] first First point
+ * @param[in] end End of the points
+ * @param[in] nThreads Number of threads, 0 to use all the available ones
+ * @return Convex hull
+ */
 template <class InputIterator>
-Dcel convexHull(InputIterator first, InputIterator end)
+Dcel convexHull(InputIterator first, InputIterator end, unsigned int nThreads)
 {
-    Dcel convexHull;
-    BipartiteGraph<Pointd, unsigned int> cg;
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
 
     std::vector<Pointd> points(first, end);
-    std::random_shuffle(points.begin(), points.end());
-
-    double determinant = 0;
-    unsigned int nPoints = (unsigned int)points.size();
-    int a, b, c, d;
-    do {
-        a = rand()%nPoints;
-        b = rand()%nPoints;
-        c = rand()%nPoints;
-        d = rand()%nPoints;
-
-        determinant = internal::areCoplanar(points[a], points[b], points[c], points[d]);
-    } while (determinant == 0);
-    std::swap(points[0], points[a]);
-    std::swap(points[1], points[b]);
-    std::swap(points[2], points[c]);
-    std::swap(points[3], points[d]);
-
-    if (determinant > 0)
-        internal::insertTet(convexHull, points[0], points[1], points[2], points[3]);
-    else
-        internal::insertTet(convexHull, points[1], points[0], points[2], points[3]);
-
-    for (Dcel::Face* f : convexHull.faceIterator()){
-        cg.addRightNode(f->id());
-    }
+    internal::QuickHullData data(points, nThreads);
 
+    //Points which are extreme along the 14 directions
+    std::vector<unsigned int> extremes = internal::quickHullExtremePoints(points);
 
-    for (unsigned int i = 4; i < points.size(); i++){
-        cg.addLeftNode(points[i]);
-        for (Dcel::Face* f : convexHull.faceIterator()){
-            if (internal::isFaceVisible(f, points[i]))
-                cg.addArc(points[i], f->id());
-        }
-    }
+    unsigned int simplex[4];
+    if (!internal::quickHullInitialSimplex(data, extremes, simplex))
+        return Dcel();
 
-    unsigned int iterations = 0;
-    while (cg.sizeLeftNodes() > 0){
-        for (const Pointd& p : cg.leftNodeIterator()){ //For every point that is not inserted in the convex hull yet
-            /**
-             * Se il punto è interno al convex hull, nel conflict graph il nodo associato al punto non
-             * ha archi uscenti: si ignora il punto.
-             */
-            if (cg.sizeAdjacencesLeftNode(p) > 0){
-
-                /**
-                 * Calcolo l'array (ordinato per face_id!) delle facce sul convex hull viste da next_point
-                 */
-                std::set<Dcel::Face*> visibleFaces;
-                for (const unsigned int& f : cg.adjacentLeftNodeIterator(p)){
-                    visibleFaces.insert(convexHull.face(f));
-                }
+    std::vector<bool> isAssigned(points.size(), false);
+    for (unsigned int i = 0; i < 4; i++)
+        isAssigned[simplex[i]] = true;
 
-                std::set<Dcel::Vertex*> horizonVertex;
-                std::vector<Dcel::HalfEdge*> horizonEdges;
-
-                /**
-                 * Calcolo la lista ordinata degli edge che stanno sul boundary delle facce visibili (orizzonte)
-                 */
-                internal::horizonEdgeList(horizonEdges, visibleFaces, horizonVertex, p);
-
-                /**
-                 * Per ogni edge sull'orizzonte, calcolo i punti non ancora inseriti sul convex hull che vedono l'edge,
-                 * ossia l'unione tra gli insiemi di punti che vedono le due facce adiacenti sull'edge.
-                 * Sono tutti i possibili punti che potranno vedere la nuova faccia che verrà costruita unendo l'edge
-                 * sull'orizzonte con next_point.
-                 * P è quindi un array di array: ogni riga i corrisponde all'i-esimo elemento di horizon.
-                 */
-                std::vector< std::set<Pointd> > P;
-                internal::calculateP(P, cg, horizonEdges);
-
-                /**
-                 * Rimuovo next_point dal conflict graph. è fondamentale farlo subito dopo aver rimosso le facce dal
-                 * convex hull: vengono ricalcolati gli indici dei nodi esattamente come vengono ricalcolati quando
-                 * viene rimosso un elemento dalla DCEL.
-                 */
-                cg.deleteLeftNode(p);
-
-                /**
-                 * Elimino dal convex hull tutte le facce di visible_faces e tutti gli half edge ed i vece ad esse
-                 * incidenti, tranne i vertici che stanno sull'orizzonte.
-                 */
-                internal::deleteVisibleFaces(convexHull, horizonVertex, visibleFaces, cg);
-
-
-                /**
-                 * Inserisco le nuove facce nel convex hull, che andranno a collegare gli edge di horizon con
-                 * next_point. Sempre in questa funzione vengono anche calcolati e aggiunti i nuovi conflitti
-                 * tra le nuove facce e i punti presenti nel conflict graph.
-                 */
-                internal::insertNewFaces(convexHull, horizonEdges, p, cg, P);
-            }
-            else
-                cg.deleteLeftNode(p);
+    //Hull of the extreme points
+    std::vector<unsigned int> extremeIds;
+    for (unsigned int pointId : extremes) {
+        if (!isAssigned[pointId]) {
+            extremeIds.push_back(pointId);
+            isAssigned[pointId] = true;
         }
+    }
 
-        iterations++;
+    std::vector<unsigned int> faceIds = {0, 1, 2, 3};
+    internal::quickHullPartition(data, extremeIds, faceIds);
+    internal::quickHullExpand(data);
+
+    //The other points are assigned to the faces of the hull of the extreme
+    //points, the ones inside it are discarded
+    std::vector<unsigned int> pointIds;
+    pointIds.reserve(points.size() - extremeIds.size() - 4);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        if (!isAssigned[i])
+            pointIds.push_back(i);
     }
-    convexHull.updateFaceNormals();
-    convexHull.updateVertexNormals();
-    convexHull.updateBoundingBox();
-    return convexHull;
+
+    faceIds.clear();
+    for (unsigned int i = 0; i < data.faces.size(); i++) {
+        if (data.faces[i].alive)
+            faceIds.push_back(i);
+    }
+
+    internal::quickHullPartition(data, pointIds, faceIds);
+    internal::quickHullExpand(data);
+
+    return internal::quickHullToDcel(data);
 }
 
 
-/* ----- INTERNAL FUNCTIONS IMPLEMENTATION ----- */
+/* ----- INTERNAL STRUCTURES AND FUNCTIONS IMPLEMENTATION ----- */
 
 namespace internal {
 
-inline double areCoplanar(const Pointd& p0, const Pointd& p1, const Pointd& p2, const Pointd& p3)
+/**
+ * @brief Constructor, it computes the tolerance on the distances from the
+ * magnitude of the coordinates
+ * @param[in] points Input points
+ * @param[in] nThreads Number of threads
+ */
+inline QuickHullData::QuickHullData(const std::vector<Pointd>& points, unsigned int nThreads) :
+    points(points),
+    iteration(0),
+    nThreads(nThreads)
 {
-    Eigen::Matrix4d m;
-    m << p0.x(), p0.y(), p0.z(), 1,
-         p1.x(), p1.y(), p1.z(), 1,
-         p2.x(), p2.y(), p2.z(), 1,
-         p3.x(), p3.y(), p3.z(), 1;
-
-    return m.determinant();
+    double maxX = 0, maxY = 0, maxZ = 0;
+    for (const Pointd& p : points) {
+        maxX = std::max(maxX, std::fabs(p.x()));
+        maxY = std::max(maxY, std::fabs(p.y()));
+        maxZ = std::max(maxZ, std::fabs(p.z()));
+    }
+    eps = 3 * DBL_EPSILON * (maxX + maxY + maxZ);
 }
 
-inline bool isFaceVisible(const Dcel::Face* f, const Pointd& p)
+/**
+ * @brief Signed distance of a point from the plane of a face
+ * @param[in] face Face
+ * @param[in] p Point
+ * @return Distance, positive if the point is outside
+ */
+inline double quickHullDistance(const QuickHullFace& face, const Pointd& p)
 {
-    Dcel::Face::ConstIncidentVertexIterator vit = f->incidentVertexBegin();
-    Pointd p1 = (*vit)->coordinate();
-    vit++;
-    Pointd p2 = (*vit)->coordinate();
-    vit++;
-    Pointd p3 = (*vit)->coordinate();
-    double determinant = areCoplanar(p1, p2, p3, p);
+    return face.normal.dot(p) - face.offset;
+}
 
-    if (determinant > std::numeric_limits<double>::epsilon()) return false;
-    else return true;
+/**
+ * @brief Add a face, the adjacencies are not set
+ * @param[in] data Convex hull
+ * @param[in] a First point
+ * @param[in] b Second point
+ * @param[in] c Third point
+ * @return Index of the new face
+ */
+inline unsigned int quickHullAddFace(QuickHullData& data, unsigned int a, unsigned int b, unsigned int c)
+{
+    unsigned int faceId;
+    if (!data.freeFaces.empty()) {
+        faceId = data.freeFaces.back();
+        data.freeFaces.pop_back();
+    }
+    else {
+        faceId = (unsigned int) data.faces.size();
+        data.faces.push_back(QuickHullFace());
+    }
 
+    QuickHullFace& face = data.faces[faceId];
+    face.v[0] = a;
+    face.v[1] = b;
+    face.v[2] = c;
+    face.adj[0] = face.adj[1] = face.adj[2] = QUICKHULL_NO_FACE;
+    face.normal = (data.points[b] - data.points[a]).cross(data.points[c] - data.points[a]);
+    face.normal.normalize();
+    face.offset = face.normal.dot(data.points[a]);
+    face.outside.clear();
+    face.alive = true;
+    face.visited = 0;
+
+    return faceId;
 }
 
-inline void insertTet(Dcel& dcel, const Pointd& p0, const Pointd& p1, const Pointd& p2, const Pointd& p3)
+/**
+ * @brief Delete a face, its index will be reused
+ * @param[in] data Convex hull
+ * @param[in] faceId Index of the face
+ */
+inline void quickHullDeleteFace(QuickHullData& data, unsigned int faceId)
 {
-    Dcel::Vertex* v0 = dcel.addVertex(p0);
-    Dcel::Vertex* v1 = dcel.addVertex(p1);
-    Dcel::Vertex* v2 = dcel.addVertex(p2);
-    Dcel::Vertex* v3 = dcel.addVertex(p3);
+    QuickHullFace& face = data.faces[faceId];
+    face.alive = false;
+    std::vector<unsigned int>().swap(face.outside);
+    data.freeFaces.push_back(faceId);
+}
 
-    Dcel::HalfEdge* e01 = dcel.addHalfEdge();
-    e01->setFromVertex(v0);
-    e01->setToVertex(v1);
+/**
+ * @brief Get the points with minimum and maximum coordinate along the x, y, z
+ * axes and along the 4 diagonals of the cube (Akl-Toussaint heuristic)
+ * @param[in] points Input points
+ * @return Indices of the extreme points, without duplicates
+ */
+inline std::vector<unsigned int> quickHullExtremePoints(const std::vector<Pointd>& points)
+{
+    const Vec3 directions[7] = {
+        Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1),
+        Vec3(1, 1, 1), Vec3(1, 1, -1), Vec3(1, -1, 1), Vec3(-1, 1, 1)
+    };
+
+    std::vector<unsigned int> extremes;
+    if (points.empty())
+        return extremes;
+
+    unsigned int minIds[7] = {0, 0, 0, 0, 0, 0, 0};
+    unsigned int maxIds[7] = {0, 0, 0, 0, 0, 0, 0};
+    double minValues[7], maxValues[7];
+    for (unsigned int d = 0; d < 7; d++) {
+        minValues[d] = maxValues[d] = directions[d].dot(points[0]);
+    }
 
-    Dcel::HalfEdge* e12 = dcel.addHalfEdge();
-    e12->setFromVertex(v1);
-    e12->setToVertex(v2);
+    for (unsigned int i = 1; i < points.size(); i++) {
+        for (unsigned int d = 0; d < 7; d++) {
+            double value = directions[d].dot(points[i]);
+            if (value < minValues[d]) {
+                minValues[d] = value;
+                minIds[d] = i;
+            }
+            else if (value > maxValues[d]) {
+                maxValues[d] = value;
+                maxIds[d] = i;
+            }
+        }
+    }
 
-    Dcel::HalfEdge* e20 = dcel.addHalfEdge();
-    e20->setFromVertex(v2);
-    e20->setToVertex(v0);
+    for (unsigned int d = 0; d < 7; d++) {
+        extremes.push_back(minIds[d]);
+        extremes.push_back(maxIds[d]);
+    }
 
+    std::sort(extremes.begin(), extremes.end());
+    extremes.erase(std::unique(extremes.begin(), extremes.end()), extremes.end());
 
-    Dcel::HalfEdge* e10 = dcel.addHalfEdge();
-    e10->setFromVertex(v1);
-    e10->setToVertex(v0);
+    return extremes;
+}
 
-    Dcel::HalfEdge* e03 = dcel.addHalfEdge();
-    e03->setFromVertex(v0);
-    e03->setToVertex(v3);
-
-    Dcel::HalfEdge* e31 = dcel.addHalfEdge();
-    e31->setFromVertex(v3);
-    e31->setToVertex(v1);
-
-
-    Dcel::HalfEdge* e23 = dcel.addHalfEdge();
-    e23->setFromVertex(v2);
-    e23->setToVertex(v3);
-
-    Dcel::HalfEdge* e30 = dcel.addHalfEdge();
-    e30->setFromVertex(v3);
-    e30->setToVertex(v0);
-
-    Dcel::HalfEdge* e02 = dcel.addHalfEdge();
-    e02->setFromVertex(v0);
-    e02->setToVertex(v2);
-
-
-    Dcel::HalfEdge* e21 = dcel.addHalfEdge();
-    e21->setFromVertex(v2);
-    e21->setToVertex(v1);
-
-    Dcel::HalfEdge* e13 = dcel.addHalfEdge();
-    e13->setFromVertex(v1);
-    e13->setToVertex(v3);
-
-    Dcel::HalfEdge* e32 = dcel.addHalfEdge();
-    e32->setFromVertex(v3);
-    e32->setToVertex(v2);
-
-    Dcel::Face* f0 = dcel.addFace();
-    f0->setOuterHalfEdge(e01);
-    f0->setColor(Color(128,128,128));
-
-    Dcel::Face* f1 = dcel.addFace();
-    f1->setOuterHalfEdge(e10);
-    f1->setColor(Color(128,128,128));
-
-    Dcel::Face* f2 = dcel.addFace();
-    f2->setOuterHalfEdge(e23);
-    f2->setColor(Color(128,128,128));
-
-    Dcel::Face* f3 = dcel.addFace();
-    f3->setOuterHalfEdge(e21);
-    f3->setColor(Color(128,128,128));
-
-    v0->setIncidentHalfEdge(e01);
-    v1->setIncidentHalfEdge(e10);
-    v2->setIncidentHalfEdge(e23);
-    v3->setIncidentHalfEdge(e32);
-
-    e01->setTwin(e10);
-    e01->setFace(f0);
-    e01->setNext(e12);
-    e01->setPrev(e20);
-
-    e12->setTwin(e21);
-    e12->setFace(f0);
-    e12->setNext(e20);
-    e12->setPrev(e01);
-
-    e20->setTwin(e02);
-    e20->setFace(f0);
-    e20->setNext(e01);
-    e20->setPrev(e12);
-
-    e10->setTwin(e01);
-    e10->setFace(f1);
-    e10->setNext(e03);
-    e10->setPrev(e31);
-
-    e03->setTwin(e30);
-    e03->setFace(f1);
-    e03->setNext(e31);
-    e03->setPrev(e10);
-
-    e31->setTwin(e13);
-    e31->setFace(f1);
-    e31->setNext(e10);
-    e31->setPrev(e03);
-
-    e23->setTwin(e32);
-    e23->setFace(f2);
-    e23->setNext(e30);
-    e23->setPrev(e02);
-
-    e30->setTwin(e03);
-    e30->setFace(f2);
-    e30->setNext(e02);
-    e30->setPrev(e23);
+/**
+ * @brief Create the initial tetrahedron: the two furthest extreme points, the
+ * furthest point from their line and the furthest point from the plane
+ * of the three points
+ * @param[in] data Convex hull
+ * @param[in] extremes Extreme points
+ * @param[out] simplex Indices of the points of the tetrahedron
+ * @return False if the points are coplanar, true otherwise
+ */
+inline bool quickHullInitialSimplex(QuickHullData& data, const std::vector<unsigned int>& extremes, unsigned int simplex[])
+{
+    const std::vector<Pointd>& points = data.points;
+
+    if (points.size() < 4)
+        return false;
+
+    //Furthest pair of extreme points
+    double maxDistance = -1;
+    for (unsigned int i = 0; i < extremes.size(); i++) {
+        for (unsigned int j = i + 1; j < extremes.size(); j++) {
+            double distance = (points[extremes[i]] - points[extremes[j]]).length();
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                simplex[0] = extremes[i];
+                simplex[1] = extremes[j];
+            }
+        }
+    }
+    if (maxDistance <= data.eps)
+        return false;
+
+    //Furthest point from the line
+    Vec3 direction = points[simplex[1]] - points[simplex[0]];
+    direction.normalize();
+
+    maxDistance = -1;
+    for (unsigned int i = 0; i < points.size(); i++) {
+        double distance = direction.cross(points[i] - points[simplex[0]]).length();
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            simplex[2] = i;
+        }
+    }
+    if (maxDistance <= data.eps)
+        return false;
+
+    //Furthest point from the plane
+    Vec3 normal = (points[simplex[1]] - points[simplex[0]]).cross(points[simplex[2]] - points[simplex[0]]);
+    normal.normalize();
+    double offset = normal.dot(points[simplex[0]]);
+
+    maxDistance = -1;
+    double signedDistance = 0;
+    for (unsigned int i = 0; i < points.size(); i++) {
+        double distance = normal.dot(points[i]) - offset;
+        if (std::fabs(distance) > maxDistance) {
+            maxDistance = std::fabs(distance);
+            signedDistance = distance;
+            simplex[3] = i;
+        }
+    }
+    if (maxDistance <= data.eps)
+        return false;
+
+    //The fourth point has to be below the first face
+    if (signedDistance > 0)
+        std::swap(simplex[0], simplex[1]);
+
+    unsigned int a = simplex[0], b = simplex[1], c = simplex[2], d = simplex[3];
+    quickHullAddFace(data, a, b, c);
+    quickHullAddFace(data, b, a, d);
+    quickHullAddFace(data, c, b, d);
+    quickHullAddFace(data, a, c, d);
+
+    //Adjacencies: the faces sharing an edge have it in opposite directions
+    for (unsigned int f = 0; f < 4; f++) {
+        for (unsigned int i = 0; i < 3; i++) {
+            for (unsigned int g = 0; g < 4; g++) {
+                for (unsigned int j = 0; j < 3; j++) {
+                    if (data.faces[f].v[i] == data.faces[g].v[(j+1)%3] &&
+                            data.faces[f].v[(i+1)%3] == data.faces[g].v[j])
+                    {
+                        data.faces[f].adj[i] = g;
+                    }
+                }
+            }
+        }
+    }
 
-    e02->setTwin(e20);
-    e02->setFace(f2);
-    e02->setNext(e23);
-    e02->setPrev(e30);
-
-    e21->setTwin(e12);
-    e21->setFace(f3);
-    e21->setNext(e13);
-    e21->setPrev(e32);
-
-    e13->setTwin(e31);
-    e13->setFace(f3);
-    e13->setNext(e32);
-    e13->setPrev(e21);
-
-    e32->setTwin(e23);
-    e32->setFace(f3);
-    e32->setNext(e21);
-    e32->setPrev(e13);
-
-    dcel.updateFaceNormals();
-    dcel.updateVertexNormals();
+    return true;
 }
 
-inline void horizonEdgeList(std::vector<Dcel::HalfEdge*>& horizon, const std::set<Dcel::Face*>& visibleFaces, std::set<Dcel::Vertex*>& horizonVertex, const Pointd& next_point)
+/**
+ * @brief Assign each point to the conflict list of the first face it sees.
+ * The points which do not see any face are discarded.
+ * @param[in] data Convex hull
+ * @param[in] pointIds Indices of the points
+ * @param[in] faceIds Indices of the candidate faces
+ */
+inline void quickHullPartition(QuickHullData& data, const std::vector<unsigned int>& pointIds, const std::vector<unsigned int>& faceIds)
 {
-    Dcel::HalfEdge* e0 = nullptr ,*e1;
-    Dcel::HalfEdge* first_boundary_edge;
-    Dcel::Face* adiacent_face;
-    bool finded = false, sees;
-    std::set<Dcel::Face*>::iterator fid = visibleFaces.begin();
-
-    /** Ciclo di ricerca della Faccia sul boundary*/
-    while (!finded){
-        Dcel::Face* f = *fid;
-
-        for (Dcel::Face::IncidentHalfEdgeIterator heit = f->incidentHalfEdgeBegin(); heit != f->incidentHalfEdgeEnd() && !finded; ++heit){
-            e0 = *heit;
-            e1 = e0->twin();
-            adiacent_face = e1->face();
-            sees=isFaceVisible(adiacent_face, next_point);
-            if (!sees)
-                finded = true;
+    std::vector<unsigned int> assignment(pointIds.size());
+
+    #pragma omp parallel for num_threads(data.nThreads) if(pointIds.size() >= QUICKHULL_PARALLEL_THRESHOLD)
+    for (int i = 0; i < (int) pointIds.size(); i++) {
+        const Pointd& p = data.points[pointIds[i]];
+
+        assignment[i] = QUICKHULL_NO_FACE;
+        for (unsigned int faceId : faceIds) {
+            if (quickHullDistance(data.faces[faceId], p) > data.eps) {
+                assignment[i] = faceId;
+                break;
+            }
         }
-        ++fid;
-        assert (fid != visibleFaces.end() || finded);
     }
 
-    // alla fine del ciclo:
-    // - e0: half edge interno alla faccia col bordo nell'orizzonte (incidente a faccia visibile)
-    // - e1: halfedge esterno alla faccia col bordo nell'orizzonte (incidente a faccia non visibile)
-
-    horizon.push_back(e1); // e1 è il primo edge sull'orizzonte
-    horizonVertex.insert(e0->fromVertex());// inserisco il from vertex di e0 in horizon_vertex
-
-    first_boundary_edge = e0;
-    e0 = e0->next(); // e0 al passo successivo: next di e0
-    do { // finchè non incontro nuovamente first_boundary_edge
-        e1 = e0->twin(); // e1: twin di e0
-        adiacent_face = e1->face(); // f: faccia incidente a e1
-        sees=isFaceVisible(adiacent_face, next_point);
-        if (!sees) { // se f è una faccia non visibile
-            // Allora e0/e1 sono sull'orizzonte!
-            horizon.push_back(e1);
-            //he = convex_hull.get_half_edge(e0);
-            horizonVertex.insert(e0->fromVertex());
-            e0 = e0->next(); // e0 al passo successivo: next di e0
-        }
-        else { // altrimenti sono sul triangolo adiacente che non sta sull'orizzonte
-            // devo continuare la ricerca stando sul from vertex di e0
-            e0 = e1->next(); // e0 al passo successivo: next di e1
-            // in questo caso, e1 è incidente ad una faccia visibile da next_point
-            // in questo modo, sto girando sul from vertex di e0
+    //Conflict lists are filled sequentially, so they do not depend on the threads
+    for (unsigned int i = 0; i < pointIds.size(); i++) {
+        if (assignment[i] != QUICKHULL_NO_FACE) {
+            QuickHullFace& face = data.faces[assignment[i]];
+            if (face.outside.empty())
+                data.pending.push_back(assignment[i]);
+            face.outside.push_back(pointIds[i]);
         }
-    } while (e0 != first_boundary_edge);
-    // finché non ho ritrovaro il primo bordo
+    }
 }
 
-inline void calculateP(std::vector< std::set<Pointd> > &P, const BipartiteGraph<Pointd, unsigned int> &cg, std::vector<Dcel::HalfEdge*> &horizonEdges)
+/**
+ * @brief Add to the convex hull the furthest point of the conflict list of a face
+ * @param[in] data Convex hull
+ * @param[in] faceId Index of the face
+ */
+inline void quickHullAddPoint(QuickHullData& data, unsigned int faceId)
 {
-    Dcel::HalfEdge* he0, *he1;
-    Dcel::Face* f0, *f1;
-
-    P.clear();
-    P.resize(horizonEdges.size());
-    for (unsigned int i=0; i<horizonEdges.size(); i++){
-        he0 = horizonEdges[i];
-        he1 = he0->twin();
-        f0 = he0->face();
-        f1 = he1->face();
-        // viene inserito in P[i] l'array ordinato contente i punti visibili da f0 e f1
-        for (const Pointd& p : cg.adjacentRightNodeIterator(f0->id()))
-            P[i].insert(p);
-        for (const Pointd& p : cg.adjacentRightNodeIterator(f1->id()))
-            P[i].insert(p);
+    //Furthest point
+    unsigned int eye = QUICKHULL_NO_FACE;
+    double maxDistance = -1;
+    for (unsigned int pointId : data.faces[faceId].outside) {
+        double distance = quickHullDistance(data.faces[faceId], data.points[pointId]);
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            eye = pointId;
+        }
+    }
+    const Pointd& p = data.points[eye];
+
+    data.iteration++;
+
+    //Depth-first visit of the visible faces: the edges of the horizon
+    //are found in counterclockwise order
+    std::vector<unsigned int> visible;
+    std::vector<std::pair<unsigned int, unsigned int>> horizon; //Visible face and edge
+
+    std::vector<QuickHullVisit> stack;
+    data.faces[faceId].visited = data.iteration;
+    visible.push_back(faceId);
+    stack.push_back({faceId, 0, 3});
+
+    while (!stack.empty()) {
+        QuickHullVisit& top = stack.back();
+        if (top.remaining == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        unsigned int f = top.face;
+        unsigned int e = top.edge;
+        top.edge = (top.edge + 1) % 3;
+        top.remaining--;
+
+        unsigned int n = data.faces[f].adj[e];
+        QuickHullFace& neighbor = data.faces[n];
+        if (neighbor.visited == data.iteration)
+            continue;
+
+        if (quickHullDistance(neighbor, p) > data.eps) {
+            neighbor.visited = data.iteration;
+            visible.push_back(n);
+
+            //The visit continues from the edge after the crossed one
+            unsigned int j = 0;
+            while (neighbor.adj[j] != f || neighbor.v[j] != data.faces[f].v[(e+1)%3])
+                j++;
+
+            stack.push_back({n, (j + 1) % 3, 2});
+        }
+        else {
+            horizon.push_back(std::make_pair(f, e));
+        }
+    }
+
+    //Points which have to be assigned to the new faces
+    std::vector<unsigned int> orphans;
+    for (unsigned int f : visible) {
+        for (unsigned int pointId : data.faces[f].outside) {
+            if (pointId != eye)
+                orphans.push_back(pointId);
+        }
+    }
+
+    //Edges of the horizon and faces on their other side
+    unsigned int nHorizon = (unsigned int) horizon.size();
+    std::vector<unsigned int> horizonA(nHorizon), horizonB(nHorizon), horizonFaces(nHorizon);
+    for (unsigned int i = 0; i < nHorizon; i++) {
+        const QuickHullFace& face = data.faces[horizon[i].first];
+        unsigned int e = horizon[i].second;
+        horizonA[i] = face.v[e];
+        horizonB[i] = face.v[(e+1)%3];
+        horizonFaces[i] = face.adj[e];
     }
+
+    for (unsigned int f : visible)
+        quickHullDeleteFace(data, f);
+
+    //Cone of new faces from the horizon to the point
+    std::vector<unsigned int> newFaces(nHorizon);
+    for (unsigned int i = 0; i < nHorizon; i++) {
+        newFaces[i] = quickHullAddFace(data, horizonA[i], horizonB[i], eye);
+    }
+
+    for (unsigned int i = 0; i < nHorizon; i++) {
+        QuickHullFace& face = data.faces[newFaces[i]];
+        face.adj[0] = horizonFaces[i];
+        face.adj[1] = newFaces[(i + 1) % nHorizon];
+        face.adj[2] = newFaces[(i + nHorizon - 1) % nHorizon];
+
+        QuickHullFace& neighbor = data.faces[horizonFaces[i]];
+        for (unsigned int j = 0; j < 3; j++) {
+            if (neighbor.v[j] == horizonB[i] && neighbor.v[(j+1)%3] == horizonA[i])
+                neighbor.adj[j] = newFaces[i];
+        }
+    }
+
+    quickHullPartition(data, orphans, newFaces);
 }
 
-inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertices, const std::set<Dcel::Face*> &visibleFaces, BipartiteGraph<Pointd, unsigned int>& cg)
+/**
+ * @brief Add points to the convex hull until all the conflict lists are empty
+ * @param[in] data Convex hull
+ */
+inline void quickHullExpand(QuickHullData& data)
 {
-    std::set<Dcel::Vertex*> garbage_vertex;      // array di vertici da eliminare a fine computazione
-
-    /**
-     * Scorro le facce da eliminare, e elimino gli half edge ad esse incidenti e le facce.
-     * Non elimino subito i vertici in quanto potrebbero essere condivisi tra più facce,
-     * ed è fondamentale che ogni vertice venga eliminato una sola volta.
-     */
-
-    for (std::set<Dcel::Face*>::const_iterator it=visibleFaces.begin(); it!=visibleFaces.end(); ++it){
-        Dcel::Face* f = *it;
-
-        Dcel::HalfEdge* e1 = f->outerHalfEdge();
-        Dcel::HalfEdge* e2 = e1->next();
-        Dcel::HalfEdge* e3 = e2->next();
-        Dcel::Vertex* v1 = e1->fromVertex();
-        Dcel::Vertex* v2 = e1->toVertex();
-        Dcel::Vertex* v3 = e2->toVertex();
-
-        /**
-         * Ogni volta che viene eliminato un elemento dalla DCEL, a tutti gli elementi dello stesso
-         * tipo con indice maggiore dell'elemento eliminato, viene decrementato l'indice.
-         * è quindi necessario, ogni volta che si elimina un elemento, è necessario aggiornare tutti
-         * gli indici che fanno riferimento ad oggetti dello stesso tipo nella DCEL, decrementandoli
-         * se hanno indice maggiore dell'indice dell'elemento eliminato.
-         */
-
-        /** eliminazione degli half_edge */
-        ch.deleteHalfEdge(e1);
-
-        ch.deleteHalfEdge(e2);
-
-        ch.deleteHalfEdge(e3);
-
-        /** eliminazione della faccia f */
-        cg.deleteRightNode(f->id());
-        ch.deleteFace(f);
-        /** Salvo i vertici da eliminare nell'array garbage_vertex */
-
-        if (horizonVertices.find(v1) == horizonVertices.end())
-            garbage_vertex.insert(v1);
-        if (horizonVertices.find(v2) == horizonVertices.end())
-            garbage_vertex.insert(v2);
-        if (horizonVertices.find(v3) == horizonVertices.end())
-            garbage_vertex.insert(v3);
-    }
+    while (!data.pending.empty()) {
+        unsigned int faceId = data.pending.back();
+        data.pending.pop_back();
 
-    /** Elimino i vertici */
-    for (std::set<Dcel::Vertex*>::iterator it = garbage_vertex.begin(); it != garbage_vertex.end(); ++it){
-        ch.deleteVertex(*it);
+        if (data.faces[faceId].alive && !data.faces[faceId].outside.empty())
+            quickHullAddPoint(data, faceId);
     }
 }
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*> & horizonEdges, const Pointd & p, BipartiteGraph<Pointd, unsigned int>& cg, std::vector<std::set<Pointd> >& P)
+/**
+ * @brief Create the Dcel of the convex hull
+ * @param[in] data Convex hull
+ * @return Dcel of the convex hull
+ */
+inline Dcel quickHullToDcel(const QuickHullData& data)
 {
-    Dcel::Vertex* v3, *v1, *v2;                   // id di vertici della faccia inserita: v3 è SEMPRE l'id del nuovo punto inserito nel ch.
-    Dcel::HalfEdge* e1, *e2, *e3;                     // id degli half edge della faccia inserita: e1 è il twin dell'edge sull'orizzonte
-                                            //                                           e2 è il next di e1
-                                            //                                           e3 è il prev di e1
-    Dcel::HalfEdge* old_e2, *old_e3;                 // old_e2: e2 al passo precedente; old_e3: e3 al primo passo.
-    Dcel::Face* f;                              // id della faccia inserita
-
-    /**
-     * Una volta costruiti gli half edge, devono essere aggiustate le relazioni di twin.
-     * L'inserimeno delle facce è fatta in senso orario, quindi ad ogni passo si può collegare
-     * il prev di e1 (e3) col next di e1 al passo precedente (old_e2).
-     * Fa eccezione la prima faccia in quanto non vi è una faccia al passo precedente.
-     * Si salva quindi il prev di e1 della prima faccia (old_e3) e lo si collega al next di e1
-     * dell'ultima faccia (e2).
-     */
-
-    /** Inserisco il nuovo punto (v3) */
-    v3 = ch.addVertex(p); // inserisco il nuovo punto
-
-    /** Costruisco il primo  triangolo: */
-    Dcel::HalfEdge* externHalfEdge = horizonEdges[0]; // edge sull'orizzonte
-    /** Half Edge */
-    // e1:
-    v2 = externHalfEdge->fromVertex(); // v2: from di extern_he (to di e1!)
-    v1 = externHalfEdge->toVertex(); // v1: to di extern_he (from di e1!)
-    e1 = ch.addHalfEdge(); // e1: id half_edge twin di extern_he
-    e1->setFromVertex(v1);
-    e1->setToVertex(v2);
-
-    // e2:
-    e2 = ch.addHalfEdge(); // e2: id half_edge next di e1
-    e2->setFromVertex(v2);
-    e2->setToVertex(v3);
-
-    // e3:
-    e3 = ch.addHalfEdge(); // e3: id half_edge prev di e1
-    e3->setFromVertex(v3);
-    e3->setToVertex(v1);
-
-    old_e3=e3; // e3 sarà il twin di e2 dell'ultima faccia
-
-    // relazioni half_edge:
-    e1->setNext(e2);
-    e2->setNext(e3);
-    e3->setNext(e1);
-    e2->setPrev(e1);
-    e3->setPrev(e2);
-    e1->setPrev(e3);
-    horizonEdges[0]->setTwin(e1);
-    e1->setTwin(horizonEdges[0]);
-
-    // faccia
-    f = ch.addFace(); // f: id faccia inserita
-    f->setOuterHalfEdge(e1);
-    f->setColor(Color(128,128,128));
-
-    // half edge incident face
-    e1->setFace(f);
-    e2->setFace(f);
-    e3->setFace(f);
-
-    // vertex incident edge
-    v1->setIncidentHalfEdge(e1);
-    v2->setIncidentHalfEdge(e2);
-    v3->setIncidentHalfEdge(e3);
-
-    cg.addRightNode(f->id()); // aggiungo f al conflict_graph
-
-    /** CHECK VISIBILITà f */
-    for (const Pointd& point: P[0]){
-        if (isFaceVisible(f, point)){
-            cg.addArc(point, f->id());
-        }
+    Dcel convexHull;
+
+    std::vector<unsigned int> faceMap(data.faces.size(), QUICKHULL_NO_FACE);
+    unsigned int nFaces = 0;
+    for (unsigned int i = 0; i < data.faces.size(); i++) {
+        if (data.faces[i].alive)
+            faceMap[i] = nFaces++;
     }
 
-    //ad ogni ciclo, il twin del nuovo e3 è il vecchio e2.
-    for (unsigned int i=1; i<horizonEdges.size(); i++){ // per ogni edge  sull'orizzonte
-        old_e2 = e2; // salvo e2 del passo precedente
-        externHalfEdge = horizonEdges[i]; // edge sull'orizzonte
-        /** Half Edge */
-        // e1:
-        v2 = externHalfEdge->fromVertex(); // v2: from di extern_he (to di e1!)
-        v1 = externHalfEdge->toVertex(); // v1: to di extern_he (from di e1!)
-        e1 = ch.addHalfEdge(); // e1: id half_edge twin di extern_he
-        e1->setFromVertex(v1);
-        e1->setToVertex(v2);
-
-        // e2:
-        e2 = ch.addHalfEdge(); // e2: id half_edge next di e1
-        e2->setFromVertex(v2);
-        e2->setToVertex(v3);
-
-        // e3:
-        e3 = ch.addHalfEdge(); // e3: id half_edge prev di e1
-        e3->setFromVertex(v3);
-        e3->setToVertex(v1);
-
-        // relazioni half edge:
-        // relazioni half_edge:
-        e1->setNext(e2);
-        e2->setNext(e3);
-        e3->setNext(e1);
-        e2->setPrev(e1);
-        e3->setPrev(e2);
-        e1->setPrev(e3);
-        horizonEdges[i]->setTwin(e1);
-        e1->setTwin(horizonEdges[i]);
-        e3->setTwin(old_e2);
-        old_e2->setTwin(e3);
-
-        //faccia
-        f = ch.addFace(); // f: id faccia inserita
-        f->setColor(Color(128,128,128));
-        f->setOuterHalfEdge(e1);
+    //Euler formula for a closed triangle mesh
+    convexHull.reserve(nFaces / 2 + 2, 3 * nFaces, nFaces);
 
-        //half edge incident face
-        e1->setFace(f);
-        e2->setFace(f);
-        e3->setFace(f);
+    std::vector<Dcel::Vertex*> vertices(data.points.size(), nullptr);
+    std::vector<Dcel::HalfEdge*> halfEdges(3 * nFaces, nullptr);
 
-        // vertex incident edge
-        v1->setIncidentHalfEdge(e1);
-        v2->setIncidentHalfEdge(e2);
+    for (unsigned int i = 0; i < data.faces.size(); i++) {
+        const QuickHullFace& face = data.faces[i];
+        if (!face.alive)
+            continue;
 
-        cg.addRightNode(f->id());
+        for (unsigned int j = 0; j < 3; j++) {
+            if (vertices[face.v[j]] == nullptr)
+                vertices[face.v[j]] = convexHull.addVertex(data.points[face.v[j]]);
+        }
+
+        Dcel::Face* f = convexHull.addFace();
+        f->setColor(Color(128,128,128));
 
-        /** CHECK VISIBILITà f */
-        for (const Pointd& point: P[i]){
-            if (isFaceVisible(f, point))
-                cg.addArc(point, f->id()); // se point vede f, aggiungo il conflitto nel conflict graph
+        Dcel::HalfEdge** faceHalfEdges = &halfEdges[3 * faceMap[i]];
+        for (unsigned int j = 0; j < 3; j++) {
+            faceHalfEdges[j] = convexHull.addHalfEdge();
         }
 
+        for (unsigned int j = 0; j < 3; j++) {
+            Dcel::HalfEdge* he = faceHalfEdges[j];
+            he->setFromVertex(vertices[face.v[j]]);
+            he->setToVertex(vertices[face.v[(j+1)%3]]);
+            he->setNext(faceHalfEdges[(j+1)%3]);
+            he->setPrev(faceHalfEdges[(j+2)%3]);
+            he->setFace(f);
+            vertices[face.v[j]]->setIncidentHalfEdge(he);
+        }
+        f->setOuterHalfEdge(faceHalfEdges[0]);
     }
 
-    e2->setTwin(old_e3);
-    old_e3->setTwin(e2);
+    //Twins
+    for (unsigned int i = 0; i < data.faces.size(); i++) {
+        const QuickHullFace& face = data.faces[i];
+        if (!face.alive)
+            continue;
+
+        for (unsigned int j = 0; j < 3; j++) {
+            const QuickHullFace& neighbor = data.faces[face.adj[j]];
+            unsigned int k = 0;
+            while (neighbor.v[k] != face.v[(j+1)%3])
+                k++;
+
+            halfEdges[3 * faceMap[i] + j]->setTwin(halfEdges[3 * faceMap[face.adj[j]] + k]);
+        }
+    }
+
+    convexHull.updateFaceNormals();
+    convexHull.updateVertexNormals();
+    convexHull.updateBoundingBox();
+
+    return convexHull;
 }
 
 } //namespace cg3::internal
+
 } //namespace cg3
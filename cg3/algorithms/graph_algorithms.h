@@ -13,6 +13,8 @@
 #include <list>
 
 #include <cg3/data_structures/graphs/graph.h>
+#include <cg3/data_structures/heaps/indexed_heap.h>
+#include <cg3/data_structures/arrays/array2d.h>
 
 namespace cg3 {
 
@@ -22,12 +24,34 @@ template <class G, class I>
 void dijkstra(
         const G& graph,
         const std::vector<I>& nodes,
-        const std::vector<std::list<size_t>>& nodeAdjacencies,
+        const std::vector<std::vector<size_t>>& nodeAdjacencies,
         const size_t sourceId,
         std::vector<double>& dist,
         std::vector<long long int>& pred);
 
 
+/* Compressed sparse row implementation */
+
+template <class W>
+void dijkstra(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const size_t sourceId,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const long long int targetId = -1);
+template <class W>
+void dijkstra(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const std::vector<size_t>& sourceIds,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const long long int targetId = -1);
+
+
 
 
 /* Implementation for cg3::Graph */
@@ -65,6 +89,79 @@ template <class T>
 GraphPath<T> dijkstra(const Graph<T>& graph, const T& source, const T& destination);
 
 
+template <class T>
+void dijkstra(
+        const Graph<T>& graph,
+        const std::vector<typename Graph<T>::iterator>& sources,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred);
+template <class T>
+void dijkstra(
+        const Graph<T>& graph,
+        const std::vector<T>& sources,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred);
+
+template <class T>
+GraphPath<T> shortestPath(
+        const Graph<T>& graph,
+        const std::vector<double>& dist,
+        const std::vector<long long int>& pred,
+        const typename Graph<T>::iterator& destinationIt);
+
+
+template <class T>
+void dijkstraDistanceMatrix(
+        const Graph<T>& graph,
+        const std::vector<typename Graph<T>::iterator>& sources,
+        const std::vector<typename Graph<T>::iterator>& destinations,
+        Array2D<double>& distances,
+        unsigned int nThreads = 0);
+template <class T>
+void dijkstraDistanceMatrix(
+        const Graph<T>& graph,
+        const std::vector<T>& sources,
+        const std::vector<T>& destinations,
+        Array2D<double>& distances,
+        unsigned int nThreads = 0);
+
+
+
+/* Point-to-point shortest path for cg3::Graph */
+
+/**
+ * @brief Default heuristic of the A* algorithm: Euclidean distance between the
+ * values of two nodes (e.g. Pointd). It is admissible if the weight of each edge
+ * is not smaller than the distance between its nodes.
+ */
+struct EuclideanDistanceHeuristic {
+    template <class P>
+    double operator()(const P& p1, const P& p2) const { return p1.dist(p2); }
+};
+
+template <class T, class H = EuclideanDistanceHeuristic>
+GraphPath<T> aStar(
+        const Graph<T>& graph,
+        const typename Graph<T>::iterator& sourceIt,
+        const typename Graph<T>::iterator& destinationIt,
+        const H& heuristic = H());
+template <class T, class H = EuclideanDistanceHeuristic>
+GraphPath<T> aStar(
+        const Graph<T>& graph,
+        const T& source,
+        const T& destination,
+        const H& heuristic = H());
+
+
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const Graph<T>& graph,
+        const typename Graph<T>::iterator& sourceIt,
+        const typename Graph<T>::iterator& destinationIt);
+template <class T>
+GraphPath<T> bidirectionalDijkstra(const Graph<T>& graph, const T& source, const T& destination);
+
+
 
 } //namespace cg3
 
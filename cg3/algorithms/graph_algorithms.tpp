@@ -6,12 +6,13 @@
  */
 #ifdef CG3_DATA_STRUCTURES_DEFINED
 
-#include <queue>
 #include <utility>
-#include <unordered_map>
+#include <limits>
 
 #include "assert.h"
 
+#include <cg3/utilities/system.h>
+
 #include "graph_algorithms.h"
 
 namespace cg3 {
@@ -21,8 +22,9 @@ namespace cg3 {
 /** ----- GENERAL PURPOSE INDEXED IMPLEMENTATION ----- */
 
 /**
- * @brief General porpouse indexed Dijkstra algorithm. The current implementation has
- * time complexity O(|E| + |V| log |V|).
+ * @brief General porpouse indexed Dijkstra algorithm. The current implementation uses
+ * an indexed d-ary heap with decrease-key, and it has time complexity
+ * O(|E| log |V|).
  * @param[in] graph Input graph. It is a templated type that must implement:
  * - getNode(id) that returns the node (or an iterator) given an id;
  * - getWeight(node1, node2) that takes the return type of getNode and returns
@@ -44,27 +46,23 @@ void dijkstra(
         std::vector<double>& dist,
         std::vector<long long int>& pred)
 {
-    typedef std::pair<double, size_t> QueueObject;
-
     size_t numberOfNodes = nodes.size();
 
-    dist.resize(numberOfNodes, G::MAX_WEIGHT);
-    pred.resize(numberOfNodes, -1);
+    dist.assign(numberOfNodes, G::MAX_WEIGHT);
+    pred.assign(numberOfNodes, -1);
 
     dist[sourceId] = 0;
     pred[sourceId] = (long long int) sourceId;
 
     //Priority queue
-    std::priority_queue<QueueObject, std::vector<QueueObject>, std::greater<QueueObject>> queue;
+    IndexedHeap<double> queue(numberOfNodes);
 
-    queue.push(std::make_pair(0, sourceId));
+    queue.push(sourceId, 0);
 
     while (!queue.empty()) {
-        //Get iterator on the queue and pop it from it
-        const QueueObject& qObject = queue.top();
-        size_t uId = qObject.second;
+        size_t uId = queue.pop();
 
-        queue.pop();
+        assert(dist[uId] < G::MAX_WEIGHT);
 
         //For each adjacent node
         for (const size_t& vId : nodeAdjacencies[uId]) {
@@ -73,8 +71,6 @@ void dijkstra(
                         graph.getNode(nodes[uId]),
                         graph.getNode(nodes[vId]));
 
-            assert(dist[uId] < G::MAX_WEIGHT);
-
             //If there is short path to v through u.
             if (dist[vId] > dist[uId] + weight)
             {
@@ -84,8 +80,11 @@ void dijkstra(
                 //Set predecessor
                 pred[vId] = (long long int) uId;
 
-                //Add to the queue
-                queue.push(std::make_pair(dist[vId], vId));
+                //Add to the queue or decrease its key
+                if (queue.contains(vId))
+                    queue.decreaseKey(vId, dist[vId]);
+                else
+                    queue.push(vId, dist[vId]);
             }
         }
     }
@@ -94,17 +93,235 @@ void dijkstra(
 
 
 
+/* ----- COMPRESSED SPARSE ROW IMPLEMENTATION ----- */
+
+
+namespace internal {
+
+template <class W>
+void dijkstraHelper(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const std::vector<size_t>& sourceIds,
+        const long long int targetId,
+        IndexedHeap<W>& queue,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred);
+
+} //namespace internal
+
+
+/**
+ * @brief Indexed Dijkstra algorithm on a compressed sparse row (CSR) representation
+ * of a graph. The adjacencies and the weights are read from contiguous arrays, hence
+ * the visit does not need any hashing.
+ * @param[in] offsets Offsets of the adjacencies: the adjacencies of the node i are
+ * in the positions from offsets[i] to offsets[i+1]-1 of targets and weights
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges
+ * @param[in] sourceId Index of the source
+ * @param[out] dist Vector of shortest path costs from the source to each node
+ * (max/2 of the weight type if the node cannot be reached)
+ * @param[out] pred Vector for predecessors to compute the path
+ * @param[in] targetId Index of the target: if it is not -1, the search stops as
+ * soon as the shortest path to the target is found
+ */
+template <class W>
+void dijkstra(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const size_t sourceId,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const long long int targetId)
+{
+    dijkstra(offsets, targets, weights, std::vector<size_t>(1, sourceId), dist, pred, targetId);
+}
+
+/**
+ * @brief Multi-source indexed Dijkstra algorithm on a compressed sparse row (CSR)
+ * representation of a graph: the distance of each node is the cost of the shortest
+ * path from its nearest source.
+ * The current implementation uses an indexed d-ary heap with decrease-key, and it
+ * has time complexity O(|E| log |V|). The only memory allocated is the one of the
+ * output vectors and of the heap.
+ * @param[in] offsets Offsets of the adjacencies: the adjacencies of the node i are
+ * in the positions from offsets[i] to offsets[i+1]-1 of targets and weights
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges (they must be non negative)
+ * @param[in] sourceIds Indices of the sources
+ * @param[out] dist Vector of shortest path costs from the nearest source to each node
+ * (max/2 of the weight type if the node cannot be reached)
+ * @param[out] pred Vector for predecessors to compute the path (each source is the
+ * predecessor of itself, -1 if the node cannot be reached)
+ * @param[in] targetId Index of the target: if it is not -1, the search stops as
+ * soon as the shortest path to the target is found. In that case, dist and pred
+ * are final only for the nodes whose distance is not greater than the one of the target.
+ */
+template <class W>
+void dijkstra(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const std::vector<size_t>& sourceIds,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const long long int targetId)
+{
+    size_t numberOfNodes = offsets.size() - 1;
+
+    dist.assign(numberOfNodes, std::numeric_limits<W>::max() / 2);
+    pred.assign(numberOfNodes, -1);
+
+    IndexedHeap<W> queue(numberOfNodes);
+
+    internal::dijkstraHelper(offsets, targets, weights, sourceIds, targetId, queue, dist, pred);
+}
+
+
+
+namespace internal {
+
+/**
+ * @brief Multi-source indexed Dijkstra on a compressed sparse row representation.
+ * The output vectors must be already initialized (distances to max/2, predecessors
+ * to -1) and the heap must be empty. After the search, the heap is empty again
+ * (it is cleared if the search stops at the target), hence it can be reused.
+ * @param[in] offsets Offsets of the adjacencies
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges
+ * @param[in] sourceIds Indices of the sources
+ * @param[in] targetId Index of the target, -1 to compute all the distances
+ * @param[in] queue Empty heap with capacity equal to the number of nodes
+ * @param[out] dist Vector of shortest path costs
+ * @param[out] pred Vector for predecessors to compute the path
+ */
+template <class W>
+void dijkstraHelper(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const std::vector<size_t>& sourceIds,
+        const long long int targetId,
+        IndexedHeap<W>& queue,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred)
+{
+    assert(queue.empty());
+
+    //Seed the sources
+    for (const size_t& sourceId : sourceIds) {
+        if (!queue.contains(sourceId)) {
+            dist[sourceId] = 0;
+            pred[sourceId] = (long long int) sourceId;
+
+            queue.push(sourceId, 0);
+        }
+    }
+
+    while (!queue.empty()) {
+        W uDist = queue.topKey();
+        size_t uId = queue.pop();
+
+        //Early exit: the shortest path to the target has been found
+        if ((long long int) uId == targetId) {
+            queue.clear();
+            return;
+        }
+
+        //For each adjacent node
+        for (size_t pos = offsets[uId]; pos < offsets[uId + 1]; pos++) {
+            size_t vId = targets[pos];
+            W newDist = uDist + weights[pos];
+
+            //If there is short path to v through u.
+            if (dist[vId] > newDist) {
+                //Update distance of v
+                dist[vId] = newDist;
+
+                //Set predecessor
+                pred[vId] = (long long int) uId;
+
+                //Add to the queue or decrease its key
+                if (queue.contains(vId))
+                    queue.decreaseKey(vId, newDist);
+                else
+                    queue.push(vId, newDist);
+            }
+        }
+    }
+}
+
+} //namespace internal
+
+
+
+
 /* ----- IMPLEMENTATION FOR cg3::Graph ----- */
 
 
 namespace internal {
 
 template <class T>
-void fillIndexedData(
+const typename Graph<T>::CSR& getCSR(
         const Graph<T>& graph,
-        std::vector<size_t>& nodes,
-        std::vector<std::vector<size_t>>& nodeAdjacencies,
-        std::unordered_map<size_t, size_t>& idMap);
+        typename Graph<T>::CSR& localCSR);
+
+template <class W>
+void transposeCSR(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        std::vector<size_t>& transposedOffsets,
+        std::vector<size_t>& transposedTargets,
+        std::vector<W>& transposedWeights);
+
+/**
+ * @brief Reusable data of the Dijkstra searches executed by a thread. The
+ * distances of the visited nodes are stored, so that only them have to be
+ * reset before the next search.
+ */
+template <class W>
+struct DijkstraWorkspace {
+    DijkstraWorkspace(const size_t numberOfNodes) :
+        queue(numberOfNodes),
+        dist(numberOfNodes, std::numeric_limits<W>::max() / 2) {}
+
+    void reset() {
+        queue.clear();
+        for (const size_t& id : visited)
+            dist[id] = std::numeric_limits<W>::max() / 2;
+        visited.clear();
+    }
+
+    IndexedHeap<W> queue;
+    std::vector<W> dist;
+    std::vector<size_t> visited;
+};
+
+template <class W>
+void distanceMatrixDijkstraHelper(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const size_t sourceId,
+        const std::vector<bool>& isDestination,
+        const size_t numberOfDestinations,
+        DijkstraWorkspace<W>& workspace);
+
+template <class W>
+void bidirectionalDijkstraStep(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        IndexedHeap<W>& queue,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const std::vector<W>& otherDist,
+        W& bestCost,
+        long long int& meetingId);
 
 
 template <class T>
@@ -163,26 +380,22 @@ DijkstraResult<T> dijkstra(
 {
     typedef typename Graph<T>::iterator NodeIterator;
 
-    //Vector of nodes and adjacencies
-    std::vector<size_t> nodes;
-    std::vector<std::vector<size_t>> nodeAdjacencies;
-    std::unordered_map<size_t, size_t> idMap;
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+    const std::vector<size_t>& nodes = csr.getGraphIds();
 
     //Vector of distances and predecessor of the shortest path from the source
     std::vector<double> dist;
     std::vector<long long int> pred;
 
 
-    //Fill indexed data needed to execute general purpose Dijkstra algorithm
-    internal::fillIndexedData(graph, nodes, nodeAdjacencies, idMap);
-
-
     //Id of the source
-    size_t sourceId = idMap.find(graph.getId(sourceIt))->second;
+    size_t sourceId = (size_t) csr.getIndex(graph.getId(sourceIt));
 
 
     //Execute Dijkstra
-    dijkstra(graph, nodes, nodeAdjacencies, sourceId, dist, pred);
+    dijkstra(csr.getOffsets(), csr.getTargets(), csr.getWeights(), sourceId, dist, pred);
 
 
 
@@ -253,32 +466,563 @@ GraphPath<T> dijkstra(
         const typename Graph<T>::iterator& sourceIt,
         const typename Graph<T>::iterator& destinationIt)
 {
-    //Vector of nodes and adjacencies
-    std::vector<size_t> nodes;
-    std::vector<std::vector<size_t>> nodeAdjacencies;
-    std::unordered_map<size_t, size_t> idMap;
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+    const std::vector<size_t>& nodes = csr.getGraphIds();
 
     //Vector of distances and predecessor of the shortest path from the source
     std::vector<double> dist;
     std::vector<long long int> pred;
 
 
-    //Fill indexed data needed by general purpose Dijkstra algorithm
-    internal::fillIndexedData(graph, nodes, nodeAdjacencies, idMap);
+    //Id of the source and destination
+    size_t sourceId = (size_t) csr.getIndex(graph.getId(sourceIt));
+    size_t destinationId = (size_t) csr.getIndex(graph.getId(destinationIt));
 
 
-    //Id of the source and destination
-    size_t sourceId = idMap.find(graph.getId(sourceIt))->second;
-    size_t destinationId = idMap.find(graph.getId(destinationIt))->second;
+    //Execute Dijkstra, stopping when the destination is reached
+    dijkstra(csr.getOffsets(), csr.getTargets(), csr.getWeights(), sourceId, dist, pred, (long long int) destinationId);
+
+
+    return internal::getShortestPath(graph, sourceIt, nodes, sourceId, destinationId, dist, pred);
+}
+
+
+/**
+ * @brief Execute multi-source Dijkstra algorithm given a cg3 graph and the sources.
+ * It computes the cost of the shortest path from the nearest source to each node of
+ * the graph, without building any path: use shortestPath() to get the path to a node.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sources Source node iterators
+ * @param[out] dist Vector of shortest path costs, indexed by the ids of the nodes in
+ * the graph (see Graph::getId). It is MAX_WEIGHT if the node cannot be reached.
+ * @param[out] pred Vector of the id of the predecessor of each node in the shortest
+ * path, indexed by the ids of the nodes in the graph. Each source is the predecessor
+ * of itself, and it is -1 if the node cannot be reached.
+ */
+template <class T>
+void dijkstra(
+        const Graph<T>& graph,
+        const std::vector<typename Graph<T>::iterator>& sources,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred)
+{
+    typedef typename Graph<T>::iterator NodeIterator;
 
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+    const std::vector<size_t>& nodes = csr.getGraphIds();
+
+    //Ids of the sources
+    std::vector<size_t> sourceIds;
+    sourceIds.reserve(sources.size());
+    for (const NodeIterator& sourceIt : sources) {
+        sourceIds.push_back((size_t) csr.getIndex(graph.getId(sourceIt)));
+    }
+
+    size_t numberOfIds = nodes.empty() ? 0 : nodes.back() + 1;
+
+    //If there are no deleted nodes, the CSR indices are the ids of the graph
+    if (nodes.size() == numberOfIds) {
+        dijkstra(csr.getOffsets(), csr.getTargets(), csr.getWeights(), sourceIds, dist, pred);
+        return;
+    }
 
     //Execute Dijkstra
-    dijkstra(graph, nodes, nodeAdjacencies, sourceId, dist, pred);
+    std::vector<double> csrDist;
+    std::vector<long long int> csrPred;
+    dijkstra(csr.getOffsets(), csr.getTargets(), csr.getWeights(), sourceIds, csrDist, csrPred);
+
+    //Map the results to the ids of the graph
+    dist.assign(numberOfIds, Graph<T>::MAX_WEIGHT);
+    pred.assign(numberOfIds, -1);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        dist[nodes[i]] = csrDist[i];
+
+        if (csrPred[i] != -1)
+            pred[nodes[i]] = (long long int) nodes[(size_t) csrPred[i]];
+    }
+}
+
+/**
+ * @brief Execute multi-source Dijkstra algorithm given a cg3 graph and the sources.
+ * It computes the cost of the shortest path from the nearest source to each node of
+ * the graph, without building any path: use shortestPath() to get the path to a node.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sources Source node values
+ * @param[out] dist Vector of shortest path costs, indexed by the ids of the nodes in
+ * the graph (see Graph::getId). It is MAX_WEIGHT if the node cannot be reached.
+ * @param[out] pred Vector of the id of the predecessor of each node in the shortest
+ * path, indexed by the ids of the nodes in the graph. Each source is the predecessor
+ * of itself, and it is -1 if the node cannot be reached.
+ */
+template <class T>
+inline void dijkstra(
+        const Graph<T>& graph,
+        const std::vector<T>& sources,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred)
+{
+    typedef typename Graph<T>::iterator NodeIterator;
+
+    //Search sources in the graph
+    std::vector<NodeIterator> sourceIts;
+    sourceIts.reserve(sources.size());
+    for (const T& source : sources) {
+        NodeIterator sourceIt = graph.findNode(source);
+        if (sourceIt == graph.end())
+            throw std::runtime_error("Source has not been found in the graph.");
+
+        sourceIts.push_back(sourceIt);
+    }
+
+    dijkstra(graph, sourceIts, dist, pred);
+}
+
+/**
+ * @brief Get the shortest path to a destination from the flat output of the
+ * multi-source Dijkstra algorithm.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] dist Vector of shortest path costs, indexed by the ids of the nodes
+ * @param[in] pred Vector of predecessors, indexed by the ids of the nodes
+ * @param[in] destinationIt Destination node iterator
+ * @return A struct which contains the shortest path (from the nearest source) and
+ * its cost. If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> shortestPath(
+        const Graph<T>& graph,
+        const std::vector<double>& dist,
+        const std::vector<long long int>& pred,
+        const typename Graph<T>::iterator& destinationIt)
+{
+    //Result graph path
+    GraphPath<T> graphPath;
+
+    size_t id = graph.getId(destinationIt);
 
+    //Get the shortest path
+    if (pred[id] != -1) {
+        while (true) {
+            graphPath.path.push_front(*graph.getNode(id));
+
+            //The source is the predecessor of itself
+            if ((size_t) pred[id] == id)
+                break;
+
+            id = (size_t) pred[id];
+        }
+    }
+
+    graphPath.cost = dist[graph.getId(destinationIt)];
+
+    return graphPath;
+}
+
+
+/**
+ * @brief Compute the costs of the shortest paths between each pair of source and
+ * destination nodes, given a cg3 graph. A Dijkstra search is executed from each
+ * source, and it stops as soon as all the destinations have been reached.
+ * The searches are executed in parallel (if OpenMP is available): each thread
+ * reuses the same workspace (queue and distances) for all its searches, and it
+ * resets only the nodes visited by the previous search.
+ * If the graph is not frozen, its compressed sparse row representation is built
+ * once for all the searches.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sources Source node iterators
+ * @param[in] destinations Destination node iterators
+ * @param[out] distances Matrix of size sources.size() x destinations.size(): the
+ * element (i,j) is the cost of the shortest path from the i-th source to the j-th
+ * destination, MAX_WEIGHT if there is no path.
+ * @param[in] nThreads Number of threads, 0 to use all the available ones
+ */
+template <class T>
+void dijkstraDistanceMatrix(
+        const Graph<T>& graph,
+        const std::vector<typename Graph<T>::iterator>& sources,
+        const std::vector<typename Graph<T>::iterator>& destinations,
+        Array2D<double>& distances,
+        unsigned int nThreads)
+{
+    distances.resize(sources.size(), destinations.size());
+
+    //No search is needed to fill an empty matrix
+    if (sources.empty() || destinations.empty())
+        return;
+
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+
+    size_t numberOfNodes = csr.numNodes();
+
+    //Ids of the sources
+    std::vector<size_t> sourceIds(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        sourceIds[i] = (size_t) csr.getIndex(graph.getId(sources[i]));
+    }
+
+    //Ids of the destinations, and number of distinct destinations
+    std::vector<size_t> destinationIds(destinations.size());
+    std::vector<bool> isDestination(numberOfNodes, false);
+    size_t numberOfDestinations = 0;
+    for (size_t j = 0; j < destinations.size(); j++) {
+        destinationIds[j] = (size_t) csr.getIndex(graph.getId(destinations[j]));
+
+        if (!isDestination[destinationIds[j]]) {
+            isDestination[destinationIds[j]] = true;
+            numberOfDestinations++;
+        }
+    }
+
+    #pragma omp parallel num_threads(nThreads)
+    {
+        internal::DijkstraWorkspace<double> workspace(numberOfNodes);
+
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < (int) sourceIds.size(); i++) {
+            internal::distanceMatrixDijkstraHelper(
+                        csr.getOffsets(), csr.getTargets(), csr.getWeights(),
+                        sourceIds[i], isDestination, numberOfDestinations, workspace);
+
+            for (size_t j = 0; j < destinationIds.size(); j++) {
+                distances(i, j) = workspace.dist[destinationIds[j]];
+            }
+
+            workspace.reset();
+        }
+    }
+}
+
+/**
+ * @brief Compute the costs of the shortest paths between each pair of source and
+ * destination nodes, given a cg3 graph.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sources Source node values
+ * @param[in] destinations Destination node values
+ * @param[out] distances Matrix of size sources.size() x destinations.size(): the
+ * element (i,j) is the cost of the shortest path from the i-th source to the j-th
+ * destination, MAX_WEIGHT if there is no path.
+ * @param[in] nThreads Number of threads, 0 to use all the available ones
+ */
+template <class T>
+inline void dijkstraDistanceMatrix(
+        const Graph<T>& graph,
+        const std::vector<T>& sources,
+        const std::vector<T>& destinations,
+        Array2D<double>& distances,
+        unsigned int nThreads)
+{
+    typedef typename Graph<T>::iterator NodeIterator;
+
+    //Search sources in the graph
+    std::vector<NodeIterator> sourceIts;
+    sourceIts.reserve(sources.size());
+    for (const T& source : sources) {
+        NodeIterator sourceIt = graph.findNode(source);
+        if (sourceIt == graph.end())
+            throw std::runtime_error("Source has not been found in the graph.");
+
+        sourceIts.push_back(sourceIt);
+    }
+
+    //Search destinations in the graph
+    std::vector<NodeIterator> destinationIts;
+    destinationIts.reserve(destinations.size());
+    for (const T& destination : destinations) {
+        NodeIterator destinationIt = graph.findNode(destination);
+        if (destinationIt == graph.end())
+            throw std::runtime_error("Destination has not been found in the graph.");
+
+        destinationIts.push_back(destinationIt);
+    }
+
+    dijkstraDistanceMatrix(graph, sourceIts, destinationIts, distances, nThreads);
+}
+
+
+
+
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source to the
+ * destination, given a cg3 graph. The nodes are visited in order of cost from the
+ * source plus the estimated cost to the destination, hence the search is directed
+ * towards the destination, and it stops as soon as the destination is reached.
+ * If the graph is not frozen, its compressed sparse row representation is built:
+ * freeze the graph to execute many queries.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sourceIt Source node iterator
+ * @param[in] destinationIt Destination node iterator
+ * @param[in] heuristic Functor that, given the values of a node and of the destination,
+ * returns the estimated cost of the shortest path between them (default: Euclidean
+ * distance). It must be admissible (it must never overestimate the cost), otherwise
+ * the returned path may not be the shortest one. It is evaluated at most once per node.
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T, class H>
+GraphPath<T> aStar(
+        const Graph<T>& graph,
+        const typename Graph<T>::iterator& sourceIt,
+        const typename Graph<T>::iterator& destinationIt,
+        const H& heuristic)
+{
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+    const std::vector<size_t>& nodes = csr.getGraphIds();
+
+    const std::vector<size_t>& offsets = csr.getOffsets();
+    const std::vector<size_t>& targets = csr.getTargets();
+    const std::vector<double>& weights = csr.getWeights();
+
+    //Id of the source and destination
+    size_t sourceId = (size_t) csr.getIndex(graph.getId(sourceIt));
+    size_t destinationId = (size_t) csr.getIndex(graph.getId(destinationIt));
+
+    const T& destination = *destinationIt;
+
+    size_t numberOfNodes = nodes.size();
+
+    //Vector of distances and predecessor of the shortest path from the source
+    std::vector<double> dist(numberOfNodes, Graph<T>::MAX_WEIGHT);
+    std::vector<long long int> pred(numberOfNodes, -1);
+
+    //Estimated cost to the destination of each node (-1 if not computed yet)
+    std::vector<double> estimate(numberOfNodes, -1);
+
+    //Priority queue, ordered by cost from the source plus estimated cost
+    IndexedHeap<double> queue(numberOfNodes);
+
+    dist[sourceId] = 0;
+    pred[sourceId] = (long long int) sourceId;
+
+    queue.push(sourceId, heuristic(*sourceIt, destination));
+
+    while (!queue.empty()) {
+        size_t uId = queue.pop();
+
+        //The shortest path to the destination has been found
+        if (uId == destinationId)
+            break;
+
+        //For each adjacent node
+        for (size_t pos = offsets[uId]; pos < offsets[uId + 1]; pos++) {
+            size_t vId = targets[pos];
+            double newDist = dist[uId] + weights[pos];
+
+            //If there is short path to v through u.
+            if (dist[vId] > newDist) {
+                //Update distance of v
+                dist[vId] = newDist;
+
+                //Set predecessor
+                pred[vId] = (long long int) uId;
+
+                //Compute the estimated cost to the destination
+                if (estimate[vId] < 0)
+                    estimate[vId] = heuristic(*graph.getNode(nodes[vId]), destination);
+
+                //Add to the queue or decrease its key (a node already visited
+                //is added again if the heuristic is not consistent)
+                if (queue.contains(vId))
+                    queue.decreaseKey(vId, newDist + estimate[vId]);
+                else
+                    queue.push(vId, newDist + estimate[vId]);
+            }
+        }
+    }
 
     return internal::getShortestPath(graph, sourceIt, nodes, sourceId, destinationId, dist, pred);
 }
 
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source to the
+ * destination, given a cg3 graph.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] source Source node value
+ * @param[in] destination Destination node value
+ * @param[in] heuristic Admissible heuristic functor (default: Euclidean distance)
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T, class H>
+inline GraphPath<T> aStar(
+        const Graph<T>& graph,
+        const T& source,
+        const T& destination,
+        const H& heuristic)
+{
+    typedef typename Graph<T>::iterator NodeIterator;
+
+    //Search source in the graph
+    NodeIterator sourceIt = graph.findNode(source);
+    if (sourceIt == graph.end())
+        throw std::runtime_error("Source has not been found in the graph.");
+
+    //Search destination in the graph
+    NodeIterator destinationIt = graph.findNode(destination);
+    if (destinationIt == graph.end())
+        throw std::runtime_error("Destination has not been found in the graph.");
+
+    return aStar(graph, sourceIt, destinationIt, heuristic);
+}
+
+
+
+/**
+ * @brief Execute bidirectional Dijkstra algorithm to get the shortest path from the
+ * source to the destination, given a cg3 graph. Two searches are executed, one from
+ * the source and one (on the reversed edges) from the destination, and they stop when
+ * they meet: the visited nodes are approximately the ones within half of the cost of
+ * the path from the source and from the destination.
+ * If the graph is not frozen, its compressed sparse row representation is built:
+ * freeze the graph to execute many queries. For directed graphs, the reversed
+ * adjacencies are built at each query in O(|V| + |E|) time.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] sourceIt Source node iterator
+ * @param[in] destinationIt Destination node iterator
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const Graph<T>& graph,
+        const typename Graph<T>::iterator& sourceIt,
+        const typename Graph<T>::iterator& destinationIt)
+{
+    //Compressed sparse row representation (built if the graph is not frozen)
+    typename Graph<T>::CSR localCSR;
+    const typename Graph<T>::CSR& csr = internal::getCSR(graph, localCSR);
+    const std::vector<size_t>& nodes = csr.getGraphIds();
+
+    //Reversed adjacencies: for undirected graphs they are the ones of the graph
+    bool directed = graph.getType() == GraphType::DIRECTED;
+
+    std::vector<size_t> transposedOffsets;
+    std::vector<size_t> transposedTargets;
+    std::vector<double> transposedWeights;
+    if (directed) {
+        internal::transposeCSR(
+                    csr.getOffsets(), csr.getTargets(), csr.getWeights(),
+                    transposedOffsets, transposedTargets, transposedWeights);
+    }
+
+    const std::vector<size_t>& reverseOffsets = directed ? transposedOffsets : csr.getOffsets();
+    const std::vector<size_t>& reverseTargets = directed ? transposedTargets : csr.getTargets();
+    const std::vector<double>& reverseWeights = directed ? transposedWeights : csr.getWeights();
+
+    //Id of the source and destination
+    size_t sourceId = (size_t) csr.getIndex(graph.getId(sourceIt));
+    size_t destinationId = (size_t) csr.getIndex(graph.getId(destinationIt));
+
+    size_t numberOfNodes = nodes.size();
+
+    //Distances and predecessors of the forward and of the backward search
+    std::vector<double> forwardDist(numberOfNodes, Graph<T>::MAX_WEIGHT);
+    std::vector<long long int> forwardPred(numberOfNodes, -1);
+    std::vector<double> backwardDist(numberOfNodes, Graph<T>::MAX_WEIGHT);
+    std::vector<long long int> backwardPred(numberOfNodes, -1);
+
+    IndexedHeap<double> forwardQueue(numberOfNodes);
+    IndexedHeap<double> backwardQueue(numberOfNodes);
+
+    forwardDist[sourceId] = 0;
+    forwardPred[sourceId] = (long long int) sourceId;
+    forwardQueue.push(sourceId, 0);
+
+    backwardDist[destinationId] = 0;
+    backwardPred[destinationId] = (long long int) destinationId;
+    backwardQueue.push(destinationId, 0);
+
+    //Cost of the best path found and node in which the searches met
+    double bestCost = Graph<T>::MAX_WEIGHT;
+    long long int meetingId = -1;
+
+    if (sourceId == destinationId) {
+        bestCost = 0;
+        meetingId = (long long int) sourceId;
+    }
+
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        //No shorter path can be found
+        if (forwardQueue.topKey() + backwardQueue.topKey() >= bestCost)
+            break;
+
+        //Expand the search with the nearest node
+        if (forwardQueue.topKey() <= backwardQueue.topKey()) {
+            internal::bidirectionalDijkstraStep(
+                        csr.getOffsets(), csr.getTargets(), csr.getWeights(),
+                        forwardQueue, forwardDist, forwardPred,
+                        backwardDist, bestCost, meetingId);
+        }
+        else {
+            internal::bidirectionalDijkstraStep(
+                        reverseOffsets, reverseTargets, reverseWeights,
+                        backwardQueue, backwardDist, backwardPred,
+                        forwardDist, bestCost, meetingId);
+        }
+    }
+
+    //Result graph path
+    GraphPath<T> graphPath;
+
+    if (meetingId != -1) {
+        //From the source to the meeting node
+        size_t id = (size_t) meetingId;
+        graphPath.path.push_front(*graph.getNode(nodes[id]));
+        while (id != sourceId) {
+            id = (size_t) forwardPred[id];
+            graphPath.path.push_front(*graph.getNode(nodes[id]));
+        }
+
+        //From the meeting node to the destination
+        id = (size_t) meetingId;
+        while (id != destinationId) {
+            id = (size_t) backwardPred[id];
+            graphPath.path.push_back(*graph.getNode(nodes[id]));
+        }
+    }
+
+    graphPath.cost = bestCost;
+
+    return graphPath;
+}
+
+/**
+ * @brief Execute bidirectional Dijkstra algorithm to get the shortest path from the
+ * source to the destination, given a cg3 graph.
+ * @param[in] graph Input cg3 graph.
+ * @param[in] source Source node value
+ * @param[in] destination Destination node value
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+inline GraphPath<T> bidirectionalDijkstra(const Graph<T>& graph, const T& source, const T& destination)
+{
+    typedef typename Graph<T>::iterator NodeIterator;
+
+    //Search source in the graph
+    NodeIterator sourceIt = graph.findNode(source);
+    if (sourceIt == graph.end())
+        throw std::runtime_error("Source has not been found in the graph.");
+
+    //Search destination in the graph
+    NodeIterator destinationIt = graph.findNode(destination);
+    if (destinationIt == graph.end())
+        throw std::runtime_error("Destination has not been found in the graph.");
+
+    return bidirectionalDijkstra(graph, sourceIt, destinationIt);
+}
+
 
 
 
@@ -286,58 +1030,186 @@ GraphPath<T> dijkstra(
 namespace internal {
 
 /**
- * @brief Fill indexed data structure needed by the Dijkstra algorithm for a cg3 graph.
+ * @brief Get the compressed sparse row representation of a cg3 graph. If the graph
+ * is frozen, its stored representation is returned, otherwise the representation is
+ * built in the given local object.
  * @param[in] graph Input cg3 graph
- * @param[out] nodes List of ids of the nodes of the graph
- * @param[in] nodeAdjacencies Indexed adjacencies of each graph node (referring to the
- * indices of the vector "nodes")
- * @param[out] idMap Map to get the index of a node (referring to the indices of the vector
- * "nodes") given the id on the input cg3 graph
+ * @param[out] localCSR Local representation, built if the graph is not frozen
+ * @return Compressed sparse row representation of the graph
  */
 template <class T>
-inline void fillIndexedData(
+inline const typename Graph<T>::CSR& getCSR(
         const Graph<T>& graph,
-        std::vector<size_t>& nodes,
-        std::vector<std::vector<size_t>>& nodeAdjacencies,
-        std::unordered_map<size_t, size_t>& idMap)
+        typename Graph<T>::CSR& localCSR)
 {
-    typedef typename Graph<T>::iterator NodeIterator;
-    typedef typename Graph<T>::AdjacentIterator AdjacentIterator;
+    if (graph.isFrozen())
+        return graph.getCSR();
 
-    size_t id;
+    localCSR.build(graph);
+    return localCSR;
+}
 
-    //Fill vector of iterators for the nodes
-    id = 0;
+/**
+ * @brief Dijkstra search of a distance matrix, on a compressed sparse row
+ * representation. The search stops when all the destinations have been reached.
+ * The workspace must have been reset.
+ * @param[in] offsets Offsets of the adjacencies
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges
+ * @param[in] sourceId Index of the source
+ * @param[in] isDestination Flag for each node, true if it is a destination
+ * @param[in] numberOfDestinations Number of nodes that are destinations
+ * @param[out] workspace Workspace of the thread, containing the distances
+ */
+template <class W>
+void distanceMatrixDijkstraHelper(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        const size_t sourceId,
+        const std::vector<bool>& isDestination,
+        const size_t numberOfDestinations,
+        DijkstraWorkspace<W>& workspace)
+{
+    IndexedHeap<W>& queue = workspace.queue;
+    std::vector<W>& dist = workspace.dist;
 
-    //Iterate on nodes of the graph
-    for (NodeIterator it = graph.begin(); it != graph.end(); ++it) {
-        size_t graphId = graph.getId(it);
+    size_t reachedDestinations = 0;
 
-        nodes.push_back(graphId);
+    dist[sourceId] = 0;
+    workspace.visited.push_back(sourceId);
 
-        idMap.insert(std::make_pair(graphId, id));
+    queue.push(sourceId, 0);
 
-        id++;
+    while (!queue.empty()) {
+        W uDist = queue.topKey();
+        size_t uId = queue.pop();
+
+        //Stop when all the destinations have been reached
+        if (isDestination[uId]) {
+            reachedDestinations++;
+            if (reachedDestinations == numberOfDestinations)
+                return;
+        }
+
+        //For each adjacent node
+        for (size_t pos = offsets[uId]; pos < offsets[uId + 1]; pos++) {
+            size_t vId = targets[pos];
+            W newDist = uDist + weights[pos];
+
+            //If there is short path to v through u.
+            if (dist[vId] > newDist) {
+                if (!queue.contains(vId)) {
+                    //First time that v is reached
+                    if (dist[vId] == std::numeric_limits<W>::max() / 2)
+                        workspace.visited.push_back(vId);
+
+                    dist[vId] = newDist;
+                    queue.push(vId, newDist);
+                }
+                else {
+                    dist[vId] = newDist;
+                    queue.decreaseKey(vId, newDist);
+                }
+            }
+        }
     }
+}
 
-    //Fill vector of adjacencies
-    nodeAdjacencies.resize(nodes.size());
+/**
+ * @brief Build the compressed sparse row representation of the graph with
+ * reversed edges, in O(|V| + |E|) time
+ * @param[in] offsets Offsets of the adjacencies
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges
+ * @param[out] transposedOffsets Offsets of the reversed adjacencies
+ * @param[out] transposedTargets Indices of the nodes of the reversed adjacencies
+ * @param[out] transposedWeights Weights of the reversed edges
+ */
+template <class W>
+void transposeCSR(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        std::vector<size_t>& transposedOffsets,
+        std::vector<size_t>& transposedTargets,
+        std::vector<W>& transposedWeights)
+{
+    size_t numberOfNodes = offsets.size() - 1;
 
-    id = 0;
-    for (const size_t& graphId : nodes) {
-        NodeIterator nodeIt = graph.getNode(graphId);
+    //Count the incoming edges of each node
+    transposedOffsets.assign(numberOfNodes + 1, 0);
+    for (const size_t& target : targets)
+        transposedOffsets[target + 1]++;
 
-        std::vector<size_t>& adjList = nodeAdjacencies[id];
+    for (size_t i = 0; i < numberOfNodes; i++)
+        transposedOffsets[i + 1] += transposedOffsets[i];
 
-        //For each adjacent node
-        for (AdjacentIterator adjNodeIt = graph.adjacentBegin(nodeIt); adjNodeIt != graph.adjacentEnd(nodeIt); adjNodeIt++) {
-            typename std::unordered_map<size_t, size_t>::iterator findIdIt = idMap.find(graph.getId(adjNodeIt));
-            size_t adjId = findIdIt->second;
+    //Fill the reversed edges
+    transposedTargets.resize(targets.size());
+    transposedWeights.resize(weights.size());
+
+    std::vector<size_t> nextPos(transposedOffsets.begin(), transposedOffsets.end() - 1);
+    for (size_t uId = 0; uId < numberOfNodes; uId++) {
+        for (size_t pos = offsets[uId]; pos < offsets[uId + 1]; pos++) {
+            size_t newPos = nextPos[targets[pos]]++;
+
+            transposedTargets[newPos] = uId;
+            transposedWeights[newPos] = weights[pos];
+        }
+    }
+}
 
-            adjList.push_back(adjId);
+/**
+ * @brief Visit the top node of the queue of one of the two searches of the
+ * bidirectional Dijkstra algorithm, updating the best path found if the
+ * other search has reached an adjacent node.
+ * @param[in] offsets Offsets of the adjacencies of the search
+ * @param[in] targets Indices of the adjacent nodes
+ * @param[in] weights Weights of the edges
+ * @param[in] queue Queue of the search (it must not be empty)
+ * @param[out] dist Vector of the distances of the search
+ * @param[out] pred Vector of the predecessors of the search
+ * @param[in] otherDist Vector of the distances of the other search
+ * @param[out] bestCost Cost of the best path found
+ * @param[out] meetingId Node of the best path in which the searches meet
+ */
+template <class W>
+void bidirectionalDijkstraStep(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<W>& weights,
+        IndexedHeap<W>& queue,
+        std::vector<W>& dist,
+        std::vector<long long int>& pred,
+        const std::vector<W>& otherDist,
+        W& bestCost,
+        long long int& meetingId)
+{
+    W uDist = queue.topKey();
+    size_t uId = queue.pop();
+
+    //For each adjacent node
+    for (size_t pos = offsets[uId]; pos < offsets[uId + 1]; pos++) {
+        size_t vId = targets[pos];
+        W newDist = uDist + weights[pos];
+
+        //If there is short path to v through u.
+        if (dist[vId] > newDist) {
+            dist[vId] = newDist;
+            pred[vId] = (long long int) uId;
+
+            if (queue.contains(vId))
+                queue.decreaseKey(vId, newDist);
+            else
+                queue.push(vId, newDist);
         }
 
-        id++;
+        //Update the best path if v has been reached by the other search
+        if (dist[vId] + otherDist[vId] < bestCost) {
+            bestCost = dist[vId] + otherDist[vId];
+            meetingId = (long long int) vId;
+        }
     }
 }
 
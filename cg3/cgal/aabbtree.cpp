@@ -8,7 +8,10 @@
 
 #include "aabbtree.h"
 
-#include <random>
+#include <algorithm>
+#include <cmath>
+
+#include <cg3/utilities/system.h>
 
 #ifdef TRIMESH_DEFINED
 #include <trimesh/trimesh.h>
@@ -20,11 +23,42 @@
 
 namespace cg3 {
 namespace cgal {
+namespace internal {
+
+//A node contributes with its dipole if the query point is farther than
+//WINDING_NUMBER_ACCURACY times its radius
+static const double WINDING_NUMBER_ACCURACY = 2;
+
+//Maximum number of triangles in a leaf of the winding number hierarchy
+static const unsigned int WINDING_NUMBER_LEAF_SIZE = 8;
+
+inline Pointd toPointd(const CGAL::Simple_cartesian<double>::Point_3& p)
+{
+    return Pointd(p.x(), p.y(), p.z());
+}
+
+/**
+ * @brief Signed solid angle of a triangle seen from the origin (Van Oosterom and Strackee)
+ * @param[in] a, b, c: vertices of the triangle, relative to the query point
+ * @return the solid angle, positive if the triangle is counterclockwise seen from the origin
+ */
+inline double triangleSolidAngle(const Vec3& a, const Vec3& b, const Vec3& c)
+{
+    double la = a.length(), lb = b.length(), lc = c.length();
+    double numerator = a.dot(b.cross(c));
+    double denominator = la * lb * lc + a.dot(b) * lc + a.dot(c) * lb + b.dot(c) * la;
+    return 2 * std::atan2(numerator, denominator);
+}
+
+} //namespace cg3::cgal::internal
 
 /**
  * @brief  Creates an empty AABBTree. This object cannot be used.
  */
-AABBTree::AABBTree() {
+AABBTree::AABBTree() :
+    forDistanceQueries(false),
+    treeType(DCEL)
+{
 }
 
 /**
@@ -35,21 +69,12 @@ AABBTree::AABBTree(const AABBTree& other) :
     forDistanceQueries(other.forDistanceQueries),
     treeType(other.treeType),
     triangles(other.triangles),
-    bb(other.bb)
-{
     #ifdef  CG3_DCEL_DEFINED
-    mapDcelVerticesToCgalPoints = other.mapDcelVerticesToCgalPoints;
-    mapCgalPointsToDcelVertices = other.mapCgalPointsToDcelVertices;
-    mapCgalTrianglesToDcelFaces = other.mapCgalTrianglesToDcelFaces;
+    dcelFaces(other.dcelFaces),
     #endif
-    #if defined(TRIMESH_DEFINED) || defined( CG3_EIGENMESH_DEFINED)
-    mapIdVerticesToCgalPoints = other.mapIdVerticesToCgalPoints;
-    mapCgalTrianglesToIdTriangles = other.mapCgalTrianglesToIdTriangles;
-    #endif
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    bb(other.bb)
+{
+    buildTree();
 }
 
 /**
@@ -59,22 +84,17 @@ AABBTree::AABBTree(const AABBTree& other) :
 AABBTree::AABBTree(AABBTree &&other) :
     forDistanceQueries(other.forDistanceQueries),
     treeType(other.treeType),
-    triangles(other.triangles),
-    bb(other.bb)
-{
+    triangles(std::move(other.triangles)),
     #ifdef  CG3_DCEL_DEFINED
-    mapDcelVerticesToCgalPoints = std::move(other.mapDcelVerticesToCgalPoints);
-    mapCgalPointsToDcelVertices = std::move(other.mapCgalPointsToDcelVertices);
-    mapCgalTrianglesToDcelFaces = std::move(other.mapCgalTrianglesToDcelFaces);
+    dcelFaces(std::move(other.dcelFaces)),
     #endif
-    #if defined(TRIMESH_DEFINED) || defined( CG3_EIGENMESH_DEFINED)
-    mapIdVerticesToCgalPoints = std::move(other.mapIdVerticesToCgalPoints);
-    mapCgalTrianglesToIdTriangles = std::move(other.mapCgalTrianglesToIdTriangles);
-    #endif
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    bb(other.bb)
+{
+    other.tree.clear();
+    other.triangles.clear();
+    other.windingNodes.clear();
+    other.windingTriangles.clear();
+    buildTree();
 }
 
 #ifdef TRIMESH_DEFINED
@@ -83,27 +103,24 @@ AABBTree::AABBTree(AABBTree &&other) :
  * @param[in] t: the trimesh on which is constructed the tree.
  * @param[in] forDistanceQueries: use this parameter to optimize the tree for distance queries.
  */
-AABBTree::AABBTree(const Trimesh<double>& t, bool forDistanceQueries)
+AABBTree::AABBTree(const Trimesh<double>& t, bool forDistanceQueries) :
+    forDistanceQueries(forDistanceQueries)
 {
     treeType = TRIMESH;
-    for (int i = 0; i < t.numVertices(); i++){
-        Pointd p = t.vertex(i);
-        CGALPoint pp(p.x(), p.y(), p.z());
-        mapIdVerticesToCgalPoints[i] = pp;
-    }
+    triangles.reserve(t.numTriangles());
     for (int i = 0; i < t.numTriangles(); ++i){
-        int i1 = t.tri_vertex_id(i, 0), i2 = t.tri_vertex_id(i, 1), i3 = t.tri_vertex_id(i, 2);
-        assert(mapIdVerticesToCgalPoints.find(i1) != mapIdVerticesToCgalPoints.end());
-        assert(mapIdVerticesToCgalPoints.find(i2) != mapIdVerticesToCgalPoints.end());
-        assert(mapIdVerticesToCgalPoints.find(i3) != mapIdVerticesToCgalPoints.end());
-        CGALTriangle tr(mapIdVerticesToCgalPoints.at(i1), mapIdVerticesToCgalPoints.at(i2), mapIdVerticesToCgalPoints.at(i3));
-        mapCgalTrianglesToIdTriangles[tr] = i;
+        Pointd p1 = t.vertex(t.tri_vertex_id(i, 0)),
+               p2 = t.vertex(t.tri_vertex_id(i, 1)),
+               p3 = t.vertex(t.tri_vertex_id(i, 2));
+        IndexedTriangle tr;
+        tr.triangle = CGALTriangle(
+                    CGALPoint(p1.x(), p1.y(), p1.z()),
+                    CGALPoint(p2.x(), p2.y(), p2.z()),
+                    CGALPoint(p3.x(), p3.y(), p3.z()));
+        tr.faceId = i;
         triangles.push_back(tr);
     }
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    buildTree();
 
     bb  = t.getBoundingBox();
 }
@@ -115,30 +132,25 @@ AABBTree::AABBTree(const Trimesh<double>& t, bool forDistanceQueries)
  * @param[in] m: the eigenmesh on which is constructed the tree.
  * @param[in] forDistanceQueries: use this parameter to optimize the tree for distance queries.
  */
-AABBTree::AABBTree(const SimpleEigenMesh& m, bool forDistanceQueries)
+AABBTree::AABBTree(const SimpleEigenMesh& m, bool forDistanceQueries) :
+    forDistanceQueries(forDistanceQueries)
 {
     treeType = EIGENMESH;
-    for (unsigned int i = 0; i < m.numberVertices(); i++){
-        Pointd p = m.vertex(i);
-        CGALPoint pp(p.x(), p.y(), p.z());
-        mapIdVerticesToCgalPoints[i] = pp;
-    }
+    triangles.reserve(m.numberFaces());
     for (unsigned int i = 0; i < m.numberFaces(); ++i){
         if (! m.isDegenerateTriangle(i)){
             Pointi f = m.face(i);
-            int i1 = f(0), i2 = f(1), i3 = f(2);
-            assert(mapIdVerticesToCgalPoints.find(i1) != mapIdVerticesToCgalPoints.end());
-            assert(mapIdVerticesToCgalPoints.find(i2) != mapIdVerticesToCgalPoints.end());
-            assert(mapIdVerticesToCgalPoints.find(i3) != mapIdVerticesToCgalPoints.end());
-            CGALTriangle tr(mapIdVerticesToCgalPoints.at(i1), mapIdVerticesToCgalPoints.at(i2), mapIdVerticesToCgalPoints.at(i3));
-            mapCgalTrianglesToIdTriangles[tr] = i;
+            Pointd p1 = m.vertex(f(0)), p2 = m.vertex(f(1)), p3 = m.vertex(f(2));
+            IndexedTriangle tr;
+            tr.triangle = CGALTriangle(
+                        CGALPoint(p1.x(), p1.y(), p1.z()),
+                        CGALPoint(p2.x(), p2.y(), p2.z()),
+                        CGALPoint(p3.x(), p3.y(), p3.z()));
+            tr.faceId = i;
             triangles.push_back(tr);
         }
     }
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    buildTree();
 
     bb  = m.boundingBox();
 }
@@ -154,26 +166,24 @@ AABBTree::AABBTree(const Dcel& d, bool forDistanceQueries) :
     forDistanceQueries(forDistanceQueries)
 {
     treeType = DCEL;
-    for (Dcel::ConstVertexIterator vit = d.vertexBegin(); vit != d.vertexEnd(); ++vit){
-        const Dcel::Vertex* v = *vit;
-        CGALPoint pp(v->coordinate().x(), v->coordinate().y(), v->coordinate().z());
-        mapDcelVerticesToCgalPoints[v] = pp;
-        mapCgalPointsToDcelVertices[pp] = v;
-    }
+    triangles.reserve(d.numberFaces());
+    dcelFaces.reserve(d.numberFaces());
     for (Dcel::ConstFaceIterator fit = d.faceBegin(); fit != d.faceEnd(); ++fit){
         const Dcel::Face* f = *fit;
         const Dcel::HalfEdge* he = f->outerHalfEdge();
-        const Dcel::Vertex* v1 = he->fromVertex();
-        const Dcel::Vertex* v2 = he->toVertex();
-        const Dcel::Vertex* v3 = he->next()->toVertex();
-        CGALTriangle t(mapDcelVerticesToCgalPoints.at(v1), mapDcelVerticesToCgalPoints.at(v2), mapDcelVerticesToCgalPoints.at(v3));
-        mapCgalTrianglesToDcelFaces[t] = f;
+        Pointd p1 = he->fromVertex()->coordinate(),
+               p2 = he->toVertex()->coordinate(),
+               p3 = he->next()->toVertex()->coordinate();
+        IndexedTriangle t;
+        t.triangle = CGALTriangle(
+                    CGALPoint(p1.x(), p1.y(), p1.z()),
+                    CGALPoint(p2.x(), p2.y(), p2.z()),
+                    CGALPoint(p3.x(), p3.y(), p3.z()));
+        t.faceId = (unsigned int) dcelFaces.size();
         triangles.push_back(t);
+        dcelFaces.push_back(f);
     }
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    buildTree();
 
     bb = d.boundingBox();
 }
@@ -186,23 +196,17 @@ AABBTree::AABBTree(const Dcel& d, bool forDistanceQueries) :
  */
 AABBTree& AABBTree::operator=(const cgal::AABBTree& other)
 {
+    if (this == &other)
+        return *this;
+
     forDistanceQueries = other.forDistanceQueries;
     treeType = other.treeType;
+    tree.clear();
     triangles = other.triangles;
     #ifdef  CG3_DCEL_DEFINED
-    mapDcelVerticesToCgalPoints = other.mapDcelVerticesToCgalPoints;
-    mapCgalPointsToDcelVertices = other.mapCgalPointsToDcelVertices;
-    mapCgalTrianglesToDcelFaces = other.mapCgalTrianglesToDcelFaces;
-    #endif
-    #if defined(TRIMESH_DEFINED) || defined( CG3_EIGENMESH_DEFINED)
-    mapIdVerticesToCgalPoints = other.mapIdVerticesToCgalPoints;
-    mapCgalTrianglesToIdTriangles = other.mapCgalTrianglesToIdTriangles;
+    dcelFaces = other.dcelFaces;
     #endif
-    tree.clear();
-    tree.insert(triangles.begin(), triangles.end());
-
-    if (forDistanceQueries)
-        tree.accelerate_distance_queries();
+    buildTree();
 
     bb = other.bb;
     return *this;
@@ -257,65 +261,77 @@ Pointd AABBTree::nearestPoint(const Pointd& p) const
 }
 
 /**
- * @brief AABBTree::isInside
- * @param p
- * @param numberOfChecks
- * @return
+ * @brief Returns the generalized winding number of the mesh at a point: it is 1 inside
+ * and 0 outside a closed mesh whose faces are oriented outwards (-1 inside if
+ * they are oriented inwards), and a value in between for open meshes.
+ *
+ * The triangles are visited through a bounding hierarchy: the contribution of a node
+ * far enough from the point is approximated by the dipole of its triangles, the
+ * triangles near the point contribute their exact solid angle. The query does
+ * not modify the tree and can be executed in parallel.
+ * @param[in] p: query point
+ * @return the winding number
  */
-bool AABBTree::isInside(const Pointd& p, int numberOfChecks) const
+double AABBTree::windingNumber(const Pointd& p) const
 {
-    static std::random_device rd;
-    static std::mt19937 e2(rd());
-    assert(numberOfChecks % 2 == 1);
-    int inside = 0, outside = 0;
-    std::uniform_real_distribution<> dist(0, 6);
-    std::uniform_real_distribution<> distx(bb.minX(), bb.maxX());
-    std::uniform_real_distribution<> disty(bb.minY(), bb.maxY());
-    std::uniform_real_distribution<> distz(bb.minZ(), bb.maxZ());
-    for (int i = 0; i < numberOfChecks; i++) {
-        Pointd boundingPoint;
-        double n1, n2;
-        int side = std::floor(dist(e2));
-        switch(side % 3){
-            case 0: // x
-                n1 = disty(e2);
-                n2 = distz(e2);
-                boundingPoint.setY(n1);
-                boundingPoint.setZ(n2);
-                if (side == 0)
-                    boundingPoint.setX(bb.minX());
-                else
-                    boundingPoint.setX(bb.maxX());
-                break;
-            case 1: // y
-                n1 = distx(e2);
-                n2 = distz(e2);
-                boundingPoint.setX(n1);
-                boundingPoint.setZ(n2);
-                if (side == 1)
-                    boundingPoint.setY(bb.minY());
-                else
-                    boundingPoint.setY(bb.maxY());
-                break;
-            case 2: // z
-                n1 = distx(e2);
-                n2 = disty(e2);
-                boundingPoint.setX(n1);
-                boundingPoint.setY(n2);
-                if (side == 2)
-                    boundingPoint.setZ(bb.minZ());
-                else
-                    boundingPoint.setZ(bb.maxZ());
-                break;
-        }
+    if (windingNodes.empty())
+        return 0;
 
-        int numberIntersected = numberIntersectedPrimitives(p, boundingPoint);
-        if (numberIntersected % 2 == 1)
-            inside++;
-        else
-            outside++;
+    double solidAngle = 0;
+
+    //The hierarchy is balanced: its depth is less than 32
+    unsigned int stack[64];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const WindingNumberNode& node = windingNodes[stack[--stackSize]];
+
+        Vec3 d = node.center - p;
+        double distance = d.length();
+
+        if (distance > internal::WINDING_NUMBER_ACCURACY * node.radius) {
+            solidAngle += node.normal.dot(d) / (distance * distance * distance);
+        }
+        else if (node.left == 0) {
+            for (unsigned int i = node.begin; i < node.end; i++) {
+                const CGALTriangle& t = triangles[windingTriangles[i]].triangle;
+                solidAngle += internal::triangleSolidAngle(
+                            internal::toPointd(t[0]) - p,
+                            internal::toPointd(t[1]) - p,
+                            internal::toPointd(t[2]) - p);
+            }
+        }
+        else {
+            stack[stackSize++] = node.left;
+            stack[stackSize++] = node.right;
+        }
     }
-    return inside > outside;
+
+    return solidAngle / (4 * M_PI);
+}
+
+/**
+ * @brief Checks if a point is inside the mesh, using its generalized winding number.
+ * The result is deterministic and does not depend on the orientation of the mesh.
+ * @param[in] p: query point
+ * @return true if the point is inside the mesh
+ */
+bool AABBTree::isInside(const Pointd& p) const
+{
+    return std::fabs(windingNumber(p)) >= 0.5;
+}
+
+/**
+ * @brief Checks if a point is inside the mesh.
+ * @deprecated The number of checks is ignored: the point is classified by its
+ * generalized winding number, see isInside(const Pointd&).
+ * @param[in] p: query point
+ * @return true if the point is inside the mesh
+ */
+bool AABBTree::isInside(const Pointd& p, int) const
+{
+    return isInside(p);
 }
 
 /**
@@ -383,6 +399,121 @@ bool AABBTree::isInsidePseudoRandom(const Pointd& p, int numberOfChecks) const
     return inside > outside;
 }
 
+/**
+ * @brief Returns, for each ray, the number of triangles which are intersected by it.
+ * The rays are processed in parallel.
+ * @param[in] rays: starting and passing points of the ray queries
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the number of triangles intersected by each ray
+ */
+std::vector<int> AABBTree::numberIntersectedPrimitives(
+        const std::vector<std::pair<Pointd, Pointd>>& rays,
+        unsigned int nThreads) const
+{
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    std::vector<int> result(rays.size());
+
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(nThreads)
+    for (int i = 0; i < (int) rays.size(); i++){
+        result[i] = numberIntersectedPrimitives(rays[i].first, rays[i].second);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns, for each bounding box, the number of triangles which are intersected by it.
+ * The boxes are processed in parallel.
+ * @param[in] boxes: bounding box queries
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the number of triangles intersected by each box
+ */
+std::vector<int> AABBTree::numberIntersectedPrimitives(
+        const std::vector<BoundingBox>& boxes,
+        unsigned int nThreads) const
+{
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    std::vector<int> result(boxes.size());
+
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(nThreads)
+    for (int i = 0; i < (int) boxes.size(); i++){
+        result[i] = numberIntersectedPrimitives(boxes[i]);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the squared distance of each point from the mesh.
+ * The points are processed in parallel.
+ * @param[in] points: query points
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the squared distances
+ */
+std::vector<double> AABBTree::squaredDistances(
+        const std::vector<Pointd>& points,
+        unsigned int nThreads) const
+{
+    std::vector<double> result(points.size());
+    closestPointsAndPrimitives(
+                points,
+                [&result](int i, const CGALPoint& query, const AABB_triangle_traits::Point_and_primitive_id& ppid) {
+                    result[i] = CGAL::squared_distance(query, ppid.first);
+                },
+                nThreads);
+    return result;
+}
+
+/**
+ * @brief Returns the nearest point on the mesh of each point.
+ * The points are processed in parallel.
+ * @param[in] points: query points
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the nearest points
+ */
+std::vector<Pointd> AABBTree::nearestPoints(
+        const std::vector<Pointd>& points,
+        unsigned int nThreads) const
+{
+    std::vector<Pointd> result(points.size());
+    closestPointsAndPrimitives(
+                points,
+                [&result](int i, const CGALPoint&, const AABB_triangle_traits::Point_and_primitive_id& ppid) {
+                    result[i] = Pointd(ppid.first.x(), ppid.first.y(), ppid.first.z());
+                },
+                nThreads);
+    return result;
+}
+
+/**
+ * @brief Returns, for each point, true if it is inside the mesh (see isInside).
+ * The points are processed in parallel.
+ * @param[in] points: query points
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return true for the points inside the mesh
+ */
+std::vector<bool> AABBTree::isInside(
+        const std::vector<Pointd>& points,
+        unsigned int nThreads) const
+{
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    //std::vector<bool> cannot be written concurrently
+    std::vector<unsigned char> inside(points.size());
+
+    #pragma omp parallel for schedule(dynamic, 64) num_threads(nThreads)
+    for (int i = 0; i < (int) points.size(); i++){
+        inside[i] = isInside(points[i]);
+    }
+
+    return std::vector<bool>(inside.begin(), inside.end());
+}
+
 #ifdef  CG3_DCEL_DEFINED
 /**
  * @brief AABBTree::getContainedDcelFaces
@@ -395,14 +526,10 @@ void AABBTree::containedDcelFaces(
 {
     assert(treeType == DCEL);
     CGALBoundingBox bb(b.minX(), b.minY(), b.minZ(), b.maxX(), b.maxY(), b.maxZ());
-    std::list< Tree::Primitive_id > trianglesIds;
+    std::vector<Tree::Primitive_id> trianglesIds;
     tree.all_intersected_primitives(bb, std::back_inserter(trianglesIds));
-    for (std::list< Tree::Primitive_id >::const_iterator it = trianglesIds.begin(); it != trianglesIds.end(); ++it){
-        const Tree::Primitive_id id = *it;
-        const CGALTriangle t = *id;
-        std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
-        assert(mit != mapCgalTrianglesToDcelFaces.end());
-        outputList.push_back(mit->second);
+    for (const Tree::Primitive_id& id : trianglesIds){
+        outputList.push_back(dcelFaces[id->faceId]);
     }
 }
 
@@ -484,13 +611,10 @@ void AABBTree::intersectedDcelFaces(
     CGALPoint pb(p2.x(), p2.y(), p2.z());
     //CGALRay ray_query(pa,pb);
     K::Segment_3 ray_query(pa,pb);
-    std::list< Tree::Primitive_id > trianglesIds;
+    std::vector<Tree::Primitive_id> trianglesIds;
     tree.all_intersected_primitives(ray_query, std::back_inserter(trianglesIds));
-    for (std::list< Tree::Primitive_id >::const_iterator it = trianglesIds.begin(); it != trianglesIds.end(); ++it){
-        const Tree::Primitive_id id = *it;
-        const CGALTriangle t = *id;
-        std::map<CGALTriangle, const cg3::Dcel::Face*, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
-        outputList.push_back(mit->second);
+    for (const Tree::Primitive_id& id : trianglesIds){
+        outputList.push_back(dcelFaces[id->faceId]);
     }
 }
 
@@ -513,12 +637,7 @@ const Dcel::Face* AABBTree::nearestDcelFace(const Pointd& p) const
     assert(treeType == DCEL);
     CGALPoint query(p.x(), p.y(), p.z());
     AABB_triangle_traits::Point_and_primitive_id ppid = tree.closest_point_and_primitive(query);
-    const Tree::Primitive_id tp = ppid.second;
-    const CGALTriangle t = *tp;
-    std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToDcelFaces.find(t);
-    assert(mit != mapCgalTrianglesToDcelFaces.end());
-    return mit->second;
-
+    return dcelFaces[ppid.second->faceId];
 }
 
 /**
@@ -541,6 +660,28 @@ const Dcel::Vertex* AABBTree::nearestDcelVertex(const Pointd& p) const
     assert(closest != nullptr);
     return closest;
 }
+
+/**
+ * @brief Returns the nearest Dcel face of each point.
+ * The points are processed in parallel.
+ * @param[in] points: query points
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the nearest faces
+ */
+std::vector<const Dcel::Face*> AABBTree::nearestDcelFaces(
+        const std::vector<Pointd>& points,
+        unsigned int nThreads) const
+{
+    assert(treeType == DCEL);
+    std::vector<const Dcel::Face*> result(points.size());
+    closestPointsAndPrimitives(
+                points,
+                [this, &result](int i, const CGALPoint&, const AABB_triangle_traits::Point_and_primitive_id& ppid) {
+                    result[i] = dcelFaces[ppid.second->faceId];
+                },
+                nThreads);
+    return result;
+}
 #endif
 
 #ifdef  CG3_EIGENMESH_DEFINED
@@ -558,13 +699,10 @@ void AABBTree::getIntersectedEigenFaces(const Pointd& p1, const Pointd &p2, std:
     CGALPoint pb(p2.x(), p2.y(), p2.z());
     //CGALRay ray_query(pa,pb);
     K::Segment_3 ray_query(pa,pb);
-    std::list< Tree::Primitive_id > trianglesIds;
+    std::vector<Tree::Primitive_id> trianglesIds;
     tree.all_intersected_primitives(ray_query, std::back_inserter(trianglesIds));
-    for (std::list< Tree::Primitive_id >::const_iterator it = trianglesIds.begin(); it != trianglesIds.end(); ++it){
-        const Tree::Primitive_id id = *it;
-        const CGALTriangle t = *id;
-        std::map<CGALTriangle, int, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
-        outputList.push_back(mit->second);
+    for (const Tree::Primitive_id& id : trianglesIds){
+        outputList.push_back((int) id->faceId);
     }
 }
 
@@ -578,14 +716,188 @@ unsigned int AABBTree::getNearestEigenFace(const Pointd& p) const
     assert(treeType == EIGENMESH);
     CGALPoint query(p.x(), p.y(), p.z());
     AABB_triangle_traits::Point_and_primitive_id ppid = tree.closest_point_and_primitive(query);
-    const Tree::Primitive_id tp = ppid.second;
-    const CGALTriangle t = *tp;
-    std::map<CGALTriangle, int, cmpCGALTriangle>::const_iterator mit = mapCgalTrianglesToIdTriangles.find(t);
-    assert(mit != mapCgalTrianglesToIdTriangles.end());
-    return mit->second;
+    return ppid.second->faceId;
+}
+
+/**
+ * @brief Returns the id of the nearest face of each point.
+ * The points are processed in parallel.
+ * @param[in] points: query points
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the ids of the nearest faces
+ */
+std::vector<unsigned int> AABBTree::nearestEigenFaces(
+        const std::vector<Pointd>& points,
+        unsigned int nThreads) const
+{
+    assert(treeType == EIGENMESH);
+    std::vector<unsigned int> result(points.size());
+    closestPointsAndPrimitives(
+                points,
+                [&result](int i, const CGALPoint&, const AABB_triangle_traits::Point_and_primitive_id& ppid) {
+                    result[i] = ppid.second->faceId;
+                },
+                nThreads);
+    return result;
 }
 #endif
 
+/**
+ * @brief Computes the nearest point and primitive of each point, in parallel,
+ * and passes them to a function. Each thread uses the result of its previous
+ * query as hint for the next one when the two query points are close
+ * (sampled points are usually coherent), and the default hint otherwise.
+ * @param[in] points: query points
+ * @param[in] function: called with the index of the point, the query and its result
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ */
+template <class Function>
+void AABBTree::closestPointsAndPrimitives(
+        const std::vector<Pointd>& points,
+        Function function,
+        unsigned int nThreads) const
+{
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    #pragma omp parallel num_threads(nThreads)
+    {
+        bool hasHint = false;
+        CGALPoint lastQuery;
+        double lastDistance = 0;
+        AABB_triangle_traits::Point_and_primitive_id hint;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < (int) points.size(); i++){
+            CGALPoint query(points[i].x(), points[i].y(), points[i].z());
+
+            //The previous result is at most lastDistance + |query - lastQuery|
+            //far from the query
+            if (hasHint && CGAL::squared_distance(query, lastQuery) <= lastDistance)
+                hint = tree.closest_point_and_primitive(query, hint);
+            else
+                hint = tree.closest_point_and_primitive(query);
+
+            hasHint = true;
+            lastQuery = query;
+            lastDistance = CGAL::squared_distance(query, hint.first);
+
+            function(i, query, hint);
+        }
+    }
+}
+
+/**
+ * @brief Builds the tree on the triangles. The triangles must not be
+ * modified (or reallocated) until the tree is rebuilt.
+ */
+void AABBTree::buildTree()
+{
+    tree.clear();
+    tree.insert(triangles.cbegin(), triangles.cend());
+    tree.build();
+
+    if (forDistanceQueries)
+        tree.accelerate_distance_queries();
+
+    buildWindingNumberHierarchy();
+}
+
+/**
+ * @brief Builds the hierarchy used to compute winding numbers: the triangles
+ * are recursively split at the median of their centroids along the longest
+ * axis, and each node stores the dipole approximation of its triangles.
+ */
+void AABBTree::buildWindingNumberHierarchy()
+{
+    windingNodes.clear();
+    windingTriangles.resize(triangles.size());
+    if (triangles.empty())
+        return;
+
+    std::vector<Pointd> centroids(triangles.size());
+    std::vector<Vec3> areaNormals(triangles.size());
+    for (unsigned int i = 0; i < triangles.size(); i++) {
+        Pointd p1 = internal::toPointd(triangles[i].triangle[0]),
+               p2 = internal::toPointd(triangles[i].triangle[1]),
+               p3 = internal::toPointd(triangles[i].triangle[2]);
+        centroids[i] = (p1 + p2 + p3) / 3;
+        areaNormals[i] = (p2 - p1).cross(p3 - p1) / 2;
+        windingTriangles[i] = i;
+    }
+
+    WindingNumberNode root = {};
+    root.begin = 0;
+    root.end = (unsigned int) triangles.size();
+    windingNodes.reserve(2 * triangles.size() / internal::WINDING_NUMBER_LEAF_SIZE + 1);
+    windingNodes.push_back(root);
+
+    //Nodes are processed in breadth-first order, appending their children
+    for (unsigned int n = 0; n < windingNodes.size(); n++) {
+        unsigned int begin = windingNodes[n].begin, end = windingNodes[n].end;
+
+        //Dipole: area weighted centroid and normal
+        Pointd center;
+        Vec3 normal;
+        double area = 0;
+        BoundingBox centroidsBox(centroids[windingTriangles[begin]], centroids[windingTriangles[begin]]);
+        for (unsigned int i = begin; i < end; i++) {
+            unsigned int t = windingTriangles[i];
+            double triangleArea = areaNormals[t].length();
+            center += centroids[t] * triangleArea;
+            normal += areaNormals[t];
+            area += triangleArea;
+            centroidsBox.setMin(centroidsBox.min().min(centroids[t]));
+            centroidsBox.setMax(centroidsBox.max().max(centroids[t]));
+        }
+        if (area > 0)
+            center /= area;
+        else
+            center = centroidsBox.center();
+
+        double radius = 0;
+        for (unsigned int i = begin; i < end; i++) {
+            const CGALTriangle& t = triangles[windingTriangles[i]].triangle;
+            for (unsigned int j = 0; j < 3; j++)
+                radius = std::max(radius, center.dist(internal::toPointd(t[j])));
+        }
+
+        windingNodes[n].center = center;
+        windingNodes[n].normal = normal;
+        windingNodes[n].radius = radius;
+        windingNodes[n].left = windingNodes[n].right = 0;
+
+        if (end - begin > internal::WINDING_NUMBER_LEAF_SIZE) {
+            //Median split along the longest axis of the centroids
+            unsigned int axis = 0;
+            if (centroidsBox.lengthY() > centroidsBox.lengthX())
+                axis = 1;
+            if (centroidsBox.lengthZ() > std::max(centroidsBox.lengthX(), centroidsBox.lengthY()))
+                axis = 2;
+
+            unsigned int middle = begin + (end - begin) / 2;
+            std::nth_element(
+                        windingTriangles.begin() + begin,
+                        windingTriangles.begin() + middle,
+                        windingTriangles.begin() + end,
+                        [&centroids, axis](unsigned int t1, unsigned int t2) {
+                            return centroids[t1][axis] < centroids[t2][axis];
+                        });
+
+            WindingNumberNode left = {}, right = {};
+            left.begin = begin;
+            left.end = middle;
+            right.begin = middle;
+            right.end = end;
+
+            windingNodes[n].left = (unsigned int) windingNodes.size();
+            windingNodes[n].right = (unsigned int) windingNodes.size() + 1;
+            windingNodes.push_back(left);
+            windingNodes.push_back(right);
+        }
+    }
+}
+
 /**
  * @brief AABBTree::isDegeneratedTriangle
  * @param t
@@ -8,6 +8,9 @@
 #ifndef CG3_CGAL_AABBTREE_H
 #define CG3_CGAL_AABBTREE_H
 
+#include <list>
+#include <vector>
+
 #include <cg3/geometry/bounding_box.h>
 
 #ifdef  CG3_DCEL_DEFINED
@@ -28,7 +31,6 @@ class EigenMesh;
 #include <CGAL/Simple_cartesian.h>
 #include <CGAL/AABB_tree.h>
 #include <CGAL/AABB_traits.h>
-#include <CGAL/AABB_triangle_primitive.h>
 
 namespace cg3 {
 namespace cgal {
@@ -63,8 +65,16 @@ public:
     int numberIntersectedPrimitives(const BoundingBox& b) const;
     double squaredDistance(const Pointd &p) const;
     Pointd nearestPoint(const Pointd &p) const;
-    bool isInside(const Pointd &p, int numberOfChecks = 7) const;
+    double windingNumber(const Pointd &p) const;
+    bool isInside(const Pointd &p) const;
+    bool isInside(const Pointd &p, int numberOfChecks) const;
     bool isInsidePseudoRandom(const Pointd &p, int numberOfChecks = 7) const;
+
+    std::vector<int> numberIntersectedPrimitives(const std::vector<std::pair<Pointd, Pointd>>& rays, unsigned int nThreads = 0) const;
+    std::vector<int> numberIntersectedPrimitives(const std::vector<BoundingBox>& boxes, unsigned int nThreads = 0) const;
+    std::vector<double> squaredDistances(const std::vector<Pointd>& points, unsigned int nThreads = 0) const;
+    std::vector<Pointd> nearestPoints(const std::vector<Pointd>& points, unsigned int nThreads = 0) const;
+    std::vector<bool> isInside(const std::vector<Pointd>& points, unsigned int nThreads = 0) const;
     #ifdef  CG3_DCEL_DEFINED
     void containedDcelFaces(std::list<const Dcel::Face*> &outputList, const BoundingBox &b) const;
     std::list<const Dcel::Face*> containedDcelFaces(const BoundingBox &b) const;
@@ -75,11 +85,13 @@ public:
     std::list<const Dcel::Face*> intersectedDcelFaces(const Pointd& p1, const Pointd& p2) const;
     const Dcel::Face* nearestDcelFace(const Pointd &p) const;
     const Dcel::Vertex* nearestDcelVertex(const Pointd &p) const;
+    std::vector<const Dcel::Face*> nearestDcelFaces(const std::vector<Pointd>& points, unsigned int nThreads = 0) const;
     #endif
 
     #ifdef  CG3_EIGENMESH_DEFINED
     void getIntersectedEigenFaces(const Pointd& p1, const Pointd &p2, std::list<int> &outputList);
     unsigned int getNearestEigenFace(const Pointd& p) const;
+    std::vector<unsigned int> nearestEigenFaces(const std::vector<Pointd>& points, unsigned int nThreads = 0) const;
     #endif
 
     #ifdef CG3_OLD_NAMES_COMPATIBILITY
@@ -108,36 +120,72 @@ protected:
     typedef K::Line_3 CGALLine;
     typedef K::Point_3 CGALPoint;
     typedef K::Triangle_3 CGALTriangle;
-    typedef CGAL::AABB_triangle_primitive<K, std::list<CGALTriangle>::iterator> CGALTrianglePrimitive;
+
+    /**
+     * @brief Triangle of the input mesh, with the index of its face
+     */
+    struct IndexedTriangle {
+        CGALTriangle triangle;
+        unsigned int faceId; //Face index (EigenMesh) or position in dcelFaces (Dcel)
+    };
+
+    /**
+     * @brief CGAL primitive over the contiguous array of triangles: the id of a
+     * primitive points to its triangle, hence the face of a query result is
+     * obtained in constant time
+     */
+    class CGALTrianglePrimitive {
+    public:
+        typedef const IndexedTriangle* Id;
+        typedef K::Point_3 Point;
+        typedef K::Triangle_3 Datum;
+        typedef const K::Point_3& Point_reference;
+        typedef const K::Triangle_3& Datum_reference;
+
+        CGALTrianglePrimitive() : t(nullptr) {}
+        CGALTrianglePrimitive(std::vector<IndexedTriangle>::const_iterator it) : t(&(*it)) {}
+
+        const Id& id() const {return t;}
+        Datum_reference datum() const {return t->triangle;}
+        Point_reference reference_point() const {return t->triangle.vertex(0);}
+
+    private:
+        Id t;
+    };
+
     typedef CGAL::AABB_traits<K, CGALTrianglePrimitive> AABB_triangle_traits;
     typedef CGAL::AABB_tree<AABB_triangle_traits> Tree;
 
     typedef AABB_triangle_traits::Bounding_box CGALBoundingBox;
 
-    struct cmpCGALTriangle {
-        bool operator()(const CGALTriangle& a, const CGALTriangle& b) const {
-            if (a == b) return false;
-            if (a[0] == b[0] && a[1] == b[1]) return (a[2] < b[2]);
-            if (a[0] == b[0]) return (a[1] < b[1]);
-            return (a[0] < b[0]);
-        }
+    static bool isDegeneratedTriangle(const CGALTriangle &t);
+
+    /**
+     * @brief Node of the hierarchy used to compute winding numbers: far from
+     * the query point, its triangles are approximated by a single dipole
+     */
+    struct WindingNumberNode {
+        Pointd center; //Area weighted centroid of the triangles
+        Vec3 normal; //Sum of the area weighted normals of the triangles
+        double radius; //Radius of the ball around center containing the triangles
+        unsigned int begin, end; //Range of the triangles in windingTriangles
+        unsigned int left, right; //Children, 0 for leaves
     };
 
-    static bool isDegeneratedTriangle(const CGALTriangle &t);
+    void buildTree();
+    void buildWindingNumberHierarchy();
+    template <class Function>
+    void closestPointsAndPrimitives(const std::vector<Pointd>& points, Function function, unsigned int nThreads) const;
 
     Tree tree;
     bool forDistanceQueries;
     TreeType treeType;
+    std::vector<IndexedTriangle> triangles; //Triangles referred by the tree, never reallocated after the build
     #ifdef CG3_DCEL_DEFINED
-    std::map<const Dcel::Vertex*, CGALPoint> mapDcelVerticesToCgalPoints;
-    std::map<CGALPoint, const Dcel::Vertex*> mapCgalPointsToDcelVertices;
-    std::map<CGALTriangle, const Dcel::Face*, cmpCGALTriangle> mapCgalTrianglesToDcelFaces;
-    #endif
-    #if defined(TRIMESH_DEFINED) || defined( CG3_EIGENMESH_DEFINED)
-    std::map<int, CGALPoint> mapIdVerticesToCgalPoints;
-    std::map<CGALTriangle, int, cmpCGALTriangle> mapCgalTrianglesToIdTriangles;
+    std::vector<const Dcel::Face*> dcelFaces; //Dcel face of each triangle
     #endif
-    std::list<CGALTriangle> triangles;
+    std::vector<WindingNumberNode> windingNodes; //Winding number hierarchy, the root is the first node
+    std::vector<unsigned int> windingTriangles; //Triangles sorted by the winding number hierarchy
     BoundingBox bb;
 };
 
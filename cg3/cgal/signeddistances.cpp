@@ -26,15 +26,7 @@ std::vector<double> unsignedDistances(
         const std::vector<Pointd>& points,
         const AABBTree& tree)
 {
-    std::vector<double> distances(points.size(), 0);
-    size_t size = distances.size();
-
-    #pragma omp parallel for
-    for (unsigned int i = 0; i < size; i++){
-        distances[i] = tree.squaredDistance(points[i]);
-    }
-
-    return distances;
+    return tree.squaredDistances(points);
 }
 
 } //namespace cg3::cgal
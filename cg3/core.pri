@@ -74,16 +74,24 @@ SOURCES += \
 
 #io
 HEADERS += \
+    $$PWD/core/cg3/io/block_file.h \
+    $$PWD/core/cg3/io/compression.h \
+    $$PWD/core/cg3/io/file_reader.h \
     $$PWD/core/cg3/io/load_save_file.h \
     $$PWD/core/cg3/io/serializable_object.h \
     $$PWD/core/cg3/io/serialize.h \
+    $$PWD/core/cg3/io/serialize_compressed.h \
     $$PWD/core/cg3/io/serialize_eigen.h \
     $$PWD/core/cg3/io/serialize_qt.h \
     $$PWD/core/cg3/io/serialize_std.h
 
 SOURCES += \
+    $$PWD/core/cg3/io/block_file.tpp \
+    $$PWD/core/cg3/io/compression.tpp \
+    $$PWD/core/cg3/io/file_reader.tpp \
     $$PWD/core/cg3/io/load_save_file.tpp \
     $$PWD/core/cg3/io/serialize.tpp \
+    $$PWD/core/cg3/io/serialize_compressed.tpp \
     $$PWD/core/cg3/io/serialize_eigen.tpp \
     $$PWD/core/cg3/io/serialize_qt.tpp \
     $$PWD/core/cg3/io/serialize_std.tpp
@@ -96,6 +104,7 @@ HEADERS += \
     $$PWD/core/cg3/utilities/eigen.h \
     $$PWD/core/cg3/utilities/hash.h \
     $$PWD/core/cg3/utilities/map.h \
+    $$PWD/core/cg3/utilities/memory_pool.h \
     $$PWD/core/cg3/utilities/nested_initializer_lists.h \
     $$PWD/core/cg3/utilities/pair.h \
     $$PWD/core/cg3/utilities/set.h \
@@ -111,6 +120,7 @@ SOURCES += \
     $$PWD/core/cg3/utilities/eigen.tpp \
     $$PWD/core/cg3/utilities/hash.tpp \
     $$PWD/core/cg3/utilities/map.tpp \
+    $$PWD/core/cg3/utilities/memory_pool.tpp \
     $$PWD/core/cg3/utilities/pair.tpp \
     $$PWD/core/cg3/utilities/set.tpp \
     $$PWD/core/cg3/utilities/string.tpp \
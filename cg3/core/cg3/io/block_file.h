@@ -0,0 +1,139 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_BLOCK_FILE_H
+#define CG3_BLOCK_FILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cg3 {
+
+namespace internal {
+
+typedef enum {
+    BLOCK_CHAR, BLOCK_UCHAR, BLOCK_INT, BLOCK_UINT,
+    BLOCK_LONGLONG, BLOCK_ULONGLONG, BLOCK_FLOAT, BLOCK_DOUBLE
+} BlockScalarType;
+
+template <typename T> struct BlockScalar;
+template <> struct BlockScalar<char>               { static const BlockScalarType type = BLOCK_CHAR; };
+template <> struct BlockScalar<unsigned char>      { static const BlockScalarType type = BLOCK_UCHAR; };
+template <> struct BlockScalar<int>                { static const BlockScalarType type = BLOCK_INT; };
+template <> struct BlockScalar<unsigned int>       { static const BlockScalarType type = BLOCK_UINT; };
+template <> struct BlockScalar<long long>          { static const BlockScalarType type = BLOCK_LONGLONG; };
+template <> struct BlockScalar<unsigned long long> { static const BlockScalarType type = BLOCK_ULONGLONG; };
+template <> struct BlockScalar<float>              { static const BlockScalarType type = BLOCK_FLOAT; };
+template <> struct BlockScalar<double>             { static const BlockScalarType type = BLOCK_DOUBLE; };
+
+/**
+ * @brief First 64 bytes of a block file.
+ */
+typedef struct {
+    char magic[8];          /**< @brief "cg3block" */
+    uint32_t version;
+    uint32_t byteOrder;     /**< @brief 0x01020304 written with the byte order of the machine */
+    uint32_t alignment;     /**< @brief Alignment in bytes of the beginning of every block */
+    uint32_t nBlocks;
+    char type[40];          /**< @brief Null terminated name of the stored object */
+} BlockFileHeader;
+
+/**
+ * @brief Description of a block, stored after the header.
+ */
+typedef struct {
+    char name[16];          /**< @brief Null terminated name of the block */
+    uint32_t scalarType;    /**< @brief A BlockScalarType */
+    uint32_t cols;
+    uint64_t rows;
+    uint64_t offset;        /**< @brief Position of the block from the beginning of the file */
+    uint64_t size;          /**< @brief Size of the block in bytes */
+} BlockFileEntry;
+
+static const uint32_t blockFileVersion = 1;
+static const uint32_t blockFileAlignment = 64;
+
+} //namespace cg3::internal
+
+/**
+ * @brief The BlockFileWriter class writes a block file: a versioned binary file
+ * containing a set of named row-major matrices (blocks).
+ *
+ * Every block starts at an offset multiple of 64 bytes, therefore the file can be
+ * mapped in memory by BlockFile and its blocks can be used directly (e.g. wrapped by
+ * an Eigen::Map) without copying them.
+ *
+ * The blocks are not copied by addBlock(): the data must be valid until save() is
+ * called.
+ */
+class BlockFileWriter
+{
+public:
+    BlockFileWriter(const std::string& type);
+
+    template <typename T>
+    void addBlock(const std::string& name, const T* data, size_t rows, size_t cols);
+
+    bool save(const std::string& filename) const;
+
+private:
+    std::string type;
+    std::vector<internal::BlockFileEntry> entries;
+    std::vector<const char*> blocks;
+};
+
+/**
+ * @brief The BlockFile class maps in memory a file written by BlockFileWriter and gives
+ * access to its blocks without reading or copying them.
+ *
+ * Opening a file costs only the validation of its header, whatever the size of the
+ * file: the operating system loads the pages of a block the first time they are
+ * accessed. Pointers returned by block() remain valid until the file is closed.
+ *
+ * Files written on machines with a different byte order are refused.
+ */
+class BlockFile
+{
+public:
+    BlockFile();
+    BlockFile(const std::string& filename);
+    BlockFile(const BlockFile& other) = delete;
+    ~BlockFile();
+
+    bool open(const std::string& filename);
+    bool isOpen() const;
+    void close();
+
+    const std::string& type() const;
+    unsigned int version() const;
+    bool hasBlock(const std::string& name) const;
+
+    template <typename T>
+    bool block(const std::string& name, const T*& data, size_t& rows, size_t& cols) const;
+
+    BlockFile& operator=(const BlockFile& other) = delete;
+
+private:
+    const internal::BlockFileEntry* findBlock(const std::string& name) const;
+
+    const char* mapping;
+    size_t mappingSize;
+    #ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+    #else
+    int fileDescriptor;
+    #endif
+    std::string fileType;
+    unsigned int fileVersion;
+    std::vector<internal::BlockFileEntry> entries;
+};
+
+} //namespace cg3
+
+#include "block_file.tpp"
+
+#endif // CG3_BLOCK_FILE_H
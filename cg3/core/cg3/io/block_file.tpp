@@ -0,0 +1,277 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "block_file.h"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cg3 {
+
+/**
+ * @brief Creates a writer for an object of the given type.
+ * @param[in] type: name of the stored object, checked by the readers (at most 39 characters)
+ */
+inline BlockFileWriter::BlockFileWriter(const std::string& type) :
+    type(type.substr(0, sizeof(internal::BlockFileHeader::type) - 1))
+{
+}
+
+/**
+ * @brief Adds a row-major matrix to the blocks that will be saved.
+ * @param[in] name: name of the block (at most 15 characters)
+ * @param[in] data: pointer to the rows*cols elements of the matrix
+ * @param[in] rows: number of rows of the matrix
+ * @param[in] cols: number of columns of the matrix
+ */
+template <typename T>
+inline void BlockFileWriter::addBlock(
+        const std::string& name,
+        const T* data,
+        size_t rows,
+        size_t cols)
+{
+    internal::BlockFileEntry entry;
+    std::memset(&entry, 0, sizeof(entry));
+    std::strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+    entry.scalarType = internal::BlockScalar<T>::type;
+    entry.rows = rows;
+    entry.cols = cols;
+    entry.size = rows * cols * sizeof(T);
+    entries.push_back(entry);
+    blocks.push_back((const char*)data);
+}
+
+/**
+ * @brief Writes the header, the description of the blocks and all the blocks on a file.
+ * @param[in] filename: the file that will be written
+ * @return false if the file cannot be written
+ */
+inline bool BlockFileWriter::save(const std::string& filename) const
+{
+    internal::BlockFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "cg3block", sizeof(header.magic));
+    header.version = internal::blockFileVersion;
+    header.byteOrder = 0x01020304;
+    header.alignment = internal::blockFileAlignment;
+    header.nBlocks = entries.size();
+    std::strncpy(header.type, type.c_str(), sizeof(header.type) - 1);
+
+    std::vector<internal::BlockFileEntry> table(entries);
+    uint64_t offset = sizeof(header) + table.size() * sizeof(internal::BlockFileEntry);
+    for (internal::BlockFileEntry& entry : table) {
+        offset = (offset + header.alignment - 1) / header.alignment * header.alignment;
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    std::ofstream fp(filename, std::ios::binary);
+    if (!fp.is_open())
+        return false;
+    const char padding[internal::blockFileAlignment] = {};
+    fp.write((const char*)&header, sizeof(header));
+    if (!table.empty())
+        fp.write((const char*)table.data(), table.size() * sizeof(internal::BlockFileEntry));
+    uint64_t position = sizeof(header) + table.size() * sizeof(internal::BlockFileEntry);
+    for (unsigned int i = 0; i < table.size(); i++) {
+        fp.write(padding, table[i].offset - position);
+        fp.write(blocks[i], table[i].size);
+        position = table[i].offset + table[i].size;
+    }
+    fp.close();
+    return !fp.fail();
+}
+
+inline BlockFile::BlockFile() :
+    mapping(nullptr),
+    mappingSize(0),
+    #ifdef _WIN32
+    fileHandle(INVALID_HANDLE_VALUE),
+    mappingHandle(nullptr),
+    #else
+    fileDescriptor(-1),
+    #endif
+    fileVersion(0)
+{
+}
+
+inline BlockFile::BlockFile(const std::string& filename) :
+    BlockFile()
+{
+    open(filename);
+}
+
+inline BlockFile::~BlockFile()
+{
+    close();
+}
+
+/**
+ * @brief Maps the given file in memory and validates its header and its blocks,
+ * closing the file previously opened.
+ * @param[in] filename: a file written by BlockFileWriter
+ * @return false if the file cannot be mapped or is not a valid block file
+ */
+inline bool BlockFile::open(const std::string& filename)
+{
+    close();
+    #ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize)) {
+        close();
+        return false;
+    }
+    mappingSize = fileSize.QuadPart;
+    if (mappingSize >= sizeof(internal::BlockFileHeader))
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle != nullptr)
+        mapping = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    #else
+    fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStat) != 0) {
+        close();
+        return false;
+    }
+    mappingSize = fileStat.st_size;
+    if (mappingSize >= sizeof(internal::BlockFileHeader)) {
+        void* m = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        if (m != MAP_FAILED)
+            mapping = (const char*)m;
+    }
+    #endif
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+
+    internal::BlockFileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    header.type[sizeof(header.type) - 1] = '\0';
+    uint64_t tableEnd = sizeof(header) + (uint64_t)header.nBlocks * sizeof(internal::BlockFileEntry);
+    if (std::memcmp(header.magic, "cg3block", sizeof(header.magic)) != 0 ||
+            header.version == 0 || header.version > internal::blockFileVersion ||
+            header.byteOrder != 0x01020304 || tableEnd > mappingSize) {
+        close();
+        return false;
+    }
+    entries.resize(header.nBlocks);
+    if (header.nBlocks > 0)
+        std::memcpy(entries.data(), mapping + sizeof(header), header.nBlocks * sizeof(internal::BlockFileEntry));
+    for (internal::BlockFileEntry& entry : entries) {
+        entry.name[sizeof(entry.name) - 1] = '\0';
+        if (entry.offset > mappingSize || entry.size > mappingSize - entry.offset ||
+                entry.offset % internal::blockFileAlignment != 0) {
+            close();
+            return false;
+        }
+    }
+    fileType = header.type;
+    fileVersion = header.version;
+    return true;
+}
+
+inline bool BlockFile::isOpen() const
+{
+    return mapping != nullptr;
+}
+
+/**
+ * @brief Unmaps the file: all the pointers returned by block() become invalid.
+ */
+inline void BlockFile::close()
+{
+    #ifdef _WIN32
+    if (mapping != nullptr)
+        UnmapViewOfFile(mapping);
+    if (mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+    #else
+    if (mapping != nullptr)
+        munmap((void*)mapping, mappingSize);
+    if (fileDescriptor >= 0)
+        ::close(fileDescriptor);
+    fileDescriptor = -1;
+    #endif
+    mapping = nullptr;
+    mappingSize = 0;
+    fileType.clear();
+    fileVersion = 0;
+    entries.clear();
+}
+
+/**
+ * @brief Returns the type of the object stored in the file.
+ */
+inline const std::string& BlockFile::type() const
+{
+    return fileType;
+}
+
+/**
+ * @brief Returns the version of the format with which the file has been written.
+ */
+inline unsigned int BlockFile::version() const
+{
+    return fileVersion;
+}
+
+inline bool BlockFile::hasBlock(const std::string& name) const
+{
+    return findBlock(name) != nullptr;
+}
+
+/**
+ * @brief Gives access to a block of the file, without copying it.
+ * @param[in] name: name of the block
+ * @param[out] data: pointer to the first element of the block (row-major)
+ * @param[out] rows: number of rows of the block
+ * @param[out] cols: number of columns of the block
+ * @return false if the file does not contain a block with the given name whose
+ * elements are of type T
+ */
+template <typename T>
+inline bool BlockFile::block(
+        const std::string& name,
+        const T*& data,
+        size_t& rows,
+        size_t& cols) const
+{
+    const internal::BlockFileEntry* entry = findBlock(name);
+    if (entry == nullptr || entry->scalarType != (uint32_t)internal::BlockScalar<T>::type ||
+            entry->rows * entry->cols * sizeof(T) != entry->size)
+        return false;
+    data = (const T*)(mapping + entry->offset);
+    rows = entry->rows;
+    cols = entry->cols;
+    return true;
+}
+
+inline const internal::BlockFileEntry* BlockFile::findBlock(const std::string& name) const
+{
+    for (const internal::BlockFileEntry& entry : entries) {
+        if (name == entry.name)
+            return &entry;
+    }
+    return nullptr;
+}
+
+} //namespace cg3
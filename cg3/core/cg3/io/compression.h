@@ -0,0 +1,40 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_COMPRESSION_H
+#define CG3_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cg3 {
+namespace internal {
+
+/*
+ * Fast lossless compression of memory blocks, using the LZ4 block format: a sequence of
+ * literal runs, each one followed by a copy of at most 64KB back in the decompressed data.
+ */
+
+size_t compressionBound(size_t size);
+
+size_t compressBlock(
+        const char* source,
+        size_t size,
+        char* destination);
+
+bool decompressBlock(
+        const char* source,
+        size_t compressedSize,
+        char* destination,
+        size_t size);
+
+uint32_t checksum(const char* data, size_t size);
+
+} //namespace cg3::internal
+} //namespace cg3
+
+#include "compression.tpp"
+
+#endif // CG3_COMPRESSION_H
@@ -0,0 +1,263 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "compression.h"
+
+#include <cstring>
+#include <vector>
+
+namespace cg3 {
+namespace internal {
+
+namespace lz {
+
+static const size_t minMatch = 4;
+static const size_t lastLiterals = 5;   //the last bytes of a block are always literals
+static const size_t matchLimit = 12;    //no match starts in the last bytes of a block
+static const size_t maxOffset = 65535;
+static const unsigned int hashLog = 14;
+
+inline uint32_t read32(const char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t read64(const char* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash(uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - hashLog);
+}
+
+inline uint32_t rotateLeft(uint32_t v, unsigned int r)
+{
+    return (v << r) | (v >> (32 - r));
+}
+
+inline char* writeToken(char* op, size_t literals, size_t matchLength)
+{
+    *op++ = (char)(((literals < 15 ? literals : 15) << 4) | (matchLength < 15 ? matchLength : 15));
+    return op;
+}
+
+inline char* writeLength(char* op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = (char)255;
+    *op++ = (char)length;
+    return op;
+}
+
+inline bool readLength(const unsigned char*& ip, const unsigned char* end, size_t& length)
+{
+    unsigned char b;
+    do {
+        if (ip == end)
+            return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+} //namespace cg3::internal::lz
+
+/**
+ * @brief Returns the maximum size of a compressed block of the given size,
+ * reached when the data is not compressible.
+ */
+inline size_t compressionBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief Compresses a block of memory.
+ *
+ * Repeated sequences of 4 or more bytes are found with a hash table of the last positions
+ * in which every sequence appeared, and are replaced with a copy from that position.
+ * The search is skipped faster on data that does not compress, so that the cost of
+ * compressing random data stays close to the cost of copying it.
+ *
+ * @param[in] source: the block to compress
+ * @param[in] size: size in bytes of the block
+ * @param[out] destination: buffer of at least compressionBound(size) bytes
+ * @return the size of the compressed block
+ */
+inline size_t compressBlock(
+        const char* source,
+        size_t size,
+        char* destination)
+{
+    const char* ip = source;
+    const char* anchor = source;
+    const char* const end = source + size;
+    char* op = destination;
+
+    if (size > lz::matchLimit) {
+        std::vector<uint32_t> table(1 << lz::hashLog, 0);
+        const char* const mfLimit = end - lz::matchLimit;
+        const char* const matchEnd = end - lz::lastLiterals;
+        unsigned int misses = 0;
+        while (ip < mfLimit) {
+            uint32_t sequence = lz::read32(ip);
+            uint32_t h = lz::hash(sequence);
+            const char* ref = source + table[h];
+            table[h] = (uint32_t)(ip - source);
+            if (ref < ip && (size_t)(ip - ref) <= lz::maxOffset && lz::read32(ref) == sequence) {
+                const char* mp = ip + lz::minMatch;
+                const char* rp = ref + lz::minMatch;
+                while (mp + 8 <= matchEnd && lz::read64(mp) == lz::read64(rp)) {
+                    mp += 8;
+                    rp += 8;
+                }
+                while (mp < matchEnd && *mp == *rp) {
+                    mp++;
+                    rp++;
+                }
+
+                size_t literals = ip - anchor;
+                size_t matchLength = mp - ip - lz::minMatch;
+                size_t offset = ip - ref;
+                op = lz::writeToken(op, literals, matchLength);
+                if (literals >= 15)
+                    op = lz::writeLength(op, literals - 15);
+                std::memcpy(op, anchor, literals);
+                op += literals;
+                *op++ = (char)(offset & 255);
+                *op++ = (char)(offset >> 8);
+                if (matchLength >= 15)
+                    op = lz::writeLength(op, matchLength - 15);
+
+                ip = anchor = mp;
+                misses = 0;
+            }
+            else {
+                ip += 1 + (misses++ >> 6);
+            }
+        }
+    }
+
+    size_t literals = end - anchor;
+    op = lz::writeToken(op, literals, 0);
+    if (literals >= 15)
+        op = lz::writeLength(op, literals - 15);
+    if (literals > 0)
+        std::memcpy(op, anchor, literals);
+    op += literals;
+    return op - destination;
+}
+
+/**
+ * @brief Decompresses a block compressed by compressBlock().
+ *
+ * Every length and offset read from the compressed block is checked, therefore corrupted
+ * data never causes reads or writes out of the given buffers.
+ *
+ * @param[in] source: the compressed block
+ * @param[in] compressedSize: size in bytes of the compressed block
+ * @param[out] destination: buffer of size bytes
+ * @param[in] size: size in bytes of the decompressed block
+ * @return false if the compressed block is not valid or does not decompress
+ * in exactly size bytes
+ */
+inline bool decompressBlock(
+        const char* source,
+        size_t compressedSize,
+        char* destination,
+        size_t size)
+{
+    const unsigned char* ip = (const unsigned char*)source;
+    const unsigned char* const end = ip + compressedSize;
+    char* op = destination;
+    char* const opEnd = destination + size;
+
+    while (ip < end) {
+        unsigned int token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !lz::readLength(ip, end, literals))
+            return false;
+        if (literals > (size_t)(end - ip) || literals > (size_t)(opEnd - op))
+            return false;
+        if (literals > 0)
+            std::memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip == end)
+            break;
+
+        if (end - ip < 2)
+            return false;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - destination))
+            return false;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !lz::readLength(ip, end, matchLength))
+            return false;
+        matchLength += lz::minMatch;
+        if (matchLength > (size_t)(opEnd - op))
+            return false;
+        const char* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else {
+            //overlapping copy: repeats the last offset bytes
+            for (size_t i = 0; i < matchLength; i++)
+                *op++ = *match++;
+        }
+    }
+    return op == opEnd;
+}
+
+/**
+ * @brief Computes a 32 bit checksum (xxHash32) of a block of memory.
+ */
+inline uint32_t checksum(const char* data, size_t size)
+{
+    static const uint32_t p1 = 2654435761U, p2 = 2246822519U, p3 = 3266489917U,
+            p4 = 668265263U, p5 = 374761393U;
+    const char* p = data;
+    const char* const end = data + size;
+    uint32_t h;
+
+    if (size >= 16) {
+        uint32_t v[4] = {p1 + p2, p2, 0, 0 - p1};
+        for (; p + 16 <= end; p += 16) {
+            for (unsigned int i = 0; i < 4; i++)
+                v[i] = lz::rotateLeft(v[i] + lz::read32(p + 4*i) * p2, 13) * p1;
+        }
+        h = lz::rotateLeft(v[0], 1) + lz::rotateLeft(v[1], 7) +
+                lz::rotateLeft(v[2], 12) + lz::rotateLeft(v[3], 18);
+    }
+    else {
+        h = p5;
+    }
+    h += (uint32_t)size;
+
+    for (; p + 4 <= end; p += 4)
+        h = lz::rotateLeft(h + lz::read32(p) * p3, 17) * p4;
+    for (; p < end; p++)
+        h = lz::rotateLeft(h + (unsigned char)*p * p5, 11) * p1;
+
+    h ^= h >> 15;
+    h *= p2;
+    h ^= h >> 13;
+    h *= p3;
+    h ^= h >> 16;
+    return h;
+}
+
+} //namespace cg3::internal
+} //namespace cg3
@@ -0,0 +1,76 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_FILE_READER_H
+#define CG3_FILE_READER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace cg3 {
+namespace internal {
+
+/**
+ * @brief The FileReader class reads a file in large chunks, and allows to access
+ * its lines without copying them.
+ *
+ * getLine() returns the boundaries of the next line directly inside the internal
+ * buffer: the pointers remain valid until the next call of getLine() or read().
+ * Lines longer than the buffer are managed by enlarging the buffer.
+ *
+ * get(), peek() and read() give access to raw bytes, and are meant to be used to read
+ * binary blocks after a textual header.
+ *
+ * seek() and position() allow to read only a portion of a file, e.g. when the file
+ * is split in chunks which are read by different threads.
+ */
+class FileReader
+{
+public:
+    FileReader(size_t bufferSize = 1 << 20);
+    FileReader(const std::string& filename, size_t bufferSize = 1 << 20);
+    FileReader(const FileReader& other) = delete;
+    ~FileReader();
+
+    bool open(const std::string& filename);
+    bool isOpen() const;
+    void close();
+
+    unsigned long long size();
+    unsigned long long position() const;
+    bool seek(unsigned long long offset);
+
+    bool getLine(const char*& lineBegin, const char*& lineEnd);
+    const char* get(size_t size);
+    const char* peek(size_t& size);
+    bool read(void* data, size_t size);
+
+    FileReader& operator=(const FileReader& other) = delete;
+
+private:
+    bool fill();
+
+    std::FILE* file;
+    std::vector<char> buffer;
+    unsigned long long bufferOffset; /**< @brief Position in the file of the first byte of the buffer */
+    size_t dataBegin;   /**< @brief First not consumed byte of the buffer */
+    size_t dataEnd;     /**< @brief End of the valid bytes of the buffer */
+    bool endOfFile;
+};
+
+const char* skipSpaces(const char* p, const char* end);
+const char* skipToken(const char* p, const char* end);
+bool tokenEquals(const char* begin, const char* end, const char* string);
+
+bool parseDouble(const char*& p, const char* end, double& value);
+bool parseInt(const char*& p, const char* end, long long& value);
+
+} //namespace cg3::internal
+} //namespace cg3
+
+#include "file_reader.tpp"
+
+#endif // CG3_FILE_READER_H
@@ -0,0 +1,407 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "file_reader.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace cg3 {
+namespace internal {
+
+/**
+ * @brief Creates a FileReader not associated to any file.
+ * @param[in] bufferSize: size in bytes of the chunks read from the file
+ */
+inline FileReader::FileReader(size_t bufferSize) :
+    file(nullptr),
+    buffer(bufferSize > 0 ? bufferSize : 1),
+    bufferOffset(0),
+    dataBegin(0),
+    dataEnd(0),
+    endOfFile(true)
+{
+}
+
+/**
+ * @brief Creates a FileReader and opens the given file.
+ * @param[in] filename: the file that will be read
+ * @param[in] bufferSize: size in bytes of the chunks read from the file
+ */
+inline FileReader::FileReader(const std::string& filename, size_t bufferSize) :
+    FileReader(bufferSize)
+{
+    open(filename);
+}
+
+inline FileReader::~FileReader()
+{
+    close();
+}
+
+/**
+ * @brief Opens the given file, closing the file previously opened.
+ * @param[in] filename: the file that will be read
+ * @return true if the file has been opened
+ */
+inline bool FileReader::open(const std::string& filename)
+{
+    close();
+    file = std::fopen(filename.c_str(), "rb");
+    endOfFile = file == nullptr;
+    return file != nullptr;
+}
+
+inline bool FileReader::isOpen() const
+{
+    return file != nullptr;
+}
+
+inline void FileReader::close()
+{
+    if (file != nullptr)
+        std::fclose(file);
+    file = nullptr;
+    bufferOffset = 0;
+    dataBegin = dataEnd = 0;
+    endOfFile = true;
+}
+
+/**
+ * @brief Returns the size in bytes of the opened file (0 if no file is opened).
+ */
+inline unsigned long long FileReader::size()
+{
+    if (file == nullptr)
+        return 0;
+    unsigned long long current = bufferOffset + dataEnd;
+    #ifdef _WIN32
+    _fseeki64(file, 0, SEEK_END);
+    unsigned long long fileSize = _ftelli64(file);
+    _fseeki64(file, current, SEEK_SET);
+    #else
+    fseeko(file, 0, SEEK_END);
+    unsigned long long fileSize = ftello(file);
+    fseeko(file, current, SEEK_SET);
+    #endif
+    return fileSize;
+}
+
+/**
+ * @brief Returns the position in the file of the next byte that will be read.
+ */
+inline unsigned long long FileReader::position() const
+{
+    return bufferOffset + dataBegin;
+}
+
+/**
+ * @brief Moves the reading position at the given offset from the beginning of the file,
+ * discarding the content of the buffer.
+ * @param[in] offset: the new position in the file
+ * @return false if no file is opened or the position cannot be reached
+ */
+inline bool FileReader::seek(unsigned long long offset)
+{
+    if (file == nullptr)
+        return false;
+    #ifdef _WIN32
+    bool ok = _fseeki64(file, offset, SEEK_SET) == 0;
+    #else
+    bool ok = fseeko(file, offset, SEEK_SET) == 0;
+    #endif
+    bufferOffset = offset;
+    dataBegin = dataEnd = 0;
+    endOfFile = !ok;
+    return ok;
+}
+
+/**
+ * @brief Gives the boundaries of the next line of the file.
+ *
+ * The newline character (and the carriage return preceding it) is not part of the line.
+ *
+ * @param[out] lineBegin: pointer to the first character of the line
+ * @param[out] lineEnd: pointer past the last character of the line
+ * @return false if the end of the file has been reached
+ */
+inline bool FileReader::getLine(const char*& lineBegin, const char*& lineEnd)
+{
+    size_t searchFrom = dataBegin;
+    for (;;) {
+        const char* newLine = (const char*)std::memchr(
+                    buffer.data() + searchFrom, '\n', dataEnd - searchFrom);
+        if (newLine != nullptr || (endOfFile && dataBegin != dataEnd)) {
+            lineBegin = buffer.data() + dataBegin;
+            lineEnd = newLine != nullptr ? newLine : buffer.data() + dataEnd;
+            dataBegin = lineEnd - buffer.data() + (newLine != nullptr ? 1 : 0);
+            if (lineEnd != lineBegin && *(lineEnd-1) == '\r')
+                lineEnd--;
+            return true;
+        }
+        if (endOfFile)
+            return false;
+        size_t alreadySearched = dataEnd - dataBegin;
+        fill();
+        searchFrom = dataBegin + alreadySearched;
+    }
+}
+
+/**
+ * @brief Gives access to the next size bytes of the file, without copying them.
+ *
+ * The returned pointer points inside the internal buffer and remains valid until the
+ * next call of getLine(), get() or read().
+ *
+ * @param[in] size: number of bytes to read
+ * @return a pointer to the read bytes, or nullptr if the file contains less than size bytes
+ */
+inline const char* FileReader::get(size_t size)
+{
+    while (dataEnd - dataBegin < size) {
+        if (!fill())
+            return nullptr;
+    }
+    const char* data = buffer.data() + dataBegin;
+    dataBegin += size;
+    return data;
+}
+
+/**
+ * @brief Gives access to the next bytes of the file without consuming them: a following
+ * get() returns the same bytes.
+ *
+ * The returned pointer points inside the internal buffer and remains valid until the
+ * next call of getLine(), get(), peek() or read().
+ *
+ * @param[in,out] size: number of requested bytes; in output, the number of available bytes,
+ * which is smaller than the requested one only at the end of the file
+ * @return a pointer to the available bytes
+ */
+inline const char* FileReader::peek(size_t& size)
+{
+    while (dataEnd - dataBegin < size && fill());
+    size = std::min(size, dataEnd - dataBegin);
+    return buffer.data() + dataBegin;
+}
+
+/**
+ * @brief Copies the next size bytes of the file in data.
+ *
+ * Large blocks are read directly from the file, without passing through the buffer.
+ *
+ * @param[out] data: destination of the bytes, must contain at least size bytes
+ * @param[in] size: number of bytes to read
+ * @return false if the file contains less than size bytes
+ */
+inline bool FileReader::read(void* data, size_t size)
+{
+    char* dst = (char*)data;
+    size_t available = std::min(size, dataEnd - dataBegin);
+    std::memcpy(dst, buffer.data() + dataBegin, available);
+    dataBegin += available;
+    dst += available;
+    size -= available;
+    if (size >= buffer.size() && file != nullptr) {
+        bufferOffset += dataEnd;
+        dataBegin = dataEnd = 0;
+        size_t n = std::fread(dst, 1, size, file);
+        bufferOffset += n;
+        if (n < size)
+            endOfFile = true;
+        return n == size;
+    }
+    while (size > 0) {
+        if (!fill())
+            return false;
+        size_t n = std::min(size, dataEnd - dataBegin);
+        std::memcpy(dst, buffer.data() + dataBegin, n);
+        dataBegin += n;
+        dst += n;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves the not consumed bytes at the beginning of the buffer (enlarging it if
+ * it is full) and reads the next chunk of the file.
+ * @return true if at least one byte has been read
+ */
+inline bool FileReader::fill()
+{
+    if (file == nullptr || endOfFile)
+        return false;
+    if (dataBegin > 0) {
+        std::memmove(buffer.data(), buffer.data() + dataBegin, dataEnd - dataBegin);
+        bufferOffset += dataBegin;
+        dataEnd -= dataBegin;
+        dataBegin = 0;
+    }
+    if (dataEnd == buffer.size())
+        buffer.resize(buffer.size() * 2);
+    size_t n = std::fread(buffer.data() + dataEnd, 1, buffer.size() - dataEnd, file);
+    dataEnd += n;
+    if (n == 0)
+        endOfFile = true;
+    return n > 0;
+}
+
+/**
+ * @brief Returns the first character of [p, end) that is not a space or a tab.
+ */
+inline const char* skipSpaces(const char* p, const char* end)
+{
+    while (p != end && (*p == ' ' || *p == '\t'))
+        p++;
+    return p;
+}
+
+/**
+ * @brief Returns the first space or tab of [p, end), that is the end of the token
+ * beginning in p.
+ */
+inline const char* skipToken(const char* p, const char* end)
+{
+    while (p != end && *p != ' ' && *p != '\t')
+        p++;
+    return p;
+}
+
+/**
+ * @brief Returns true if the characters in [begin, end) are equal to the given
+ * null terminated string.
+ */
+inline bool tokenEquals(const char* begin, const char* end, const char* string)
+{
+    size_t length = std::strlen(string);
+    return (size_t)(end - begin) == length && std::memcmp(begin, string, length) == 0;
+}
+
+/**
+ * @brief Parses a floating point number starting from p (leading spaces are skipped),
+ * and moves p after the last parsed character.
+ *
+ * Numbers with at most 19 significant digits and a small exponent, which are the ones
+ * written by any mesh exporter, are converted exactly without calling the C library.
+ * All the other numbers (and inf/nan) are converted by std::strtod.
+ *
+ * @param[in/out] p: position where the number starts
+ * @param[in] end: end of the valid characters
+ * @param[out] value: the parsed number
+ * @return false if a number cannot be parsed starting from p
+ */
+inline bool parseDouble(const char*& p, const char* end, double& value)
+{
+    static const double powersOf10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* begin = skipSpaces(p, end);
+    const char* c = begin;
+    bool negative = false;
+    if (c != end && (*c == '-' || *c == '+')) {
+        negative = *c == '-';
+        c++;
+    }
+
+    unsigned long long mantissa = 0;
+    int nDigits = 0, exponent = 0;
+    bool anyDigit = false, exact = true;
+    for (; c != end && *c >= '0' && *c <= '9'; c++) {
+        anyDigit = true;
+        if (nDigits < 19) {
+            mantissa = mantissa * 10 + (*c - '0');
+            if (mantissa > 0)
+                nDigits++;
+        }
+        else {
+            exponent++;
+            exact &= *c == '0';
+        }
+    }
+    if (c != end && *c == '.') {
+        for (c++; c != end && *c >= '0' && *c <= '9'; c++) {
+            anyDigit = true;
+            if (nDigits < 19) {
+                mantissa = mantissa * 10 + (*c - '0');
+                if (mantissa > 0)
+                    nDigits++;
+                exponent--;
+            }
+            else
+                exact &= *c == '0';
+        }
+    }
+    if (anyDigit && c != end && (*c == 'e' || *c == 'E')) {
+        const char* e = c + 1;
+        bool negativeExponent = false;
+        if (e != end && (*e == '-' || *e == '+')) {
+            negativeExponent = *e == '-';
+            e++;
+        }
+        if (e != end && *e >= '0' && *e <= '9') {
+            int exp = 0;
+            for (; e != end && *e >= '0' && *e <= '9'; e++)
+                if (exp < 10000)
+                    exp = exp * 10 + (*e - '0');
+            exponent += negativeExponent ? -exp : exp;
+            c = e;
+        }
+        else
+            exact = false; //let strtod decide
+    }
+
+    if (anyDigit && exact && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double v = (double)mantissa;
+        if (exponent < 0)
+            v /= powersOf10[-exponent];
+        else
+            v *= powersOf10[exponent];
+        value = negative ? -v : v;
+        p = c;
+        return true;
+    }
+
+    //slow path: strtod on a null terminated copy of the token
+    const char* tokenEnd = skipToken(begin, end);
+    std::string token(begin, tokenEnd);
+    char* parsedEnd;
+    double v = std::strtod(token.c_str(), &parsedEnd);
+    if (parsedEnd == token.c_str())
+        return false;
+    value = v;
+    p = begin + (parsedEnd - token.c_str());
+    return true;
+}
+
+/**
+ * @brief Parses an integer number starting from p (leading spaces are skipped),
+ * and moves p after the last parsed character.
+ * @param[in/out] p: position where the number starts
+ * @param[in] end: end of the valid characters
+ * @param[out] value: the parsed number
+ * @return false if a number cannot be parsed starting from p
+ */
+inline bool parseInt(const char*& p, const char* end, long long& value)
+{
+    const char* c = skipSpaces(p, end);
+    bool negative = false;
+    if (c != end && (*c == '-' || *c == '+')) {
+        negative = *c == '-';
+        c++;
+    }
+    if (c == end || *c < '0' || *c > '9')
+        return false;
+    long long v = 0;
+    for (; c != end && *c >= '0' && *c <= '9'; c++)
+        v = v * 10 + (*c - '0');
+    value = negative ? -v : v;
+    p = c;
+    return true;
+}
+
+} //namespace cg3::internal
+} //namespace cg3
@@ -14,6 +14,8 @@
 #include <fstream>
 #include <sstream>
 #include "../utilities/color.h"
+#include "file_reader.h"
+#include "../utilities/system.h"
 #include <clocale>
 
 #ifdef CG3_WITH_EIGEN
@@ -62,6 +64,11 @@ typedef enum {
     RGB,
     RGBA
 } ColorMode;
+typedef enum {
+    ASCII,
+    BINARY_LITTLE_ENDIAN,
+    BINARY_BIG_ENDIAN
+} FileFormat;
 
 } //namespace cg3::io
 
@@ -92,6 +99,240 @@ Color colorFromArray(
         const T arrayColors[],
         io::ColorMode colorMod);
 
+template <typename W>
+void meshTypeFromFaceSizes(
+        const std::vector<W>& faceSizes,
+        io::MeshType& meshType);
+
+namespace obj {
+
+/**
+ * @brief A "mtllib" or "usemtl" record, with the number of faces of its chunk that
+ * precede it.
+ */
+typedef struct {
+    size_t face;
+    bool library;
+    std::string name;
+} MaterialRecord;
+
+/**
+ * @brief The records read from a contiguous range of lines of an obj file.
+ *
+ * Negative face indices are stored relative to the vertices of the chunk: their
+ * positions in faces are stored in relativeIndices, and they are moved to absolute
+ * indices when the chunks are merged.
+ */
+template <typename T, typename V, typename C, typename W>
+struct Chunk {
+    std::vector<T> coords;
+    std::vector<V> faces;
+    std::vector<C> verticesNormals;
+    std::vector<Color> verticesColors;
+    std::vector<W> faceSizes;
+    std::vector<size_t> relativeIndices;
+    std::vector<MaterialRecord> materials;
+    int modality;
+    bool valid;
+};
+
+unsigned int numberOfChunks(
+        unsigned long long fileSize,
+        unsigned int nThreads);
+
+template <typename T, typename V, typename C, typename W>
+bool parseLines(
+        FileReader& file,
+        unsigned long long end,
+        Chunk<T, V, C, W>& chunk);
+
+template <typename T, typename V, typename C, typename W>
+void parseChunk(
+        const std::string& filename,
+        unsigned long long begin,
+        unsigned long long end,
+        Chunk<T, V, C, W>& chunk);
+
+template <typename T, typename V, typename C, typename W>
+void mergeChunks(
+        std::vector<Chunk<T, V, C, W>>& chunks,
+        int& modality,
+        std::vector<T>& coords,
+        std::vector<V>& faces,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors,
+        std::vector<W>& faceSizes,
+        unsigned int nThreads);
+
+template <typename T, typename V, typename C, typename W>
+void loadFaceColors(
+        const std::string& filename,
+        const std::vector<Chunk<T, V, C, W>>& chunks,
+        std::vector<Color>& faceColors);
+
+} //namespace cg3::internal::obj
+
+namespace ply {
+
+typedef enum {VERTEX, FACE, OTHER} ElementType;
+typedef enum {unknown = -1, x, y, z, nx, ny, nz, red, green, blue, alpha, list} PropertyName;
+typedef enum {CHAR, UCHAR, SHORT, USHORT, INT, UINT, FLOAT, DOUBLE} PropertyType;
+
+typedef struct {
+    PropertyName name;
+    PropertyType type;
+    bool isList;
+    PropertyType listSizeType;
+} Property;
+
+typedef struct {
+    ElementType type;
+    unsigned long long number;
+    std::vector<Property> properties;
+} Element;
+
+bool loadHeader(
+        FileReader& file,
+        io::FileFormat& format,
+        std::vector<Element>& elements);
+
+bool propertyType(
+        const char* begin,
+        const char* end,
+        PropertyType& type);
+
+void setColorComponent(
+        Color& color,
+        const Property& property,
+        double value);
+
+bool nextAsciiLine(
+        FileReader& file,
+        const char*& line,
+        const char*& lineEnd);
+
+bool skipAsciiList(
+        const char*& p,
+        const char* end);
+
+template <typename T, typename C>
+bool loadAsciiVertices(
+        FileReader& file,
+        const Element& element,
+        int modality,
+        std::vector<T>& coords,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors);
+
+template <typename V, typename W>
+bool loadAsciiFaces(
+        FileReader& file,
+        const Element& element,
+        int modality,
+        std::vector<V>& faces,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes);
+
+bool skipAsciiElement(
+        FileReader& file,
+        const Element& element);
+
+bool isLittleEndianMachine();
+
+unsigned int typeSize(PropertyType type);
+
+double binaryValue(
+        const char* data,
+        PropertyType type,
+        bool swap);
+
+bool readBinaryValue(
+        FileReader& file,
+        PropertyType type,
+        bool swap,
+        double& value);
+
+bool readBinaryList(
+        FileReader& file,
+        const Property& property,
+        bool swap,
+        const char*& data,
+        unsigned int& size);
+
+template <typename T, typename C>
+bool loadBinaryVertices(
+        FileReader& file,
+        const Element& element,
+        bool swap,
+        int modality,
+        std::vector<T>& coords,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors);
+
+const char* binaryElementEnd(
+        const char* data,
+        const char* end,
+        const Element& element,
+        bool swap);
+
+template <typename V, typename W>
+bool loadBinaryFaces(
+        FileReader& file,
+        const Element& element,
+        bool swap,
+        int modality,
+        std::vector<V>& faces,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes);
+
+bool skipBinaryElement(
+        FileReader& file,
+        const Element& element,
+        bool swap);
+
+template <typename T>
+void appendBinaryValue(
+        std::vector<char>& buffer,
+        T value,
+        bool swap);
+
+template <typename A, typename B, typename C, typename T, typename V, typename W>
+bool saveBinaryData(
+        std::ofstream& fp,
+        io::FileFormat format,
+        size_t nVertices,
+        size_t nFaces,
+        const A vertices[],
+        const B faces[],
+        io::MeshType meshType,
+        int modality,
+        const C verticesNormals[],
+        io::ColorMode colorMod,
+        const T verticesColors[],
+        const V faceColors[],
+        const W polygonSizes[],
+        bool wideFaceSizes);
+
+} //namespace cg3::internal::ply
+
+#ifdef CG3_WITH_EIGEN
+template <typename S, typename T>
+void copyCoordinatesOnEigen(
+        const std::vector<S>& coords,
+        Eigen::PlainObjectBase<T>& matrix);
+
+template <typename S, typename V>
+void copyTrianglesOnEigen(
+        const std::vector<S>& faces,
+        const std::vector<unsigned int>& faceSizes,
+        Eigen::PlainObjectBase<V>& triangles);
+
+template <typename W>
+void copyColorsOnEigen(
+        const std::vector<Color>& colors,
+        Eigen::PlainObjectBase<W>& matrix);
+#endif
+
 } //namespace cg3::internal
 
 /*
@@ -125,12 +366,26 @@ bool saveMeshOnPly(
         io::ColorMode colorMod = io::RGB,
         const T verticesColors[] = internal::dummyVectorFloat.data(),
         const V triangleColors[] = internal::dummyVectorFloat.data(),
-        const W polygonSizes[] = internal::dummyVectorUnsignedInt.data());
+        const W polygonSizes[] = internal::dummyVectorUnsignedInt.data(),
+        io::FileFormat format = io::ASCII);
 
 /*
  * Load
  */
 ///Obj
+template <typename T, typename V, typename C = double, typename W = unsigned int>
+bool loadMeshFromObj(
+        const std::string &filename,
+        std::vector<T>& coords,
+        std::vector<V>& faces,
+        io::MeshType& meshType,
+        int& modality = internal::dummyInt,
+        std::vector<C>& verticesNormals = internal::dummyVectorDouble,
+        std::vector<Color>& verticesColors = internal::dummyVectorColor,
+        std::vector<Color>& faceColors = internal::dummyVectorColor,
+        std::vector<W>& faceSizes = internal::dummyVectorUnsignedInt,
+        unsigned int nThreads = 0);
+
 template <typename T, typename V, typename C = double, typename W = unsigned int>
 bool loadMeshFromObj(
         const std::string &filename,
@@ -172,6 +427,18 @@ bool loadTriangleMeshFromObj(
 #endif
 
 ///Ply
+template <typename T, typename V, typename C = double, typename W = unsigned int>
+bool loadMeshFromPly(
+        const std::string& filename,
+        std::vector<T>& coords,
+        std::vector<V>& faces,
+        io::MeshType& meshType,
+        int& modality = internal::dummyInt,
+        std::vector<C>& verticesNormals = internal::dummyVectorDouble,
+        std::vector<Color>& verticesColors = internal::dummyVectorColor,
+        std::vector<Color>& faceColors = internal::dummyVectorColor,
+        std::vector<W>& faceSizes = internal::dummyVectorUnsignedInt);
+
 template <typename T, typename V, typename C = double, typename W = unsigned int>
 bool loadMeshFromPly(
         const std::string& filename,
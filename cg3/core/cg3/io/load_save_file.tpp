@@ -7,6 +7,10 @@
 
 #include "load_save_file.h"
 #include "../utilities/tokenizer.h"
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
 
 namespace cg3 {
 namespace internal {
@@ -145,6 +149,1060 @@ inline Color colorFromArray(
     return c;
 }
 
+/**
+ * @brief Sets the type of the mesh looking at the number of vertices of every face.
+ */
+template <typename W>
+inline void meshTypeFromFaceSizes(
+        const std::vector<W>& faceSizes,
+        io::MeshType& meshType)
+{
+    bool triangles = true, quads = true;
+    for (unsigned int i = 0; i < faceSizes.size() && (triangles || quads); i++){
+        triangles &= faceSizes[i] == 3;
+        quads &= faceSizes[i] == 4;
+    }
+    if (triangles)
+        meshType = io::TRIANGLE_MESH;
+    else if (quads)
+        meshType = io::QUAD_MESH;
+    else
+        meshType = io::POLYGON_MESH;
+}
+
+namespace obj {
+
+/**
+ * @brief Returns the number of chunks in which an obj file should be split in order
+ * to be parsed by nThreads threads.
+ *
+ * More chunks than threads are used to balance the load (vertex lines are cheaper
+ * than face lines), but no chunk is smaller than 8 MB.
+ */
+inline unsigned int numberOfChunks(
+        unsigned long long fileSize,
+        unsigned int nThreads)
+{
+    const unsigned long long minChunkSize = 8 << 20;
+    if (nThreads <= 1)
+        return 1;
+    unsigned long long n = std::min(
+                (unsigned long long)nThreads * 4, fileSize / minChunkSize);
+    return n > 1 ? (unsigned int)n : 1;
+}
+
+/**
+ * @brief Parses the lines of an obj file from the current position of file, until
+ * the first line that begins at or after the position end.
+ * @param[in] file: a FileReader positioned at the beginning of a line
+ * @param[in] end: position in the file where the chunk ends
+ * @param[out] chunk: the records read from the lines
+ * @return false if a line is not valid
+ */
+template <typename T, typename V, typename C, typename W>
+inline bool parseLines(
+        FileReader& file,
+        unsigned long long end,
+        Chunk<T, V, C, W>& chunk)
+{
+    const char* line;
+    const char* lineEnd;
+    chunk.modality = 0;
+    while(file.position() < end && file.getLine(line, lineEnd)) {
+        const char* header = skipSpaces(line, lineEnd);
+        const char* p = skipToken(header, lineEnd);
+        size_t headerSize = p - header;
+
+        // Handle
+        //
+        // v 0.123 0.234 0.345
+        // v 0.123 0.234 0.345 0.5 0.5 0.5
+        // v 0.123 0.234 0.345 0.5 0.5 0.5 255
+        if (headerSize == 1 && header[0] == 'v') {
+            double x, y, z, r, g, b, alpha;
+            if (!parseDouble(p, lineEnd, x) ||
+                    !parseDouble(p, lineEnd, y) ||
+                    !parseDouble(p, lineEnd, z))
+                return false;
+            chunk.coords.push_back(x);
+            chunk.coords.push_back(y);
+            chunk.coords.push_back(z);
+
+            if (parseDouble(p, lineEnd, r) &&
+                    parseDouble(p, lineEnd, g) &&
+                    parseDouble(p, lineEnd, b)){
+                chunk.modality |= io::COLOR_VERTICES;
+                if (!parseDouble(p, lineEnd, alpha))
+                    alpha = 255;
+                Color c(r*255, g*255, b*255, alpha);
+                chunk.verticesColors.push_back(c);
+            }
+        }
+        else if (headerSize == 2 && header[0] == 'v' && header[1] == 'n') {
+            double x, y, z;
+            chunk.modality |= io::NORMAL_VERTICES;
+            if (!parseDouble(p, lineEnd, x) ||
+                    !parseDouble(p, lineEnd, y) ||
+                    !parseDouble(p, lineEnd, z))
+                return false;
+            chunk.verticesNormals.push_back(x);
+            chunk.verticesNormals.push_back(y);
+            chunk.verticesNormals.push_back(z);
+        }
+        // Handle
+        //
+        // f 1 2 3
+        // f 3/1 4/2 5/3
+        // f 6/4/1 3/5/3 7/6/5
+        // f -3 -2 -1
+        else if (headerSize == 1 && header[0] == 'f') {
+            long long nVertices = chunk.coords.size() / 3;
+            unsigned int nVert = 0;
+            for (p = skipSpaces(p, lineEnd); p != lineEnd; p = skipSpaces(p, lineEnd)) {
+                long long id;
+                if (!parseInt(p, lineEnd, id) || id == 0)
+                    return false;
+                if (id < 0)
+                    chunk.relativeIndices.push_back(chunk.faces.size());
+                chunk.faces.push_back(id > 0 ? id - 1 : nVertices + id);
+                nVert++;
+                p = skipToken(p, lineEnd); //skips texture and normal indices
+            }
+            chunk.faceSizes.push_back(nVert);
+        }
+        else if (tokenEquals(header, p, "mtllib") || tokenEquals(header, p, "usemtl")) {
+            MaterialRecord record;
+            record.face = chunk.faceSizes.size();
+            record.library = header[0] == 'm';
+            const char* name = skipSpaces(p, lineEnd);
+            record.name.assign(name, skipToken(name, lineEnd));
+            chunk.materials.push_back(record);
+            if (record.library)
+                chunk.modality |= io::COLOR_FACES;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the lines of an obj file that begin in the range of bytes [begin, end).
+ *
+ * The line that contains the byte begin-1 belongs to the previous chunk and is skipped.
+ * Sets chunk.valid to false if the file cannot be read or contains a non valid line.
+ */
+template <typename T, typename V, typename C, typename W>
+inline void parseChunk(
+        const std::string& filename,
+        unsigned long long begin,
+        unsigned long long end,
+        Chunk<T, V, C, W>& chunk)
+{
+    FileReader file(filename);
+    chunk.valid = file.isOpen();
+    if (chunk.valid && begin > 0) {
+        const char* line;
+        const char* lineEnd;
+        chunk.valid = file.seek(begin - 1);
+        file.getLine(line, lineEnd);
+    }
+    if (chunk.valid)
+        chunk.valid = parseLines(file, end, chunk);
+}
+
+/**
+ * @brief Concatenates the records of all the chunks in the output vectors.
+ *
+ * The position of every chunk in the outputs is given by a prefix sum of the sizes of
+ * the chunks, then the chunks are copied in parallel by nThreads threads (relative face
+ * indices are moved by the number of vertices of the preceding chunks). The memory of
+ * the chunks is released while they are copied.
+ */
+template <typename T, typename V, typename C, typename W>
+inline void mergeChunks(
+        std::vector<Chunk<T, V, C, W>>& chunks,
+        int& modality,
+        std::vector<T>& coords,
+        std::vector<V>& faces,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors,
+        std::vector<W>& faceSizes,
+        unsigned int nThreads)
+{
+    int nChunks = chunks.size();
+    std::vector<size_t> coordsOffset(nChunks+1, 0), facesOffset(nChunks+1, 0);
+    std::vector<size_t> normalsOffset(nChunks+1, 0), colorsOffset(nChunks+1, 0);
+    std::vector<size_t> sizesOffset(nChunks+1, 0);
+    for (int i = 0; i < nChunks; i++) {
+        coordsOffset[i+1] = coordsOffset[i] + chunks[i].coords.size();
+        facesOffset[i+1] = facesOffset[i] + chunks[i].faces.size();
+        normalsOffset[i+1] = normalsOffset[i] + chunks[i].verticesNormals.size();
+        colorsOffset[i+1] = colorsOffset[i] + chunks[i].verticesColors.size();
+        sizesOffset[i+1] = sizesOffset[i] + chunks[i].faceSizes.size();
+        modality |= chunks[i].modality;
+    }
+    coords.resize(coordsOffset[nChunks]);
+    faces.resize(facesOffset[nChunks]);
+    verticesNormals.resize(normalsOffset[nChunks]);
+    verticesColors.resize(colorsOffset[nChunks]);
+    faceSizes.resize(sizesOffset[nChunks]);
+
+    #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+    for (int i = 0; i < nChunks; i++) {
+        Chunk<T, V, C, W>& c = chunks[i];
+        std::copy(c.coords.begin(), c.coords.end(), coords.begin() + coordsOffset[i]);
+        std::copy(c.faces.begin(), c.faces.end(), faces.begin() + facesOffset[i]);
+        std::copy(c.verticesNormals.begin(), c.verticesNormals.end(), verticesNormals.begin() + normalsOffset[i]);
+        std::copy(c.verticesColors.begin(), c.verticesColors.end(), verticesColors.begin() + colorsOffset[i]);
+        std::copy(c.faceSizes.begin(), c.faceSizes.end(), faceSizes.begin() + sizesOffset[i]);
+        V vertexOffset = coordsOffset[i] / 3;
+        for (size_t j = 0; j < c.relativeIndices.size(); j++)
+            faces[facesOffset[i] + c.relativeIndices[j]] += vertexOffset;
+        std::vector<T>().swap(c.coords);
+        std::vector<V>().swap(c.faces);
+        std::vector<C>().swap(c.verticesNormals);
+        std::vector<Color>().swap(c.verticesColors);
+    }
+}
+
+/**
+ * @brief Computes the colors of the faces, executing the "mtllib" and "usemtl"
+ * records of all the chunks in order.
+ *
+ * A face gets a color only if a material library has been successfully loaded before
+ * it, and its color is the one of the last "usemtl" record that precedes it.
+ */
+template <typename T, typename V, typename C, typename W>
+inline void loadFaceColors(
+        const std::string& filename,
+        const std::vector<Chunk<T, V, C, W>>& chunks,
+        std::vector<Color>& faceColors)
+{
+    bool usemtu = false;
+    std::map<std::string, Color> mapColors;
+    Color actualColor;
+    for (const Chunk<T, V, C, W>& chunk : chunks) {
+        size_t face = 0;
+        for (const MaterialRecord& record : chunk.materials) {
+            if (usemtu)
+                faceColors.insert(faceColors.end(), record.face - face, actualColor);
+            face = record.face;
+            if (record.library) {
+                std::string mtufilename = record.name;
+                size_t lastSlash = filename.find_last_of("/");
+                if (lastSlash < filename.size()){
+                    std::string path = filename.substr(0, lastSlash);
+                    mtufilename = path + "/" + mtufilename;
+                }
+                usemtu = loadMtlFile(mtufilename, mapColors);
+            }
+            else if (usemtu) {
+                assert(mapColors.find(record.name) != mapColors.end());
+                actualColor = mapColors[record.name];
+            }
+        }
+        if (usemtu)
+            faceColors.insert(faceColors.end(), chunk.faceSizes.size() - face, actualColor);
+    }
+}
+
+} //namespace cg3::internal::obj
+
+namespace ply {
+
+/**
+ * @brief Reads the header of a ply file, from the "ply" line to the "end_header" line.
+ *
+ * All the properties of all the elements are stored (also the unknown ones), in order
+ * to be able to skip them while reading the data. The list of the face element containing
+ * the indices of the vertices is named "list".
+ *
+ * @param[in] file: a FileReader positioned at the beginning of the file
+ * @param[out] format: the format of the data that follows the header
+ * @param[out] elements: the elements declared in the header, in order
+ * @return false if the header is not valid
+ */
+inline bool loadHeader(
+        FileReader& file,
+        io::FileFormat& format,
+        std::vector<Element>& elements)
+{
+    static const char* propertyNames[] = {"x", "y", "z", "nx", "ny", "nz", "red", "green", "blue", "alpha"};
+    const char* line;
+    const char* lineEnd;
+
+    format = io::ASCII;
+    elements.clear();
+    if (!file.getLine(line, lineEnd))
+        return false;
+    line = skipSpaces(line, lineEnd);
+    if (!tokenEquals(line, skipToken(line, lineEnd), "ply"))
+        return false;
+
+    while (file.getLine(line, lineEnd)) {
+        const char* token = skipSpaces(line, lineEnd);
+        const char* tokenEnd = skipToken(token, lineEnd);
+
+        if (tokenEquals(token, tokenEnd, "end_header")) {
+            //the first list of the face element is used if vertex_indices is missing
+            for (Element& e : elements) {
+                if (e.type != FACE)
+                    continue;
+                bool found = false;
+                for (const Property& p : e.properties)
+                    found |= p.name == list;
+                for (unsigned int i = 0; i < e.properties.size() && !found; i++) {
+                    if (e.properties[i].isList) {
+                        e.properties[i].name = list;
+                        found = true;
+                    }
+                }
+            }
+            return true;
+        }
+        else if (tokenEquals(token, tokenEnd, "format")) {
+            token = skipSpaces(tokenEnd, lineEnd);
+            tokenEnd = skipToken(token, lineEnd);
+            if (tokenEquals(token, tokenEnd, "ascii"))
+                format = io::ASCII;
+            else if (tokenEquals(token, tokenEnd, "binary_little_endian"))
+                format = io::BINARY_LITTLE_ENDIAN;
+            else if (tokenEquals(token, tokenEnd, "binary_big_endian"))
+                format = io::BINARY_BIG_ENDIAN;
+            else
+                return false;
+        }
+        else if (tokenEquals(token, tokenEnd, "element")) { //new type of element read
+            Element e;
+            token = skipSpaces(tokenEnd, lineEnd);
+            tokenEnd = skipToken(token, lineEnd);
+            if (tokenEquals(token, tokenEnd, "vertex"))
+                e.type = VERTEX;
+            else if (tokenEquals(token, tokenEnd, "face"))
+                e.type = FACE;
+            else
+                e.type = OTHER;
+            long long number;
+            if (!parseInt(tokenEnd, lineEnd, number) || number < 0)
+                return false;
+            e.number = number;
+            elements.push_back(e);
+        }
+        else if (tokenEquals(token, tokenEnd, "property")) {
+            if (elements.empty())
+                return false;
+            Property p;
+            token = skipSpaces(tokenEnd, lineEnd);
+            tokenEnd = skipToken(token, lineEnd);
+            p.isList = tokenEquals(token, tokenEnd, "list");
+            if (p.isList) {
+                token = skipSpaces(tokenEnd, lineEnd);
+                tokenEnd = skipToken(token, lineEnd);
+                if (!propertyType(token, tokenEnd, p.listSizeType))
+                    return false;
+                token = skipSpaces(tokenEnd, lineEnd);
+                tokenEnd = skipToken(token, lineEnd);
+            }
+            if (!propertyType(token, tokenEnd, p.type))
+                return false;
+            if (!p.isList)
+                p.listSizeType = p.type;
+            token = skipSpaces(tokenEnd, lineEnd);
+            tokenEnd = skipToken(token, lineEnd);
+            p.name = unknown;
+            if (p.isList) {
+                if (tokenEquals(token, tokenEnd, "vertex_indices") ||
+                        tokenEquals(token, tokenEnd, "vertex_index"))
+                    p.name = list;
+            }
+            else {
+                for (int i = x; i <= alpha; i++)
+                    if (tokenEquals(token, tokenEnd, propertyNames[i]))
+                        p.name = (PropertyName)i;
+            }
+            elements.back().properties.push_back(p);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Converts the name of a ply type (e.g. "uchar", "float32") to a PropertyType.
+ * @return false if the name is not a valid ply type
+ */
+inline bool propertyType(
+        const char* begin,
+        const char* end,
+        PropertyType& type)
+{
+    if (tokenEquals(begin, end, "char") || tokenEquals(begin, end, "int8"))
+        type = CHAR;
+    else if (tokenEquals(begin, end, "uchar") || tokenEquals(begin, end, "uint8"))
+        type = UCHAR;
+    else if (tokenEquals(begin, end, "short") || tokenEquals(begin, end, "int16"))
+        type = SHORT;
+    else if (tokenEquals(begin, end, "ushort") || tokenEquals(begin, end, "uint16"))
+        type = USHORT;
+    else if (tokenEquals(begin, end, "int") || tokenEquals(begin, end, "int32"))
+        type = INT;
+    else if (tokenEquals(begin, end, "uint") || tokenEquals(begin, end, "uint32"))
+        type = UINT;
+    else if (tokenEquals(begin, end, "float") || tokenEquals(begin, end, "float32"))
+        type = FLOAT;
+    else if (tokenEquals(begin, end, "double") || tokenEquals(begin, end, "float64"))
+        type = DOUBLE;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Sets a component of the color: floating point values are in [0, 1],
+ * integer values are in [0, 255].
+ */
+inline void setColorComponent(
+        Color& color,
+        const Property& property,
+        double value)
+{
+    bool f = property.type == FLOAT || property.type == DOUBLE;
+    switch (property.name) {
+        case red:
+            if (f) color.setRedF(value); else color.setRed(value);
+            break;
+        case green:
+            if (f) color.setGreenF(value); else color.setGreen(value);
+            break;
+        case blue:
+            if (f) color.setBlueF(value); else color.setBlue(value);
+            break;
+        case alpha:
+            if (f) color.setAlphaF(value); else color.setAlpha(value);
+            break;
+        default:
+            ;
+    }
+}
+
+/**
+ * @brief Skips the non empty lines of the file.
+ * @return false if the end of the file has been reached
+ */
+inline bool nextAsciiLine(
+        FileReader& file,
+        const char*& line,
+        const char*& lineEnd)
+{
+    do {
+        if (!file.getLine(line, lineEnd))
+            return false;
+    } while (skipSpaces(line, lineEnd) == lineEnd);
+    return true;
+}
+
+/**
+ * @brief Reads (and discards) an ascii list property, moving p after it.
+ */
+inline bool skipAsciiList(
+        const char*& p,
+        const char* end)
+{
+    long long size;
+    double dummy;
+    if (!parseInt(p, end, size) || size < 0)
+        return false;
+    for (long long i = 0; i < size; i++)
+        if (!parseDouble(p, end, dummy))
+            return false;
+    return true;
+}
+
+/**
+ * @brief Reads the vertex element of an ascii ply file, appending the read values
+ * to the given vectors.
+ */
+template <typename T, typename C>
+inline bool loadAsciiVertices(
+        FileReader& file,
+        const Element& element,
+        int modality,
+        std::vector<T>& coords,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors)
+{
+    const char* line;
+    const char* lineEnd;
+    for (unsigned long long i = 0; i < element.number; i++) {
+        if (!nextAsciiLine(file, line, lineEnd))
+            return false;
+        double cnv[6] = {0, 0, 0, 0, 0, 0};
+        Color c;
+
+        //manage properties of vertex
+        for (const Property& p : element.properties) {
+            if (p.isList) {
+                if (!skipAsciiList(line, lineEnd))
+                    return false;
+                continue;
+            }
+            double value;
+            if (!parseDouble(line, lineEnd, value))
+                return false;
+            if (p.name >= x && p.name <= nz)
+                cnv[p.name] = value;
+            else if (p.name >= red && p.name <= alpha)
+                setColorComponent(c, p, value);
+        }
+
+        coords.push_back(cnv[0]);
+        coords.push_back(cnv[1]);
+        coords.push_back(cnv[2]);
+        if (modality & io::NORMAL_VERTICES){
+            verticesNormals.push_back(cnv[3]);
+            verticesNormals.push_back(cnv[4]);
+            verticesNormals.push_back(cnv[5]);
+        }
+        if (modality & io::COLOR_VERTICES)
+            verticesColors.push_back(c);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the face element of an ascii ply file, appending the read values
+ * to the given vectors.
+ */
+template <typename V, typename W>
+inline bool loadAsciiFaces(
+        FileReader& file,
+        const Element& element,
+        int modality,
+        std::vector<V>& faces,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes)
+{
+    const char* line;
+    const char* lineEnd;
+    for (unsigned long long i = 0; i < element.number; i++) {
+        if (!nextAsciiLine(file, line, lineEnd))
+            return false;
+        Color c;
+
+        //manage properties of face
+        for (const Property& p : element.properties) {
+            if (p.name == list) {
+                long long size, index;
+                if (!parseInt(line, lineEnd, size) || size < 0)
+                    return false;
+                for (long long j = 0; j < size; j++) {
+                    if (!parseInt(line, lineEnd, index))
+                        return false;
+                    faces.push_back(index);
+                }
+                faceSizes.push_back(size);
+            }
+            else if (p.isList) {
+                if (!skipAsciiList(line, lineEnd))
+                    return false;
+            }
+            else {
+                double value;
+                if (!parseDouble(line, lineEnd, value))
+                    return false;
+                setColorComponent(c, p, value);
+            }
+        }
+        if (modality & io::COLOR_FACES)
+            faceColors.push_back(c);
+    }
+    return true;
+}
+
+/**
+ * @brief Skips an element of an ascii ply file.
+ */
+inline bool skipAsciiElement(
+        FileReader& file,
+        const Element& element)
+{
+    const char* line;
+    const char* lineEnd;
+    for (unsigned long long i = 0; i < element.number; i++)
+        if (!nextAsciiLine(file, line, lineEnd))
+            return false;
+    return true;
+}
+
+/**
+ * @brief Returns true if the machine stores numbers in little endian order.
+ */
+inline bool isLittleEndianMachine()
+{
+    const unsigned short one = 1;
+    return *((const unsigned char*)&one) == 1;
+}
+
+/**
+ * @brief Returns the number of bytes of a property type in a binary ply file.
+ */
+inline unsigned int typeSize(PropertyType type)
+{
+    switch (type) {
+        case CHAR:
+        case UCHAR:
+            return 1;
+        case SHORT:
+        case USHORT:
+            return 2;
+        case INT:
+        case UINT:
+        case FLOAT:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+/**
+ * @brief Converts the bytes of a binary value to a double.
+ * @param[in] data: the bytes of the value
+ * @param[in] type: the type of the value
+ * @param[in] swap: true if the endianness of the value is not the one of the machine
+ */
+inline double binaryValue(
+        const char* data,
+        PropertyType type,
+        bool swap)
+{
+    char bytes[8];
+    unsigned int size = typeSize(type);
+    if (swap) {
+        for (unsigned int i = 0; i < size; i++)
+            bytes[i] = data[size-1-i];
+    }
+    else
+        std::memcpy(bytes, data, size);
+
+    switch (type) {
+        case CHAR: {
+            int8_t v; std::memcpy(&v, bytes, 1); return v;
+        }
+        case UCHAR: {
+            uint8_t v; std::memcpy(&v, bytes, 1); return v;
+        }
+        case SHORT: {
+            int16_t v; std::memcpy(&v, bytes, 2); return v;
+        }
+        case USHORT: {
+            uint16_t v; std::memcpy(&v, bytes, 2); return v;
+        }
+        case INT: {
+            int32_t v; std::memcpy(&v, bytes, 4); return v;
+        }
+        case UINT: {
+            uint32_t v; std::memcpy(&v, bytes, 4); return v;
+        }
+        case FLOAT: {
+            float v; std::memcpy(&v, bytes, 4); return v;
+        }
+        default: {
+            double v; std::memcpy(&v, bytes, 8); return v;
+        }
+    }
+}
+
+/**
+ * @brief Reads a single binary value from the file.
+ */
+inline bool readBinaryValue(
+        FileReader& file,
+        PropertyType type,
+        bool swap,
+        double& value)
+{
+    const char* data = file.get(typeSize(type));
+    if (data == nullptr)
+        return false;
+    value = binaryValue(data, type, swap);
+    return true;
+}
+
+/**
+ * @brief Reads a binary list property: its size and the bytes of all its values.
+ * @param[out] data: pointer to the bytes of the values of the list, valid until the next read
+ * @param[out] size: the number of values of the list
+ */
+inline bool readBinaryList(
+        FileReader& file,
+        const Property& property,
+        bool swap,
+        const char*& data,
+        unsigned int& size)
+{
+    double s;
+    if (!readBinaryValue(file, property.listSizeType, swap, s) || s < 0)
+        return false;
+    size = (unsigned int)s;
+    data = file.get(size * typeSize(property.type));
+    return data != nullptr;
+}
+
+/**
+ * @brief Reads the vertex element of a binary ply file, appending the read values
+ * to the given vectors.
+ *
+ * If the vertex element does not contain lists (i.e. every vertex has the same size),
+ * vertices are decoded directly from blocks of about 1 MB.
+ */
+template <typename T, typename C>
+inline bool loadBinaryVertices(
+        FileReader& file,
+        const Element& element,
+        bool swap,
+        int modality,
+        std::vector<T>& coords,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors)
+{
+    size_t stride = 0;
+    bool fixedSize = true;
+    for (const Property& p : element.properties) {
+        if (p.isList)
+            fixedSize = false;
+        else
+            stride += typeSize(p.type);
+    }
+    unsigned long long blockSize = fixedSize ? std::max((size_t)1, ((size_t)1 << 20) / std::max(stride, (size_t)1)) : 1;
+    const char* block = nullptr;
+    const char* listData;
+
+    for (unsigned long long i = 0; i < element.number; i++) {
+        if (fixedSize && i % blockSize == 0) { //bulk read of the next block of vertices
+            unsigned long long n = std::min(blockSize, element.number - i);
+            block = file.get(n * stride);
+            if (block == nullptr)
+                return false;
+        }
+        const char* data = block + (i % blockSize) * stride;
+        double cnv[6] = {0, 0, 0, 0, 0, 0};
+        Color c;
+
+        //manage properties of vertex
+        for (const Property& p : element.properties) {
+            double value;
+            if (p.isList) {
+                unsigned int size;
+                if (!readBinaryList(file, p, swap, listData, size))
+                    return false;
+                continue;
+            }
+            if (fixedSize) {
+                value = binaryValue(data, p.type, swap);
+                data += typeSize(p.type);
+            }
+            else if (!readBinaryValue(file, p.type, swap, value))
+                return false;
+            if (p.name >= x && p.name <= nz)
+                cnv[p.name] = value;
+            else if (p.name >= red && p.name <= alpha)
+                setColorComponent(c, p, value);
+        }
+
+        coords.push_back(cnv[0]);
+        coords.push_back(cnv[1]);
+        coords.push_back(cnv[2]);
+        if (modality & io::NORMAL_VERTICES){
+            verticesNormals.push_back(cnv[3]);
+            verticesNormals.push_back(cnv[4]);
+            verticesNormals.push_back(cnv[5]);
+        }
+        if (modality & io::COLOR_VERTICES)
+            verticesColors.push_back(c);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the end of the binary element (e.g. a face) beginning in data,
+ * or nullptr if the element does not end before end.
+ */
+inline const char* binaryElementEnd(
+        const char* data,
+        const char* end,
+        const Element& element,
+        bool swap)
+{
+    for (const Property& p : element.properties) {
+        if (p.isList) {
+            unsigned int sizeSize = typeSize(p.listSizeType);
+            if ((size_t)(end - data) < sizeSize)
+                return nullptr;
+            double s = binaryValue(data, p.listSizeType, swap);
+            if (s < 0)
+                return nullptr;
+            data += sizeSize;
+            if ((size_t)(end - data) < (size_t)s * typeSize(p.type))
+                return nullptr;
+            data += (size_t)s * typeSize(p.type);
+        }
+        else {
+            if ((size_t)(end - data) < typeSize(p.type))
+                return nullptr;
+            data += typeSize(p.type);
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Reads the face element of a binary ply file, appending the read values
+ * to the given vectors.
+ *
+ * Faces are decoded directly from blocks of about 1 MB: the faces which are entirely
+ * contained in a block are decoded, and the next block begins with the first incomplete
+ * face.
+ */
+template <typename V, typename W>
+inline bool loadBinaryFaces(
+        FileReader& file,
+        const Element& element,
+        bool swap,
+        int modality,
+        std::vector<V>& faces,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes)
+{
+    size_t blockSize = 1 << 20;
+    unsigned long long i = 0;
+    while (i < element.number) {
+        size_t available = blockSize;
+        const char* block = file.peek(available);
+        const char* blockEnd = block + available;
+        const char* data = block;
+        unsigned long long first = i;
+
+        while (i < element.number && binaryElementEnd(data, blockEnd, element, swap) != nullptr) {
+            Color c;
+
+            //manage properties of face
+            for (const Property& p : element.properties) {
+                if (p.isList) {
+                    unsigned int size = (unsigned int)binaryValue(data, p.listSizeType, swap);
+                    data += typeSize(p.listSizeType);
+                    unsigned int itemSize = typeSize(p.type);
+                    if (p.name == list) {
+                        for (unsigned int j = 0; j < size; j++)
+                            faces.push_back(binaryValue(data + j*itemSize, p.type, swap));
+                        faceSizes.push_back(size);
+                    }
+                    data += size * itemSize;
+                }
+                else {
+                    setColorComponent(c, p, binaryValue(data, p.type, swap));
+                    data += typeSize(p.type);
+                }
+            }
+            if (modality & io::COLOR_FACES)
+                faceColors.push_back(c);
+            i++;
+        }
+
+        if (i == first) { //the next face does not fit in the block
+            if (available < blockSize)
+                return false; //end of file
+            blockSize *= 2;
+        }
+        else
+            file.get(data - block);
+    }
+    return true;
+}
+
+/**
+ * @brief Skips an element of a binary ply file.
+ */
+inline bool skipBinaryElement(
+        FileReader& file,
+        const Element& element,
+        bool swap)
+{
+    const char* data;
+    for (unsigned long long i = 0; i < element.number; i++) {
+        for (const Property& p : element.properties) {
+            unsigned int size;
+            double value;
+            if (p.isList && !readBinaryList(file, p, swap, data, size))
+                return false;
+            if (!p.isList && !readBinaryValue(file, p.type, swap, value))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the bytes of a value to the buffer, swapping them if required.
+ */
+template <typename T>
+inline void appendBinaryValue(
+        std::vector<char>& buffer,
+        T value,
+        bool swap)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (swap)
+        std::reverse(bytes, bytes + sizeof(T));
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @brief Writes the vertices and the faces of a binary ply file, whose header
+ * has been already written by saveMeshOnPly.
+ *
+ * Data is written in blocks of about 1 MB, using the types declared in the header:
+ * float for coordinates and normals, uchar for colors, uchar (or uint, if wideFaceSizes
+ * is true) for the sizes of the faces, int for the indices.
+ */
+template <typename A, typename B, typename C, typename T, typename V, typename W>
+inline bool saveBinaryData(
+        std::ofstream& fp,
+        io::FileFormat format,
+        size_t nVertices,
+        size_t nFaces,
+        const A vertices[],
+        const B faces[],
+        io::MeshType meshType,
+        int modality,
+        const C verticesNormals[],
+        io::ColorMode colorMod,
+        const T verticesColors[],
+        const V faceColors[],
+        const W polygonSizes[],
+        bool wideFaceSizes)
+{
+    const size_t blockSize = 1 << 20;
+    bool swap = (format == io::BINARY_LITTLE_ENDIAN) != isLittleEndianMachine();
+    std::vector<char> buffer;
+    buffer.reserve(blockSize + 256);
+
+    for (size_t i = 0; i < nVertices; i++) {
+        appendBinaryValue(buffer, (float)vertices[i*3], swap);
+        appendBinaryValue(buffer, (float)vertices[i*3+1], swap);
+        appendBinaryValue(buffer, (float)vertices[i*3+2], swap);
+        if (modality & io::NORMAL_VERTICES) {
+            appendBinaryValue(buffer, (float)verticesNormals[i*3], swap);
+            appendBinaryValue(buffer, (float)verticesNormals[i*3+1], swap);
+            appendBinaryValue(buffer, (float)verticesNormals[i*3+2], swap);
+        }
+        if (modality & io::COLOR_VERTICES){
+            Color c = colorFromArray(colorMod == io::RGB ? i*3 : i*4, verticesColors, colorMod);
+            buffer.push_back(c.red());
+            buffer.push_back(c.green());
+            buffer.push_back(c.blue());
+            if (colorMod == io::RGBA)
+                buffer.push_back(c.alpha());
+        }
+        if (buffer.size() >= blockSize) {
+            fp.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < nFaces; i++) {
+        unsigned int size;
+        if (meshType == io::TRIANGLE_MESH)
+            size = 3;
+        else if (meshType == io::QUAD_MESH)
+            size = 4;
+        else
+            size = polygonSizes[i];
+        if (wideFaceSizes)
+            appendBinaryValue(buffer, (uint32_t)size, swap);
+        else
+            buffer.push_back((unsigned char)size);
+        for (unsigned int k = 0; k < size; k++)
+            appendBinaryValue(buffer, (int32_t)faces[j+k], swap);
+        j += size;
+        if (modality & io::COLOR_FACES){
+            Color c = colorFromArray(colorMod == io::RGB ? i*3 : i*4, faceColors, colorMod);
+            buffer.push_back(c.red());
+            buffer.push_back(c.green());
+            buffer.push_back(c.blue());
+            if (colorMod == io::RGBA)
+                buffer.push_back(c.alpha());
+        }
+        if (buffer.size() >= blockSize) {
+            fp.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    fp.write(buffer.data(), buffer.size());
+    return fp.good();
+}
+
+} //namespace cg3::internal::ply
+
+#ifdef CG3_WITH_EIGEN
+/**
+ * @brief Copies a vector of 3D coordinates (x0 y0 z0 x1 ...) in a #rows x 3 matrix.
+ */
+template <typename S, typename T>
+inline void copyCoordinatesOnEigen(
+        const std::vector<S>& coords,
+        Eigen::PlainObjectBase<T>& matrix)
+{
+    matrix.resize(coords.size()/3, 3);
+    for (unsigned int i = 0; i < coords.size()/3; i++){
+        matrix(i,0) = coords[i*3];
+        matrix(i,1) = coords[i*3+1];
+        matrix(i,2) = coords[i*3+2];
+    }
+}
+
+/**
+ * @brief Copies the first three vertices of every face in a #faces x 3 matrix.
+ */
+template <typename S, typename V>
+inline void copyTrianglesOnEigen(
+        const std::vector<S>& faces,
+        const std::vector<unsigned int>& faceSizes,
+        Eigen::PlainObjectBase<V>& triangles)
+{
+    triangles.resize(faceSizes.size(), 3);
+    size_t j = 0;
+    for (unsigned int i = 0; i < faceSizes.size(); i++){
+        for (unsigned int id = 0; id < 3 && id < faceSizes[i]; id++)
+            triangles(i,id) = faces[j+id];
+        j += faceSizes[i];
+    }
+}
+
+/**
+ * @brief Copies a vector of colors in a #colors x 3 matrix. Floating point matrices
+ * will contain values in [0, 1], integer matrices values in [0, 255].
+ */
+template <typename W>
+inline void copyColorsOnEigen(
+        const std::vector<Color>& colors,
+        Eigen::PlainObjectBase<W>& matrix)
+{
+    matrix.resize(colors.size(), 3);
+    for (unsigned int i = 0; i < colors.size(); i++){
+        if (std::is_floating_point<typename Eigen::PlainObjectBase<W>::Scalar>::value) {
+            matrix(i, 0) = colors[i].redF();
+            matrix(i, 1) = colors[i].greenF();
+            matrix(i, 2) = colors[i].blueF();
+        }
+        else {
+            matrix(i, 0) = colors[i].red();
+            matrix(i, 1) = colors[i].green();
+            matrix(i, 2) = colors[i].blue();
+        }
+    }
+}
+#endif
+
 } //namespace cg3::internal
 
 /**
@@ -285,6 +1343,7 @@ bool saveMeshOnObj(
  * @param verticesColors
  * @param faceColors
  * @param polygonSizes
+ * @param format: io::ASCII, io::BINARY_LITTLE_ENDIAN or io::BINARY_BIG_ENDIAN
  * @return
  */
 template <typename A, typename B, typename C, typename T, typename V, typename W >
@@ -300,7 +1359,8 @@ inline bool saveMeshOnPly(
         io::ColorMode colorMod,
         const T verticesColors[],
         const V faceColors[],
-        const W polygonSizes[])
+        const W polygonSizes[],
+        io::FileFormat format)
 {
     std::string plyfilename;
     std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
@@ -311,7 +1371,10 @@ inline bool saveMeshOnPly(
     else
         plyfilename = filename + ".ply";
 
-    fp.open (plyfilename);
+    if (format == io::ASCII)
+        fp.open (plyfilename);
+    else
+        fp.open (plyfilename, std::ios::out | std::ios::binary);
     if(!fp) {
         return false;
     }
@@ -319,7 +1382,13 @@ inline bool saveMeshOnPly(
     fp.setf( std::ios::fixed, std:: ios::floatfield );
 
     //header
-    fp << "ply\nformat ascii 1.0\n";
+    fp << "ply\nformat ";
+    if (format == io::BINARY_LITTLE_ENDIAN)
+        fp << "binary_little_endian 1.0\n";
+    else if (format == io::BINARY_BIG_ENDIAN)
+        fp << "binary_big_endian 1.0\n";
+    else
+        fp << "ascii 1.0\n";
     fp << "element vertex " << nVertices << "\n";
     fp << "property float x\nproperty float y\nproperty float z\n";
     if (modality & io::NORMAL_VERTICES){
@@ -332,7 +1401,13 @@ inline bool saveMeshOnPly(
             fp << "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
     }
     fp << "element face " << nFaces << "\n";
-    fp << "property list uchar int vertex_indices\n";
+    //sizes of the faces are written as uchar, unless a face has more than 255 vertices
+    bool wideFaceSizes = false;
+    if (meshType == io::POLYGON_MESH) {
+        for (size_t i = 0; i < nFaces && !wideFaceSizes; i++)
+            wideFaceSizes = polygonSizes[i] > 255;
+    }
+    fp << "property list " << (wideFaceSizes ? "uint" : "uchar") << " int vertex_indices\n";
     if (modality & io::COLOR_FACES){
         if (colorMod == io::RGB)
             fp << "property uchar red\nproperty uchar green\nproperty uchar blue\n";
@@ -342,6 +1417,15 @@ inline bool saveMeshOnPly(
     fp << "end_header\n";
     //
 
+    if (format != io::ASCII) {
+        bool r = internal::ply::saveBinaryData(
+                    fp, format, nVertices, nFaces, vertices, faces, meshType, modality,
+                    verticesNormals, colorMod, verticesColors, faceColors, polygonSizes,
+                    wideFaceSizes);
+        fp.close();
+        return r;
+    }
+
     for(size_t i=0; i<nVertices*3; i+=3) {
         fp << vertices[i] << " " << vertices[i+1] << " " << vertices[i+2];
         if (modality & io::NORMAL_VERTICES) {
@@ -413,173 +1497,126 @@ inline bool saveMeshOnPly(
 
 /**
  * @ingroup cg3core
- * @brief loadMeshFromObj
- * @param filename
- * @param coords
- * @param faces
- * @param meshType
- * @param modality
- * @param verticesNormals
- * @param verticesColors
- * @param faceColors
- * @param faceSizes
- * @return
+ * @brief Loads a mesh from an obj file.
+ *
+ * The file is read in large chunks, and numbers are parsed directly inside the read
+ * buffer: no intermediate string is created for lines or tokens.
+ *
+ * Large files are split at line boundaries in chunks which are parsed in parallel by
+ * nThreads threads; the chunks are then merged in order, therefore the loaded mesh is
+ * the same for any number of threads.
+ *
+ * Supported records are "v" (with optional rgb[a] colors), "vn", "f" (indices can be
+ * negative, and texture/normal indices are ignored), "mtllib" and "usemtl".
+ *
+ * @param[in] filename: the obj file
+ * @param[out] coords: coordinates of the vertices (x0 y0 z0 x1 y1 z1 ...)
+ * @param[out] faces: indices of the vertices of all the faces, one face after the other
+ * @param[out] meshType: TRIANGLE_MESH, QUAD_MESH or POLYGON_MESH
+ * @param[out] modality: the properties (io::FileMode) contained in the file
+ * @param[out] verticesNormals: normals of the vertices (x0 y0 z0 x1 y1 z1 ...)
+ * @param[out] verticesColors: colors of the vertices
+ * @param[out] faceColors: colors of the faces, read from the mtl file
+ * @param[out] faceSizes: number of vertices of every face
+ * @param[in] nThreads: number of threads used to parse the file, 0 means all the
+ * available threads (see maxNumberOfThreads())
+ * @return false if the file cannot be opened or is not a valid obj file
  */
 template <typename T, typename V, typename C, typename W>
 bool loadMeshFromObj(
         const std::string& filename,
-        std::list<T>& coords,
-        std::list<V>& faces,
-        io::MeshType & meshType,
-        int &modality,
-        std::list<C> &verticesNormals,
-        std::list<Color> &verticesColors,
-        std::list<Color> &faceColors,
-        std::list<W> &faceSizes)
+        std::vector<T>& coords,
+        std::vector<V>& faces,
+        io::MeshType& meshType,
+        int& modality,
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes,
+        unsigned int nThreads)
 {
     std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
-    static const std::string vertex = "v";
-    static const std::string vertexNormal = "vn";
-    static const std::string face   = "f";
-
-    std::ifstream file(filename.c_str());
-    std::string   line;
-    bool usemtu = false;
-    bool first = true;
-    std::map<std::string, Color> mapColors;
-    Color actualColor;
+    internal::FileReader file(filename);
 
     coords.clear();
     faces.clear();
     verticesNormals.clear();
     verticesColors.clear();
     faceColors.clear();
+    faceSizes.clear();
     modality = 0;
 
-    if(!file.is_open()) {
+    if(!file.isOpen()) {
         return false;
     }
-    while(std::getline(file,line)) {
-
-        cg3::Tokenizer spaceTokenizer(line, ' ');
-
-        if (spaceTokenizer.begin() != spaceTokenizer.end()) {
-
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            std::string header = *token;
-
-            if (header == "mtllib"){
-                modality |= io::COLOR_FACES;
-                usemtu = true;
-                std::string mtufilename = *(++token);
-                size_t lastSlash = filename.find_last_of("/");
-                if (lastSlash < filename.size()){
-                    std::string path = filename.substr(0, lastSlash);
-                    mtufilename = path + "/" + mtufilename;
-                }
-                if (! internal::loadMtlFile(mtufilename, mapColors))
-                    usemtu = false;
-            }
-
-            if (header == vertexNormal) {
-                modality |= io::NORMAL_VERTICES;
-                std::string x = *(++token);
-                std::string y = *(++token);
-                std::string z = *(++token);
-
-                verticesNormals.push_back(std::stod(x));
-                verticesNormals.push_back(std::stod(y));
-                verticesNormals.push_back(std::stod(z));
-            }
-
-            // Handle
-            //
-            // v 0.123 0.234 0.345
-            // v 0.123 0.234 0.345 1.0
-            if (header == vertex) {
-                std::string x = *(++token);
-                std::string y = *(++token);
-                std::string z = *(++token);
-
-                coords.push_back(std::stod(x));
-                coords.push_back(std::stod(y));
-                coords.push_back(std::stod(z));
-
-                ++token;
-
-                if (token != spaceTokenizer.end()){
-                    modality |= io::COLOR_VERTICES;
-                    std::string r = *(token);
-                    std::string g = *(++token);
-                    std::string b = *(++token);
-                    ++token;
-                    double alpha = 255;
-                    if (token != spaceTokenizer.end()){
-                        alpha = std::stoi(*token);
-                    }
-                    Color c(std::stod(r)*255, std::stod(g)*255, std::stod(b)*255, alpha);
-                    verticesColors.push_back(c);
-                }
-            }
-            // Handle
-            //
-            // f 1 2 3
-            // f 3/1 4/2 5/3
-            // f 6/4/1 3/5/3 7/6/5
-
-            else if (header == face) {
-                std::vector<std::string> dummy;
-                token++;
-                for (unsigned int i = 0; token != spaceTokenizer.end(); i++) {
-                    dummy.push_back(*(token));
-                    token++;
-                }
-                unsigned int nVert = (unsigned int)dummy.size();
-                faceSizes.push_back(nVert);
-
-                if (first == true){
-                    first = false;
-                    if (nVert == 3)
-                        meshType = io::TRIANGLE_MESH;
-                    else if (nVert == 4)
-                        meshType = io::QUAD_MESH;
-                    else
-                        meshType = io::POLYGON_MESH;
-                }
-                else {
-                    if (meshType == io::TRIANGLE_MESH && nVert != 3)
-                        meshType = io::POLYGON_MESH;
-                    if (meshType == io::QUAD_MESH && nVert != 4)
-                        meshType = io::POLYGON_MESH;
-                }
-
-                std::vector<cg3::Tokenizer> slashTokenizer;
-                for (unsigned int i=0; i<dummy.size(); i++){
-                    cg3::Tokenizer t(dummy[i], '/');
-                    slashTokenizer.push_back(t);
-                }
-
-                for (unsigned int i=0; i<dummy.size(); i++){
-                    std::string ids = *(slashTokenizer[i].begin());
-                    faces.push_back(std::stoi(ids)-1);
-                }
-
-                if (usemtu){
-                    faceColors.push_back(actualColor);
-                }
-            }
-            else if (header == "usemtl" && usemtu){
-                std::string color = *(++token);
-                assert(mapColors.find(color) != mapColors.end());
-                actualColor = mapColors[color];
-            }
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+    unsigned long long fileSize = file.size();
+    int nChunks = internal::obj::numberOfChunks(fileSize, nThreads);
+    std::vector<internal::obj::Chunk<T, V, C, W>> chunks(nChunks);
+
+    if (nChunks == 1) {
+        internal::obj::Chunk<T, V, C, W>& chunk = chunks[0];
+        if (!internal::obj::parseLines(file, fileSize, chunk))
+            return false;
+        internal::obj::loadFaceColors(filename, chunks, faceColors);
+        modality = chunk.modality;
+        coords.swap(chunk.coords);
+        faces.swap(chunk.faces);
+        verticesNormals.swap(chunk.verticesNormals);
+        verticesColors.swap(chunk.verticesColors);
+        faceSizes.swap(chunk.faceSizes);
+    }
+    else {
+        file.close();
+        #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+        for (int i = 0; i < nChunks; i++) {
+            internal::obj::parseChunk(filename, fileSize * i / nChunks, fileSize * (i+1) / nChunks, chunks[i]);
+        }
+        for (int i = 0; i < nChunks; i++) {
+            if (!chunks[i].valid)
+                return false;
         }
+        internal::obj::loadFaceColors(filename, chunks, faceColors);
+        internal::obj::mergeChunks(chunks, modality, coords, faces, verticesNormals, verticesColors, faceSizes, nThreads);
     }
-    file.close();
+    internal::meshTypeFromFaceSizes(faceSizes, meshType);
     return true;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief Loads a mesh from an obj file, storing its properties in lists.
+ * @see loadMeshFromObj(const std::string&, std::vector<T>&, std::vector<V>&, io::MeshType&, int&, std::vector<C>&, std::vector<Color>&, std::vector<Color>&, std::vector<W>&)
+ */
+template <typename T, typename V, typename C, typename W>
+bool loadMeshFromObj(
+        const std::string& filename,
+        std::list<T>& coords,
+        std::list<V>& faces,
+        io::MeshType & meshType,
+        int &modality,
+        std::list<C> &verticesNormals,
+        std::list<Color> &verticesColors,
+        std::list<Color> &faceColors,
+        std::list<W> &faceSizes)
+{
+    std::vector<T> vcoords;
+    std::vector<V> vfaces;
+    std::vector<C> vnormals;
+    std::vector<Color> vcolors, fcolors;
+    std::vector<W> fsizes;
+    bool r = loadMeshFromObj(filename, vcoords, vfaces, meshType, modality, vnormals, vcolors, fcolors, fsizes);
+    coords.assign(vcoords.begin(), vcoords.end());
+    faces.assign(vfaces.begin(), vfaces.end());
+    verticesNormals.assign(vnormals.begin(), vnormals.end());
+    verticesColors.assign(vcolors.begin(), vcolors.end());
+    faceColors.assign(fcolors.begin(), fcolors.end());
+    faceSizes.assign(fsizes.begin(), fsizes.end());
+    return r;
+}
+
 /**
  * @ingroup cg3core
  * @brief loadTriangleMeshFromObj
@@ -602,44 +1639,32 @@ bool loadTriangleMeshFromObj(
         std::vector<Color> &verticesColors,
         std::vector<Color> &triangleColors)
 {
-    std::list<T> dummyc;
-    std::list<V> dummyt;
+    std::vector<T> dummyc;
+    std::vector<V> dummyt;
     io::MeshType meshType;
     modality = 0;
-    std::list<C> dummyvn;
-    std::list<Color> dummycv;
-    std::list<Color> dummyct;
-    bool r = loadMeshFromObj(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct);
+    std::vector<C> dummyvn;
+    std::vector<Color> dummycv;
+    std::vector<Color> dummyct;
+    std::vector<unsigned int> faceSizes;
+    bool r = loadMeshFromObj(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && meshType != io::TRIANGLE_MESH){
         std::cerr << "Error: mesh contained on " << filename << " is not a triangle mesh\n";
         r = false;
     }
     if (r) {
-        coords.clear();
-        triangles.clear();
-        coords = std::vector<T>{ std::make_move_iterator(std::begin(dummyc)),
-                                      std::make_move_iterator(std::end(dummyc)) };
-        triangles = std::vector<V>{ std::make_move_iterator(std::begin(dummyt)),
-                                         std::make_move_iterator(std::end(dummyt)) };
-        if (modality & io::NORMAL_VERTICES && dummyc.size() == dummyvn.size()){
-            verticesNormals.clear();
-            verticesNormals = std::vector<C>{ std::make_move_iterator(std::begin(dummyvn)),
-                                          std::make_move_iterator(std::end(dummyvn)) };
-        }
+        coords.swap(dummyc);
+        triangles.swap(dummyt);
+        if (modality & io::NORMAL_VERTICES && coords.size() == dummyvn.size())
+            verticesNormals.swap(dummyvn);
         else
             modality &= ~io::NORMAL_VERTICES;
-        if (modality & io::COLOR_VERTICES && dummyc.size() == dummycv.size()*3){
-            verticesColors.clear();
-            verticesColors = std::vector<Color>{ std::make_move_iterator(std::begin(dummycv)),
-                                                      std::make_move_iterator(std::end(dummycv)) };
-        }
+        if (modality & io::COLOR_VERTICES && coords.size() == dummycv.size()*3)
+            verticesColors.swap(dummycv);
         else
             modality &= ~io::COLOR_VERTICES;
-        if (modality & io::COLOR_FACES && dummyt.size() == dummyct.size()*3){
-            triangleColors.clear();
-            triangleColors = std::vector<Color>{ std::make_move_iterator(std::begin(dummyct)),
-                                                      std::make_move_iterator(std::end(dummyct)) };
-        }
+        if (modality & io::COLOR_FACES && triangles.size() == dummyct.size()*3)
+            triangleColors.swap(dummyct);
         else
             modality &= ~io::COLOR_FACES;
     }
@@ -661,37 +1686,20 @@ bool loadTriangleMeshFromObj(
         Eigen::PlainObjectBase<T>& coords,
         Eigen::PlainObjectBase<V>&triangles)
 {
-    std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-    std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+    std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+    std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
     io::MeshType meshType;
-    std::list<unsigned int> faceSizes;
-    bool r = loadMeshFromObj(filename, dummyc, dummyt, meshType,
-                             internal::dummyInt, internal::dummyListDouble,
-                             internal::dummyListColor, internal::dummyListColor, faceSizes);
+    int modality;
+    std::vector<double> dummyvn;
+    std::vector<Color> dummycv, dummyct;
+    std::vector<unsigned int> faceSizes;
+    bool r = loadMeshFromObj(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && meshType != io::TRIANGLE_MESH){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
     }
     if (r) {
-        coords.resize(dummyc.size()/3, 3);
-        triangles.resize(faceSizes.size(), 3);
-        int v = 0;
-        for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end();){
-            coords(v,0) = *it++;
-            coords(v,1) = *it++;
-            coords(v,2) = *it++;
-            v++;
-        }
-        int t = 0;
-        std::list<unsigned int>::iterator fsit = faceSizes.begin();
-        for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end();){
-            for (unsigned int id = 0; id < *fsit; id++){
-                if (id < 3)
-                    triangles(t,id) = *it++;
-                else it++;
-            }
-            t++;
-            fsit++;
-        }
+        internal::copyCoordinatesOnEigen(dummyc, coords);
+        internal::copyTrianglesOnEigen(dummyt, faceSizes, triangles);
     }
     return r;
 }
@@ -718,95 +1726,33 @@ bool loadTriangleMeshFromObj(
         Eigen::PlainObjectBase<W> &verticesColors,
         Eigen::PlainObjectBase<X> &triangleColors)
 {
-    std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-    std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+    std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+    std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
     modality = 0;
     io::MeshType meshType;
-    std::list<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
-    std::list<Color> dummycv;
-    std::list<Color> dummyct;
-    std::list<unsigned int> faceSizes;
+    std::vector<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
+    std::vector<Color> dummycv;
+    std::vector<Color> dummyct;
+    std::vector<unsigned int> faceSizes;
     bool r = loadMeshFromObj(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && meshType != io::TRIANGLE_MESH){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
     }
     if (r) {
-        coords.resize(dummyc.size()/3, 3);
-        triangles.resize(faceSizes.size(), 3);
-        int v = 0;
-        for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end(); ){
-            coords(v,0) = *it++;
-            coords(v,1) = *it++;
-            coords(v,2) = *it++;
-            v++;
-        }
-        int t = 0;
-        std::list<unsigned int>::iterator fsit = faceSizes.begin();
-        for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end(); ){
-            for (unsigned int id = 0; id < *fsit; id++){
-                if (id < 3)
-                    triangles(t,id) = *it++;
-                else it++;
-            }
-            t++;
-            fsit++;
-        }
-        if (modality & io::NORMAL_VERTICES
-                && dummyc.size() == dummyvn.size()) {
-            verticesNormals.resize(dummyc.size()/3, 3);
-            int vn = 0;
-            for (typename std::list<typename Eigen::PlainObjectBase<C>::Scalar>::iterator it = dummyvn.begin(); it != dummyvn.end(); ){
-                verticesNormals(vn, 0) = *it++;
-                verticesNormals(vn, 1) = *it++;
-                verticesNormals(vn, 2) = *it++;
-                vn++;
-            }
-        }
+        internal::copyCoordinatesOnEigen(dummyc, coords);
+        internal::copyTrianglesOnEigen(dummyt, faceSizes, triangles);
+        if (modality & io::NORMAL_VERTICES && dummyc.size() == dummyvn.size())
+            internal::copyCoordinatesOnEigen(dummyvn, verticesNormals);
         else
             modality &= ~io::NORMAL_VERTICES;
-        if (modality & io::COLOR_VERTICES && dummyc.size() == dummycv.size()*3){
-            verticesColors.resize(dummyc.size()/3, 3);
-            int vc = 0;
-            for (typename std::list<Color>::iterator it = dummycv.begin(); it != dummycv.end(); ++it) {
-                Color c = *it;
-                if (typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(float) ||
-                        typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(double)) {
-                    verticesColors(vc, 0) = c.redF();
-                    verticesColors(vc, 1) = c.greenF();
-                    verticesColors(vc, 2) = c.blueF();
-                }
-                else {
-                    verticesColors(vc, 0) = c.red();
-                    verticesColors(vc, 1) = c.green();
-                    verticesColors(vc, 2) = c.blue();
-                }
-                vc++;
-            }
-        }
+        if (modality & io::COLOR_VERTICES && dummyc.size() == dummycv.size()*3)
+            internal::copyColorsOnEigen(dummycv, verticesColors);
         else
             modality &= ~io::COLOR_VERTICES;
-        if (modality & io::COLOR_FACES && faceSizes.size() == dummyct.size()){
-            triangleColors.resize(faceSizes.size(), 3);
-            int vc = 0;
-            for (typename std::list<Color>::iterator it = dummyct.begin(); it != dummyct.end(); ++it) {
-                Color c = *it;
-                if (typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(float) ||
-                        typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(double)) {
-                    triangleColors(vc, 0) = c.redF();
-                    triangleColors(vc, 1) = c.greenF();
-                    triangleColors(vc, 2) = c.blueF();
-                }
-                else {
-                    triangleColors(vc, 0) = c.red();
-                    triangleColors(vc, 1) = c.green();
-                    triangleColors(vc, 2) = c.blue();
-                }
-                vc++;
-            }
-        }
+        if (modality & io::COLOR_FACES && faceSizes.size() == dummyct.size())
+            internal::copyColorsOnEigen(dummyct, triangleColors);
         else
             modality &= ~io::COLOR_FACES;
-
     }
     return r;
 }
@@ -814,110 +1760,65 @@ bool loadTriangleMeshFromObj(
 
 /**
  * @ingroup cg3core
- * @brief loadMeshFromPly
- * @param filename
- * @param coords
- * @param faces
- * @param meshType
- * @param modality
- * @param verticesNormals
- * @param verticesColors
- * @param faceColors
- * @param faceSizes
- * @return
+ * @brief Loads a mesh from a ply file.
+ *
+ * The header is parsed first, then every element is read in the order in which it is
+ * declared: the output vectors are reserved using the number of vertices and faces
+ * declared in the header. Both ascii and binary (little and big endian) files are
+ * supported: ascii numbers are parsed directly inside the read buffer, binary
+ * vertices are read in blocks.
+ *
+ * @param[in] filename: the ply file
+ * @param[out] coords: coordinates of the vertices (x0 y0 z0 x1 y1 z1 ...)
+ * @param[out] faces: indices of the vertices of all the faces, one face after the other
+ * @param[out] meshType: TRIANGLE_MESH, QUAD_MESH or POLYGON_MESH
+ * @param[out] modality: the properties (io::FileMode) contained in the file
+ * @param[out] verticesNormals: normals of the vertices (x0 y0 z0 x1 y1 z1 ...)
+ * @param[out] verticesColors: colors of the vertices
+ * @param[out] faceColors: colors of the faces
+ * @param[out] faceSizes: number of vertices of every face
+ * @return false if the file cannot be opened or is not a valid ply file
  */
 template <typename T, typename V, typename C, typename W>
 bool loadMeshFromPly(
         const std::string& filename,
-        std::list<T>& coords,
-        std::list<V>& faces,
+        std::vector<T>& coords,
+        std::vector<V>& faces,
         io::MeshType& meshType,
         int& modality,
-        std::list<C>& verticesNormals,
-        std::list<Color>& verticesColors,
-        std::list<Color>& faceColors,
-        std::list<W>& faceSizes)
+        std::vector<C>& verticesNormals,
+        std::vector<Color>& verticesColors,
+        std::vector<Color>& faceColors,
+        std::vector<W>& faceSizes)
 {
-    typedef enum {VERTEX, FACE, OTHER} ElementType;
-    typedef enum {unknown = -1, x, y, z, nx, ny, nz, red, green, blue, alpha, list} PropertyName;
-    typedef enum {UCHAR, FLOAT} PropertyType;
-    typedef struct {
-        PropertyName name;
-        PropertyType type;
-    } Property;
-
-    std::ifstream file(filename.c_str());
-    std::string   line;
-
-    int nVer = -1, nFac = -1;
-    int nv=0, nf=0;
-    std::list<Property> vertexProperties;
-    std::list<Property> faceProperties;
-
-    bool first = true;
+    internal::FileReader file(filename);
+    io::FileFormat format;
+    std::vector<internal::ply::Element> elements;
 
+    coords.clear();
+    faces.clear();
+    verticesNormals.clear();
+    verticesColors.clear();
+    faceColors.clear();
+    faceSizes.clear();
+    modality = 0;
 
-    if(!file.is_open()) {
+    if(!file.isOpen()) {
         std::cerr << "ERROR : read() : could not open input file " << filename.c_str() << "\n";
         return false;
     }
 
     //reading header
-    std::string headerLine;
-    bool error;
-    ElementType elementType = OTHER;
-    do {
-        error = !(std::getline(file,line));
-        if (!error){
-            cg3::Tokenizer spaceTokenizer(line, ' ');
-            if (spaceTokenizer.begin() == spaceTokenizer.end()) continue;
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            headerLine = *token;
-            if (headerLine == "element") { //new type of element read
-                std::string s = *(++token);
-                if (s == "vertex"){
-                    elementType = VERTEX;
-                    nVer = std::stoi(*(++token));
-                }
-                else if (s == "face"){
-                    elementType = FACE;
-                    nFac = std::stoi(*(++token));
-                }
-                else elementType = OTHER;
-            }
-            else if (headerLine == "property"){
-                Property p;
-                std::string type = *(++token);
-                std::string name = *(++token);
-                p.name = unknown;
-                if (name == "x") p.name = x;
-                if (name == "y") p.name = y;
-                if (name == "z") p.name = z;
-                if (name == "nx") p.name = nx;
-                if (name == "ny") p.name = ny;
-                if (name == "nz") p.name = nz;
-                if (name == "red") p.name = red;
-                if (name == "green") p.name = green;
-                if (name == "blue") p.name = blue;
-                if (name == "alpha") p.name = alpha;
-                if (type == "list") p.name = list;
-                if (p.name != unknown){
-                    if (type == "float" || type == "double") p.type = FLOAT;
-                    else p.type = UCHAR;
-                    if (elementType == VERTEX)
-                        vertexProperties.push_back(p);
-                    else if (elementType == FACE)
-                        faceProperties.push_back(p);
-                }
-            }
-        }
-
-    } while (!error && headerLine != "end_header");
-    modality = 0;
+    bool error = !internal::ply::loadHeader(file, format, elements);
     std::array<bool, 11> vb{{false}};
-    for (Property p : vertexProperties){
-        if (p.name >= 0)
-            vb[p.name] = true;
+    std::array<bool, 11> fb{{false}};
+    for (const internal::ply::Element& e : elements){
+        for (const internal::ply::Property& p : e.properties){
+            if (p.name >= 0 && e.type == internal::ply::VERTEX)
+                vb[p.name] = true;
+            if (p.name >= 0 && e.type == internal::ply::FACE)
+                fb[p.name] = true;
+        }
     }
     if (!vb[0] || !vb[1] || !vb[2])
         error = true;
@@ -925,175 +1826,82 @@ bool loadMeshFromPly(
         modality |= io::NORMAL_VERTICES;
     if (vb[6] && vb[7] && vb[8])
         modality |= io::COLOR_VERTICES;
-    std::array<bool, 11> fb{{false}};
-    for (Property p : faceProperties){
-        if (p.name >= 0)
-            fb[p.name] = true;
-    }
     if (!fb[10])
         error = true;
     if (fb[6] && fb[7] && fb[8])
         modality |= io::COLOR_FACES;
-
     if (error){ //error while reading header
         std::cerr << "Error while parsing ply file\n";
         return false;
     }
 
-    while(std::getline(file,line)) {
-        cg3::Tokenizer spaceTokenizer(line, ' ');
-
-        if (spaceTokenizer.begin() == spaceTokenizer.end()) continue;
-
-        if (nv < nVer){ //reading vertices
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            std::array<double, 6> cnv;
-            Color c;
-
-            //manage properties of vertex
-            for (Property p : vertexProperties){
-                if (token == spaceTokenizer.end())
-                    return false;
-                if (p.name >= 0 && p.name < 6){
-                    cnv[p.name] = std::stod(*token);
-                }
-                else if (p.name >= 6 && p.name < 10){
-                    switch (p.name) {
-                        case red:
-                            if (p.type == UCHAR)
-                                c.setRed(std::stoi(*token));
-                            else
-                                c.setRedF(std::stof(*token));
-                            break;
-                        case green:
-                            if (p.type == UCHAR)
-                                c.setGreen(std::stoi(*token));
-                            else
-                                c.setGreenF(std::stof(*token));
-                            break;
-                        case blue:
-                            if (p.type == UCHAR)
-                                c.setBlue(std::stoi(*token));
-                            else
-                                c.setBlueF(std::stof(*token));
-                            break;
-                        case alpha:
-                            if (p.type == UCHAR)
-                                c.setAlpha(std::stoi(*token));
-                            else
-                                c.setAlphaF(std::stof(*token));
-                            break;
-                        default:
-                            ;
-                    }
-                }
-
-                //move to next property
-                token++;
-            }
-
-            //save properties to lists
-            coords.push_back(cnv[0]);
-            coords.push_back(cnv[1]);
-            coords.push_back(cnv[2]);
-            if (modality & io::NORMAL_VERTICES){
-                verticesNormals.push_back(cnv[3]);
-                verticesNormals.push_back(cnv[4]);
-                verticesNormals.push_back(cnv[5]);
-            }
-            if (modality & io::COLOR_VERTICES){
-                verticesColors.push_back(c);
-            }
-
-            //move to next face
-            nv++;
+    bool binary = format != io::ASCII;
+    bool swap = binary && (format == io::BINARY_LITTLE_ENDIAN) != internal::ply::isLittleEndianMachine();
+    for (const internal::ply::Element& e : elements){
+        if (e.type == internal::ply::VERTEX){
+            coords.reserve(coords.size() + e.number*3);
+            if (modality & io::NORMAL_VERTICES)
+                verticesNormals.reserve(verticesNormals.size() + e.number*3);
+            if (modality & io::COLOR_VERTICES)
+                verticesColors.reserve(verticesColors.size() + e.number);
+            if (binary)
+                error = !internal::ply::loadBinaryVertices(file, e, swap, modality, coords, verticesNormals, verticesColors);
+            else
+                error = !internal::ply::loadAsciiVertices(file, e, modality, coords, verticesNormals, verticesColors);
         }
-        else if (nf < nFac){ //reading faces
-            cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-            std::vector<int> indices;
-            Color c;
-
-            //manage properties of face
-            for (Property p : faceProperties){
-                if (token == spaceTokenizer.end())
-                    return false;
-                if (p.name == list){
-                    int size = std::stoi(*(token));
-                    indices.resize(size);
-                    for (int i = 0; i < size; i++){
-                        token++;
-                        if (token == spaceTokenizer.end())
-                            return false;
-                        indices[i] = std::stoi(*token);
-                    }
-                }
-                else {
-                    switch (p.name) {
-                        case red:
-                            if (p.type == UCHAR)
-                                c.setRed(std::stoi(*token));
-                            else
-                                c.setRedF(std::stof(*token));
-                            break;
-                        case green:
-                            if (p.type == UCHAR)
-                                c.setGreen(std::stoi(*token));
-                            else
-                                c.setGreenF(std::stof(*token));
-                            break;
-                        case blue:
-                            if (p.type == UCHAR)
-                                c.setBlue(std::stoi(*token));
-                            else
-                                c.setBlueF(std::stof(*token));
-                            break;
-                        case alpha:
-                            if (p.type == UCHAR)
-                                c.setAlpha(std::stoi(*token));
-                            else
-                                c.setAlphaF(std::stof(*token));
-                            break;
-                        default:
-                            ;
-                    }
-                }
-
-                //move to next property
-                token++;
-            }
-
-            //managing meshtype
-            if (first == true){
-                first = false;
-                if (indices.size() == 3)
-                    meshType = io::TRIANGLE_MESH;
-                else if (indices.size() == 4)
-                    meshType = io::QUAD_MESH;
-                else
-                    meshType = io::POLYGON_MESH;
-            }
-            else {
-                if (meshType == io::TRIANGLE_MESH && indices.size() != 3)
-                    meshType = io::POLYGON_MESH;
-                if (meshType == io::QUAD_MESH && indices.size() != 4)
-                    meshType = io::POLYGON_MESH;
-            }
-            //save properties to lists
-            faceSizes.push_back((unsigned int)indices.size());
-            for (unsigned int i = 0; i < indices.size(); i++)
-                faces.push_back(indices[i]);
+        else if (e.type == internal::ply::FACE){
+            faces.reserve(faces.size() + e.number*3);
+            faceSizes.reserve(faceSizes.size() + e.number);
             if (modality & io::COLOR_FACES)
-                faceColors.push_back(c);
-
-            //move to next face
-            nf++;
-
+                faceColors.reserve(faceColors.size() + e.number);
+            if (binary)
+                error = !internal::ply::loadBinaryFaces(file, e, swap, modality, faces, faceColors, faceSizes);
+            else
+                error = !internal::ply::loadAsciiFaces(file, e, modality, faces, faceColors, faceSizes);
         }
+        else if (binary)
+            error = !internal::ply::skipBinaryElement(file, e, swap);
+        else
+            error = !internal::ply::skipAsciiElement(file, e);
+        if (error)
+            return false;
     }
-    file.close();
+    internal::meshTypeFromFaceSizes(faceSizes, meshType);
     return true;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief Loads a mesh from a ply file, storing its properties in lists.
+ * @see loadMeshFromPly(const std::string&, std::vector<T>&, std::vector<V>&, io::MeshType&, int&, std::vector<C>&, std::vector<Color>&, std::vector<Color>&, std::vector<W>&)
+ */
+template <typename T, typename V, typename C, typename W>
+bool loadMeshFromPly(
+        const std::string& filename,
+        std::list<T>& coords,
+        std::list<V>& faces,
+        io::MeshType& meshType,
+        int& modality,
+        std::list<C>& verticesNormals,
+        std::list<Color>& verticesColors,
+        std::list<Color>& faceColors,
+        std::list<W>& faceSizes)
+{
+    std::vector<T> vcoords;
+    std::vector<V> vfaces;
+    std::vector<C> vnormals;
+    std::vector<Color> vcolors, fcolors;
+    std::vector<W> fsizes;
+    bool r = loadMeshFromPly(filename, vcoords, vfaces, meshType, modality, vnormals, vcolors, fcolors, fsizes);
+    coords.assign(vcoords.begin(), vcoords.end());
+    faces.assign(vfaces.begin(), vfaces.end());
+    verticesNormals.assign(vnormals.begin(), vnormals.end());
+    verticesColors.assign(vcolors.begin(), vcolors.end());
+    faceColors.assign(fcolors.begin(), fcolors.end());
+    faceSizes.assign(fsizes.begin(), fsizes.end());
+    return r;
+}
+
 #ifdef CG3_WITH_EIGEN
 /**
  * @ingroup cg3core
@@ -1109,37 +1917,20 @@ bool loadTriangleMeshFromPly(
         Eigen::PlainObjectBase<T>& coords,
         Eigen::PlainObjectBase<V>&triangles)
 {
-    std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-    std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+    std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+    std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
     io::MeshType meshType;
-    std::list<unsigned int> faceSizes;
-    bool r = loadMeshFromPly(filename, dummyc, dummyt, meshType,
-                             internal::dummyInt, internal::dummyListDouble,
-                             internal::dummyListColor, internal::dummyListColor, faceSizes);
+    int modality;
+    std::vector<double> dummyvn;
+    std::vector<Color> dummycv, dummyct;
+    std::vector<unsigned int> faceSizes;
+    bool r = loadMeshFromPly(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && meshType != io::TRIANGLE_MESH){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
     }
     if (r) {
-        coords.resize(dummyc.size()/3, 3);
-        triangles.resize(faceSizes.size(), 3);
-        int v = 0;
-        for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end();){
-            coords(v,0) = *it++;
-            coords(v,1) = *it++;
-            coords(v,2) = *it++;
-            v++;
-        }
-        int t = 0;
-        std::list<unsigned int>::iterator fsit = faceSizes.begin();
-        for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end(); ){
-            for (unsigned int id = 0; id < *fsit; id++){
-                if (id < 3)
-                    triangles(t,id) = *it++;
-                else it++;
-            }
-            t++;
-            fsit++;
-        }
+        internal::copyCoordinatesOnEigen(dummyc, coords);
+        internal::copyTrianglesOnEigen(dummyt, faceSizes, triangles);
     }
     return r;
 }
@@ -1166,95 +1957,33 @@ bool loadTriangleMeshFromPly(
         Eigen::PlainObjectBase<W> &verticesColors,
         Eigen::PlainObjectBase<X> &triangleColors)
 {
-    std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-    std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+    std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+    std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
     modality = 0;
     io::MeshType meshType;
-    std::list<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
-    std::list<Color> dummycv;
-    std::list<Color> dummyct;
-    std::list<unsigned int> faceSizes;
+    std::vector<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
+    std::vector<Color> dummycv;
+    std::vector<Color> dummyct;
+    std::vector<unsigned int> faceSizes;
     bool r = loadMeshFromPly(filename, dummyc, dummyt, meshType, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && meshType != io::TRIANGLE_MESH){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
     }
     if (r) {
-        coords.resize(dummyc.size()/3, 3);
-        triangles.resize(faceSizes.size(), 3);
-        int v = 0;
-        for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end();) {
-            coords(v,0) = *it++;
-            coords(v,1) = *it++;
-            coords(v,2) = *it++;
-            v++;
-        }
-        int t = 0;
-        std::list<unsigned int>::iterator fsit = faceSizes.begin();
-        for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end();) {
-            for (unsigned int id = 0; id < *fsit; id++){
-                if (id < 3)
-                    triangles(t,id) = *it++;
-                else it++;
-            }
-            t++;
-            fsit++;
-        }
-        if (modality & io::NORMAL_VERTICES
-                && dummyc.size() == dummyvn.size()) {
-            verticesNormals.resize(dummyc.size()/3, 3);
-            int vn = 0;
-            for (typename std::list<typename Eigen::PlainObjectBase<C>::Scalar>::iterator it = dummyvn.begin(); it != dummyvn.end();) {
-                verticesNormals(vn, 0) = *it++;
-                verticesNormals(vn, 1) = *it++;
-                verticesNormals(vn, 2) = *it++;
-                vn++;
-            }
-        }
+        internal::copyCoordinatesOnEigen(dummyc, coords);
+        internal::copyTrianglesOnEigen(dummyt, faceSizes, triangles);
+        if (modality & io::NORMAL_VERTICES && dummyc.size() == dummyvn.size())
+            internal::copyCoordinatesOnEigen(dummyvn, verticesNormals);
         else
             modality &= ~io::NORMAL_VERTICES;
-        if (modality & io::COLOR_VERTICES && dummyc.size() == dummycv.size()*3) {
-            verticesColors.resize(dummyc.size()/3, 3);
-            int vc = 0;
-            for (typename std::list<Color>::iterator it = dummycv.begin(); it != dummycv.end(); ++it){
-                Color c = *it;
-                if (typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(float) ||
-                        typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(double)) {
-                    verticesColors(vc, 0) = c.redF();
-                    verticesColors(vc, 1) = c.greenF();
-                    verticesColors(vc, 2) = c.blueF();
-                }
-                else {
-                    verticesColors(vc, 0) = c.red();
-                    verticesColors(vc, 1) = c.green();
-                    verticesColors(vc, 2) = c.blue();
-                }
-                vc++;
-            }
-        }
+        if (modality & io::COLOR_VERTICES && dummyc.size() == dummycv.size()*3)
+            internal::copyColorsOnEigen(dummycv, verticesColors);
         else
             modality &= ~io::COLOR_VERTICES;
-        if (modality & io::COLOR_FACES && faceSizes.size() == dummyct.size()){
-            triangleColors.resize(faceSizes.size(), 3);
-            int vc = 0;
-            for (typename std::list<Color>::iterator it = dummyct.begin(); it != dummyct.end(); ++it){
-                Color c = *it;
-                if (typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(float) ||
-                        typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(double)) {
-                    triangleColors(vc, 0) = c.redF();
-                    triangleColors(vc, 1) = c.greenF();
-                    triangleColors(vc, 2) = c.blueF();
-                }
-                else {
-                    triangleColors(vc, 0) = c.red();
-                    triangleColors(vc, 1) = c.green();
-                    triangleColors(vc, 2) = c.blue();
-                }
-                vc++;
-            }
-        }
+        if (modality & io::COLOR_FACES && faceSizes.size() == dummyct.size())
+            internal::copyColorsOnEigen(dummyct, triangleColors);
         else
             modality &= ~io::COLOR_FACES;
-
     }
     return r;
 }
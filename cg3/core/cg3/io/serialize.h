@@ -72,12 +72,27 @@ void deserializeAttribute(std::ifstream& binaryFile);
 template<typename T, typename... Args>
 void deserializeAttribute(std::ifstream& binaryFile, T& t, Args&... args);
 
+/**
+ * @brief Tells if an object of type T is serialized by writing its bytes, and therefore
+ * if a contiguous sequence of objects of type T can be written (and read) with a single
+ * call. It can be specialized for user types whose serialize() writes only their bytes.
+ */
+template <typename T>
+struct isBulkSerializable : std::integral_constant<bool, std::is_arithmetic<T>::value> {};
+
+template <typename T>
+void serializeBlock(const T* data, unsigned long long size, std::ofstream& binaryFile);
+
+template <typename T>
+void deserializeBlock(T* data, unsigned long long size, std::ifstream& binaryFile);
+
 } //namespace cg3::internal
 } //namespace cg3
 
 #include "serialize_std.h"
 #include "serialize_eigen.h"
 #include "serialize_qt.h"
+#include "serialize_compressed.h"
 
 #include "serialize.tpp"
 
@@ -399,4 +399,81 @@ inline void internal::deserializeAttribute(
     t = std::move(tmp);
 }
 
+namespace internal {
+
+template <typename T>
+inline void serializeBlock(
+        const T* data,
+        unsigned long long size,
+        std::ofstream& binaryFile,
+        std::true_type)
+{
+    binaryFile.write(reinterpret_cast<const char*>(data), size * sizeof(T));
+}
+
+template <typename T>
+inline void serializeBlock(
+        const T* data,
+        unsigned long long size,
+        std::ofstream& binaryFile,
+        std::false_type)
+{
+    for (unsigned long long i = 0; i < size; ++i)
+        serialize(data[i], binaryFile);
+}
+
+template <typename T>
+inline void deserializeBlock(
+        T* data,
+        unsigned long long size,
+        std::ifstream& binaryFile,
+        std::true_type)
+{
+    if (! binaryFile.read(reinterpret_cast<char*>(data), size * sizeof(T)))
+        throw std::ios_base::failure("Deserialization failed of " + typeName<T>(false, false, false) + " block");
+}
+
+template <typename T>
+inline void deserializeBlock(
+        T* data,
+        unsigned long long size,
+        std::ifstream& binaryFile,
+        std::false_type)
+{
+    for (unsigned long long i = 0; i < size; ++i)
+        deserialize(data[i], binaryFile);
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Serializes the size objects pointed by data, one after the other.
+ *
+ * If the objects are bulk serializable (see isBulkSerializable), they are written with a
+ * single call; the result is the same of calling serialize() on every object.
+ */
+template <typename T>
+inline void internal::serializeBlock(
+        const T* data,
+        unsigned long long size,
+        std::ofstream& binaryFile)
+{
+    serializeBlock(data, size, binaryFile, isBulkSerializable<T>());
+}
+
+/**
+ * @brief Deserializes size objects serialized by serializeBlock() (or by serialize()
+ * called on every object), storing them in the array pointed by data.
+ * @throws std::ios_base::failure if the objects cannot be read; the position of the
+ * stream is not restored.
+ */
+template <typename T>
+inline void internal::deserializeBlock(
+        T* data,
+        unsigned long long size,
+        std::ifstream& binaryFile)
+{
+    deserializeBlock(data, size, binaryFile, isBulkSerializable<T>());
+}
+
 } //namespace cg3
@@ -0,0 +1,109 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_SERIALIZE_COMPRESSED_H
+#define CG3_SERIALIZE_COMPRESSED_H
+
+#include <cstdint>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+
+#include "serialize.h"
+
+namespace cg3 {
+
+template <typename T>
+void serializeCompressed(
+        const T& obj,
+        std::ofstream& binaryFile,
+        unsigned int blockSize = 1 << 20);
+
+template <typename T>
+void deserializeCompressed(
+        T& obj,
+        std::ifstream& binaryFile);
+
+namespace internal {
+
+static const unsigned int compressedStreamVersion = 1;
+static const unsigned int maxCompressedStreamBlockSize = 1 << 26;
+
+/**
+ * @brief Stream buffer that compresses, in blocks, everything written on it, and writes
+ * the compressed blocks on another stream buffer.
+ *
+ * Every block is written as its size, the size of the compressed data, a checksum of the
+ * uncompressed data and the compressed data (or the uncompressed data, if the compression
+ * does not reduce its size). A block of size zero ends the stream.
+ */
+class CompressingStreamBuffer : public std::streambuf
+{
+public:
+    CompressingStreamBuffer(std::streambuf* destination, unsigned int blockSize);
+
+    bool finish();
+
+protected:
+    int_type overflow(int_type c);
+    int sync();
+
+private:
+    bool writeBlock();
+
+    std::streambuf* destination;
+    std::vector<char> block;
+    std::vector<char> compressed;
+    bool failed;
+};
+
+/**
+ * @brief Stream buffer that reads the blocks written by a CompressingStreamBuffer,
+ * checking their checksums.
+ *
+ * The position of the blocks already read is stored, therefore the stream can be sought
+ * (positions are counted on the uncompressed data), as done by the deserialize functions
+ * to restore the position of a stream after an error.
+ */
+class DecompressingStreamBuffer : public std::streambuf
+{
+public:
+    DecompressingStreamBuffer(std::streambuf* source, unsigned int blockSize);
+
+    bool finish();
+    bool isCorrupted() const;
+
+protected:
+    int_type underflow();
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+private:
+    typedef struct {
+        unsigned long long begin;   //position of the block in the uncompressed stream
+        std::streampos position;    //position of the block in the source
+        uint32_t size;
+    } BlockPosition;
+
+    bool loadBlock(unsigned int i);
+    unsigned long long blockBegin() const;
+
+    std::streambuf* source;
+    unsigned int maxBlockSize;
+    std::vector<char> block;
+    std::vector<char> compressed;
+    std::vector<BlockPosition> blocks;
+    unsigned int nextBlock;
+    std::streampos frontier;        //position in the source after the last block read
+    bool atFrontier;
+    bool ended;
+    bool corrupted;
+};
+
+} //namespace cg3::internal
+} //namespace cg3
+
+#include "serialize_compressed.tpp"
+
+#endif // CG3_SERIALIZE_COMPRESSED_H
@@ -0,0 +1,351 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "serialize_compressed.h"
+
+#include <cstring>
+
+#include "compression.h"
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief Serializes an object in a compressed stream: all the data written by the
+ * serialize function of the object (and by the functions it calls, like
+ * serializeObjectAttributes()) is compressed in blocks, each one with its checksum.
+ *
+ * Big objects like Dcel, BipartiteGraph or RegularLattice are usually compressed to a
+ * fraction of their size, at a speed close to the one of the disk. The object must be
+ * loaded with deserializeCompressed().
+ *
+ * Usage:
+ * @code{.cpp}
+ * std::ofstream myFile;
+ * myFile.open ("file.bin", std::ios::out | std::ios::binary);
+ * cg3::serializeCompressed(dcel, myFile);
+ * myFile.close();
+ * @endcode
+ *
+ * @param[in] obj: the object that we want to serialize
+ * @param[in] binaryFile: std::ofstream opened in binary mode on the file we want to serialize
+ * @param[in] blockSize: size in bytes of the uncompressed blocks
+ */
+template <typename T>
+inline void serializeCompressed(
+        const T& obj,
+        std::ofstream& binaryFile,
+        unsigned int blockSize)
+{
+    if (blockSize == 0 || blockSize > internal::maxCompressedStreamBlockSize)
+        blockSize = internal::maxCompressedStreamBlockSize;
+    serialize("cg3CompressedStream", binaryFile);
+    serialize(internal::compressedStreamVersion, binaryFile);
+    serialize(blockSize, binaryFile);
+
+    internal::CompressingStreamBuffer buffer(binaryFile.rdbuf(), blockSize);
+    std::ios& stream = binaryFile;
+    std::streambuf* fileBuffer = stream.rdbuf(&buffer);
+    try {
+        serialize(obj, binaryFile);
+    }
+    catch(...){
+        stream.rdbuf(fileBuffer);
+        throw;
+    }
+    bool good = binaryFile.good() && buffer.finish();
+    stream.rdbuf(fileBuffer);
+    if (!good)
+        binaryFile.setstate(std::ios::badbit);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Deserializes an object serialized with serializeCompressed().
+ *
+ * The checksum of every block is verified: if the file is corrupted, or if the data
+ * deserialized doesn't match with the object, an exception is thrown and the position
+ * of the binary file is restored as it was when the function was called.
+ *
+ * @param[out] obj: the object that we want to load
+ * @param[in] binaryFile: std::ifstream opened in binary mode on the file we want to deserialize
+ * @throws std::ios_base::failure exception if the object cannot be deserialized.
+ */
+template <typename T>
+inline void deserializeCompressed(
+        T& obj,
+        std::ifstream& binaryFile)
+{
+    std::streampos begin = binaryFile.tellg();
+    unsigned int version, blockSize;
+    try {
+        std::string tmp;
+        deserialize(tmp, binaryFile);
+        if (tmp != "cg3CompressedStream")
+            throw std::ios_base::failure("Mismatching String: " + tmp + " != cg3CompressedStream");
+        deserialize(version, binaryFile);
+        deserialize(blockSize, binaryFile);
+        if (version == 0 || version > internal::compressedStreamVersion)
+            throw std::ios_base::failure("Unsupported compressed stream version");
+        if (blockSize == 0 || blockSize > internal::maxCompressedStreamBlockSize)
+            throw std::ios_base::failure("Invalid compressed stream block size");
+    }
+    catch(std::ios_base::failure& e){
+        restoreFilePosition(binaryFile, begin);
+        throw std::ios_base::failure(e.what() + std::string("\nFrom compressed stream"));
+    }
+
+    internal::DecompressingStreamBuffer buffer(binaryFile.rdbuf(), blockSize);
+    std::ios& stream = binaryFile;
+    std::streambuf* fileBuffer = stream.rdbuf(&buffer);
+    std::string error;
+    try {
+        deserialize(obj, binaryFile);
+        if (!buffer.finish())
+            error = "Truncated compressed stream";
+    }
+    catch(std::ios_base::failure& e){
+        error = e.what();
+    }
+    catch(...){
+        error = "Deserialization failed";
+    }
+    stream.rdbuf(fileBuffer);
+    if (buffer.isCorrupted())
+        error = "Corrupted compressed block\n" + error;
+    if (!error.empty()) {
+        restoreFilePosition(binaryFile, begin);
+        throw std::ios_base::failure(error + "\nFrom compressed stream");
+    }
+}
+
+namespace internal {
+
+/**
+ * CompressingStreamBuffer
+ */
+
+inline CompressingStreamBuffer::CompressingStreamBuffer(
+        std::streambuf* destination,
+        unsigned int blockSize) :
+    destination(destination),
+    block(blockSize),
+    compressed(compressionBound(blockSize)),
+    failed(false)
+{
+    setp(block.data(), block.data() + block.size());
+}
+
+/**
+ * @brief Writes the last block and the end of the stream.
+ * @return false if some data could not be written on the destination
+ */
+inline bool CompressingStreamBuffer::finish()
+{
+    uint32_t end = 0;
+    if (!writeBlock() ||
+            destination->sputn((const char*)&end, sizeof(end)) != (std::streamsize)sizeof(end))
+        failed = true;
+    return !failed;
+}
+
+inline CompressingStreamBuffer::int_type CompressingStreamBuffer::overflow(int_type c)
+{
+    if (!writeBlock())
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+/**
+ * @brief Flushing does not write the current block, which would reduce the compression
+ * ratio: the blocks are written when full or at the end of the stream.
+ */
+inline int CompressingStreamBuffer::sync()
+{
+    return failed ? -1 : 0;
+}
+
+inline bool CompressingStreamBuffer::writeBlock()
+{
+    uint32_t header[3];
+    header[0] = (uint32_t)(pptr() - pbase());
+    if (failed || header[0] == 0)
+        return !failed;
+    header[1] = (uint32_t)compressBlock(pbase(), header[0], compressed.data());
+    header[2] = checksum(pbase(), header[0]);
+    const char* data = compressed.data();
+    if (header[1] >= header[0]) { //not compressible: stored as it is
+        header[1] = header[0];
+        data = pbase();
+    }
+    if (destination->sputn((const char*)header, sizeof(header)) != (std::streamsize)sizeof(header) ||
+            destination->sputn(data, header[1]) != (std::streamsize)header[1])
+        failed = true;
+    setp(block.data(), block.data() + block.size());
+    return !failed;
+}
+
+/**
+ * DecompressingStreamBuffer
+ */
+
+inline DecompressingStreamBuffer::DecompressingStreamBuffer(
+        std::streambuf* source,
+        unsigned int blockSize) :
+    source(source),
+    maxBlockSize(blockSize),
+    block(blockSize),
+    nextBlock(0),
+    atFrontier(true),
+    ended(false),
+    corrupted(false)
+{
+    frontier = source->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+    setg(nullptr, nullptr, nullptr);
+}
+
+/**
+ * @brief Reads the remaining blocks until the end of the stream, and leaves the source
+ * after the end of the stream.
+ * @return false if the stream is corrupted or truncated
+ */
+inline bool DecompressingStreamBuffer::finish()
+{
+    while (!ended && loadBlock(blocks.size()));
+    if (ended)
+        source->pubseekpos(frontier, std::ios_base::in);
+    return ended && !corrupted;
+}
+
+/**
+ * @brief Tells if a block whose checksum does not match with its data has been found.
+ */
+inline bool DecompressingStreamBuffer::isCorrupted() const
+{
+    return corrupted;
+}
+
+inline DecompressingStreamBuffer::int_type DecompressingStreamBuffer::underflow()
+{
+    if (gptr() == egptr() && !loadBlock(nextBlock))
+        return traits_type::eof();
+    return traits_type::to_int_type(*gptr());
+}
+
+inline DecompressingStreamBuffer::pos_type DecompressingStreamBuffer::seekoff(
+        off_type off,
+        std::ios_base::seekdir dir,
+        std::ios_base::openmode which)
+{
+    if (dir == std::ios_base::cur)
+        return seekpos(pos_type(blockBegin() + (gptr() - eback()) + off), which);
+    if (dir == std::ios_base::beg)
+        return seekpos(pos_type(off), which);
+    return pos_type(off_type(-1));
+}
+
+inline DecompressingStreamBuffer::pos_type DecompressingStreamBuffer::seekpos(
+        pos_type pos,
+        std::ios_base::openmode which)
+{
+    off_type target = pos;
+    if (!(which & std::ios_base::in) || target < 0)
+        return pos_type(off_type(-1));
+    unsigned long long t = target;
+    if (t == 0) { //the first block will be loaded by underflow()
+        nextBlock = 0;
+        setg(block.data(), block.data(), block.data());
+        return pos;
+    }
+    if (nextBlock == 0 || t < blockBegin() || t > blockBegin() + (egptr() - eback())) {
+        unsigned int i = 0;
+        while (i + 1 < blocks.size() && blocks[i + 1].begin <= t)
+            i++;
+        if (!loadBlock(i))
+            return pos_type(off_type(-1));
+    }
+    while (t > blockBegin() + (egptr() - eback())) {
+        if (!loadBlock(nextBlock))
+            return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + (t - blockBegin()), egptr());
+    return pos;
+}
+
+/**
+ * @brief Loads in the get area the i-th block of the stream, which must be already known
+ * or must be the one that follows the last block read.
+ * @return false if the stream is ended or the block is corrupted
+ */
+inline bool DecompressingStreamBuffer::loadBlock(unsigned int i)
+{
+    if (corrupted || i > blocks.size() || (i == blocks.size() && ended))
+        return false;
+    std::streampos position = i < blocks.size() ? blocks[i].position : frontier;
+    if (i < blocks.size() || !atFrontier)
+        source->pubseekpos(position, std::ios_base::in);
+    atFrontier = false;
+
+    uint32_t header[3];
+    if (source->sgetn((char*)header, sizeof(uint32_t)) != (std::streamsize)sizeof(uint32_t))
+        return false;
+    if (header[0] == 0) { //end of the stream
+        if (i == blocks.size()) {
+            ended = true;
+            frontier = position + std::streamoff(sizeof(uint32_t));
+            atFrontier = true;
+        }
+        return false;
+    }
+    if (source->sgetn((char*)(header + 1), 2 * sizeof(uint32_t)) != (std::streamsize)(2 * sizeof(uint32_t)))
+        return false;
+    if (header[0] > maxBlockSize || header[1] > header[0]) {
+        corrupted = true;
+        return false;
+    }
+    bool valid = true;
+    if (header[1] == header[0]) { //block stored not compressed
+        if (source->sgetn(block.data(), header[0]) != (std::streamsize)header[0])
+            return false;
+    }
+    else {
+        compressed.resize(header[1]);
+        if (source->sgetn(compressed.data(), header[1]) != (std::streamsize)header[1])
+            return false;
+        valid = decompressBlock(compressed.data(), header[1], block.data(), header[0]);
+    }
+    if (!valid || checksum(block.data(), header[0]) != header[2]) {
+        corrupted = true;
+        return false;
+    }
+
+    if (i == blocks.size()) {
+        BlockPosition p;
+        p.begin = i == 0 ? 0 : blocks[i - 1].begin + blocks[i - 1].size;
+        p.position = position;
+        p.size = header[0];
+        blocks.push_back(p);
+        frontier = position + std::streamoff(3 * sizeof(uint32_t) + header[1]);
+        atFrontier = true;
+    }
+    nextBlock = i + 1;
+    setg(block.data(), block.data(), block.data() + header[0]);
+    return true;
+}
+
+/**
+ * @brief Returns the position, in the uncompressed stream, of the block in the get area.
+ */
+inline unsigned long long DecompressingStreamBuffer::blockBegin() const
+{
+    return nextBlock == 0 ? 0 : blocks[nextBlock - 1].begin;
+}
+
+} //namespace cg3::internal
+} //namespace cg3
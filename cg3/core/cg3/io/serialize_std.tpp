@@ -7,6 +7,8 @@
 
 #include "serialize_std.h"
 
+#include <memory>
+
 namespace cg3 {
 
 template<typename T1, typename T2>
@@ -148,15 +150,12 @@ inline void deserialize(std::unordered_set<T, A...> &s, std::ifstream& binaryFil
 template <typename ...A>
 inline void serialize(const std::vector<bool, A...> &v, std::ofstream& binaryFile)
 {
-    bool tmp;
     unsigned long long int size = v.size();
     serialize("stdvectorBool", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::vector<bool, A...>::const_iterator it = v.begin(); it != v.end(); ++it){
-        if (*it) tmp = 1;
-        else tmp = 0;
-        serialize(tmp, binaryFile);
-    }
+    std::unique_ptr<bool[]> tmp(new bool[size]);
+    std::copy(v.begin(), v.end(), tmp.get());
+    internal::serializeBlock(tmp.get(), size, binaryFile);
 }
 
 /**
@@ -171,8 +170,7 @@ inline void serialize(const std::vector<T, A...> &v, std::ofstream& binaryFile)
     unsigned long long int size = v.size();
     serialize(std::string("stdvector"), binaryFile);
     serialize(size, binaryFile);
-    for (typename std::vector<T, A...>::const_iterator it = v.begin(); it != v.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeBlock(v.data(), size, binaryFile);
 }
 
 /**
@@ -193,12 +191,9 @@ inline void deserialize(std::vector<bool, A...> &v, std::ifstream& binaryFile)
         if (s != "stdvectorBool")
             throw std::ios_base::failure("Mismatching String: " + s + " != stdvectorBool");
         deserialize(size, binaryFile);
-        tmpv.resize(size);
-        bool tmp;
-        for (unsigned int it = 0; it < size; ++it){
-            deserialize(tmp, binaryFile);
-            tmpv[it] = tmp;
-        }
+        std::unique_ptr<bool[]> tmp(new bool[size]);
+        internal::deserializeBlock(tmp.get(), size, binaryFile);
+        tmpv.assign(tmp.get(), tmp.get() + size);
         v = std::move(tmpv);
     }
     catch(std::ios_base::failure& e){
@@ -230,9 +225,7 @@ inline void deserialize(std::vector<T, A...> &v, std::ifstream& binaryFile)
             throw std::ios_base::failure("Mismatching String: " + s + " != stdvector");
         deserialize(size, binaryFile);
         tmpv.resize(size);
-        for (unsigned int it = 0; it < size; ++it){
-            deserialize(tmpv[it], binaryFile);
-        }
+        internal::deserializeBlock(tmpv.data(), size, binaryFile);
         v = std::move(tmpv);
 
     }
@@ -368,8 +361,7 @@ inline void serialize(const std::array<T, A...> &a, std::ofstream& binaryFile)
     unsigned long long int size = a.size();
     serialize("stdarray", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::array<T, A...>::const_iterator it = a.begin(); it != a.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeBlock(a.data(), size, binaryFile);
 }
 
 /**
@@ -392,11 +384,9 @@ inline void deserialize(std::array<T, A...> &a, std::ifstream& binaryFile)
         deserialize(size, binaryFile);
         if (size != a.size())
             throw std::ios_base::failure(std::string("Mismatching std::array size: ") + std::to_string(size) + " != " + std::to_string(a.size()));
-        std::vector<T> tmp(size);
-        for (unsigned int it = 0; it < size; ++it){
-            deserialize(tmp[it], binaryFile);
-        }
-        std::copy_n(tmp.begin(), size, a.begin());
+        std::array<T, A...> tmp;
+        internal::deserializeBlock(tmp.data(), size, binaryFile);
+        a = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
         restoreFilePosition(binaryFile, begin);
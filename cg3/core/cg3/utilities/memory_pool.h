@@ -0,0 +1,89 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_MEMORY_POOL_H
+#define CG3_MEMORY_POOL_H
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief The MemoryPool class is a slab allocator for objects of type T.
+ *
+ * Objects are constructed inside contiguous blocks (slabs) of memory, and their
+ * addresses remain valid until they are destroyed or the pool is cleared.
+ * Destroyed objects are recycled through an intrusive free list, hence both
+ * create() and destroy() are O(1) and do not call the global allocator unless
+ * a new block is needed.
+ *
+ * The size of the blocks grows geometrically, starting from minBlockSize and
+ * up to maxBlockSize objects. reserve() allows to allocate in a single block all the
+ * objects that are going to be created.
+ *
+ * @note clear() and the destructor release all the blocks without calling the
+ * destructors of the objects that are still alive: the owner of the pool must call
+ * destroy() (or just the destructor of the objects, see destroyWithoutRecycle())
+ * if T is not trivially destructible.
+ */
+template<class T>
+class MemoryPool
+{
+public:
+    MemoryPool(size_t minBlockSize = 64, size_t maxBlockSize = 65536);
+    MemoryPool(const MemoryPool& other) = delete;
+    MemoryPool(MemoryPool&& other);
+    ~MemoryPool();
+
+    template<class... Args>
+    T* create(Args&&... args);
+    void destroy(T* object);
+    void destroyWithoutRecycle(T* object);
+
+    void reserve(size_t n);
+    void clear();
+    size_t size() const;
+    size_t capacity() const;
+    size_t numberBlocks() const;
+
+    void swap(MemoryPool& other);
+    void splice(MemoryPool& other);
+
+    MemoryPool& operator=(const MemoryPool& other) = delete;
+    MemoryPool& operator=(MemoryPool&& other);
+
+private:
+    union Slot {
+        Slot* next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    void allocateBlock(size_t blockSize);
+
+    std::vector<Slot*> blocks;
+    Slot* freeList;
+    Slot* freeListTail; /**< @brief Last slot of the free list, used to concatenate free lists */
+    Slot* current;      /**< @brief First never used slot of the current block */
+    Slot* currentEnd;   /**< @brief End of the current block */
+    std::vector<std::pair<Slot*, Slot*>> unusedRanges; /**< @brief Never used slots of the other blocks */
+    size_t minBlockSize;
+    size_t maxBlockSize;
+    size_t nextBlockSize;
+    size_t nObjects;
+    size_t nSlots;
+};
+
+template<class T>
+void swap(MemoryPool<T>& p1, MemoryPool<T>& p2);
+
+} //namespace cg3
+
+#include "memory_pool.tpp"
+
+#endif // CG3_MEMORY_POOL_H
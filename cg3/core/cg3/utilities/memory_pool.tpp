@@ -0,0 +1,283 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "memory_pool.h"
+
+#include <new>
+#include <utility>
+#include <algorithm>
+
+namespace cg3 {
+
+/**
+ * @brief Creates an empty pool. No memory is allocated until the first create() or reserve().
+ * @param[in] minBlockSize: number of objects contained in the first block
+ * @param[in] maxBlockSize: maximum number of objects contained in a block allocated by create()
+ */
+template<class T>
+MemoryPool<T>::MemoryPool(size_t minBlockSize, size_t maxBlockSize) :
+    freeList(nullptr),
+    freeListTail(nullptr),
+    current(nullptr),
+    currentEnd(nullptr),
+    minBlockSize(minBlockSize > 0 ? minBlockSize : 1),
+    maxBlockSize(std::max(maxBlockSize, minBlockSize)),
+    nextBlockSize(this->minBlockSize),
+    nObjects(0),
+    nSlots(0)
+{
+}
+
+template<class T>
+MemoryPool<T>::MemoryPool(MemoryPool&& other) :
+    blocks(std::move(other.blocks)),
+    freeList(other.freeList),
+    freeListTail(other.freeListTail),
+    current(other.current),
+    currentEnd(other.currentEnd),
+    unusedRanges(std::move(other.unusedRanges)),
+    minBlockSize(other.minBlockSize),
+    maxBlockSize(other.maxBlockSize),
+    nextBlockSize(other.nextBlockSize),
+    nObjects(other.nObjects),
+    nSlots(other.nSlots)
+{
+    other.blocks.clear();
+    other.freeList = nullptr;
+    other.freeListTail = nullptr;
+    other.current = nullptr;
+    other.currentEnd = nullptr;
+    other.unusedRanges.clear();
+    other.nextBlockSize = other.minBlockSize;
+    other.nObjects = 0;
+    other.nSlots = 0;
+}
+
+template<class T>
+MemoryPool<T>::~MemoryPool()
+{
+    clear();
+}
+
+/**
+ * @brief Constructs a new object inside the pool, forwarding the arguments to its constructor.
+ * @return the pointer to the new object
+ * @par Complexity:
+ *      \e O(1) amortized
+ */
+template<class T>
+template<class... Args>
+T* MemoryPool<T>::create(Args&&... args)
+{
+    Slot* slot;
+    if (freeList != nullptr) {
+        slot = freeList;
+        freeList = freeList->next;
+        if (freeList == nullptr)
+            freeListTail = nullptr;
+    }
+    else {
+        if (current == currentEnd) {
+            if (!unusedRanges.empty()) {
+                current = unusedRanges.back().first;
+                currentEnd = unusedRanges.back().second;
+                unusedRanges.pop_back();
+            }
+            else {
+                allocateBlock(nextBlockSize);
+                nextBlockSize = std::min(nextBlockSize * 2, maxBlockSize);
+            }
+        }
+        slot = current++;
+    }
+    T* object = new (&slot->storage) T(std::forward<Args>(args)...);
+    nObjects++;
+    return object;
+}
+
+/**
+ * @brief Destroys an object created by this pool, and makes its memory available
+ * for the next create().
+ * @param[in] object: an object created by this pool
+ * @par Complexity:
+ *      \e O(1)
+ */
+template<class T>
+void MemoryPool<T>::destroy(T* object)
+{
+    object->~T();
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->next = freeList;
+    if (freeList == nullptr)
+        freeListTail = slot;
+    freeList = slot;
+    nObjects--;
+}
+
+/**
+ * @brief Calls the destructor of an object created by this pool without recycling
+ * its memory. It must be used only when the pool is going to be cleared.
+ * @param[in] object: an object created by this pool
+ */
+template<class T>
+void MemoryPool<T>::destroyWithoutRecycle(T* object)
+{
+    object->~T();
+    nObjects--;
+}
+
+/**
+ * @brief Makes sure that the pool can contain at least n objects without allocating
+ * other memory. The missing capacity is allocated in a single block.
+ * @param[in] n: number of objects
+ */
+template<class T>
+void MemoryPool<T>::reserve(size_t n)
+{
+    if (n > nSlots)
+        allocateBlock(n - nSlots);
+}
+
+/**
+ * @brief Releases all the blocks of the pool.
+ *
+ * The destructors of the objects still alive are not called.
+ * @par Complexity:
+ *      \e O(numberBlocks)
+ */
+template<class T>
+void MemoryPool<T>::clear()
+{
+    for (Slot* block : blocks)
+        delete[] block;
+    blocks.clear();
+    freeList = nullptr;
+    freeListTail = nullptr;
+    current = nullptr;
+    currentEnd = nullptr;
+    unusedRanges.clear();
+    nextBlockSize = minBlockSize;
+    nObjects = 0;
+    nSlots = 0;
+}
+
+/**
+ * @return the number of objects alive in the pool
+ */
+template<class T>
+size_t MemoryPool<T>::size() const
+{
+    return nObjects;
+}
+
+/**
+ * @return the number of objects that the pool can contain without allocating other memory
+ */
+template<class T>
+size_t MemoryPool<T>::capacity() const
+{
+    return nSlots;
+}
+
+/**
+ * @return the number of blocks allocated by the pool
+ */
+template<class T>
+size_t MemoryPool<T>::numberBlocks() const
+{
+    return blocks.size();
+}
+
+template<class T>
+void MemoryPool<T>::swap(MemoryPool& other)
+{
+    std::swap(blocks, other.blocks);
+    std::swap(freeList, other.freeList);
+    std::swap(freeListTail, other.freeListTail);
+    std::swap(current, other.current);
+    std::swap(currentEnd, other.currentEnd);
+    std::swap(unusedRanges, other.unusedRanges);
+    std::swap(minBlockSize, other.minBlockSize);
+    std::swap(maxBlockSize, other.maxBlockSize);
+    std::swap(nextBlockSize, other.nextBlockSize);
+    std::swap(nObjects, other.nObjects);
+    std::swap(nSlots, other.nSlots);
+}
+
+/**
+ * @brief Moves all the blocks of another pool into this pool: the objects created by
+ * the other pool become objects of this pool, and their addresses do not change.
+ * The other pool is left empty.
+ *
+ * The free list of the other pool is concatenated to the free list of this pool,
+ * and its never used slots are kept as ranges: no slot is visited.
+ * @param[in] other: the pool whose blocks are moved
+ * @par Complexity:
+ *      \e O(numberBlocks of the other pool)
+ */
+template<class T>
+void MemoryPool<T>::splice(MemoryPool& other)
+{
+    if (&other == this)
+        return;
+
+    if (other.freeList != nullptr) {
+        other.freeListTail->next = freeList;
+        if (freeList == nullptr)
+            freeListTail = other.freeListTail;
+        freeList = other.freeList;
+    }
+
+    if (other.current != other.currentEnd)
+        unusedRanges.push_back(std::make_pair(other.current, other.currentEnd));
+    unusedRanges.insert(unusedRanges.end(), other.unusedRanges.begin(), other.unusedRanges.end());
+
+    blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+    nextBlockSize = std::max(nextBlockSize, other.nextBlockSize);
+    nObjects += other.nObjects;
+    nSlots += other.nSlots;
+
+    other.blocks.clear();
+    other.freeList = nullptr;
+    other.freeListTail = nullptr;
+    other.current = nullptr;
+    other.currentEnd = nullptr;
+    other.unusedRanges.clear();
+    other.nextBlockSize = other.minBlockSize;
+    other.nObjects = 0;
+    other.nSlots = 0;
+}
+
+template<class T>
+MemoryPool<T>& MemoryPool<T>::operator=(MemoryPool&& other)
+{
+    MemoryPool<T> tmp(std::move(other));
+    swap(tmp);
+    return *this;
+}
+
+/**
+ * @brief Allocates a new block, which becomes the current one. The slots never used
+ * of the previous block are kept as a range.
+ */
+template<class T>
+void MemoryPool<T>::allocateBlock(size_t blockSize)
+{
+    if (current != currentEnd)
+        unusedRanges.push_back(std::make_pair(current, currentEnd));
+    Slot* block = new Slot[blockSize];
+    blocks.push_back(block);
+    current = block;
+    currentEnd = block + blockSize;
+    nSlots += blockSize;
+}
+
+template<class T>
+inline void swap(MemoryPool<T>& p1, MemoryPool<T>& p2)
+{
+    p1.swap(p2);
+}
+
+} //namespace cg3
@@ -18,6 +18,8 @@ std::string executeCommand(const std::string& cmd);
 
 std::string executeCommand(const char* cmd);
 
+unsigned int maxNumberOfThreads();
+
 } //namespace cg3
 
 #include "system.tpp"
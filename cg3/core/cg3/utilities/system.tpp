@@ -7,6 +7,14 @@
 
 #include "system.h"
 
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace cg3 {
 
 /**
@@ -48,4 +56,20 @@ inline std::string executeCommand(const char* cmd)
     return result;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief Returns the maximum number of threads that can be used by the parallel
+ * algorithms of the library.
+ * @return the number of threads available to OpenMP, 1 if the library has been
+ * compiled without OpenMP
+ */
+inline unsigned int maxNumberOfThreads()
+{
+    #ifdef _OPENMP
+    return omp_get_max_threads();
+    #else
+    return 1;
+    #endif
+}
+
 } //namespace cg3
@@ -35,6 +35,7 @@ SOURCES += \
 HEADERS += \
     $$PWD/data_structures/graphs/graph.h \
     $$PWD/data_structures/graphs/includes/nodes/graph_node.h \
+    $$PWD/data_structures/graphs/includes/graph_csr.h \
     $$PWD/data_structures/graphs/includes/iterators/graph_genericnodeiterator.h \
     $$PWD/data_structures/graphs/includes/iterators/graph_nodeiterator.h \
     $$PWD/data_structures/graphs/includes/iterators/graph_adjacentiterator.h \
@@ -43,6 +44,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/data_structures/graphs/graph.tpp \
     $$PWD/data_structures/graphs/includes/nodes/graph_node.tpp \
+    $$PWD/data_structures/graphs/includes/graph_csr.tpp \
     $$PWD/data_structures/graphs/includes/iterators/graph_genericnodeiterator.tpp \
     $$PWD/data_structures/graphs/includes/iterators/graph_nodeiterator.tpp \
     $$PWD/data_structures/graphs/includes/iterators/graph_adjacentiterator.tpp \
@@ -60,12 +62,22 @@ SOURCES += \
     $$PWD/data_structures/graphs/bipartite_graph.tpp \
     $$PWD/data_structures/graphs/bipartite_graph_iterators.tpp
 
+
+# ----- Heaps -----
+
+HEADERS += \
+    $$PWD/data_structures/heaps/indexed_heap.h
+
+SOURCES += \
+    $$PWD/data_structures/heaps/indexed_heap.tpp
+
 # ----- Trees -----
 
 
 # Tree common includes
 HEADERS +=  \
     $$PWD/data_structures/trees/includes/tree_common.h \
+    $$PWD/data_structures/trees/includes/tree_node_pool.h \
     $$PWD/data_structures/trees/includes/iterators/tree_genericiterator.h \
     $$PWD/data_structures/trees/includes/iterators/tree_insertiterator.h \
     $$PWD/data_structures/trees/includes/iterators/tree_iterator.h \
@@ -77,6 +89,8 @@ HEADERS +=  \
     $$PWD/data_structures/trees/includes/avl_helpers.h
 
 SOURCES += \
+    $$PWD/data_structures/trees/includes/tree_common.cpp \
+    $$PWD/data_structures/trees/includes/tree_node_pool.tpp \
     $$PWD/data_structures/trees/includes/iterators/tree_insertiterator.tpp \
     $$PWD/data_structures/trees/includes/iterators/tree_iterator.tpp \
     $$PWD/data_structures/trees/includes/iterators/tree_reverseiterator.tpp \
@@ -117,15 +131,28 @@ SOURCES += \
 # Range tree
 HEADERS += \
     $$PWD/data_structures/trees/rangetree.h \
+    $$PWD/data_structures/trees/static_rangetree.h \
     $$PWD/data_structures/trees/includes/nodes/rangetree_node.h \
     $$PWD/data_structures/trees/includes/rangetree_types.h
 
 SOURCES += \
     $$PWD/data_structures/trees/rangetree.tpp \
+    $$PWD/data_structures/trees/static_rangetree.tpp \
     $$PWD/data_structures/trees/includes/nodes/rangetree_node.tpp \
     $$PWD/data_structures/trees/includes/rangetree_types.cpp
 
 
+# Fixed dimension range tree
+HEADERS += \
+    $$PWD/data_structures/trees/fixed_dimension_rangetree.h \
+    $$PWD/data_structures/trees/includes/nodes/fixed_dimension_rangetree_node.h \
+    $$PWD/data_structures/trees/includes/fixed_dimension_rangetree_shared_data.h
+
+SOURCES += \
+    $$PWD/data_structures/trees/fixed_dimension_rangetree.tpp \
+    $$PWD/data_structures/trees/includes/nodes/fixed_dimension_rangetree_node.tpp
+
+
 # AABB tree
 HEADERS += \
     $$PWD/data_structures/trees/aabbtree.h \
@@ -134,3 +161,13 @@ HEADERS += \
 SOURCES += \
     $$PWD/data_structures/trees/aabbtree.tpp \
     $$PWD/data_structures/trees/includes/nodes/aabb_node.tpp
+
+
+# BVH
+HEADERS += \
+    $$PWD/data_structures/trees/bvh.h \
+    $$PWD/data_structures/trees/triangle_bvh.h
+
+SOURCES += \
+    $$PWD/data_structures/trees/bvh.tpp \
+    $$PWD/data_structures/trees/triangle_bvh.tpp
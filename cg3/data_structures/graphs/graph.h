@@ -43,6 +43,12 @@ enum GraphType { DIRECTED, UNDIRECTED };
  * Recompact operation is automatically done after a defined number of deleted nodes
  * (to avoid memory exhaustion and optimize its usage). This number is set to 10000.
  *
+ * Traversal-heavy algorithms can use the read-only compressed sparse row (CSR)
+ * representation of the graph. The freeze() method stores it in the graph: while
+ * the graph is frozen the adjacent node and edge iterators use it, and the
+ * algorithms do not need to build it again. Any modification of the graph
+ * discards the representation.
+ *
  */
 template <class T>
 class Graph
@@ -82,6 +88,11 @@ public:
     typedef NodeIterator iterator;
 
 
+    /* Compressed sparse row representation */
+
+    class CSR;
+
+
     /* Constructors / destructor */
 
     explicit Graph(const GraphType& type = GraphType::DIRECTED);
@@ -121,10 +132,18 @@ public:
 
     size_t numNodes() const;
     size_t numEdges() const;
+    GraphType getType() const;
     void clear();
     void recompact();
 
 
+    /* Compressed sparse row representation */
+
+    void freeze();
+    bool isFrozen() const;
+    const CSR& getCSR() const;
+
+
     /* Iterators */
 
     NodeIterator begin() const;
@@ -179,6 +198,8 @@ protected:
     inline double getWeightHelper(const size_t& id1, const size_t& id2) const;
     inline void setWeightHelper(const size_t& id1, const size_t& id2, const double weight);
 
+    inline void unfreeze();
+
 
     /* Protected fields */
 
@@ -190,6 +211,9 @@ protected:
     std::vector<bool> isDeleted; //Delete flag
     int nDeletedNodes; //Number of deleted nodes
 
+    CSR csr; //Compressed sparse row representation
+    bool frozen; //True if the CSR representation is valid
+
 };
 
 
@@ -197,6 +221,8 @@ protected:
 
 #include "includes/nodes/graph_node.h"
 
+#include "includes/graph_csr.h"
+
 #include "includes/iterators/graph_genericnodeiterator.h"
 #include "includes/iterators/graph_nodeiterator.h"
 #include "includes/iterators/graph_adjacentiterator.h"
@@ -24,7 +24,8 @@ constexpr double Graph<T>::MAX_WEIGHT;
 template <class T>
 Graph<T>::Graph(const GraphType& type) :
     type(type),
-    nDeletedNodes(0)
+    nDeletedNodes(0),
+    frozen(false)
 {
 
 }
@@ -47,6 +48,8 @@ typename Graph<T>::NodeIterator Graph<T>::addNode(const T& o)
     if (mapIt != map.end())
         return this->nodeEnd();
 
+    unfreeze();
+
     //Create new node
     size_t newId = nodes.size();
 
@@ -76,6 +79,8 @@ bool Graph<T>::deleteNode(const T& o)
 
     size_t nodeId = mapIt->second;
 
+    unfreeze();
+
     //Setting node as deleted
     isDeleted[nodeId] = true;
 
@@ -398,6 +403,16 @@ size_t Graph<T>::numEdges() const
     return numEdges;
 }
 
+/**
+ * @brief Get the type of the graph
+ * @return Type of the graph (directed or undirected)
+ */
+template <class T>
+GraphType Graph<T>::getType() const
+{
+    return type;
+}
+
 /**
  * @brief Clear the graph.
  * It deletes all the nodes and clear the element map
@@ -405,6 +420,8 @@ size_t Graph<T>::numEdges() const
 template <class T>
 void Graph<T>::clear()
 {
+    unfreeze();
+
     //Clear nodes and map
     nodes.clear();
     map.clear();
@@ -422,6 +439,8 @@ void Graph<T>::clear()
 template <class T>
 void Graph<T>::recompact()
 {
+    unfreeze();
+
     //Vector to keep track in which index the nodes have been placed.
     std::vector<long long int> indexMap(this->nodes.size(), -1);
 
@@ -489,6 +508,49 @@ void Graph<T>::recompact()
 
 
 
+
+/* ----- COMPRESSED SPARSE ROW REPRESENTATION ----- */
+
+/**
+ * @brief Freeze the graph: build and store its compressed sparse row
+ * representation, in O(|V| + |E|) time.
+ * While the graph is frozen, the adjacent node and edge iterators and the
+ * algorithms on the graph use the representation. The first modification of
+ * the graph discards it.
+ */
+template <class T>
+void Graph<T>::freeze()
+{
+    if (!frozen) {
+        csr.build(*this);
+        frozen = true;
+    }
+}
+
+/**
+ * @brief Check if the graph is frozen
+ * @return True if the compressed sparse row representation is valid
+ */
+template <class T>
+bool Graph<T>::isFrozen() const
+{
+    return frozen;
+}
+
+/**
+ * @brief Get the compressed sparse row representation of the graph.
+ * It is empty if the graph is not frozen.
+ * @return Compressed sparse row representation
+ */
+template <class T>
+const typename Graph<T>::CSR& Graph<T>::getCSR() const
+{
+    return csr;
+}
+
+
+
+
 /* ----- ITERATORS ----- */
 
 
@@ -562,6 +624,16 @@ template <class T>
 typename Graph<T>::AdjacentIterator Graph<T>::adjacentBegin(
         NodeIterator nodeIt) const
 {
+    //Navigate the CSR representation if the graph is frozen
+    if (frozen) {
+        size_t index = (size_t) csr.getIndex((size_t) nodeIt.id);
+        return AdjacentIterator(
+                    this,
+                    nodeIt,
+                    csr.getOffsets()[index],
+                    csr.getOffsets()[index + 1]);
+    }
+
     //Get first valid adjacent iterator
     return AdjacentIterator(
                 this,
@@ -582,6 +654,15 @@ template <class T>
 typename Graph<T>::AdjacentIterator Graph<T>::adjacentEnd(
         NodeIterator nodeIt) const
 {
+    if (frozen) {
+        size_t index = (size_t) csr.getIndex((size_t) nodeIt.id);
+        return AdjacentIterator(
+                    this,
+                    nodeIt,
+                    csr.getOffsets()[index + 1],
+                    csr.getOffsets()[index + 1]);
+    }
+
     return AdjacentIterator(
                 this,
                 nodeIt,
@@ -845,6 +926,8 @@ template <class T>
 void Graph<T>::addEdgeHelper(const size_t& id1, const size_t& id2, const double weight)
 {
     if (!isDeleted[id2]) {
+        unfreeze();
+
         Node& n1 = this->nodes.at(id1);
 
         std::unordered_map<size_t, double>::iterator it = n1.adjacentNodes.find(id2);
@@ -867,6 +950,8 @@ template <class T>
 void Graph<T>::deleteEdgeHelper(const size_t& id1, const size_t& id2)
 {
     if (!isDeleted[id2]) {
+        unfreeze();
+
         Node& n1 = this->nodes.at(id1);
         n1.adjacentNodes.erase(id2);
     }
@@ -929,9 +1014,24 @@ void Graph<T>::setWeightHelper(const size_t& id1, const size_t& id2, const doubl
     if (it == n1.adjacentNodes.end())
         return;
 
+    unfreeze();
+
     it->second = weight;
 }
 
+/**
+ * @brief Discard the compressed sparse row representation, if the
+ * graph is frozen. It must be called before any modification of the graph
+ */
+template <class T>
+void Graph<T>::unfreeze()
+{
+    if (frozen) {
+        frozen = false;
+        csr.clear();
+    }
+}
+
 
 
 
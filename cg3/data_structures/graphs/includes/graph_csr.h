@@ -0,0 +1,73 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_GRAPH_CSR_H
+#define CG3_GRAPH_CSR_H
+
+#include <vector>
+
+#include "../graph.h"
+
+namespace cg3 {
+
+/**
+ * @brief Read-only compressed sparse row (CSR) representation of a graph
+ *
+ * The not deleted nodes of the graph are numbered from 0 to numNodes()-1
+ * (CSR indices), following the order of the node iterator. The adjacent nodes
+ * of the node i are targets[offsets[i]] ... targets[offsets[i+1]-1] (CSR
+ * indices), and weights contains the weights of the corresponding edges.
+ * Adjacencies are therefore stored in contiguous arrays, and a traversal does
+ * not need any hashing or any check on deleted nodes.
+ *
+ * The snapshot is not updated when the graph is modified.
+ */
+template <class T>
+class Graph<T>::CSR
+{
+
+public:
+
+    /* Constructors */
+
+    CSR();
+    explicit CSR(const Graph<T>& graph);
+
+
+    /* Public methods */
+
+    void build(const Graph<T>& graph);
+    void clear();
+
+    inline size_t numNodes() const;
+    inline size_t numEdges() const;
+
+    inline const std::vector<size_t>& getOffsets() const;
+    inline const std::vector<size_t>& getTargets() const;
+    inline const std::vector<double>& getWeights() const;
+
+    inline const std::vector<size_t>& getGraphIds() const;
+
+    inline size_t getGraphId(const size_t index) const;
+    inline long long int getIndex(const size_t graphId) const;
+
+
+private:
+
+    /* Fields */
+
+    std::vector<size_t> offsets; //First adjacency of each node (numNodes()+1 values)
+    std::vector<size_t> targets; //CSR indices of the adjacent nodes
+    std::vector<double> weights; //Weights of the edges
+
+    std::vector<size_t> graphIds; //Id in the graph of each CSR index
+    std::vector<long long int> indices; //CSR index of each graph id (-1 if deleted)
+
+};
+
+}
+
+#include "graph_csr.tpp"
+
+#endif // CG3_GRAPH_CSR_H
@@ -0,0 +1,182 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "graph_csr.h"
+
+namespace cg3 {
+
+/* ----- CONSTRUCTORS ----- */
+
+/**
+ * @brief Default constructor, it creates an empty representation
+ */
+template <class T>
+Graph<T>::CSR::CSR()
+{
+
+}
+
+/**
+ * @brief Constructor, it creates the representation of a graph
+ * @param[in] graph Input graph
+ */
+template <class T>
+Graph<T>::CSR::CSR(const Graph<T>& graph)
+{
+    build(graph);
+}
+
+
+
+/* ----- PUBLIC METHODS ----- */
+
+/**
+ * @brief Build the representation of a graph, in O(|V| + |E|) time
+ * @param[in] graph Input graph
+ */
+template <class T>
+void Graph<T>::CSR::build(const Graph<T>& graph)
+{
+    clear();
+
+    //Number the not deleted nodes
+    indices.resize(graph.nodes.size(), -1);
+    for (size_t i = 0; i < graph.nodes.size(); i++) {
+        if (!graph.isDeleted[i]) {
+            indices[i] = (long long int) graphIds.size();
+            graphIds.push_back(i);
+        }
+    }
+
+    //Count the adjacencies
+    offsets.resize(graphIds.size() + 1, 0);
+
+    size_t numEdges = 0;
+    for (size_t i = 0; i < graphIds.size(); i++) {
+        offsets[i] = numEdges;
+        for (const std::pair<const size_t, double>& adj : graph.nodes[graphIds[i]].adjacentNodes) {
+            if (!graph.isDeleted[adj.first])
+                numEdges++;
+        }
+    }
+    offsets[graphIds.size()] = numEdges;
+
+    //Fill targets and weights
+    targets.resize(numEdges);
+    weights.resize(numEdges);
+
+    for (size_t i = 0; i < graphIds.size(); i++) {
+        size_t pos = offsets[i];
+        for (const std::pair<const size_t, double>& adj : graph.nodes[graphIds[i]].adjacentNodes) {
+            if (!graph.isDeleted[adj.first]) {
+                targets[pos] = (size_t) indices[adj.first];
+                weights[pos] = adj.second;
+                pos++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Clear the representation and release its memory
+ */
+template <class T>
+void Graph<T>::CSR::clear()
+{
+    std::vector<size_t>().swap(offsets);
+    std::vector<size_t>().swap(targets);
+    std::vector<double>().swap(weights);
+    std::vector<size_t>().swap(graphIds);
+    std::vector<long long int>().swap(indices);
+}
+
+/**
+ * @brief Get the number of nodes
+ * @return Number of nodes
+ */
+template <class T>
+size_t Graph<T>::CSR::numNodes() const
+{
+    return graphIds.size();
+}
+
+/**
+ * @brief Get the number of edges (for undirected graphs, each
+ * edge is counted twice)
+ * @return Number of edges
+ */
+template <class T>
+size_t Graph<T>::CSR::numEdges() const
+{
+    return targets.size();
+}
+
+/**
+ * @brief Get the offsets of the adjacencies: the adjacencies of the
+ * node i are in the positions from offsets[i] to offsets[i+1]-1
+ * @return Vector of offsets (numNodes()+1 values)
+ */
+template <class T>
+const std::vector<size_t>& Graph<T>::CSR::getOffsets() const
+{
+    return offsets;
+}
+
+/**
+ * @brief Get the CSR indices of the adjacent nodes
+ * @return Vector of targets (numEdges() values)
+ */
+template <class T>
+const std::vector<size_t>& Graph<T>::CSR::getTargets() const
+{
+    return targets;
+}
+
+/**
+ * @brief Get the weights of the edges
+ * @return Vector of weights (numEdges() values)
+ */
+template <class T>
+const std::vector<double>& Graph<T>::CSR::getWeights() const
+{
+    return weights;
+}
+
+/**
+ * @brief Get the ids in the graph of the nodes
+ * @return Vector of ids (numNodes() values)
+ */
+template <class T>
+const std::vector<size_t>& Graph<T>::CSR::getGraphIds() const
+{
+    return graphIds;
+}
+
+/**
+ * @brief Get the id in the graph of a node
+ * @param[in] index CSR index of the node
+ * @return Id of the node in the graph
+ */
+template <class T>
+size_t Graph<T>::CSR::getGraphId(const size_t index) const
+{
+    return graphIds[index];
+}
+
+/**
+ * @brief Get the CSR index of a node
+ * @param[in] graphId Id of the node in the graph
+ * @return CSR index of the node, -1 if the node is not in
+ * the representation
+ */
+template <class T>
+long long int Graph<T>::CSR::getIndex(const size_t graphId) const
+{
+    if (graphId >= indices.size())
+        return -1;
+
+    return indices[graphId];
+}
+
+}
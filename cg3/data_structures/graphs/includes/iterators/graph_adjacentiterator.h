@@ -6,7 +6,8 @@
 namespace cg3 {
 
 /**
- * @brief The iterator of a graph
+ * @brief The iterator of a graph. If the graph is frozen, it navigates
+ * the adjacencies in the compressed sparse row representation.
  */
 template <class T>
 class Graph<T>::AdjacentIterator :
@@ -27,6 +28,13 @@ private:
             const Graph<T>* graph,
             const NodeIterator& targetNodeIt,
             std::unordered_map<size_t, double>::const_iterator it);
+
+    inline AdjacentIterator(
+            const Graph<T>* graph,
+            const NodeIterator& targetNodeIt,
+            const size_t csrPos,
+            const size_t csrEnd);
+
 public:
 
     /* Iterator operators */
@@ -51,6 +59,10 @@ private:
     NodeIterator targetNodeIt;
     std::unordered_map<size_t, double>::const_iterator it;
 
+    bool csrMode; //True if the iterator navigates the CSR representation
+    size_t csrPos; //Current position in the CSR targets
+    size_t csrEnd; //End position in the CSR targets
+
 };
 
 
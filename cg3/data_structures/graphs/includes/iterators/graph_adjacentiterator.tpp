@@ -15,7 +15,10 @@ Graph<T>::AdjacentIterator::AdjacentIterator(
         const Graph<T>* graph) :
     Graph<T>::GenericNodeIterator(graph),
     targetNodeIt(this->graph->nodeEnd()),
-    it(std::unordered_map<size_t, double>::const_iterator())
+    it(std::unordered_map<size_t, double>::const_iterator()),
+    csrMode(false),
+    csrPos(0),
+    csrEnd(0)
 {
 
 }
@@ -27,7 +30,10 @@ Graph<T>::AdjacentIterator::AdjacentIterator(
         std::unordered_map<size_t, double>::const_iterator it) :
     Graph<T>::GenericNodeIterator(graph),
     targetNodeIt(targetNodeIt),
-    it(it)
+    it(it),
+    csrMode(false),
+    csrPos(0),
+    csrEnd(0)
 {
     if (targetNodeIt != this->graph->nodeEnd() &&
             it != this->graph->nodes.at((size_t) targetNodeIt.id).adjacentNodes.end())
@@ -36,6 +42,25 @@ Graph<T>::AdjacentIterator::AdjacentIterator(
     }
 }
 
+template <class T>
+Graph<T>::AdjacentIterator::AdjacentIterator(
+        const Graph<T>* graph,
+        const NodeIterator& targetNodeIt,
+        const size_t csrPos,
+        const size_t csrEnd) :
+    Graph<T>::GenericNodeIterator(graph),
+    targetNodeIt(targetNodeIt),
+    it(std::unordered_map<size_t, double>::const_iterator()),
+    csrMode(true),
+    csrPos(csrPos),
+    csrEnd(csrEnd)
+{
+    if (csrPos < csrEnd) {
+        const CSR& csr = this->graph->csr;
+        this->id = (long long int) csr.getGraphId(csr.getTargets()[csrPos]);
+    }
+}
+
 
 
 /* ----- OPERATOR OVERLOAD ----- */
@@ -48,7 +73,10 @@ bool Graph<T>::AdjacentIterator::operator ==(
     return (this->graph == otherIterator.graph &&
             this->id == otherIterator.id &&
             targetNodeIt == otherIterator.targetNodeIt &&
-            it == otherIterator.it);
+            csrMode == otherIterator.csrMode &&
+            (csrMode ?
+                 csrPos == otherIterator.csrPos :
+                 it == otherIterator.it));
 }
 
 template <class T>
@@ -88,6 +116,20 @@ const T& Graph<T>::AdjacentIterator::operator *() const
 template <class T>
 void Graph<T>::AdjacentIterator::next()
 {
+    if (csrMode) {
+        ++csrPos;
+
+        if (csrPos < csrEnd) {
+            const CSR& csr = this->graph->csr;
+            this->id = (long long int) csr.getGraphId(csr.getTargets()[csrPos]);
+        }
+        else {
+            this->id = -1;
+        }
+
+        return;
+    }
+
     ++it;
     it = this->graph->getFirstValidIteratorAdjacent(targetNodeIt, it);
 
@@ -0,0 +1,94 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_INDEXED_HEAP_H
+#define CG3_INDEXED_HEAP_H
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <limits>
+
+namespace cg3 {
+
+/**
+ * @brief Indexed d-ary min-heap
+ *
+ * The elements of the heap are the indices from 0 to capacity()-1, each one
+ * associated to a key. The position of each index in the heap is stored: every
+ * index is in the heap at most once, and the key of an element can be decreased
+ * in O(log_D n) time (decrease-key).
+ *
+ * The default arity is 4: a 4-ary heap is shallower than a binary heap and the
+ * children of a node are contiguous in memory, hence it is usually faster for
+ * algorithms (like Dijkstra) that perform many decrease-key operations.
+ *
+ * The comparator C defines the order of the keys: the top of the heap is the
+ * element with the minimum key.
+ */
+template <class K, unsigned int D = 4, class C = std::less<K>>
+class IndexedHeap
+{
+
+    static_assert(D >= 2, "The arity of a heap must be at least 2.");
+
+public:
+
+    /* Public const */
+
+    static constexpr size_t NOT_IN_HEAP = std::numeric_limits<size_t>::max();
+
+
+    /* Constructors */
+
+    explicit IndexedHeap(
+            const size_t capacity = 0,
+            const C& comparator = C());
+
+
+    /* Public methods */
+
+    void resize(const size_t capacity);
+    inline size_t capacity() const;
+
+    inline size_t size() const;
+    inline bool empty() const;
+
+    inline bool contains(const size_t index) const;
+    inline const K& getKey(const size_t index) const;
+
+    inline void push(const size_t index, const K& key);
+    inline void decreaseKey(const size_t index, const K& key);
+
+    inline size_t top() const;
+    inline const K& topKey() const;
+    inline size_t pop();
+
+    void clear();
+
+
+private:
+
+    /* Private methods */
+
+    inline void siftUp(size_t pos);
+    inline void siftDown(size_t pos);
+
+    inline void place(const size_t pos, const std::pair<K, size_t>& element);
+
+
+    /* Fields */
+
+    std::vector<std::pair<K, size_t>> heap; //Pairs key-index in heap order
+    std::vector<size_t> positions; //Position in the heap of each index
+
+    C comparator;
+
+};
+
+}
+
+#include "indexed_heap.tpp"
+
+#endif // CG3_INDEXED_HEAP_H
@@ -0,0 +1,269 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "indexed_heap.h"
+
+#include "assert.h"
+
+namespace cg3 {
+
+/* ----- CONST ----- */
+
+template <class K, unsigned int D, class C>
+constexpr size_t IndexedHeap<K, D, C>::NOT_IN_HEAP;
+
+
+/* ----- CONSTRUCTORS ----- */
+
+/**
+ * @brief Constructor, it creates an empty heap
+ * @param[in] capacity Number of indices that can be inserted in the heap
+ * @param[in] comparator Comparator of the keys
+ */
+template <class K, unsigned int D, class C>
+IndexedHeap<K, D, C>::IndexedHeap(
+        const size_t capacity,
+        const C& comparator) :
+    positions(capacity, NOT_IN_HEAP),
+    comparator(comparator)
+{
+
+}
+
+
+
+/* ----- PUBLIC METHODS ----- */
+
+/**
+ * @brief Set the number of indices that can be inserted in the heap.
+ * The heap is cleared.
+ * @param[in] capacity Number of indices
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::resize(const size_t capacity)
+{
+    heap.clear();
+    positions.assign(capacity, NOT_IN_HEAP);
+}
+
+/**
+ * @brief Get the number of indices that can be inserted in the heap
+ * @return Capacity of the heap
+ */
+template <class K, unsigned int D, class C>
+size_t IndexedHeap<K, D, C>::capacity() const
+{
+    return positions.size();
+}
+
+/**
+ * @brief Get the number of elements in the heap
+ * @return Size of the heap
+ */
+template <class K, unsigned int D, class C>
+size_t IndexedHeap<K, D, C>::size() const
+{
+    return heap.size();
+}
+
+/**
+ * @brief Check if the heap is empty
+ * @return True if the heap is empty
+ */
+template <class K, unsigned int D, class C>
+bool IndexedHeap<K, D, C>::empty() const
+{
+    return heap.empty();
+}
+
+/**
+ * @brief Check if an index is in the heap
+ * @param[in] index Input index
+ * @return True if the index is in the heap
+ */
+template <class K, unsigned int D, class C>
+bool IndexedHeap<K, D, C>::contains(const size_t index) const
+{
+    return positions[index] != NOT_IN_HEAP;
+}
+
+/**
+ * @brief Get the key of an index in the heap
+ * @param[in] index Input index (it must be in the heap)
+ * @return Key of the index
+ */
+template <class K, unsigned int D, class C>
+const K& IndexedHeap<K, D, C>::getKey(const size_t index) const
+{
+    assert(contains(index));
+    return heap[positions[index]].first;
+}
+
+/**
+ * @brief Insert an index in the heap, in O(log_D n) time
+ * @param[in] index Input index (it must not be in the heap)
+ * @param[in] key Key of the index
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::push(const size_t index, const K& key)
+{
+    assert(!contains(index));
+
+    positions[index] = heap.size();
+    heap.push_back(std::make_pair(key, index));
+
+    siftUp(heap.size() - 1);
+}
+
+/**
+ * @brief Decrease the key of an index in the heap, in O(log_D n) time
+ * @param[in] index Input index (it must be in the heap)
+ * @param[in] key New key, not greater than the current one
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::decreaseKey(const size_t index, const K& key)
+{
+    assert(contains(index));
+    assert(!comparator(heap[positions[index]].first, key));
+
+    size_t pos = positions[index];
+    heap[pos].first = key;
+
+    siftUp(pos);
+}
+
+/**
+ * @brief Get the index with the minimum key
+ * @return Top index of the heap (the heap must not be empty)
+ */
+template <class K, unsigned int D, class C>
+size_t IndexedHeap<K, D, C>::top() const
+{
+    assert(!empty());
+    return heap.front().second;
+}
+
+/**
+ * @brief Get the minimum key
+ * @return Key of the top index of the heap (the heap must not be empty)
+ */
+template <class K, unsigned int D, class C>
+const K& IndexedHeap<K, D, C>::topKey() const
+{
+    assert(!empty());
+    return heap.front().first;
+}
+
+/**
+ * @brief Remove the index with the minimum key, in O(D log_D n) time
+ * @return Removed index (the heap must not be empty)
+ */
+template <class K, unsigned int D, class C>
+size_t IndexedHeap<K, D, C>::pop()
+{
+    assert(!empty());
+
+    size_t index = heap.front().second;
+    positions[index] = NOT_IN_HEAP;
+
+    if (heap.size() > 1) {
+        place(0, heap.back());
+        heap.pop_back();
+
+        siftDown(0);
+    }
+    else {
+        heap.pop_back();
+    }
+
+    return index;
+}
+
+/**
+ * @brief Remove all the elements of the heap, in O(size()) time.
+ * The capacity is not changed.
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::clear()
+{
+    for (const std::pair<K, size_t>& element : heap)
+        positions[element.second] = NOT_IN_HEAP;
+
+    heap.clear();
+}
+
+
+
+/* ----- PRIVATE METHODS ----- */
+
+/**
+ * @brief Move up an element until the heap property is restored
+ * @param[in] pos Position of the element
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::siftUp(size_t pos)
+{
+    std::pair<K, size_t> element = heap[pos];
+
+    while (pos > 0) {
+        size_t parentPos = (pos - 1) / D;
+
+        if (!comparator(element.first, heap[parentPos].first))
+            break;
+
+        place(pos, heap[parentPos]);
+        pos = parentPos;
+    }
+
+    place(pos, element);
+}
+
+/**
+ * @brief Move down an element until the heap property is restored
+ * @param[in] pos Position of the element
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::siftDown(size_t pos)
+{
+    std::pair<K, size_t> element = heap[pos];
+    size_t heapSize = heap.size();
+
+    while (true) {
+        size_t firstChild = pos * D + 1;
+        if (firstChild >= heapSize)
+            break;
+
+        size_t lastChild = firstChild + D < heapSize ? firstChild + D : heapSize;
+
+        //Get the child with the minimum key
+        size_t minPos = firstChild;
+        for (size_t childPos = firstChild + 1; childPos < lastChild; childPos++) {
+            if (comparator(heap[childPos].first, heap[minPos].first))
+                minPos = childPos;
+        }
+
+        if (!comparator(heap[minPos].first, element.first))
+            break;
+
+        place(pos, heap[minPos]);
+        pos = minPos;
+    }
+
+    place(pos, element);
+}
+
+/**
+ * @brief Place an element in a position of the heap, updating
+ * the position of its index
+ * @param[in] pos Position
+ * @param[in] element Pair key-index
+ */
+template <class K, unsigned int D, class C>
+void IndexedHeap<K, D, C>::place(const size_t pos, const std::pair<K, size_t>& element)
+{
+    heap[pos] = element;
+    positions[element.second] = pos;
+}
+
+}
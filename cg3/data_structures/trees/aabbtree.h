@@ -18,22 +18,22 @@
 #include "includes/iterators/tree_rangebased_iterators.h"
 
 #include "includes/nodes/aabb_node.h"
+#include "includes/tree_node_pool.h"
 
 namespace cg3 {
 
-/* Types */
-
-enum AABBValueType { MIN, MAX };
-
-
 /**
  * @brief An autobalancing (AVL) AABB tree
  *
  * No duplicates are allowed. It has been implemented as
  * a FAT AABB tree: the AABB of each node is the AABB
  * containing the entire childhood AABBs.
+ *
+ * The AABB value extractor (E) and the comparator (C) can be function
+ * pointers or any other callable type (functors or lambdas): with stateless
+ * functors the calls are inlined in the tree algorithms.
  */
-template <int D, class K, class T = K, class C = DefaultComparatorType<K>>
+template <int D, class K, class T = K, class C = DefaultComparatorType<K>, class E = AABBValueExtractorFunction<K>>
 class AABBTree
 {
 
@@ -43,43 +43,43 @@ public:
 
     using KeyOverlapChecker = bool (*)(const K& key1, const K& key2);
 
-    using AABBValueExtractor = double (*)(const K& key, const AABBValueType& valueType, const int& dim);
+    using AABBValueExtractor = E;
 
 
     /* Typedefs */
 
     typedef internal::AABBNode<D,K,T> Node;
 
-    typedef TreeGenericIterator<AABBTree<D,K,T,C>, Node> generic_iterator;
+    typedef TreeGenericIterator<AABBTree<D,K,T,C,E>, Node> generic_iterator;
 
-    typedef TreeIterator<AABBTree<D,K,T,C>, Node, T> iterator;
-    typedef TreeIterator<AABBTree<D,K,T,C>, Node, const T> const_iterator;
+    typedef TreeIterator<AABBTree<D,K,T,C,E>, Node, T> iterator;
+    typedef TreeIterator<AABBTree<D,K,T,C,E>, Node, const T> const_iterator;
 
-    typedef TreeReverseIterator<AABBTree<D,K,T,C>, Node, T> reverse_iterator;
-    typedef TreeReverseIterator<AABBTree<D,K,T,C>, Node, const T> const_reverse_iterator;
+    typedef TreeReverseIterator<AABBTree<D,K,T,C,E>, Node, T> reverse_iterator;
+    typedef TreeReverseIterator<AABBTree<D,K,T,C,E>, Node, const T> const_reverse_iterator;
 
-    typedef TreeInsertIterator<AABBTree<D,K,T,C>, K> insert_iterator;
+    typedef TreeInsertIterator<AABBTree<D,K,T,C,E>, K> insert_iterator;
 
-    typedef TreeRangeBasedIterator<AABBTree<D,K,T,C>> RangeBasedIterator;
-    typedef TreeRangeBasedConstIterator<AABBTree<D,K,T,C>> RangeBasedConstIterator;
-    typedef TreeRangeBasedReverseIterator<AABBTree<D,K,T,C>> RangeBasedReverseIterator;
-    typedef TreeRangeBasedConstReverseIterator<AABBTree<D,K,T,C>> RangeBasedConstReverseIterator;
+    typedef TreeRangeBasedIterator<AABBTree<D,K,T,C,E>> RangeBasedIterator;
+    typedef TreeRangeBasedConstIterator<AABBTree<D,K,T,C,E>> RangeBasedConstIterator;
+    typedef TreeRangeBasedReverseIterator<AABBTree<D,K,T,C,E>> RangeBasedReverseIterator;
+    typedef TreeRangeBasedConstReverseIterator<AABBTree<D,K,T,C,E>> RangeBasedConstReverseIterator;
 
 
 
     /* Constructors/destructor */
 
-    explicit AABBTree(const AABBValueExtractor customAABBExtractor,
-             const C& customComparator = &internal::defaultComparator<K>);
+    explicit AABBTree(const AABBValueExtractor& customAABBExtractor,
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit AABBTree(const std::vector<std::pair<K,T>>& vec,
-             const AABBValueExtractor customAABBExtractor,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const AABBValueExtractor& customAABBExtractor,
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit AABBTree(const std::vector<K>& vec,
-             const AABBValueExtractor customAABBExtractor,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const AABBValueExtractor& customAABBExtractor,
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
 
-    AABBTree(const AABBTree<D,K,T,C>& bst);
-    AABBTree(AABBTree<D,K,T,C>&& bst);
+    AABBTree(const AABBTree<D,K,T,C,E>& bst);
+    AABBTree(AABBTree<D,K,T,C,E>&& bst);
 
     ~AABBTree();
 
@@ -112,15 +112,16 @@ public:
             const K& start, const K& end,
             OutputIterator out);
 
-    template <class OutputIterator>
+    template <class OutputIterator, class F = KeyOverlapChecker>
     void aabbOverlapQuery(
             const K& key,
             OutputIterator out,
-            KeyOverlapChecker keyOverlapChecker = nullptr);
+            const F& keyOverlapChecker = nullptr);
 
+    template <class F = KeyOverlapChecker>
     bool aabbOverlapCheck(
             const K& key,
-            KeyOverlapChecker keyOverlapChecker = nullptr);
+            const F& keyOverlapChecker = nullptr);
 
 
     /* Iterator Min/Max Next/Prev */
@@ -157,8 +158,8 @@ public:
 
     /* Swap function and assignment */
 
-    inline AABBTree<D,K,T,C>& operator= (AABBTree<D,K,T,C> bst);
-    inline void swap(AABBTree<D,K,T,C>& bst);
+    inline AABBTree<D,K,T,C,E>& operator= (AABBTree<D,K,T,C,E> bst);
+    inline void swap(AABBTree<D,K,T,C,E>& bst);
 
 
 protected:
@@ -173,6 +174,8 @@ protected:
 
     AABBValueExtractor aabbValueExtractor;
 
+    internal::TreeNodePool<Node,T> nodePool;
+
 
     /* Protected methods */
 
@@ -181,41 +184,43 @@ protected:
 
     /* AABB helpers */
 
+    template <class F>
     inline void aabbOverlapQueryHelper(
             Node* node,
             const K& key,
             const typename Node::AABB& aabb,
             std::vector<Node*> &out,
-            KeyOverlapChecker keyOverlapChecker);
+            const F& keyOverlapChecker);
 
+    template <class F>
     inline bool aabbOverlapCheckHelper(
             Node* node,
             const K& key,
             const typename Node::AABB& aabb,
-            KeyOverlapChecker keyOverlapChecker);
+            const F& keyOverlapChecker);
 
     inline void updateAABBHelper(
             Node* node,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
 
     /* AVL helpers for AABB */
 
     inline void rebalanceAABBHelper(
             Node* node,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
     inline void updateHeightAndRebalanceAABBHelper(
             Node* node,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
     inline Node* leftRotateAABBHelper(
             Node* a,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
     inline Node* rightRotateAABBHelper(
             Node* a,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
 
 
@@ -228,12 +233,12 @@ protected:
     inline void setAABBFromKeyHelper(
             const K& k,
             typename Node::AABB& aabb,
-            AABBValueExtractor aabbValueExtractor);
+            const AABBValueExtractor& aabbValueExtractor);
 
 };
 
-template <int D, class K, class T, class C>
-void swap(AABBTree<D,K,T,C>& b1, AABBTree<D,K,T,C>& b2);
+template <int D, class K, class T, class C, class E>
+void swap(AABBTree<D,K,T,C,E>& b1, AABBTree<D,K,T,C,E>& b2);
 
 }
 
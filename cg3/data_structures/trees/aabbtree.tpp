@@ -28,9 +28,9 @@ namespace cg3 {
  * @param[in] customComparator Custom comparator to be used to compare if a key
  * is less than another one. The default comparator is the < operator
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::AABBTree(
-        const AABBValueExtractor customAABBValueExtractor,
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::AABBTree(
+        const AABBValueExtractor& customAABBValueExtractor,
         const C& customComparator) :
     comparator(customComparator),
     aabbValueExtractor(customAABBValueExtractor)
@@ -47,10 +47,10 @@ AABBTree<D,K,T,C>::AABBTree(
  * @param[in] customComparator Custom comparator to be used to compare if a key
  * is less than another one. The default comparator is the < operator
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::AABBTree(
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::AABBTree(
         const std::vector<std::pair<K,T>>& vec,
-        const AABBValueExtractor customAABBValueExtractor,
+        const AABBValueExtractor& customAABBValueExtractor,
         const C& customComparator) :
     comparator(customComparator),
     aabbValueExtractor(customAABBValueExtractor)
@@ -69,10 +69,10 @@ AABBTree<D,K,T,C>::AABBTree(
  * @param[in] customComparator Custom comparator to be used to compare if a key
  * is less than another one. The default comparator is the < operator
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::AABBTree(
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::AABBTree(
         const std::vector<K>& vec,
-        const AABBValueExtractor customAABBValueExtractor,
+        const AABBValueExtractor& customAABBValueExtractor,
         const C& customComparator) :
     comparator(customComparator),
     aabbValueExtractor(customAABBValueExtractor)
@@ -85,12 +85,12 @@ AABBTree<D,K,T,C>::AABBTree(
  * @brief Copy constructor
  * @param bst BST
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::AABBTree(const AABBTree<D,K,T,C>& bst) :
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::AABBTree(const AABBTree<D,K,T,C,E>& bst) :
     comparator(bst.comparator),
     aabbValueExtractor(bst.aabbValueExtractor)
 {
-    this->root = internal::copySubtreeHelper<Node,T>(bst.root);
+    this->root = internal::copySubtreeHelper(bst.root, nodePool);
     this->entries = bst.entries;
 }
 
@@ -98,10 +98,11 @@ AABBTree<D,K,T,C>::AABBTree(const AABBTree<D,K,T,C>& bst) :
  * @brief Move constructor
  * @param bst BST
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::AABBTree(AABBTree<D,K,T,C>&& bst) :
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::AABBTree(AABBTree<D,K,T,C,E>&& bst) :
     comparator(bst.comparator),
-    aabbValueExtractor(bst.aabbValueExtractor)
+    aabbValueExtractor(bst.aabbValueExtractor),
+    nodePool(std::move(bst.nodePool))
 {
     this->root = bst.root;
     bst.root = nullptr;
@@ -111,8 +112,8 @@ AABBTree<D,K,T,C>::AABBTree(AABBTree<D,K,T,C>&& bst) :
 /**
  * @brief Destructor
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>::~AABBTree()
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>::~AABBTree()
 {
     this->clear();
 }
@@ -132,8 +133,8 @@ AABBTree<D,K,T,C>::~AABBTree()
  *
  * @param[in] vec Vector of values
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::construction(const std::vector<K>& vec)
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::construction(const std::vector<K>& vec)
 {
     std::vector<std::pair<K,T>> pairVec;
 
@@ -152,8 +153,8 @@ void AABBTree<D,K,T,C>::construction(const std::vector<K>& vec)
  *
  * @param[in] vec Vector of pairs of keys/values
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::construction(const std::vector<std::pair<K,T>>& vec)
 {
     this->clear();
 
@@ -163,13 +164,14 @@ void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
+    nodePool.reserve(2*sortedVec.size()-1, sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool.create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -177,6 +179,7 @@ void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
+                nodePool,
                 comparator);
 
     //Update the height of nodes and create their AABBs
@@ -201,8 +204,8 @@ void AABBTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
  * @return The iterator pointing to the node if it has been
  * successfully inserted, end iterator otherwise
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::insert(const K& key)
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::insert(const K& key)
 {
     return insert(key, key);
 }
@@ -218,15 +221,15 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::insert(const K& key)
  * @return The iterator pointing to the node if it has been
  * successfully inserted, end iterator otherwise
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::insert(
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool.create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
@@ -258,8 +261,8 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::insert(
  * @param[in] key Key of the node
  * @return True if item has been found and then erased, false otherwise
  */
-template <int D, class K, class T, class C>
-bool AABBTree<D,K,T,C>::erase(const K& key)
+template <int D, class K, class T, class C, class E>
+bool AABBTree<D,K,T,C,E>::erase(const K& key)
 {
     //Query the BST to find the node
     Node* node = internal::findNodeHelperLeaf(key, this->root, comparator);
@@ -267,7 +270,7 @@ bool AABBTree<D,K,T,C>::erase(const K& key)
     //If the node has been found
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, nodePool);
 
         //Update height and rebalance
         this->updateHeightAndRebalanceAABBHelper(replacingNode, aabbValueExtractor);
@@ -289,8 +292,8 @@ bool AABBTree<D,K,T,C>::erase(const K& key)
  *
  * @param[in] it A generic iterator pointing to the node to be erased
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::erase(generic_iterator it)
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::erase(generic_iterator it)
 {
     //Throw exception if the iterator does not belong to this BST
     if (it.bst != this) {
@@ -303,7 +306,7 @@ void AABBTree<D,K,T,C>::erase(generic_iterator it)
 
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, nodePool);
 
         //Update height and rebalance
         this->updateHeightAndRebalanceAABBHelper(replacingNode, aabbValueExtractor);
@@ -325,8 +328,8 @@ void AABBTree<D,K,T,C>::erase(generic_iterator it)
  * @return The iterator pointing to the BST node if the element
  * is contained in the BST, end iterator otherwise
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::find(const K& key)
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::find(const K& key)
 {
     //Query the BST to find the node
     Node* node = internal::findNodeHelperLeaf(key, this->root, comparator);
@@ -342,11 +345,11 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::find(const K& key)
  * @brief Clear the tree, delete all its elements
  *
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::clear()
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::clear()
 {
     //Clear entire tree
-    internal::clearHelper(this->root);
+    nodePool.clear(this->root);
 
     //Decreasing entries
     this->entries = 0;
@@ -360,8 +363,8 @@ void AABBTree<D,K,T,C>::clear()
  *
  * @return Number of entries in the BST
  */
-template <int D, class K, class T, class C>
-TreeSize AABBTree<D,K,T,C>::size()
+template <int D, class K, class T, class C, class E>
+TreeSize AABBTree<D,K,T,C,E>::size()
 {
     return this->entries;
 }
@@ -371,8 +374,8 @@ TreeSize AABBTree<D,K,T,C>::size()
  *
  * @return True if the BST is empty, false otherwise
  */
-template <int D, class K, class T, class C>
-bool AABBTree<D,K,T,C>::empty()
+template <int D, class K, class T, class C, class E>
+bool AABBTree<D,K,T,C,E>::empty()
 {
     return (this->size() == 0);
 }
@@ -384,8 +387,8 @@ bool AABBTree<D,K,T,C>::empty()
  *
  * @return Max height of the tree
  */
-template <int D, class K, class T, class C>
-TreeSize AABBTree<D,K,T,C>::getHeight()
+template <int D, class K, class T, class C, class E>
+TreeSize AABBTree<D,K,T,C,E>::getHeight()
 {
     return internal::getHeightHelper(this->root);
 }
@@ -401,8 +404,8 @@ TreeSize AABBTree<D,K,T,C>::getHeight()
  * @param[out] out Output iterator for the container containing the iterators
  * pointing to the nodes which have keys enclosed in the input range
  */
-template <int D, class K, class T, class C> template <class OutputIterator>
-void AABBTree<D,K,T,C>::rangeQuery(
+template <int D, class K, class T, class C, class E> template <class OutputIterator>
+void AABBTree<D,K,T,C,E>::rangeQuery(
         const K& start, const K& end,
         OutputIterator out)
 {
@@ -425,11 +428,11 @@ void AABBTree<D,K,T,C>::rangeQuery(
  * @param[in] key Input key
  * @param[out] out Vector of iterators pointing to elements that overlap
  */
-template <int D, class K, class T, class C> template <class OutputIterator>
-void AABBTree<D,K,T,C>::aabbOverlapQuery(
+template <int D, class K, class T, class C, class E> template <class OutputIterator, class F>
+void AABBTree<D,K,T,C,E>::aabbOverlapQuery(
         const K& key,
         OutputIterator out,
-        KeyOverlapChecker keyOverlapChecker)
+        const F& keyOverlapChecker)
 {
     //Get the AABB
     typename Node::AABB aabb;
@@ -453,10 +456,10 @@ void AABBTree<D,K,T,C>::aabbOverlapQuery(
  * @param[in] key Input key
  * @return True if there is an overlapping bounding box in the stored values
  */
-template <int D, class K, class T, class C>
-bool AABBTree<D,K,T,C>::aabbOverlapCheck(
+template <int D, class K, class T, class C, class E> template <class F>
+bool AABBTree<D,K,T,C,E>::aabbOverlapCheck(
         const K& key,
-        KeyOverlapChecker keyOverlapChecker)
+        const F& keyOverlapChecker)
 {
     //Get the AABB
     typename Node::AABB aabb;
@@ -477,8 +480,8 @@ bool AABBTree<D,K,T,C>::aabbOverlapCheck(
  *
  * @return The iterator pointing to the minimum node
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::getMin()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::getMin()
 {
     return iterator(this, internal::getMinimumHelperLeaf(this->root));
 }
@@ -488,8 +491,8 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::getMin()
  *
  * @return The iterator pointing to the maximum node
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::getMax()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::getMax()
 {
     return iterator(this, internal::getMaximumHelperLeaf(this->root));
 }
@@ -503,8 +506,8 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::getMax()
  * @return The iterator pointing to the successor node (end
  * iterator if it has no successor)
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::generic_iterator AABBTree<D,K,T,C>::getNext(generic_iterator it)
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::generic_iterator AABBTree<D,K,T,C,E>::getNext(generic_iterator it)
 {
     //Throw exception if the iterator does not belong to this BST
     if (it.bst != this) {
@@ -520,8 +523,8 @@ typename AABBTree<D,K,T,C>::generic_iterator AABBTree<D,K,T,C>::getNext(generic_
  * @return The iterator pointing to the predecessor node (end
  * iterator if it has no predecessor)
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::generic_iterator AABBTree<D,K,T,C>::getPrev(generic_iterator it)
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::generic_iterator AABBTree<D,K,T,C,E>::getPrev(generic_iterator it)
 {
     //Throw exception if the iterator does not belong to this BST
     if (it.bst != this) {
@@ -537,8 +540,8 @@ typename AABBTree<D,K,T,C>::generic_iterator AABBTree<D,K,T,C>::getPrev(generic_
 /**
  * @brief Begin iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::begin()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::begin()
 {
     return iterator(this, internal::getMinimumHelperLeaf(this->root));
 }
@@ -546,8 +549,8 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::begin()
 /**
  * @brief End iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::end()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::iterator AABBTree<D,K,T,C,E>::end()
 {
     return iterator(this, nullptr);
 }
@@ -556,8 +559,8 @@ typename AABBTree<D,K,T,C>::iterator AABBTree<D,K,T,C>::end()
 /**
  * @brief Begin const iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::const_iterator AABBTree<D,K,T,C>::cbegin()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::const_iterator AABBTree<D,K,T,C,E>::cbegin()
 {
     return const_iterator(this, internal::getMinimumHelperLeaf(this->root));
 }
@@ -565,8 +568,8 @@ typename AABBTree<D,K,T,C>::const_iterator AABBTree<D,K,T,C>::cbegin()
 /**
  * @brief End const iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::const_iterator AABBTree<D,K,T,C>::cend()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::const_iterator AABBTree<D,K,T,C,E>::cend()
 {
     return const_iterator(this, nullptr);
 }
@@ -575,8 +578,8 @@ typename AABBTree<D,K,T,C>::const_iterator AABBTree<D,K,T,C>::cend()
 /**
  * @brief Begin reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::reverse_iterator AABBTree<D,K,T,C>::rbegin()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::reverse_iterator AABBTree<D,K,T,C,E>::rbegin()
 {
     return reverse_iterator(this, internal::getMaximumHelperLeaf(this->root));
 }
@@ -584,8 +587,8 @@ typename AABBTree<D,K,T,C>::reverse_iterator AABBTree<D,K,T,C>::rbegin()
 /**
  * @brief End reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::reverse_iterator AABBTree<D,K,T,C>::rend()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::reverse_iterator AABBTree<D,K,T,C,E>::rend()
 {
     return reverse_iterator(this, nullptr);
 }
@@ -594,8 +597,8 @@ typename AABBTree<D,K,T,C>::reverse_iterator AABBTree<D,K,T,C>::rend()
 /**
  * @brief Begin const reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::const_reverse_iterator AABBTree<D,K,T,C>::crbegin()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::const_reverse_iterator AABBTree<D,K,T,C,E>::crbegin()
 {
     return const_reverse_iterator(this, internal::getMaximumHelperLeaf(this->root));
 }
@@ -603,8 +606,8 @@ typename AABBTree<D,K,T,C>::const_reverse_iterator AABBTree<D,K,T,C>::crbegin()
 /**
  * @brief End const reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::const_reverse_iterator AABBTree<D,K,T,C>::crend()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::const_reverse_iterator AABBTree<D,K,T,C,E>::crend()
 {
     return const_reverse_iterator(this, nullptr);
 }
@@ -614,8 +617,8 @@ typename AABBTree<D,K,T,C>::const_reverse_iterator AABBTree<D,K,T,C>::crend()
 /**
  * @brief Insert output iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::insert_iterator AABBTree<D,K,T,C>::inserter()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::insert_iterator AABBTree<D,K,T,C,E>::inserter()
 {
     return insert_iterator(this);
 }
@@ -627,8 +630,8 @@ typename AABBTree<D,K,T,C>::insert_iterator AABBTree<D,K,T,C>::inserter()
  *
  * @return Range based iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::RangeBasedIterator AABBTree<D,K,T,C>::getIterator()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::RangeBasedIterator AABBTree<D,K,T,C,E>::getIterator()
 {
     return RangeBasedIterator(this);
 }
@@ -638,8 +641,8 @@ typename AABBTree<D,K,T,C>::RangeBasedIterator AABBTree<D,K,T,C>::getIterator()
  *
  * @return Range based const iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::RangeBasedConstIterator AABBTree<D,K,T,C>::getConstIterator()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::RangeBasedConstIterator AABBTree<D,K,T,C,E>::getConstIterator()
 {
     return RangeBasedConstIterator(this);
 }
@@ -649,8 +652,8 @@ typename AABBTree<D,K,T,C>::RangeBasedConstIterator AABBTree<D,K,T,C>::getConstI
  *
  * @return Range based reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::RangeBasedReverseIterator AABBTree<D,K,T,C>::getReverseIterator()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::RangeBasedReverseIterator AABBTree<D,K,T,C,E>::getReverseIterator()
 {
     return RangeBasedReverseIterator(this);
 }
@@ -660,8 +663,8 @@ typename AABBTree<D,K,T,C>::RangeBasedReverseIterator AABBTree<D,K,T,C>::getReve
  *
  * @return Range based const reverse iterator
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::RangeBasedConstReverseIterator AABBTree<D,K,T,C>::getConstReverseIterator()
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::RangeBasedConstReverseIterator AABBTree<D,K,T,C,E>::getConstReverseIterator()
 {
     return RangeBasedConstReverseIterator(this);
 }
@@ -674,8 +677,8 @@ typename AABBTree<D,K,T,C>::RangeBasedConstReverseIterator AABBTree<D,K,T,C>::ge
  * @param[out] bst Parameter BST
  * @return This object
  */
-template <int D, class K, class T, class C>
-AABBTree<D,K,T,C>& AABBTree<D,K,T,C>::operator= (AABBTree<D,K,T,C> bst)
+template <int D, class K, class T, class C, class E>
+AABBTree<D,K,T,C,E>& AABBTree<D,K,T,C,E>::operator= (AABBTree<D,K,T,C,E> bst)
 {
     swap(bst);
     return *this;
@@ -686,14 +689,15 @@ AABBTree<D,K,T,C>& AABBTree<D,K,T,C>::operator= (AABBTree<D,K,T,C> bst)
  * @brief Swap BST with another one
  * @param[out] bst BST to be swapped with this object
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::swap(AABBTree<D,K,T,C>& bst)
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::swap(AABBTree<D,K,T,C,E>& bst)
 {
     using std::swap;
     swap(this->root, bst.root);
     swap(this->entries, bst.entries);
     swap(this->comparator, bst.comparator);
     swap(this->aabbValueExtractor, bst.aabbValueExtractor);
+    this->nodePool.swap(bst.nodePool);
 }
 
 
@@ -702,8 +706,8 @@ void AABBTree<D,K,T,C>::swap(AABBTree<D,K,T,C>& bst)
  * @param b1 First BST
  * @param b2 Second BST
  */
-template <int D, class K, class T, class C>
-void swap(AABBTree<D,K,T,C>& b1, AABBTree<D,K,T,C>& b2)
+template <int D, class K, class T, class C, class E>
+void swap(AABBTree<D,K,T,C,E>& b1, AABBTree<D,K,T,C,E>& b2)
 {
     b1.swap(b2);
 }
@@ -714,8 +718,8 @@ void swap(AABBTree<D,K,T,C>& b1, AABBTree<D,K,T,C>& b2)
 /**
  * @brief Initialization of the BST
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::initialize()
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::initialize()
 {
     this->root = nullptr;
     this->entries = 0;
@@ -736,13 +740,13 @@ void AABBTree<D,K,T,C>::initialize()
  * @param[out] out Vector of iterators pointing to elements that overlap
  * @param[in] keyOverlapChecker Key overlap filter function
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::aabbOverlapQueryHelper(
+template <int D, class K, class T, class C, class E> template <class F>
+void AABBTree<D,K,T,C,E>::aabbOverlapQueryHelper(
         Node* node,
         const K& key,
         const typename Node::AABB& aabb,
         std::vector<Node*> &out,
-        KeyOverlapChecker keyOverlapChecker)
+        const F& keyOverlapChecker)
 {
     if (node == nullptr)
         return;
@@ -750,7 +754,7 @@ void AABBTree<D,K,T,C>::aabbOverlapQueryHelper(
     //If node is a leaf, then return the node if its bounding box is overlapping
     if (node->isLeaf()) {
         if (aabbOverlapsHelper(aabb, node->aabb)) {
-            if (keyOverlapChecker == nullptr || keyOverlapChecker(key, node->key)) {
+            if (internal::checkKeyOverlap(key, node->key, keyOverlapChecker)) {
                 out.push_back(node);
             }
         }
@@ -778,12 +782,12 @@ void AABBTree<D,K,T,C>::aabbOverlapQueryHelper(
  * @param[in] keyOverlapChecker Key overlap filter function
  * @return True if there is an overlapping bounding box in the stored values
  */
-template <int D, class K, class T, class C>
-bool AABBTree<D,K,T,C>::aabbOverlapCheckHelper(
+template <int D, class K, class T, class C, class E> template <class F>
+bool AABBTree<D,K,T,C,E>::aabbOverlapCheckHelper(
         Node* node,
         const K& key,
         const typename Node::AABB& aabb,
-        KeyOverlapChecker keyOverlapChecker)
+        const F& keyOverlapChecker)
 {
     if (node == nullptr)
         return false;
@@ -791,7 +795,7 @@ bool AABBTree<D,K,T,C>::aabbOverlapCheckHelper(
     //If node is a leaf, then return the node if its bounding box is overlapping
     if (node->isLeaf()) {
         if (aabbOverlapsHelper(aabb, node->aabb)) {
-            if (keyOverlapChecker == nullptr || keyOverlapChecker(key, node->key)) {
+            if (internal::checkKeyOverlap(key, node->key, keyOverlapChecker)) {
                 return true;
             }
         }
@@ -819,10 +823,10 @@ bool AABBTree<D,K,T,C>::aabbOverlapCheckHelper(
  * @param[in] node Starting node
  * @param[in] aabbValueExtractor AABB extractor for key
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::updateAABBHelper(
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::updateAABBHelper(
         Node* node,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     if (node != nullptr) {
         bool done;
@@ -878,10 +882,10 @@ void AABBTree<D,K,T,C>::updateAABBHelper(
  * @param[in] node Starting node
  * @param[in] aabbValueExtractor AABB extractor for key
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::rebalanceAABBHelper(
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::rebalanceAABBHelper(
         Node* node,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     //Null handler
     if (node == nullptr)
@@ -959,10 +963,10 @@ void AABBTree<D,K,T,C>::rebalanceAABBHelper(
  * @param[in] node Root node of the BST
  * @param[in] aabbValueExtractor AABB extractor for key
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::updateHeightAndRebalanceAABBHelper(
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::updateHeightAndRebalanceAABBHelper(
         Node* node,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     internal::updateHeightHelper(node);
     this->rebalanceAABBHelper(node, aabbValueExtractor);
@@ -977,10 +981,10 @@ void AABBTree<D,K,T,C>::updateHeightAndRebalanceAABBHelper(
  * @param[in] aabbValueExtractor AABB extractor for key
  * @return New node in the position of the original node after the rotation
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::Node* AABBTree<D,K,T,C>::leftRotateAABBHelper(
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::Node* AABBTree<D,K,T,C,E>::leftRotateAABBHelper(
         Node* a,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     //Rotate left
     Node* b = internal::leftRotateHelper(a);
@@ -998,10 +1002,10 @@ typename AABBTree<D,K,T,C>::Node* AABBTree<D,K,T,C>::leftRotateAABBHelper(
  * @param[in] aabbValueExtractor AABB extractor for key
  * @return New node in the position of the original node after the rotation
  */
-template <int D, class K, class T, class C>
-typename AABBTree<D,K,T,C>::Node* AABBTree<D,K,T,C>::rightRotateAABBHelper(
+template <int D, class K, class T, class C, class E>
+typename AABBTree<D,K,T,C,E>::Node* AABBTree<D,K,T,C,E>::rightRotateAABBHelper(
         Node* a,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     //Rotate right
     Node* b = internal::rightRotateHelper(a);
@@ -1025,8 +1029,8 @@ typename AABBTree<D,K,T,C>::Node* AABBTree<D,K,T,C>::rightRotateAABBHelper(
  * @param[in] a Second bounding box
  * @returns True if the bounding boxes overlap, false otherwise
  */
-template <int D, class K, class T, class C>
-bool AABBTree<D,K,T,C>::aabbOverlapsHelper(
+template <int D, class K, class T, class C, class E>
+bool AABBTree<D,K,T,C,E>::aabbOverlapsHelper(
         const typename Node::AABB& a,
         const typename Node::AABB& b)
 {
@@ -1050,11 +1054,11 @@ bool AABBTree<D,K,T,C>::aabbOverlapsHelper(
  * @param[out] a Bounding box to be updated
  * @param[in] aabbValueExtractor AABB extractor for key
  */
-template <int D, class K, class T, class C>
-void AABBTree<D,K,T,C>::setAABBFromKeyHelper(
+template <int D, class K, class T, class C, class E>
+void AABBTree<D,K,T,C,E>::setAABBFromKeyHelper(
         const K& k,
         typename Node::AABB& aabb,
-        AABBValueExtractor aabbValueExtractor)
+        const AABBValueExtractor& aabbValueExtractor)
 {
     for (int i = 0; i < D; i++) {
         aabb.min[i] = aabbValueExtractor(k, MIN, i+1);
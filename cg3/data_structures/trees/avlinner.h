@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <utility>
+#include <memory>
 
 #include "includes/tree_common.h"
 
@@ -18,6 +19,7 @@
 #include "includes/iterators/tree_rangebased_iterators.h"
 
 #include "includes/nodes/avl_node.h"
+#include "includes/tree_node_pool.h"
 
 namespace cg3 {
 
@@ -27,6 +29,9 @@ namespace cg3 {
  * Keys and values are saved in all nodes, not only in the leaves. The implementation
  * is performed following "Introduction to Algorithms" (Cormen, 2011).
  * No duplicates are allowed.
+ * Each node stores the number of entries of its subtree: rank/select queries
+ * and split operations are performed in logarithmic time, join operations
+ * in logarithmic time plus the number of memory blocks of the moved node pool.
  */
 template <class K, class T = K, class C = DefaultComparatorType<K>>
 class AVLInner
@@ -38,6 +43,8 @@ public:
 
     typedef internal::AVLNode<K,T> Node;
 
+    typedef internal::TreeNodePool<Node,T> NodePool;
+
     typedef TreeGenericIterator<AVLInner<K,T,C>, Node> generic_iterator;
 
     typedef TreeIterator<AVLInner<K,T,C>, Node, T> iterator;
@@ -56,11 +63,11 @@ public:
 
     /* Constructors/destructor */
 
-    explicit AVLInner(const C& customComparator = &internal::defaultComparator<K>);
+    explicit AVLInner(const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit AVLInner(const std::vector<std::pair<K,T>>& vec,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit AVLInner(const std::vector<K>& vec,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
 
     AVLInner(const AVLInner<K,T,C>& bst);
     AVLInner(AVLInner<K,T,C>&& bst);
@@ -101,6 +108,20 @@ public:
 
 
 
+    /* Order statistics */
+
+    TreeSize rank(const K& key);
+    iterator select(const TreeSize index);
+
+
+
+    /* Split/join */
+
+    AVLInner<K,T,C> split(const K& key);
+    void join(AVLInner<K,T,C>& other);
+
+
+
     /* Iterator Min/Max Next/Prev */
 
     iterator getMin();
@@ -148,6 +169,8 @@ protected:
 
     C comparator;
 
+    std::shared_ptr<NodePool> nodePool;
+
 
     /* Protected methods */
 
@@ -26,7 +26,8 @@ namespace cg3 {
  */
 template <class K, class T, class C>
 AVLInner<K,T,C>::AVLInner(const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
 }
@@ -42,7 +43,8 @@ template <class K, class T, class C>
 AVLInner<K,T,C>::AVLInner(
         const std::vector<std::pair<K,T>>& vec,
         const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -60,7 +62,8 @@ template <class K, class T, class C>
 AVLInner<K,T,C>::AVLInner(
         const std::vector<K>& vec,
         const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -73,9 +76,10 @@ AVLInner<K,T,C>::AVLInner(
  */
 template <class K, class T, class C>
 AVLInner<K,T,C>::AVLInner(const AVLInner<K,T,C>& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::make_shared<NodePool>())
 {
-    this->root = internal::copySubtreeHelper<Node,T>(bst.root);
+    this->root = internal::copySubtreeHelper(bst.root, *nodePool);
     this->entries = bst.entries;
 }
 
@@ -85,11 +89,13 @@ AVLInner<K,T,C>::AVLInner(const AVLInner<K,T,C>& bst) :
  */
 template <class K, class T, class C>
 AVLInner<K,T,C>::AVLInner(AVLInner<K,T,C>&& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::move(bst.nodePool))
 {
     this->root = bst.root;
     bst.root = nullptr;
     this->entries = bst.entries;
+    bst.nodePool = std::make_shared<NodePool>();
 }
 
 /**
@@ -147,13 +153,23 @@ void AVLInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
+    //Remove duplicates: the medians split the collection in two
+    //halves of the same size, hence the tree is balanced
+    sortedVec.erase(
+                std::unique(sortedVec.begin(), sortedVec.end(),
+                    [this] (const std::pair<K,T>& a, const std::pair<K,T>& b) {
+                        return internal::isEqual(a.first, b.first, this->comparator);
+                    }),
+                sortedVec.end());
+
     //Create nodes
+    nodePool->reserve(sortedVec.size(), sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool->create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -163,6 +179,7 @@ void AVLInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
                 0,
                 sortedNodes.size(),
                 this->root,
+                *nodePool,
                 comparator);
 
     //Update the height of nodes
@@ -171,6 +188,9 @@ void AVLInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
             internal::updateHeightHelper(node);
         }
     }
+
+    //Update the number of entries of the subtrees
+    internal::computeSizeHelper(this->root);
 }
 
 
@@ -205,13 +225,16 @@ typename AVLInner<K,T,C>::iterator AVLInner<K,T,C>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool->create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperInner<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperInner<Node,K,C>(newNode, this->root, *nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(newNode->parent);
+
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(newNode, this->root);
 
@@ -246,7 +269,10 @@ bool AVLInner<K,T,C>::erase(const K& key)
     //If the node has been found
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperInner(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperInner(node, this->root, *nodePool);
+
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(replacingNode);
 
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(replacingNode, this->root);
@@ -279,7 +305,10 @@ void AVLInner<K,T,C>::erase(generic_iterator it)
 
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperInner(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperInner(node, this->root, *nodePool);
+
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(replacingNode);
 
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(replacingNode, this->root);
@@ -354,8 +383,15 @@ typename AVLInner<K,T,C>::iterator AVLInner<K,T,C>::findUpper(const K& key)
 template <class K, class T, class C>
 void AVLInner<K,T,C>::clear()
 {
-    //Clear entire tree
-    internal::clearHelper(this->root);
+    //Clear entire tree: the memory can be released only if the
+    //pool is not shared with other trees (see split)
+    if (nodePool.use_count() == 1) {
+        nodePool->clear(this->root);
+    }
+    else {
+        internal::clearHelper(this->root, *nodePool);
+        nodePool = std::make_shared<NodePool>();
+    }
 
     //Decreasing entries
     this->entries = 0;
@@ -431,6 +467,128 @@ void AVLInner<K,T,C>::rangeQuery(
 
 
 
+/* ----- ORDER STATISTICS ----- */
+
+/**
+ * @brief Get the number of entries in the BST with a key lower than
+ * a given key. If the key is contained in the BST, it is its position
+ * in the order of the keys.
+ *
+ * @param[in] key Input key
+ * @return Number of entries with a lower key
+ */
+template <class K, class T, class C>
+TreeSize AVLInner<K,T,C>::rank(const K& key)
+{
+    return internal::rankHelperInner(key, this->root, comparator);
+}
+
+/**
+ * @brief Get the entry in a given position of the BST, in the
+ * order of the keys
+ *
+ * @param[in] index Position of the entry, starting from 0
+ * @return The iterator pointing to the BST node if the index is
+ * lower than the number of entries, end iterator otherwise
+ */
+template <class K, class T, class C>
+typename AVLInner<K,T,C>::iterator AVLInner<K,T,C>::select(const TreeSize index)
+{
+    return iterator(this, internal::selectHelperInner(index, this->root));
+}
+
+
+
+/* ----- SPLIT/JOIN ----- */
+
+/**
+ * @brief Split the BST: the entries with a key greater than or equal
+ * to a given key are moved in a new BST, while the others remain in
+ * this BST.
+ *
+ * The two BSTs share the pool of their nodes, therefore they must not
+ * be modified concurrently by different threads. The iterators to the
+ * moved entries are not valid anymore.
+ *
+ * @param[in] key Input key
+ * @return The BST of the entries with greater or equal keys
+ */
+template <class K, class T, class C>
+AVLInner<K,T,C> AVLInner<K,T,C>::split(const K& key)
+{
+    AVLInner<K,T,C> greaterTree(comparator);
+
+    //The new tree uses the nodes of this tree
+    greaterTree.nodePool = this->nodePool;
+
+    Node* leftRoot;
+    Node* rightRoot;
+
+    internal::splitHelperInner(key, this->root, leftRoot, rightRoot, comparator);
+
+    this->root = leftRoot;
+    this->entries = internal::getSizeHelper(leftRoot);
+
+    greaterTree.root = rightRoot;
+    greaterTree.entries = internal::getSizeHelper(rightRoot);
+
+    return greaterTree;
+}
+
+/**
+ * @brief Join another BST to this BST: the entries of the other BST are
+ * moved in this BST, and the other BST is left empty.
+ * The keys of the other BST must be all greater (or all lower) than
+ * the keys of this BST.
+ *
+ * The cost is logarithmic in the number of entries, plus the cost of
+ * moving the nodes of the other BST to the pool of this BST (see
+ * internal::joinNodePoolsHelper). The iterators to the moved entries
+ * are not valid anymore.
+ *
+ * @param[out] other BST to be joined
+ */
+template <class K, class T, class C>
+void AVLInner<K,T,C>::join(AVLInner<K,T,C>& other)
+{
+    if (&other == this || other.root == nullptr)
+        return;
+
+    //Check if the keys of the other tree are greater or lower
+    bool otherIsGreater = true;
+    if (this->root != nullptr) {
+        otherIsGreater = internal::isLess(
+                    internal::getMaximumHelperInner(this->root)->key,
+                    internal::getMinimumHelperInner(other.root)->key,
+                    comparator);
+
+        if (!otherIsGreater && !internal::isLess(
+                    internal::getMaximumHelperInner(other.root)->key,
+                    internal::getMinimumHelperInner(this->root)->key,
+                    comparator))
+        {
+            throw new std::runtime_error("The keys of the joined trees cannot overlap.");
+        }
+    }
+
+    //The nodes of the other tree must belong to the pool of this tree
+    internal::joinNodePoolsHelper(this->nodePool, other.nodePool, other.root);
+
+    if (otherIsGreater) {
+        this->root = internal::joinHelperInner(this->root, other.root);
+    }
+    else {
+        this->root = internal::joinHelperInner(other.root, this->root);
+    }
+
+    this->entries += other.entries;
+
+    other.root = nullptr;
+    other.entries = 0;
+}
+
+
+
 /* ----- ITERATOR MIN/MAX NEXT/PREV ----- */
 
 /**
@@ -654,6 +812,7 @@ void AVLInner<K,T,C>::swap(AVLInner<K,T,C>& bst)
     swap(this->root, bst.root);
     swap(this->entries, bst.entries);
     swap(this->comparator, bst.comparator);
+    swap(this->nodePool, bst.nodePool);
 }
 
 
@@ -26,7 +26,8 @@ namespace cg3 {
  */
 template <class K, class T, class C>
 AVLLeaf<K,T,C>::AVLLeaf(const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
 }
@@ -42,7 +43,8 @@ template <class K, class T, class C>
 AVLLeaf<K,T,C>::AVLLeaf(
         const std::vector<std::pair<K,T>>& vec,
         const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -60,7 +62,8 @@ template <class K, class T, class C>
 AVLLeaf<K,T,C>::AVLLeaf(
         const std::vector<K>& vec,
         const C& customComparator) :
-    comparator(customComparator)
+    comparator(customComparator),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -72,9 +75,10 @@ AVLLeaf<K,T,C>::AVLLeaf(
  */
 template <class K, class T, class C>
 AVLLeaf<K,T,C>::AVLLeaf(const AVLLeaf<K,T,C>& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::make_shared<NodePool>())
 {
-    this->root = internal::copySubtreeHelper<Node,T>(bst.root);
+    this->root = internal::copySubtreeHelper(bst.root, *nodePool);
     this->entries = bst.entries;
 }
 
@@ -84,11 +88,13 @@ AVLLeaf<K,T,C>::AVLLeaf(const AVLLeaf<K,T,C>& bst) :
  */
 template <class K, class T, class C>
 AVLLeaf<K,T,C>::AVLLeaf(AVLLeaf<K,T,C>&& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::move(bst.nodePool))
 {
     this->root = bst.root;
     bst.root = nullptr;
     this->entries = bst.entries;
+    bst.nodePool = std::make_shared<NodePool>();
 }
 
 /**
@@ -146,13 +152,14 @@ void AVLLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
+    nodePool->reserve(2*sortedVec.size()-1, sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool->create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -160,6 +167,7 @@ void AVLLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
+                *nodePool,
                 comparator);
 
     //Update the height of nodes
@@ -168,6 +176,9 @@ void AVLLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
             internal::updateHeightHelper(node);
         }
     }
+
+    //Update the number of entries of the subtrees
+    internal::computeSizeHelper(this->root);
 }
 
 
@@ -202,13 +213,16 @@ typename AVLLeaf<K,T,C>::iterator AVLLeaf<K,T,C>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool->create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, *nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(newNode->parent);
+
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(newNode, this->root);
 
@@ -243,7 +257,10 @@ bool AVLLeaf<K,T,C>::erase(const K& key)
     //If the node has been found
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, *nodePool);
+
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(replacingNode);
 
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(replacingNode, this->root);
@@ -276,7 +293,10 @@ void AVLLeaf<K,T,C>::erase(generic_iterator it)
 
     if (node != nullptr) {
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, *nodePool);
+
+        //Update the number of entries of the parents
+        internal::updateSizeHelper(replacingNode);
 
         //Update height and rebalance
         internal::updateHeightAndRebalanceHelper(replacingNode, this->root);
@@ -352,8 +372,15 @@ typename AVLLeaf<K,T,C>::iterator AVLLeaf<K,T,C>::findUpper(const K& key)
 template <class K, class T, class C>
 void AVLLeaf<K,T,C>::clear()
 {
-    //Clear entire tree
-    internal::clearHelper(this->root);
+    //Clear entire tree: the memory can be released only if the
+    //pool is not shared with other trees (see split)
+    if (nodePool.use_count() == 1) {
+        nodePool->clear(this->root);
+    }
+    else {
+        internal::clearHelper(this->root, *nodePool);
+        nodePool = std::make_shared<NodePool>();
+    }
 
     //Decreasing entries
     this->entries = 0;
@@ -427,6 +454,128 @@ void AVLLeaf<K,T,C>::rangeQuery(
 
 
 
+/* ----- ORDER STATISTICS ----- */
+
+/**
+ * @brief Get the number of entries in the BST with a key lower than
+ * a given key. If the key is contained in the BST, it is its position
+ * in the order of the keys.
+ *
+ * @param[in] key Input key
+ * @return Number of entries with a lower key
+ */
+template <class K, class T, class C>
+TreeSize AVLLeaf<K,T,C>::rank(const K& key)
+{
+    return internal::rankHelperLeaf(key, this->root, comparator);
+}
+
+/**
+ * @brief Get the entry in a given position of the BST, in the
+ * order of the keys
+ *
+ * @param[in] index Position of the entry, starting from 0
+ * @return The iterator pointing to the BST node if the index is
+ * lower than the number of entries, end iterator otherwise
+ */
+template <class K, class T, class C>
+typename AVLLeaf<K,T,C>::iterator AVLLeaf<K,T,C>::select(const TreeSize index)
+{
+    return iterator(this, internal::selectHelperLeaf(index, this->root));
+}
+
+
+
+/* ----- SPLIT/JOIN ----- */
+
+/**
+ * @brief Split the BST: the entries with a key greater than or equal
+ * to a given key are moved in a new BST, while the others remain in
+ * this BST.
+ *
+ * The two BSTs share the pool of their nodes, therefore they must not
+ * be modified concurrently by different threads. The iterators to the
+ * moved entries are not valid anymore.
+ *
+ * @param[in] key Input key
+ * @return The BST of the entries with greater or equal keys
+ */
+template <class K, class T, class C>
+AVLLeaf<K,T,C> AVLLeaf<K,T,C>::split(const K& key)
+{
+    AVLLeaf<K,T,C> greaterTree(comparator);
+
+    //The new tree uses the nodes of this tree
+    greaterTree.nodePool = this->nodePool;
+
+    Node* leftRoot;
+    Node* rightRoot;
+
+    internal::splitHelperLeaf(key, this->root, leftRoot, rightRoot, *nodePool, comparator);
+
+    this->root = leftRoot;
+    this->entries = internal::getSizeHelper(leftRoot);
+
+    greaterTree.root = rightRoot;
+    greaterTree.entries = internal::getSizeHelper(rightRoot);
+
+    return greaterTree;
+}
+
+/**
+ * @brief Join another BST to this BST: the entries of the other BST are
+ * moved in this BST, and the other BST is left empty.
+ * The keys of the other BST must be all greater (or all lower) than
+ * the keys of this BST.
+ *
+ * The cost is logarithmic in the number of entries, plus the cost of
+ * moving the nodes of the other BST to the pool of this BST (see
+ * internal::joinNodePoolsHelper). The iterators to the moved entries
+ * are not valid anymore.
+ *
+ * @param[out] other BST to be joined
+ */
+template <class K, class T, class C>
+void AVLLeaf<K,T,C>::join(AVLLeaf<K,T,C>& other)
+{
+    if (&other == this || other.root == nullptr)
+        return;
+
+    //Check if the keys of the other tree are greater or lower
+    bool otherIsGreater = true;
+    if (this->root != nullptr) {
+        otherIsGreater = internal::isLess(
+                    internal::getMaximumHelperLeaf(this->root)->key,
+                    internal::getMinimumHelperLeaf(other.root)->key,
+                    comparator);
+
+        if (!otherIsGreater && !internal::isLess(
+                    internal::getMaximumHelperLeaf(other.root)->key,
+                    internal::getMinimumHelperLeaf(this->root)->key,
+                    comparator))
+        {
+            throw new std::runtime_error("The keys of the joined trees cannot overlap.");
+        }
+    }
+
+    //The nodes of the other tree must belong to the pool of this tree
+    internal::joinNodePoolsHelper(this->nodePool, other.nodePool, other.root);
+
+    if (otherIsGreater) {
+        this->root = internal::joinHelperLeaf(this->root, other.root, *nodePool);
+    }
+    else {
+        this->root = internal::joinHelperLeaf(other.root, this->root, *nodePool);
+    }
+
+    this->entries += other.entries;
+
+    other.root = nullptr;
+    other.entries = 0;
+}
+
+
+
 /* ----- ITERATOR MIN/MAX NEXT/PREV ----- */
 
 /**
@@ -652,6 +801,7 @@ void AVLLeaf<K,T,C>::swap(AVLLeaf<K,T,C>& bst)
     swap(this->root, bst.root);
     swap(this->entries, bst.entries);
     swap(this->comparator, bst.comparator);
+    swap(this->nodePool, bst.nodePool);
 }
 
 
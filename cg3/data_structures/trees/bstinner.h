@@ -18,6 +18,7 @@
 #include "includes/iterators/tree_rangebased_iterators.h"
 
 #include "includes/nodes/bst_node.h"
+#include "includes/tree_node_pool.h"
 
 namespace cg3 {
 
@@ -56,11 +57,11 @@ public:
 
     /* Constructors/destructor */
 
-    explicit BSTInner(const C& customComparator = &internal::defaultComparator<K>);
+    explicit BSTInner(const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit BSTInner(const std::vector<std::pair<K,T>>& vec,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit BSTInner(const std::vector<K>& vec,
-             const C& customComparator = &internal::defaultComparator<K>);
+             const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
 
     BSTInner(const BSTInner<K,T,C>& bst);
     BSTInner(BSTInner<K,T,C>&& bst);
@@ -148,6 +149,8 @@ protected:
 
     C comparator;
 
+    internal::TreeNodePool<Node,T> nodePool;
+
 
     /* Protected methods */
 
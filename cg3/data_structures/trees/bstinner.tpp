@@ -73,7 +73,7 @@ template <class K, class T, class C>
 BSTInner<K,T,C>::BSTInner(const BSTInner<K,T,C>& bst) :
     comparator(bst.comparator)
 {
-    this->root = internal::copySubtreeHelper<Node,T>(bst.root);
+    this->root = internal::copySubtreeHelper(bst.root, nodePool);
     this->entries = bst.entries;
 }
 
@@ -83,7 +83,8 @@ BSTInner<K,T,C>::BSTInner(const BSTInner<K,T,C>& bst) :
  */
 template <class K, class T, class C>
 BSTInner<K,T,C>::BSTInner(BSTInner<K,T,C>&& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::move(bst.nodePool))
 {
     this->root = bst.root;
     bst.root = nullptr;
@@ -145,13 +146,14 @@ void BSTInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
+    nodePool.reserve(sortedVec.size(), sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool.create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -161,6 +163,7 @@ void BSTInner<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
                 0,
                 sortedNodes.size(),
                 this->root,
+                nodePool,
                 comparator);
 }
 
@@ -196,10 +199,10 @@ typename BSTInner<K,T,C>::iterator BSTInner<K,T,C>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool.create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperInner<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperInner<Node,K,C>(newNode, this->root, nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
@@ -234,7 +237,7 @@ bool BSTInner<K,T,C>::erase(const K& key)
     //If the node has been found
     if (node != nullptr) {
         //Erase node
-        internal::eraseNodeHelperInner(node, this->root);
+        internal::eraseNodeHelperInner(node, this->root, nodePool);
 
         //Decrease the number of entries
         this->entries--;
@@ -264,7 +267,7 @@ void BSTInner<K,T,C>::erase(generic_iterator it)
 
     if (node != nullptr) {
         //Erase node
-        internal::eraseNodeHelperInner(node, this->root);
+        internal::eraseNodeHelperInner(node, this->root, nodePool);
 
         //Decrease the number of entries
         this->entries--;
@@ -337,7 +340,7 @@ template <class K, class T, class C>
 void BSTInner<K,T,C>::clear()
 {
     //Clear entire tree
-    internal::clearHelper(this->root);
+    nodePool.clear(this->root);
 
     //Decreasing entries
     this->entries = 0;
@@ -634,6 +637,7 @@ void BSTInner<K,T,C>::swap(BSTInner<K,T,C>& bst)
     swap(this->root, bst.root);
     swap(this->entries, bst.entries);
     swap(this->comparator, bst.comparator);
+    this->nodePool.swap(bst.nodePool);
 }
 
 
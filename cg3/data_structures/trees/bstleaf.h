@@ -18,6 +18,7 @@
 #include "includes/iterators/tree_rangebased_iterators.h"
 
 #include "includes/nodes/bst_node.h"
+#include "includes/tree_node_pool.h"
 
 namespace cg3 {
 
@@ -56,11 +57,11 @@ public:
 
     /* Constructors/destructor */
 
-    explicit BSTLeaf(const C& customComparator = &internal::defaultComparator<K>);
+    explicit BSTLeaf(const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit BSTLeaf(const std::vector<std::pair<K,T>>& vec,
-            const C& customComparator = &internal::defaultComparator<K>);
+            const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
     explicit BSTLeaf(const std::vector<K>& vec,
-            const C& customComparator = &internal::defaultComparator<K>);
+            const C& customComparator = internal::DefaultComparatorValue<K,C>::get());
 
     BSTLeaf(const BSTLeaf<K,T,C>& bst);
     BSTLeaf(BSTLeaf<K,T,C>&& bst);
@@ -149,6 +150,8 @@ protected:
 
     C comparator;
 
+    internal::TreeNodePool<Node,T> nodePool;
+
 
     /* Protected methods */
 
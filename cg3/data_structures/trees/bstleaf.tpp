@@ -73,7 +73,7 @@ template <class K, class T, class C>
 BSTLeaf<K,T,C>::BSTLeaf(const BSTLeaf<K,T,C>& bst) :
     comparator(bst.comparator)
 {
-    this->root = internal::copySubtreeHelper<Node,T>(bst.root);
+    this->root = internal::copySubtreeHelper(bst.root, nodePool);
     this->entries = bst.entries;
 }
 
@@ -83,7 +83,8 @@ BSTLeaf<K,T,C>::BSTLeaf(const BSTLeaf<K,T,C>& bst) :
  */
 template <class K, class T, class C>
 BSTLeaf<K,T,C>::BSTLeaf(BSTLeaf<K,T,C>&& bst) :
-    comparator(bst.comparator)
+    comparator(bst.comparator),
+    nodePool(std::move(bst.nodePool))
 {
     this->root = bst.root;
     bst.root = nullptr;
@@ -145,13 +146,14 @@ void BSTLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
+    nodePool.reserve(2*sortedVec.size()-1, sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool.create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -159,6 +161,7 @@ void BSTLeaf<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
+                nodePool,
                 comparator);
 }
 
@@ -194,10 +197,10 @@ typename BSTLeaf<K,T,C>::iterator BSTLeaf<K,T,C>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool.create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
@@ -232,7 +235,7 @@ bool BSTLeaf<K,T,C>::erase(const K& key)
     //If the node has been found
     if (node != nullptr) {
         //Erase node
-        internal::eraseNodeHelperLeaf(node, this->root);
+        internal::eraseNodeHelperLeaf(node, this->root, nodePool);
 
         //Decrease the number of entries
         this->entries--;
@@ -261,7 +264,7 @@ void BSTLeaf<K,T,C>::erase(generic_iterator it)
 
     if (node != nullptr) {
         //Erase node
-        internal::eraseNodeHelperLeaf(node, this->root);
+        internal::eraseNodeHelperLeaf(node, this->root, nodePool);
 
         //Decrease the number of entries
         this->entries--;
@@ -334,7 +337,7 @@ template <class K, class T, class C>
 void BSTLeaf<K,T,C>::clear()
 {
     //Clear entire tree
-    internal::clearHelper(this->root);
+    nodePool.clear(this->root);
 
     //Decreasing entries
     this->entries = 0;
@@ -632,6 +635,7 @@ void BSTLeaf<K,T,C>::swap(BSTLeaf<K,T,C>& bst)
     swap(this->root, bst.root);
     swap(this->entries, bst.entries);
     swap(this->comparator, bst.comparator);
+    this->nodePool.swap(bst.nodePool);
 }
 
 
@@ -0,0 +1,193 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_BVH_H
+#define CG3_BVH_H
+
+#include <array>
+#include <vector>
+#include <utility>
+
+#include "includes/tree_common.h"
+
+namespace cg3 {
+
+/**
+ * @brief A static bounding volume hierarchy
+ *
+ * Differently from AABBTree, whose nodes are ordered by the key comparator, the
+ * hierarchy is built by splitting the space: the bounding boxes of the keys are split
+ * recursively with the surface area heuristic (SAH), evaluated on a fixed number of
+ * bins along each axis. Therefore the bounding boxes of the nodes overlap as little as
+ * possible and the queries visit only the nodes close to the query.
+ *
+ * The tree cannot be modified after its construction. Nodes are stored in a single
+ * contiguous array, and the keys and values are reordered so that the ones in the same
+ * leaf are contiguous in memory.
+ *
+ * The primitives in the tree are identified by their index (from 0 to size()-1), which
+ * is returned by the ray and nearest point queries.
+ *
+ * The AABB value extractor (E) can be a function pointer or any other callable
+ * type: with a stateless functor its calls are inlined in the construction.
+ */
+template <int D, class K, class T = K, class E = AABBValueExtractorFunction<K>>
+class BVH
+{
+
+public:
+
+    /* Types */
+
+    using KeyOverlapChecker = bool (*)(const K& key1, const K& key2);
+
+    using AABBValueExtractor = E;
+
+    /**
+     * @brief D-dimensional axis-aligned bounding box
+     */
+    struct AABB {
+        std::array<double, D> min;
+        std::array<double, D> max;
+    };
+
+    /**
+     * @brief Node of the hierarchy. Children of an inner node are stored one after
+     * the other, the first one at position index. A leaf contains the primitives from
+     * index to index+count-1.
+     */
+    struct Node {
+        AABB aabb;
+        unsigned int index;
+        unsigned int count;     //0 for inner nodes
+
+        inline bool isLeaf() const { return count > 0; }
+    };
+
+
+    /* Constructors */
+
+    explicit BVH(const AABBValueExtractor& customAABBExtractor);
+    explicit BVH(const std::vector<std::pair<K,T>>& vec,
+             const AABBValueExtractor& customAABBExtractor);
+    explicit BVH(const std::vector<K>& vec,
+             const AABBValueExtractor& customAABBExtractor);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    TreeSize size() const;
+    bool empty() const;
+
+    void clear();
+
+    TreeSize getHeight() const;
+
+    const K& key(unsigned int i) const;
+    const T& value(unsigned int i) const;
+    const std::vector<Node>& nodes() const;
+
+
+    /* Queries */
+
+    template <class OutputIterator, class F = KeyOverlapChecker>
+    void aabbOverlapQuery(
+            const K& key,
+            OutputIterator out,
+            const F& keyOverlapChecker = nullptr) const;
+
+    template <class OutputIterator>
+    void aabbOverlapQuery(
+            const AABB& aabb,
+            OutputIterator out) const;
+
+    template <class F = KeyOverlapChecker>
+    bool aabbOverlapCheck(
+            const K& key,
+            const F& keyOverlapChecker = nullptr) const;
+
+    bool aabbOverlapCheck(
+            const AABB& aabb) const;
+
+    template <class Intersector, class OutputIterator>
+    void rayQuery(
+            const std::array<double, D>& origin,
+            const std::array<double, D>& direction,
+            Intersector intersector,
+            OutputIterator out) const;
+
+    template <class Intersector>
+    int nearestRayQuery(
+            const std::array<double, D>& origin,
+            const std::array<double, D>& direction,
+            Intersector intersector,
+            double& t) const;
+
+    template <class SquaredDistance>
+    int nearestPointQuery(
+            const std::array<double, D>& point,
+            SquaredDistance squaredDistance,
+            double& minSquaredDistance) const;
+
+
+protected:
+
+    /* Protected fields */
+
+    std::vector<Node> nodeArray;
+
+    std::vector<K> keys;
+    std::vector<T> values;
+    std::vector<AABB> primitiveAABBs;
+
+    AABBValueExtractor aabbValueExtractor;
+
+
+    /* Protected methods */
+
+    void build(std::vector<AABB>& aabbs, std::vector<unsigned int>& order);
+
+    bool splitHelper(
+            const std::vector<AABB>& aabbs,
+            const std::vector<std::array<double, D>>& centroids,
+            std::vector<unsigned int>& order,
+            unsigned int begin,
+            unsigned int end,
+            const AABB& bounds,
+            const AABB& centroidBounds,
+            unsigned int& mid);
+
+
+    /* AABB utilities */
+
+    inline AABB keyAABBHelper(const K& k) const;
+
+    static inline void emptyAABBHelper(AABB& aabb);
+    static inline void growAABBHelper(AABB& aabb, const AABB& other);
+    static inline double surfaceAreaHelper(const AABB& aabb);
+
+    static inline bool aabbOverlapsHelper(const AABB& a, const AABB& b);
+
+    static inline bool rayAABBHelper(
+            const AABB& aabb,
+            const std::array<double, D>& origin,
+            const std::array<double, D>& invDirection,
+            double tMax,
+            double& tEntry);
+
+    static inline double squaredDistanceAABBHelper(
+            const AABB& aabb,
+            const std::array<double, D>& point);
+
+};
+
+}
+
+
+#include "bvh.tpp"
+
+#endif // CG3_BVH_H
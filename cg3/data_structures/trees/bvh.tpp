@@ -0,0 +1,887 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "bvh.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "cg3/utilities/const.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/* Construction parameters */
+
+static const unsigned int bvhNumberOfBins = 16;
+static const unsigned int bvhMaxLeafSize = 8;
+static const unsigned int bvhMinLeafSize = 2;
+
+}
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] customAABBValueExtractor Function to extract AABB coordinates from
+ * a key
+ */
+template <int D, class K, class T, class E>
+BVH<D,K,T,E>::BVH(const AABBValueExtractor& customAABBValueExtractor) :
+    aabbValueExtractor(customAABBValueExtractor)
+{
+
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs) to be inserted
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customAABBValueExtractor Function to extract AABB coordinates from
+ * a key
+ */
+template <int D, class K, class T, class E>
+BVH<D,K,T,E>::BVH(
+        const std::vector<std::pair<K,T>>& vec,
+        const AABBValueExtractor& customAABBValueExtractor) :
+    aabbValueExtractor(customAABBValueExtractor)
+{
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of values to be inserted
+ *
+ * @param[in] vec Vector of values
+ * @param[in] customAABBValueExtractor Function to extract AABB coordinates from
+ * a key
+ */
+template <int D, class K, class T, class E>
+BVH<D,K,T,E>::BVH(
+        const std::vector<K>& vec,
+        const AABBValueExtractor& customAABBValueExtractor) :
+    aabbValueExtractor(customAABBValueExtractor)
+{
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the BVH given the values
+ *
+ * The previous content of the BVH is discarded.
+ *
+ * @param[in] vec Vector of values
+ */
+template <int D, class K, class T, class E>
+void BVH<D,K,T,E>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the BVH given the entries (pairs of keys/values)
+ *
+ * The previous content of the BVH is discarded.
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <int D, class K, class T, class E>
+void BVH<D,K,T,E>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.empty())
+        return;
+
+    std::vector<AABB> aabbs(vec.size());
+    for (unsigned int i = 0; i < vec.size(); i++) {
+        aabbs[i] = keyAABBHelper(vec[i].first);
+    }
+    std::vector<unsigned int> order(vec.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    this->build(aabbs, order);
+
+    //Keys and values of the same leaf become contiguous
+    keys.reserve(vec.size());
+    values.reserve(vec.size());
+    primitiveAABBs.reserve(vec.size());
+    for (unsigned int i : order) {
+        keys.push_back(vec[i].first);
+        values.push_back(vec[i].second);
+        primitiveAABBs.push_back(aabbs[i]);
+    }
+}
+
+/**
+ * @brief Get the number of entries in the BVH
+ *
+ * @return Number of entries
+ */
+template <int D, class K, class T, class E>
+TreeSize BVH<D,K,T,E>::size() const
+{
+    return keys.size();
+}
+
+/**
+ * @brief Check if the BVH is empty
+ *
+ * @return True if the BVH is empty
+ */
+template <int D, class K, class T, class E>
+bool BVH<D,K,T,E>::empty() const
+{
+    return keys.empty();
+}
+
+/**
+ * @brief Clear the BVH, deleting all its elements
+ */
+template <int D, class K, class T, class E>
+void BVH<D,K,T,E>::clear()
+{
+    nodeArray.clear();
+    keys.clear();
+    values.clear();
+    primitiveAABBs.clear();
+}
+
+/**
+ * @brief Get the height of the BVH
+ *
+ * @return Height of the BVH
+ */
+template <int D, class K, class T, class E>
+TreeSize BVH<D,K,T,E>::getHeight() const
+{
+    if (nodeArray.empty())
+        return 0;
+
+    TreeSize height = 0;
+    std::vector<std::pair<unsigned int, TreeSize>> stack(1, std::make_pair(0u, (TreeSize) 1));
+    while (!stack.empty()) {
+        std::pair<unsigned int, TreeSize> p = stack.back();
+        stack.pop_back();
+
+        height = std::max(height, p.second);
+        const Node& node = nodeArray[p.first];
+        if (!node.isLeaf()) {
+            stack.push_back(std::make_pair(node.index, p.second + 1));
+            stack.push_back(std::make_pair(node.index + 1, p.second + 1));
+        }
+    }
+    return height;
+}
+
+/**
+ * @brief Get the key of a primitive
+ *
+ * @param[in] i Index of the primitive, from 0 to size()-1
+ * @return Key of the primitive
+ */
+template <int D, class K, class T, class E>
+const K& BVH<D,K,T,E>::key(unsigned int i) const
+{
+    return keys[i];
+}
+
+/**
+ * @brief Get the value of a primitive
+ *
+ * @param[in] i Index of the primitive, from 0 to size()-1
+ * @return Value of the primitive
+ */
+template <int D, class K, class T, class E>
+const T& BVH<D,K,T,E>::value(unsigned int i) const
+{
+    return values[i];
+}
+
+/**
+ * @brief Get the nodes of the BVH. The first node is the root.
+ *
+ * @return Vector of nodes
+ */
+template <int D, class K, class T, class E>
+const std::vector<typename BVH<D,K,T,E>::Node>& BVH<D,K,T,E>::nodes() const
+{
+    return nodeArray;
+}
+
+
+
+/* --------- QUERIES --------- */
+
+/**
+ * @brief Get all the values whose bounding box overlaps with the bounding box
+ * of the given key. If the optional key overlap filter function is specified, then
+ * only the values whose key passes the filter are returned.
+ *
+ * @param[in] key Input key
+ * @param[out] out Output iterator for the values
+ * @param[in] keyOverlapChecker Key overlap filter function
+ */
+template <int D, class K, class T, class E>
+template <class OutputIterator, class F>
+void BVH<D,K,T,E>::aabbOverlapQuery(
+        const K& key,
+        OutputIterator out,
+        const F& keyOverlapChecker) const
+{
+    AABB aabb = keyAABBHelper(key);
+
+    if (nodeArray.empty() || !aabbOverlapsHelper(aabb, nodeArray[0].aabb))
+        return;
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodeArray[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                if (aabbOverlapsHelper(aabb, primitiveAABBs[i]) &&
+                        internal::checkKeyOverlap(key, keys[i], keyOverlapChecker))
+                {
+                    *out = values[i];
+                    out++;
+                }
+            }
+        }
+        else {
+            for (unsigned int c = node.index; c < node.index + 2; c++) {
+                if (aabbOverlapsHelper(aabb, nodeArray[c].aabb))
+                    stack.push_back(c);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get all the values whose bounding box overlaps with the given bounding box
+ *
+ * @param[in] aabb Input bounding box
+ * @param[out] out Output iterator for the values
+ */
+template <int D, class K, class T, class E>
+template <class OutputIterator>
+void BVH<D,K,T,E>::aabbOverlapQuery(
+        const AABB& aabb,
+        OutputIterator out) const
+{
+    if (nodeArray.empty() || !aabbOverlapsHelper(aabb, nodeArray[0].aabb))
+        return;
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodeArray[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                if (aabbOverlapsHelper(aabb, primitiveAABBs[i])) {
+                    *out = values[i];
+                    out++;
+                }
+            }
+        }
+        else {
+            for (unsigned int c = node.index; c < node.index + 2; c++) {
+                if (aabbOverlapsHelper(aabb, nodeArray[c].aabb))
+                    stack.push_back(c);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check if the bounding box of the given key overlaps with the one of
+ * the values. If the optional key overlap filter function is specified, then
+ * true is returned iff the bounding box overlaps and the filter function returns true.
+ *
+ * @param[in] key Input key
+ * @param[in] keyOverlapChecker Key overlap filter function
+ * @return True if there is an overlapping bounding box in the stored values
+ */
+template <int D, class K, class T, class E>
+template <class F>
+bool BVH<D,K,T,E>::aabbOverlapCheck(
+        const K& key,
+        const F& keyOverlapChecker) const
+{
+    AABB aabb = keyAABBHelper(key);
+
+    if (nodeArray.empty() || !aabbOverlapsHelper(aabb, nodeArray[0].aabb))
+        return false;
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodeArray[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                if (aabbOverlapsHelper(aabb, primitiveAABBs[i]) &&
+                        internal::checkKeyOverlap(key, keys[i], keyOverlapChecker))
+                {
+                    return true;
+                }
+            }
+        }
+        else {
+            for (unsigned int c = node.index; c < node.index + 2; c++) {
+                if (aabbOverlapsHelper(aabb, nodeArray[c].aabb))
+                    stack.push_back(c);
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Check if the given bounding box overlaps with the one of the values
+ *
+ * @param[in] aabb Input bounding box
+ * @return True if there is an overlapping bounding box in the stored values
+ */
+template <int D, class K, class T, class E>
+bool BVH<D,K,T,E>::aabbOverlapCheck(
+        const AABB& aabb) const
+{
+    if (nodeArray.empty() || !aabbOverlapsHelper(aabb, nodeArray[0].aabb))
+        return false;
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodeArray[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                if (aabbOverlapsHelper(aabb, primitiveAABBs[i]))
+                    return true;
+            }
+        }
+        else {
+            for (unsigned int c = node.index; c < node.index + 2; c++) {
+                if (aabbOverlapsHelper(aabb, nodeArray[c].aabb))
+                    stack.push_back(c);
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Get all the values whose key is intersected by a ray
+ *
+ * @param[in] origin Origin of the ray
+ * @param[in] direction Direction of the ray
+ * @param[in] intersector Function bool(const K& key, double& t) which returns true
+ * if the key is intersected by the ray, setting t to the parameter of the
+ * intersection point (origin + t * direction)
+ * @param[out] out Output iterator for the values
+ */
+template <int D, class K, class T, class E>
+template <class Intersector, class OutputIterator>
+void BVH<D,K,T,E>::rayQuery(
+        const std::array<double, D>& origin,
+        const std::array<double, D>& direction,
+        Intersector intersector,
+        OutputIterator out) const
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    std::array<double, D> invDirection;
+    for (int i = 0; i < D; i++)
+        invDirection[i] = 1.0 / direction[i];
+
+    double tEntry;
+    if (nodeArray.empty() || !rayAABBHelper(nodeArray[0].aabb, origin, invDirection, inf, tEntry))
+        return;
+
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodeArray[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                double t;
+                if (rayAABBHelper(primitiveAABBs[i], origin, invDirection, inf, tEntry) &&
+                        intersector(keys[i], t))
+                {
+                    *out = values[i];
+                    out++;
+                }
+            }
+        }
+        else {
+            for (unsigned int c = node.index; c < node.index + 2; c++) {
+                if (rayAABBHelper(nodeArray[c].aabb, origin, invDirection, inf, tEntry))
+                    stack.push_back(c);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the primitive with the nearest intersection along a ray.
+ *
+ * The children of a node are visited from the nearest to the ray origin, and the nodes
+ * farther than the nearest intersection found are skipped.
+ *
+ * @param[in] origin Origin of the ray
+ * @param[in] direction Direction of the ray
+ * @param[in] intersector Function bool(const K& key, double& t) which returns true
+ * if the key is intersected by the ray, setting t to the parameter of the nearest
+ * intersection point (origin + t * direction), with t >= 0
+ * @param[out] t Parameter of the nearest intersection point
+ * @return The index of the nearest intersected primitive, -1 if the ray does not
+ * intersect any primitive
+ */
+template <int D, class K, class T, class E>
+template <class Intersector>
+int BVH<D,K,T,E>::nearestRayQuery(
+        const std::array<double, D>& origin,
+        const std::array<double, D>& direction,
+        Intersector intersector,
+        double& t) const
+{
+    int nearest = -1;
+    t = std::numeric_limits<double>::infinity();
+    std::array<double, D> invDirection;
+    for (int i = 0; i < D; i++)
+        invDirection[i] = 1.0 / direction[i];
+
+    double tEntry;
+    if (nodeArray.empty() || !rayAABBHelper(nodeArray[0].aabb, origin, invDirection, t, tEntry))
+        return nearest;
+
+    std::vector<std::pair<unsigned int, double>> stack(1, std::make_pair(0u, tEntry));
+    while (!stack.empty()) {
+        std::pair<unsigned int, double> p = stack.back();
+        stack.pop_back();
+        if (p.second > t)
+            continue;
+
+        const Node& node = nodeArray[p.first];
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                double ti;
+                if (rayAABBHelper(primitiveAABBs[i], origin, invDirection, t, tEntry) &&
+                        intersector(keys[i], ti) && ti >= 0 && ti < t)
+                {
+                    t = ti;
+                    nearest = i;
+                }
+            }
+        }
+        else {
+            double t0, t1;
+            bool hit0 = rayAABBHelper(nodeArray[node.index].aabb, origin, invDirection, t, t0);
+            bool hit1 = rayAABBHelper(nodeArray[node.index + 1].aabb, origin, invDirection, t, t1);
+            //The nearest child is pushed last, to be visited first
+            if (hit0 && hit1 && t0 <= t1) {
+                stack.push_back(std::make_pair(node.index + 1, t1));
+                stack.push_back(std::make_pair(node.index, t0));
+            }
+            else {
+                if (hit0)
+                    stack.push_back(std::make_pair(node.index, t0));
+                if (hit1)
+                    stack.push_back(std::make_pair(node.index + 1, t1));
+            }
+        }
+    }
+    return nearest;
+}
+
+/**
+ * @brief Get the primitive nearest to a point.
+ *
+ * The children of a node are visited from the nearest to the point, and the nodes
+ * whose bounding box is farther than the nearest primitive found are skipped.
+ *
+ * @param[in] point Query point
+ * @param[in] squaredDistance Function double(const K& key) which returns the squared
+ * distance between the key and the query point
+ * @param[out] minSquaredDistance Squared distance of the nearest primitive
+ * @return The index of the nearest primitive, -1 if the BVH is empty
+ */
+template <int D, class K, class T, class E>
+template <class SquaredDistance>
+int BVH<D,K,T,E>::nearestPointQuery(
+        const std::array<double, D>& point,
+        SquaredDistance squaredDistance,
+        double& minSquaredDistance) const
+{
+    int nearest = -1;
+    minSquaredDistance = std::numeric_limits<double>::infinity();
+
+    if (nodeArray.empty())
+        return nearest;
+
+    std::vector<std::pair<unsigned int, double>> stack(
+                1, std::make_pair(0u, squaredDistanceAABBHelper(nodeArray[0].aabb, point)));
+    while (!stack.empty()) {
+        std::pair<unsigned int, double> p = stack.back();
+        stack.pop_back();
+        if (p.second >= minSquaredDistance)
+            continue;
+
+        const Node& node = nodeArray[p.first];
+        if (node.isLeaf()) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                if (squaredDistanceAABBHelper(primitiveAABBs[i], point) < minSquaredDistance) {
+                    double d = squaredDistance(keys[i]);
+                    if (d < minSquaredDistance) {
+                        minSquaredDistance = d;
+                        nearest = i;
+                    }
+                }
+            }
+        }
+        else {
+            double d0 = squaredDistanceAABBHelper(nodeArray[node.index].aabb, point);
+            double d1 = squaredDistanceAABBHelper(nodeArray[node.index + 1].aabb, point);
+            //The nearest child is pushed last, to be visited first
+            if (d0 <= d1) {
+                stack.push_back(std::make_pair(node.index + 1, d1));
+                stack.push_back(std::make_pair(node.index, d0));
+            }
+            else {
+                stack.push_back(std::make_pair(node.index, d0));
+                stack.push_back(std::make_pair(node.index + 1, d1));
+            }
+        }
+    }
+    return nearest;
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Build the hierarchy of the given bounding boxes. The children of a node are
+ * allocated together, therefore the nodes can be created in any order.
+ *
+ * @param[in] aabbs Bounding boxes of the primitives
+ * @param[out] order Order of the primitives in the leaves
+ */
+template <int D, class K, class T, class E>
+void BVH<D,K,T,E>::build(std::vector<AABB>& aabbs, std::vector<unsigned int>& order)
+{
+    const unsigned int n = aabbs.size();
+
+    std::vector<std::array<double, D>> centroids(n);
+    for (unsigned int i = 0; i < n; i++) {
+        for (int d = 0; d < D; d++)
+            centroids[i][d] = (aabbs[i].min[d] + aabbs[i].max[d]) / 2;
+    }
+
+    struct Task {
+        unsigned int node;
+        unsigned int begin;
+        unsigned int end;
+    };
+
+    nodeArray.reserve(2 * n - 1);
+    nodeArray.push_back(Node());
+    std::vector<Task> stack(1, Task{0, 0, n});
+
+    while (!stack.empty()) {
+        Task task = stack.back();
+        stack.pop_back();
+
+        AABB bounds, centroidBounds;
+        emptyAABBHelper(bounds);
+        emptyAABBHelper(centroidBounds);
+        for (unsigned int i = task.begin; i < task.end; i++) {
+            growAABBHelper(bounds, aabbs[order[i]]);
+            for (int d = 0; d < D; d++) {
+                centroidBounds.min[d] = std::min(centroidBounds.min[d], centroids[order[i]][d]);
+                centroidBounds.max[d] = std::max(centroidBounds.max[d], centroids[order[i]][d]);
+            }
+        }
+        nodeArray[task.node].aabb = bounds;
+
+        unsigned int mid;
+        if (task.end - task.begin <= internal::bvhMinLeafSize ||
+                !splitHelper(aabbs, centroids, order, task.begin, task.end, bounds, centroidBounds, mid))
+        {
+            nodeArray[task.node].index = task.begin;
+            nodeArray[task.node].count = task.end - task.begin;
+        }
+        else {
+            unsigned int children = nodeArray.size();
+            nodeArray[task.node].index = children;
+            nodeArray[task.node].count = 0;
+            nodeArray.push_back(Node());
+            nodeArray.push_back(Node());
+            stack.push_back(Task{children + 1, mid, task.end});
+            stack.push_back(Task{children, task.begin, mid});
+        }
+    }
+}
+
+/**
+ * @brief Find the split of a node with the minimum SAH cost, evaluated on the
+ * bins of the centroids along each axis, and partition its primitives.
+ *
+ * @return False if the node should be a leaf
+ */
+template <int D, class K, class T, class E>
+bool BVH<D,K,T,E>::splitHelper(
+        const std::vector<AABB>& aabbs,
+        const std::vector<std::array<double, D>>& centroids,
+        std::vector<unsigned int>& order,
+        unsigned int begin,
+        unsigned int end,
+        const AABB& bounds,
+        const AABB& centroidBounds,
+        unsigned int& mid)
+{
+    const unsigned int nBins = internal::bvhNumberOfBins;
+    const unsigned int count = end - begin;
+
+    int bestAxis = -1;
+    unsigned int bestBin = 0;
+    double bestCost = std::numeric_limits<double>::max();
+
+    for (int axis = 0; axis < D; axis++) {
+        double extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+        if (extent <= 0)
+            continue;
+        double scale = nBins / extent;
+
+        std::array<AABB, internal::bvhNumberOfBins> binAABBs;
+        std::array<unsigned int, internal::bvhNumberOfBins> binCounts;
+        for (unsigned int b = 0; b < nBins; b++) {
+            emptyAABBHelper(binAABBs[b]);
+            binCounts[b] = 0;
+        }
+        for (unsigned int i = begin; i < end; i++) {
+            unsigned int b = std::min(nBins - 1,
+                    (unsigned int) ((centroids[order[i]][axis] - centroidBounds.min[axis]) * scale));
+            binCounts[b]++;
+            growAABBHelper(binAABBs[b], aabbs[order[i]]);
+        }
+
+        //Sweep from the right: area and count of the bins after every split
+        std::array<double, internal::bvhNumberOfBins> rightAreas;
+        std::array<unsigned int, internal::bvhNumberOfBins> rightCounts;
+        AABB acc;
+        emptyAABBHelper(acc);
+        unsigned int accCount = 0;
+        for (unsigned int b = nBins - 1; b > 0; b--) {
+            growAABBHelper(acc, binAABBs[b]);
+            accCount += binCounts[b];
+            rightAreas[b - 1] = surfaceAreaHelper(acc);
+            rightCounts[b - 1] = accCount;
+        }
+
+        //Sweep from the left: cost of the split after every bin
+        emptyAABBHelper(acc);
+        accCount = 0;
+        for (unsigned int b = 0; b < nBins - 1; b++) {
+            growAABBHelper(acc, binAABBs[b]);
+            accCount += binCounts[b];
+            if (accCount == 0 || rightCounts[b] == 0)
+                continue;
+            double cost = accCount * surfaceAreaHelper(acc) + rightCounts[b] * rightAreas[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = b;
+            }
+        }
+    }
+
+    //All the centroids coincide: the primitives are split in two halves
+    if (bestAxis < 0) {
+        if (count <= internal::bvhMaxLeafSize)
+            return false;
+        mid = begin + count / 2;
+        return true;
+    }
+
+    //Cost of a leaf against the cost of traversing the node and its children
+    double area = surfaceAreaHelper(bounds);
+    if (count <= internal::bvhMaxLeafSize && count * area <= area + bestCost)
+        return false;
+
+    double scale = nBins / (centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis]);
+    std::vector<unsigned int>::iterator it = std::partition(
+                order.begin() + begin, order.begin() + end,
+                [&](unsigned int i) {
+                    return std::min(nBins - 1, (unsigned int) ((centroids[i][bestAxis] -
+                            centroidBounds.min[bestAxis]) * scale)) <= bestBin;
+                });
+    mid = it - order.begin();
+
+    if (mid == begin || mid == end) {
+        mid = begin + count / 2;
+        std::nth_element(
+                    order.begin() + begin, order.begin() + mid, order.begin() + end,
+                    [&](unsigned int a, unsigned int b) {
+                        return centroids[a][bestAxis] < centroids[b][bestAxis];
+                    });
+    }
+    return true;
+}
+
+
+
+/* --------- AABB UTILITIES --------- */
+
+/**
+ * @brief Get the bounding box of a key
+ *
+ * @param[in] k Input key
+ * @return Bounding box of the key
+ */
+template <int D, class K, class T, class E>
+inline typename BVH<D,K,T,E>::AABB BVH<D,K,T,E>::keyAABBHelper(const K& k) const
+{
+    AABB aabb;
+    for (int i = 0; i < D; i++) {
+        aabb.min[i] = aabbValueExtractor(k, MIN, i+1);
+        aabb.max[i] = aabbValueExtractor(k, MAX, i+1);
+    }
+    return aabb;
+}
+
+/**
+ * @brief Set a bounding box which does not contain any point
+ */
+template <int D, class K, class T, class E>
+inline void BVH<D,K,T,E>::emptyAABBHelper(AABB& aabb)
+{
+    aabb.min.fill(std::numeric_limits<double>::max());
+    aabb.max.fill(std::numeric_limits<double>::lowest());
+}
+
+/**
+ * @brief Enlarge a bounding box to contain another bounding box
+ */
+template <int D, class K, class T, class E>
+inline void BVH<D,K,T,E>::growAABBHelper(AABB& aabb, const AABB& other)
+{
+    for (int i = 0; i < D; i++) {
+        aabb.min[i] = std::min(aabb.min[i], other.min[i]);
+        aabb.max[i] = std::max(aabb.max[i], other.max[i]);
+    }
+}
+
+/**
+ * @brief Get the (half) surface area of a bounding box, proportional to the
+ * probability that a random ray hits it
+ */
+template <int D, class K, class T, class E>
+inline double BVH<D,K,T,E>::surfaceAreaHelper(const AABB& aabb)
+{
+    std::array<double, D> e;
+    for (int i = 0; i < D; i++)
+        e[i] = std::max(0.0, aabb.max[i] - aabb.min[i]);
+
+    double area = 0;
+    if (D < 3) {
+        for (int i = 0; i < D; i++)
+            area += e[i];
+    }
+    else {
+        for (int i = 0; i < D; i++)
+            for (int j = i + 1; j < D; j++)
+                area += e[i] * e[j];
+    }
+    return area;
+}
+
+/**
+ * @brief Check if two bounding boxes overlap, with the same tolerance
+ * used by AABBTree
+ */
+template <int D, class K, class T, class E>
+inline bool BVH<D,K,T,E>::aabbOverlapsHelper(const AABB& a, const AABB& b)
+{
+    double eps = cg3::CG3_EPSILON*100;
+
+    for (int i = 0; i < D; i++) {
+        if (a.min[i] - eps > b.max[i] + eps ||
+            b.min[i] - eps > a.max[i] + eps)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check if a ray intersects a bounding box before the parameter tMax
+ * (slab test)
+ *
+ * @param[out] tEntry Parameter of the point in which the ray enters the box
+ */
+template <int D, class K, class T, class E>
+inline bool BVH<D,K,T,E>::rayAABBHelper(
+        const AABB& aabb,
+        const std::array<double, D>& origin,
+        const std::array<double, D>& invDirection,
+        double tMax,
+        double& tEntry)
+{
+    double tMin = 0;
+    for (int i = 0; i < D; i++) {
+        double t1 = (aabb.min[i] - origin[i]) * invDirection[i];
+        double t2 = (aabb.max[i] - origin[i]) * invDirection[i];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+            return false;
+    }
+    tEntry = tMin;
+    return true;
+}
+
+/**
+ * @brief Get the squared distance between a point and a bounding box
+ * (0 if the point is inside the box)
+ */
+template <int D, class K, class T, class E>
+inline double BVH<D,K,T,E>::squaredDistanceAABBHelper(
+        const AABB& aabb,
+        const std::array<double, D>& point)
+{
+    double d = 0;
+    for (int i = 0; i < D; i++) {
+        double v = 0;
+        if (point[i] < aabb.min[i])
+            v = aabb.min[i] - point[i];
+        else if (point[i] > aabb.max[i])
+            v = point[i] - aabb.max[i];
+        d += v * v;
+    }
+    return d;
+}
+
+}
@@ -0,0 +1,323 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_FIXED_DIMENSION_RANGETREE_H
+#define CG3_FIXED_DIMENSION_RANGETREE_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+#include "includes/tree_common.h"
+
+#include "includes/iterators/tree_iterator.h"
+#include "includes/iterators/tree_reverseiterator.h"
+#include "includes/iterators/tree_insertiterator.h"
+#include "includes/iterators/tree_rangebased_iterators.h"
+
+#include "includes/nodes/fixed_dimension_rangetree_node.h"
+#include "includes/tree_node_pool.h"
+#include "includes/fixed_dimension_rangetree_shared_data.h"
+
+
+namespace cg3 {
+
+
+/**
+ * @brief Auto-balancing (AVL) multi-dimensional range tree, with the dimension
+ * fixed at compile time
+ *
+ * Values are saved only in the leaves.
+ * No duplicates are allowed.
+ * Keys and values are saved (and copied) in each dimension associated range tree.
+ * Use pointers as template arguments if it is needed to save memory. This choice has
+ * been made because we prefer to allow the user, if needed, to easily implement range
+ * searches in just a subset of the dimensions of the object.
+ *
+ * It is the variant of RangeTree in which the dimension D is a template parameter,
+ * with the same interface except for the dimension argument of the constructors.
+ * The associated range trees of a range tree of dimension D are range trees of
+ * dimension D-1, and the nodes of the first dimension have no pointer to an
+ * associated range tree.
+ * The comparators and the node pool of each dimension are stored once and
+ * shared by the range tree and all its associated range trees.
+ * Iterators always point to the nodes of the range trees of the first dimension.
+ *
+ */
+template <int D, class K, class T = K, class C = DefaultComparatorType<K>>
+class FixedDimensionRangeTree
+{
+
+    static_assert(D > 0, "The dimension of a range tree must be greater than zero.");
+
+    template <int D2, class K2, class T2, class C2>
+    friend class FixedDimensionRangeTree;
+
+
+public:
+
+    /* Typedefs */
+
+    typedef internal::FixedDimensionRangeTreeNode<D,K,T,C> Node;
+    typedef internal::FixedDimensionRangeTreeNode<1,K,T,C> LeafNode;
+
+    typedef internal::TreeNodePool<Node,T> NodePool;
+
+    typedef internal::FixedDimensionRangeTreeSharedData<D,K,T,C> SharedData;
+
+    typedef FixedDimensionRangeTree<D-1,K,T,C> AssociatedRangeTree;
+
+    typedef DefaultComparatorType<K> DefaultComparator;
+
+    typedef TreeGenericIterator<FixedDimensionRangeTree<D,K,T,C>, LeafNode> generic_iterator;
+
+    typedef TreeIterator<FixedDimensionRangeTree<D,K,T,C>, LeafNode, T> iterator;
+    typedef TreeIterator<FixedDimensionRangeTree<D,K,T,C>, LeafNode, const T> const_iterator;
+
+    typedef TreeReverseIterator<FixedDimensionRangeTree<D,K,T,C>, LeafNode, T> reverse_iterator;
+    typedef TreeReverseIterator<FixedDimensionRangeTree<D,K,T,C>, LeafNode, const T> const_reverse_iterator;
+
+    typedef TreeInsertIterator<FixedDimensionRangeTree<D,K,T,C>, K> insert_iterator;
+
+    typedef TreeRangeBasedIterator<FixedDimensionRangeTree<D,K,T,C>> RangeBasedIterator;
+    typedef TreeRangeBasedConstIterator<FixedDimensionRangeTree<D,K,T,C>> RangeBasedConstIterator;
+    typedef TreeRangeBasedReverseIterator<FixedDimensionRangeTree<D,K,T,C>> RangeBasedReverseIterator;
+    typedef TreeRangeBasedConstReverseIterator<FixedDimensionRangeTree<D,K,T,C>> RangeBasedConstReverseIterator;
+
+
+
+    /* Constructors/destructor */
+
+    explicit FixedDimensionRangeTree(const std::vector<C>& customComparators);
+    explicit FixedDimensionRangeTree(const std::vector<std::pair<K,T>>& vec,
+              const std::vector<C>& customComparators);
+    explicit FixedDimensionRangeTree(const std::vector<K>& vec,
+              const std::vector<C>& customComparators);
+
+    FixedDimensionRangeTree(const FixedDimensionRangeTree<D,K,T,C>& bst);
+    FixedDimensionRangeTree(FixedDimensionRangeTree<D,K,T,C>&& bst);
+
+    ~FixedDimensionRangeTree();
+
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    iterator insert(const K& key);
+    iterator insert(const K& key, const T& value);
+
+    bool erase(const K& key);
+
+    iterator find(const K& key);
+
+
+    size_t size();
+    bool empty();
+
+    void clear();
+
+    size_t getHeight();
+
+
+
+    template <class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out);
+
+
+
+    /* Iterator Min/Max Next/Prev */
+
+    iterator getMin();
+    iterator getMax();
+
+    generic_iterator getNext(const generic_iterator it);
+    generic_iterator getPrev(const generic_iterator it);
+
+
+    /* Iterators */
+
+    iterator begin();
+    iterator end();
+
+    const_iterator cbegin();
+    const_iterator cend();
+
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+    const_reverse_iterator crbegin();
+    const_reverse_iterator crend();
+
+    insert_iterator inserter();
+
+    RangeBasedIterator getIterator();
+    RangeBasedConstIterator getConstIterator();
+    RangeBasedReverseIterator getReverseIterator();
+    RangeBasedConstReverseIterator getConstReverseIterator();
+
+
+    /* Swap function and assignment */
+
+    inline FixedDimensionRangeTree<D,K,T,C>& operator= (FixedDimensionRangeTree<D,K,T,C> bst);
+    inline void swap(FixedDimensionRangeTree<D,K,T,C>& bst);
+
+protected:
+
+    /* Typedefs */
+
+    typedef std::integral_constant<bool, (D > 1)> HasAssociatedRangeTree;
+
+
+    /* Protected fields */
+
+    Node* root;
+
+    size_t entries;
+
+    std::shared_ptr<SharedData> sharedData;
+
+
+    /* Protected constructors */
+
+    explicit FixedDimensionRangeTree(const std::shared_ptr<SharedData>& sharedData);
+
+
+    /* Protected methods */
+
+    void initialize();
+
+    Node* copyRangeTreeSubtree(
+            const Node* rootNode,
+            Node* parent = nullptr);
+
+
+    /* Range query helpers */
+
+    inline void rangeQueryHelper(
+            const K& start, const K& end,
+            std::vector<LeafNode*>& out);
+
+
+
+    /* Helpers depending on the dimension (std::true_type if D > 1) */
+
+    inline LeafNode* findLeafHelper(const K& key, std::true_type);
+    inline LeafNode* findLeafHelper(const K& key, std::false_type);
+
+    inline LeafNode* getMinimumLeafHelper(std::true_type);
+    inline LeafNode* getMinimumLeafHelper(std::false_type);
+
+    inline LeafNode* getMaximumLeafHelper(std::true_type);
+    inline LeafNode* getMaximumLeafHelper(std::false_type);
+
+    inline void copyAssociatedTreeHelper(
+            const Node* node, Node* newNode, std::true_type);
+    inline void copyAssociatedTreeHelper(
+            const Node* node, Node* newNode, std::false_type);
+
+    inline void rangeSearchInNextDimensionHelper(
+            Node* node,
+            const K& start, const K& end,
+            std::vector<LeafNode*>& out,
+            std::true_type);
+    inline void rangeSearchInNextDimensionHelper(
+            Node* node,
+            const K& start, const K& end,
+            std::vector<LeafNode*>& out,
+            std::false_type);
+
+
+
+    /* Helpers for associate range trees */
+
+    inline void createAssociatedTreeHelper(
+            Node* node);
+
+    inline void createParentAssociatedTreeHelper(
+            Node* node, std::true_type);
+    inline void createParentAssociatedTreeHelper(
+            Node* node, std::false_type);
+
+    inline void createNewNodeAssociatedTreesHelper(
+            Node* newNode, std::true_type);
+    inline void createNewNodeAssociatedTreesHelper(
+            Node* newNode, std::false_type);
+
+
+
+    inline LeafNode* insertIntoAssociatedTreeHelper(
+            Node* node,
+            const K& key,
+            const T& value);
+
+    inline void insertIntoParentAssociatedTreesHelper(
+            Node* node,
+            const K& key,
+            const T& value,
+            std::true_type);
+    inline void insertIntoParentAssociatedTreesHelper(
+            Node* node,
+            const K& key,
+            const T& value,
+            std::false_type);
+
+
+
+    inline void eraseFromAssociatedTreeHelper(
+            Node* node,
+            const K& key);
+
+    inline void eraseFromParentAssociatedTreesHelper(
+            Node* node,
+            const K& key,
+            std::true_type);
+    inline void eraseFromParentAssociatedTreesHelper(
+            Node* node,
+            const K& key,
+            std::false_type);
+
+
+
+    inline void updateAssociatedTreesAfterRotationHelper(
+            Node* a, Node* b,
+            Node* movedSubtree, Node* otherSubtree,
+            std::true_type);
+    inline void updateAssociatedTreesAfterRotationHelper(
+            Node* a, Node* b,
+            Node* movedSubtree, Node* otherSubtree,
+            std::false_type);
+
+
+
+    /* AVL helpers for range tree */
+
+    inline void rebalanceRangeTreeHelper(Node* node);
+
+    inline void updateHeightAndRebalanceRangeTreeHelper(Node* node);
+
+    inline Node* leftRotateRangeTreeHelper(Node* a);
+
+    inline Node* rightRotateRangeTreeHelper(Node* a);
+
+};
+
+
+template <int D, class K, class T, class C>
+void swap(FixedDimensionRangeTree<D,K,T,C>& b1, FixedDimensionRangeTree<D,K,T,C>& b2);
+
+}
+
+
+#include "fixed_dimension_rangetree.tpp"
+
+
+#endif // CG3_FIXED_DIMENSION_RANGETREE_H
@@ -0,0 +1,1343 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "fixed_dimension_rangetree.h"
+
+#include "assert.h"
+
+#include "cg3/cg3lib.h"
+
+#include "includes/bstleaf_helpers.h"
+#include "includes/avl_helpers.h"
+
+namespace cg3 {
+
+
+/* --------- CONSTRUCTORS/DESTRUCTORS --------- */
+
+
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(
+        const std::vector<C>& customComparators) :
+    sharedData(std::make_shared<SharedData>(customComparators))
+{
+    this->initialize();
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs) to be inserted
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(
+        const std::vector<std::pair<K,T>>& vec,
+        const std::vector<C>& customComparators) :
+    sharedData(std::make_shared<SharedData>(customComparators))
+{
+    this->initialize();
+    this->construction(vec);
+}
+
+
+/**
+ * @brief Constructor with a vector of values to be inserted
+ *
+ * @param[in] vec Vector of values
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(
+        const std::vector<K>& vec,
+        const std::vector<C>& customComparators) :
+    sharedData(std::make_shared<SharedData>(customComparators))
+{
+    this->initialize();
+    this->construction(vec);
+}
+
+/**
+ * @brief Copy constructor
+ * @param rangeTree Range tree
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(const FixedDimensionRangeTree<D,K,T,C>& bst) :
+    sharedData(std::make_shared<SharedData>(*bst.sharedData))
+{
+    this->root = this->copyRangeTreeSubtree(bst.root);
+    this->entries = bst.entries;
+}
+
+/**
+ * @brief Move constructor
+ * @param rangeTree Range tree
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(FixedDimensionRangeTree<D,K,T,C>&& bst) :
+    sharedData(bst.sharedData)
+{
+    this->root = bst.root;
+    bst.root = nullptr;
+    this->entries = bst.entries;
+}
+
+/**
+ * @brief Constructor of an associated range tree, which uses the
+ * comparator and the node pool of its dimension
+ *
+ * @param[in] sharedData Data shared with the other range trees of
+ * the same dimension
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::FixedDimensionRangeTree(
+        const std::shared_ptr<SharedData>& sharedData) :
+    sharedData(sharedData)
+{
+    this->initialize();
+}
+
+/**
+ * @brief Destructor
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>::~FixedDimensionRangeTree()
+{
+    this->clear();
+}
+
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the BST given the initial values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of values
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the BST given the initial values
+ * (pairs of keys/values)
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.size() == 0)
+        return;
+
+    std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
+
+    //Sort the collection
+    C& comparator = sharedData->comparator;
+    internal::PairComparator<K,T,C> pairComparator(comparator);
+    std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
+
+    //Create nodes
+    NodePool& nodePool = sharedData->nodePool;
+    nodePool.reserve(2*sortedVec.size()-1, sortedVec.size());
+    std::vector<Node*> sortedNodes;
+    for (std::pair<K,T>& pair : sortedVec) {
+        Node* node = nodePool.create(pair.first, pair.second);
+        sortedNodes.push_back(node);
+    }
+
+    //Calling the bottom up helper
+    this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
+                sortedNodes,
+                this->root,
+                nodePool,
+                comparator);
+
+    //Update the height of nodes and create their AABBs
+    for (Node*& node : sortedNodes) {
+        if (node != nullptr && node->isLeaf()) {
+            //Update height
+            internal::updateHeightHelper(node);
+
+            //Create associate trees climbing on parents
+            this->createParentAssociatedTreeHelper(node, HasAssociatedRangeTree());
+
+            //Insert new node into associated range trees of the node and the parents
+            this->insertIntoParentAssociatedTreesHelper(node, node->key, *(node->value), HasAssociatedRangeTree());
+        }
+    }
+}
+
+
+
+
+
+/**
+ * @brief Insert in the BST a given value
+ *
+ * @param[in] key Key/value to be inserted
+ * @return The iterator pointing to the node if it has been
+ * successfully inserted, end iterator otherwise
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::insert(const K& key)
+{
+    return insert(key, key);
+}
+
+/**
+ * @brief Insert in the BST a given value with the given key
+ *
+ * If an entry with the same key is already contained, the new
+ * entry will be not inserted
+ *
+ * @param[in] key Key of the entry
+ * @param[in] value Value of the entry
+ * @return The iterator pointing to the node if it has been
+ * successfully inserted, end iterator otherwise
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::insert(
+        const K& key, const T& value)
+{
+    NodePool& nodePool = sharedData->nodePool;
+
+    //Create new node
+    Node* newNode = nodePool.create(key, value);
+
+    //Insert node
+    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, nodePool, sharedData->comparator);
+
+    //If node has been inserted
+    if (result != nullptr) {
+        //Create associated trees for the node and its new parent
+        this->createNewNodeAssociatedTreesHelper(newNode, HasAssociatedRangeTree());
+
+        //Insert new node into associated range trees of the node and the parents
+        this->insertIntoParentAssociatedTreesHelper(
+                    newNode, newNode->key, *(newNode->value), HasAssociatedRangeTree());
+
+
+        //Update height and rebalance
+        this->updateHeightAndRebalanceRangeTreeHelper(newNode);
+
+
+        //Increment entry number
+        this->entries++;
+
+        //Returns the iterator to the node in the range tree of the first dimension:
+        //it is searched after the rebalancing, which can replace the associated
+        //range trees of the nodes involved in the rotations
+        return iterator(this, this->findLeafHelper(key, HasAssociatedRangeTree()));
+    }
+
+    //Returns end iterator
+    return this->end();
+}
+
+
+
+
+/**
+ * @brief Erase value from BST given the key
+ *
+ * @param[in] key Key of the node
+ * @return True if item has been found and then erased, false otherwise
+ */
+template <int D, class K, class T, class C>
+bool FixedDimensionRangeTree<D,K,T,C>::erase(const K& key)
+{
+    //Query the BST to find the node
+    Node* node = internal::findNodeHelperLeaf(key, this->root, sharedData->comparator);
+
+    //If the node has been found
+    if (node != nullptr) {
+
+        //Update associated trees
+        this->eraseFromParentAssociatedTreesHelper(node->parent, node->key, HasAssociatedRangeTree());
+
+        //Erase node
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, sharedData->nodePool);
+
+
+        //Update height and rebalance
+        this->updateHeightAndRebalanceRangeTreeHelper(replacingNode);
+
+        //Decrease the number of entries
+        this->entries--;
+
+        return true;
+    }
+    return false;
+}
+
+
+
+/**
+ * @brief Find entry in the BST given the key
+ *
+ * @param[in] key Key of the node to be found
+ * @return The iterator pointing to the BST node if the element
+ * is contained in the BST, end iterator otherwise
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::find(const K& key)
+{
+    return iterator(this, this->findLeafHelper(key, HasAssociatedRangeTree()));
+}
+
+
+
+
+
+/**
+ * @brief Clear the tree, delete all its elements
+ *
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::clear()
+{
+    //Clear entire tree (nodes are destroyed one by one: the pool
+    //is shared with the associated range trees)
+    internal::clearHelper(this->root, sharedData->nodePool);
+
+    //Decreasing entries
+    this->entries = 0;
+}
+
+
+
+
+/**
+ * @brief Get the number of entries in the range tree
+ *
+ * @return Number of entries
+ */
+template <int D, class K, class T, class C>
+size_t FixedDimensionRangeTree<D,K,T,C>::size()
+{
+    return this->entries;
+}
+
+/**
+ * @brief Check if the tree is empty
+ *
+ * @return True if the range tree is empty
+ */
+template <int D, class K, class T, class C>
+bool FixedDimensionRangeTree<D,K,T,C>::empty()
+{
+    return (this->size() == 0);
+}
+
+
+
+/**
+ * @brief Get max height of the tree
+ *
+ * @return Max height of the tree
+ */
+template <int D, class K, class T, class C>
+size_t FixedDimensionRangeTree<D,K,T,C>::getHeight()
+{
+    return internal::getHeightHelper(this->root);
+}
+
+
+
+
+/**
+ * @brief Find entries in the range tree that are enclosed in a given range.
+ * Start and end are included bounds of the range.
+ *
+ * @param[in] start Starting value of the range
+ * @param[in] end End value of the range
+ * @param[out] out Output iterator for the container containing the iterators
+ * pointing to the nodes in the deepest range tree which have keys enclosed
+ * in the input range
+ */
+template <int D, class K, class T, class C>template <class OutputIterator>
+void FixedDimensionRangeTree<D,K,T,C>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out)
+{
+    //Output
+    std::vector<LeafNode*> nodeOutput;
+
+    //Execute range query
+    this->rangeQueryHelper(start, end, nodeOutput);
+
+    for (LeafNode* node : nodeOutput) {
+        *out = iterator(this, node);
+        out++;
+    }
+}
+
+
+
+/* ----- ITERATOR MIN/MAX NEXT/PREV ----- */
+
+/**
+ * @brief Get minimum key entry in the BST
+ *
+ * @return The iterator pointing to the minimum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::getMin()
+{
+    return iterator(this, this->getMinimumLeafHelper(HasAssociatedRangeTree()));
+}
+
+/**
+ * @brief Get maximum key entry in the BST
+ *
+ * @return The iterator pointing to the maximum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::getMax()
+{
+    return iterator(this, this->getMaximumLeafHelper(HasAssociatedRangeTree()));
+}
+
+
+
+/**
+ * @brief Get successor of a element pointed by iterator
+ *
+ * @param[in] it Iterator pointing to the node
+ * @return The iterator pointing to the successor node (end
+ * iterator if it has no successor)
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::generic_iterator FixedDimensionRangeTree<D,K,T,C>::getNext(generic_iterator it)
+{
+    //Throw exception if the iterator does not belong to this BST
+    if (it.bst != this) {
+        throw new std::runtime_error("A tree can only use its own nodes.");
+    }
+    return generic_iterator(this, internal::getSuccessorHelperLeaf(it.node));
+}
+
+/**
+ * @brief Get predecessor of a element pointed by iterator
+ *
+ * @param[in] it Iterator pointing to the node
+ * @return The iterator pointing to the predecessor node (end
+ * iterator if it has no predecessor)
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::generic_iterator FixedDimensionRangeTree<D,K,T,C>::getPrev(generic_iterator it)
+{
+    //Throw exception if the iterator does not belong to this BST
+    if (it.bst != this) {
+        throw new std::runtime_error("A tree can only use its own nodes.");
+    }
+    return generic_iterator(this, internal::getPredecessorHelperLeaf(it.node));
+}
+
+
+
+/* --------- ITERATORS --------- */
+
+/**
+ * @brief Begin iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::begin()
+{
+    return iterator(this, this->getMinimumLeafHelper(HasAssociatedRangeTree()));
+}
+
+/**
+ * @brief End iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::iterator FixedDimensionRangeTree<D,K,T,C>::end()
+{
+    return iterator(this, nullptr);
+}
+
+
+/**
+ * @brief Begin const iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::const_iterator FixedDimensionRangeTree<D,K,T,C>::cbegin()
+{
+    return const_iterator(this, this->getMinimumLeafHelper(HasAssociatedRangeTree()));
+}
+
+/**
+ * @brief End const iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::const_iterator FixedDimensionRangeTree<D,K,T,C>::cend()
+{
+    return const_iterator(this, nullptr);
+}
+
+
+/**
+ * @brief Begin reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::reverse_iterator FixedDimensionRangeTree<D,K,T,C>::rbegin()
+{
+    return reverse_iterator(this, this->getMaximumLeafHelper(HasAssociatedRangeTree()));
+}
+
+/**
+ * @brief End reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::reverse_iterator FixedDimensionRangeTree<D,K,T,C>::rend()
+{
+    return reverse_iterator(this, nullptr);
+}
+
+
+/**
+ * @brief Begin const reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::const_reverse_iterator FixedDimensionRangeTree<D,K,T,C>::crbegin()
+{
+    return const_reverse_iterator(this, this->getMaximumLeafHelper(HasAssociatedRangeTree()));
+}
+
+/**
+ * @brief End const reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::const_reverse_iterator FixedDimensionRangeTree<D,K,T,C>::crend()
+{
+    return const_reverse_iterator(this, nullptr);
+}
+
+
+
+/**
+ * @brief Insert output iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::insert_iterator FixedDimensionRangeTree<D,K,T,C>::inserter()
+{
+    return insert_iterator(this);
+}
+
+
+
+/**
+ * @brief Get range based iterator of the BST
+ *
+ * @return Range based iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::RangeBasedIterator FixedDimensionRangeTree<D,K,T,C>::getIterator()
+{
+    return RangeBasedIterator(this);
+}
+
+/**
+ * @brief Get range based const iterator of the BST
+ *
+ * @return Range based const iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::RangeBasedConstIterator FixedDimensionRangeTree<D,K,T,C>::getConstIterator()
+{
+    return RangeBasedConstIterator(this);
+}
+
+/**
+ * @brief Get range based reverse iterator of the BST
+ *
+ * @return Range based reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::RangeBasedReverseIterator FixedDimensionRangeTree<D,K,T,C>::getReverseIterator()
+{
+    return RangeBasedReverseIterator(this);
+}
+
+/**
+ * @brief Get range based const reverse iterator of the BST
+ *
+ * @return Range based const reverse iterator
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::RangeBasedConstReverseIterator FixedDimensionRangeTree<D,K,T,C>::getConstReverseIterator()
+{
+    return RangeBasedConstReverseIterator(this);
+}
+
+
+/* ----- SWAP FUNCTION AND ASSIGNMENT ----- */
+
+/**
+ * @brief Assignment operator
+ * @param[out] bst Parameter BST
+ * @return This object
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTree<D,K,T,C>& FixedDimensionRangeTree<D,K,T,C>::operator= (FixedDimensionRangeTree<D,K,T,C> bst)
+{
+    swap(bst);
+    return *this;
+}
+
+
+/**
+ * @brief Swap BST with another one
+ * @param[out] bst BST to be swapped with this object
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::swap(FixedDimensionRangeTree<D,K,T,C>& bst)
+{
+    using std::swap;
+    swap(this->root, bst.root);
+    swap(this->entries, bst.entries);
+    swap(this->sharedData, bst.sharedData);
+}
+
+
+/**
+ * @brief Swap graph with another one
+ * @param b1 First BST
+ * @param b2 Second BST
+ */
+template <int D, class K, class T, class C>
+void swap(FixedDimensionRangeTree<D,K,T,C>& b1, FixedDimensionRangeTree<D,K,T,C>& b2)
+{
+    b1.swap(b2);
+}
+
+
+/* --------- PRIVATE METHODS --------- */
+
+/**
+ * @brief Initialization of the range tree
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::initialize()
+{
+    this->root = nullptr;
+    this->entries = 0;
+}
+
+
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::Node* FixedDimensionRangeTree<D,K,T,C>::copyRangeTreeSubtree(
+        const Node* rootNode,
+        Node* parent)
+{
+    if (rootNode == nullptr)
+        return nullptr;
+
+    Node* newNode = sharedData->nodePool.copy(rootNode);
+
+    newNode->left = this->copyRangeTreeSubtree(rootNode->left, newNode);
+    newNode->right = this->copyRangeTreeSubtree(rootNode->right, newNode);
+    newNode->parent = parent;
+
+    this->copyAssociatedTreeHelper(rootNode, newNode, HasAssociatedRangeTree());
+
+    return newNode;
+}
+
+
+/* --------- RANGE QUERY HELPERS --------- */
+
+/**
+ * @brief Find entries in the range tree that are enclosed in a given range
+ *
+ * @param[in] start Starting value of the range
+ * @param[in] end End value of the range
+ * @param[out] out Container containing the nodes which have keys enclosed
+ * in the input range
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::rangeQueryHelper(
+        const K& start, const K& end,
+        std::vector<LeafNode*>& out)
+{
+    const C& comparator = sharedData->comparator;
+
+    //Find split node
+    Node* splitNode = internal::findSplitNodeHelperLeaf(start, end, this->root, comparator);
+
+    if (splitNode == nullptr)
+        return;
+
+    //If the split node is a leaf
+    if (splitNode->isLeaf()) {
+        //Report the node if it is contained in the range
+        if (internal::isGreaterOrEqual(splitNode->key, start, comparator) &&
+                internal::isLessOrEqual(splitNode->key, end, comparator))
+        {
+            this->rangeSearchInNextDimensionHelper(splitNode, start, end, out, HasAssociatedRangeTree());
+        }
+    }
+    //If the split node is not a leaf
+    else {
+        //Follow path from splitNode to start and report right subtrees
+        Node* vl = splitNode->left;
+        while (!vl->isLeaf()) {
+            if (internal::isLess(start, vl->key, comparator)) {
+                this->rangeSearchInNextDimensionHelper(vl->right, start, end, out, HasAssociatedRangeTree());
+                vl = vl->left;
+            }
+            else {
+                vl = vl->right;
+            }
+        }
+        //Report the node if it is contained in the range
+        if (internal::isGreaterOrEqual(vl->key, start, comparator) &&
+                internal::isLessOrEqual(vl->key, end, comparator))
+        {
+            this->rangeSearchInNextDimensionHelper(vl, start, end, out, HasAssociatedRangeTree());
+        }
+
+        //Follow path from splitNode to end and report left subtrees
+        Node* vr = splitNode->right;
+        while (!vr->isLeaf()) {
+            if (internal::isGreaterOrEqual(end, vr->key, comparator)) {
+                this->rangeSearchInNextDimensionHelper(vr->left, start, end, out, HasAssociatedRangeTree());
+                vr = vr->right;
+            }
+            else {
+                vr = vr->left;
+            }
+        }
+        //Report the node if it is contained in the range
+        if (internal::isGreaterOrEqual(vr->key, start, comparator) &&
+                internal::isLessOrEqual(vr->key, end, comparator)) {
+            this->rangeSearchInNextDimensionHelper(vr, start, end, out, HasAssociatedRangeTree());
+        }
+    }
+
+}
+
+
+/**
+ * @brief Range search in next dimension or report the subtree
+ *
+ * @param[in] node Root of the subtree
+ * @param[in] start Starting value of the range
+ * @param[in] end End value of the range
+ * @param[out] out Container containing the nodes which have keys enclosed
+ * in the input range
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::rangeSearchInNextDimensionHelper(
+        Node* node,
+        const K& start,
+        const K& end,
+        std::vector<LeafNode*>& out,
+        std::true_type)
+{
+    node->assRangeTree->rangeQueryHelper(start, end, out);
+}
+
+/**
+ * @brief Report the subtree (first dimension)
+ *
+ * @param[in] node Root of the subtree
+ * @param[in] start Starting value of the range
+ * @param[in] end End value of the range
+ * @param[out] out Container containing the nodes which have keys enclosed
+ * in the input range
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::rangeSearchInNextDimensionHelper(
+        Node* node,
+        const K& start,
+        const K& end,
+        std::vector<LeafNode*>& out,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(start);
+    CG3_SUPPRESS_WARNING(end);
+    internal::reportSubTreeHelperLeaf(node, out);
+}
+
+
+
+/* ----- HELPERS FOR THE NODES OF THE FIRST DIMENSION ----- */
+
+/**
+ * @brief Find the node of the first dimension given the key
+ *
+ * @param[in] key Key of the node to be found
+ * @return The node of the range tree of the first dimension
+ * associated to the root, nullptr if the key is not contained
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::findLeafHelper(
+        const K& key,
+        std::true_type)
+{
+    if (this->root == nullptr)
+        return nullptr;
+
+    return this->root->assRangeTree->findLeafHelper(key, typename AssociatedRangeTree::HasAssociatedRangeTree());
+}
+
+/**
+ * @brief Find the node given the key (first dimension)
+ *
+ * @param[in] key Key of the node to be found
+ * @return The node, nullptr if the key is not contained
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::findLeafHelper(
+        const K& key,
+        std::false_type)
+{
+    return internal::findNodeHelperLeaf(key, this->root, sharedData->comparator);
+}
+
+/**
+ * @brief Get the minimum node of the range tree of the first
+ * dimension associated to the root
+ *
+ * @return The minimum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::getMinimumLeafHelper(
+        std::true_type)
+{
+    if (this->root == nullptr)
+        return nullptr;
+
+    return this->root->assRangeTree->getMinimumLeafHelper(typename AssociatedRangeTree::HasAssociatedRangeTree());
+}
+
+/**
+ * @brief Get the minimum node (first dimension)
+ *
+ * @return The minimum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::getMinimumLeafHelper(
+        std::false_type)
+{
+    return internal::getMinimumHelperLeaf(this->root);
+}
+
+/**
+ * @brief Get the maximum node of the range tree of the first
+ * dimension associated to the root
+ *
+ * @return The maximum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::getMaximumLeafHelper(
+        std::true_type)
+{
+    if (this->root == nullptr)
+        return nullptr;
+
+    return this->root->assRangeTree->getMaximumLeafHelper(typename AssociatedRangeTree::HasAssociatedRangeTree());
+}
+
+/**
+ * @brief Get the maximum node (first dimension)
+ *
+ * @return The maximum node
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::getMaximumLeafHelper(
+        std::false_type)
+{
+    return internal::getMaximumHelperLeaf(this->root);
+}
+
+
+
+/* ----- HELPERS FOR ASSOCIATED RANGE TREE ----- */
+
+/**
+ * @brief Copy the associated tree of a node in the copy of the node
+ *
+ * @param[in] node Node
+ * @param[out] newNode Copy of the node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::copyAssociatedTreeHelper(
+        const Node* node,
+        Node* newNode,
+        std::true_type)
+{
+    if (node->assRangeTree != nullptr) {
+        const AssociatedRangeTree* assRangeTree = node->assRangeTree;
+
+        this->createAssociatedTreeHelper(newNode);
+        newNode->assRangeTree->root = newNode->assRangeTree->copyRangeTreeSubtree(assRangeTree->root);
+        newNode->assRangeTree->entries = assRangeTree->entries;
+    }
+}
+
+/**
+ * @brief Copy the associated tree of a node: nothing to do in
+ * the first dimension
+ *
+ * @param[in] node Node
+ * @param[out] newNode Copy of the node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::copyAssociatedTreeHelper(
+        const Node* node,
+        Node* newNode,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(node);
+    CG3_SUPPRESS_WARNING(newNode);
+}
+
+/**
+ * @brief Create associated tree helper for a node. The associated
+ * tree uses the shared data of the next dimension.
+ *
+ * @param[in] node Node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::createAssociatedTreeHelper(
+        Node *node)
+{
+    std::shared_ptr<typename AssociatedRangeTree::SharedData> nextSharedData(
+                this->sharedData, &this->sharedData->next);
+
+    node->assRangeTree = new AssociatedRangeTree(nextSharedData);
+}
+
+
+
+/**
+ * @brief Create associated tree helper for a node
+ * climbing on parents (the input node is included)
+ *
+ * @param[in] node Node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::createParentAssociatedTreeHelper(
+        Node *node,
+        std::true_type)
+{
+    while (node != nullptr && node->assRangeTree == nullptr) {
+        //Insert into associated range tree
+        createAssociatedTreeHelper(node);
+
+        //Next parent
+        node = node->parent;
+    }
+}
+
+/**
+ * @brief Create associated tree helper for a node climbing on
+ * parents: nothing to do in the first dimension
+ *
+ * @param[in] node Node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::createParentAssociatedTreeHelper(
+        Node *node,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(node);
+}
+
+/**
+ * @brief Create the associated trees of a new node and of its parent,
+ * which has been created by the insertion. The other child of the
+ * parent is inserted in the associated tree of the parent.
+ *
+ * @param[in] newNode New node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::createNewNodeAssociatedTreesHelper(
+        Node* newNode,
+        std::true_type)
+{
+    //New node parent
+    Node* newParent = newNode->parent;
+
+    //Getting other child of the parent
+    if (newParent != nullptr) {
+        Node* otherNode = nullptr;
+
+        if (newParent->left == newNode) {
+            otherNode = newParent->right;
+        }
+        else {
+            otherNode = newParent->left;
+        }
+
+        //Create associated tree for the parent
+        this->createAssociatedTreeHelper(newParent);
+        //Insert into associated range tree of the parent the node
+        this->insertIntoAssociatedTreeHelper(newParent, otherNode->key, *(otherNode->value));
+    }
+
+    //Create associated tree for the node
+    this->createAssociatedTreeHelper(newNode);
+}
+
+/**
+ * @brief Create the associated trees of a new node: nothing to do
+ * in the first dimension
+ *
+ * @param[in] newNode New node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::createNewNodeAssociatedTreesHelper(
+        Node* newNode,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(newNode);
+}
+
+
+/**
+ * @brief Insert into associated range tree key/value of the node
+ *
+ * @param[in] node Node for which the new node will be inserted into
+ * its associated range tree
+ * @param[in] key Key of new node
+ * @param[in] value Value of new node
+ * @return The inserted node in the range tree of the first dimension
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::LeafNode* FixedDimensionRangeTree<D,K,T,C>::insertIntoAssociatedTreeHelper(
+        Node* node,
+        const K& key,
+        const T& value)
+{
+    //Insert into associated range tree
+    auto it = node->assRangeTree->insert(key, value);
+    return it.node;
+}
+
+
+
+/**
+ * @brief Insert into associated range trees the current key and value
+ * climbing on parents (the input node is included)
+ *
+ * @param[in] node Node from which the climbing starts
+ * @param[in] key Key of new node
+ * @param[in] value Value of new node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::insertIntoParentAssociatedTreesHelper(
+        Node* node,
+        const K& key,
+        const T& value,
+        std::true_type)
+{
+    while (node != nullptr) {
+        //Insert into associated range tree
+        insertIntoAssociatedTreeHelper(node, key, value);
+
+        //Next parent
+        node = node->parent;
+    }
+}
+
+/**
+ * @brief Insert into associated range trees the current key and value
+ * climbing on parents: nothing to do in the first dimension
+ *
+ * @param[in] node Node from which the climbing starts
+ * @param[in] key Key of new node
+ * @param[in] value Value of new node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::insertIntoParentAssociatedTreesHelper(
+        Node* node,
+        const K& key,
+        const T& value,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(node);
+    CG3_SUPPRESS_WARNING(key);
+    CG3_SUPPRESS_WARNING(value);
+}
+
+
+/**
+ * @brief Erase from associated range tree key/value of the node
+ *
+ * @param[in] node Node for which the node will be erase from its
+ * associated range tree
+ * @param[in] key Key of the node to be deleted
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::eraseFromAssociatedTreeHelper(
+        Node* node,
+        const K& key)
+{
+    //Erase from associated range tree
+    node->assRangeTree->erase(key);
+}
+
+
+
+/**
+ * @brief Erase from associated range trees the current key climbing
+ * on parents (the input node is included)
+ *
+ * @param[in] node Node from which the climbing starts
+ * @param[in] key Key of new node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::eraseFromParentAssociatedTreesHelper(
+        Node* node,
+        const K& key,
+        std::true_type)
+{
+    while (node != nullptr) {
+        //Erase from associated range tree
+        eraseFromAssociatedTreeHelper(node, key);
+
+        //Next parent
+        node = node->parent;
+    }
+}
+
+/**
+ * @brief Erase from associated range trees the current key climbing
+ * on parents: nothing to do in the first dimension
+ *
+ * @param[in] node Node from which the climbing starts
+ * @param[in] key Key of new node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::eraseFromParentAssociatedTreesHelper(
+        Node* node,
+        const K& key,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(node);
+    CG3_SUPPRESS_WARNING(key);
+}
+
+
+/**
+ * @brief Update the associated trees after a rotation
+ *
+ * @param[in] a Rotated node
+ * @param[in] b New node in the position of the rotated node
+ * @param[in] movedSubtree Subtree which is no longer a descendant of a
+ * @param[in] otherSubtree Subtree which is now also a descendant of b
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::updateAssociatedTreesAfterRotationHelper(
+        Node* a,
+        Node* b,
+        Node* movedSubtree,
+        Node* otherSubtree,
+        std::true_type)
+{
+    if (otherSubtree != nullptr) {
+        //Insert the other subtree into b associated tree
+        for (auto it = otherSubtree->assRangeTree->begin(); it != otherSubtree->assRangeTree->end(); it++) {
+            LeafNode* otherNode = it.node;
+            insertIntoAssociatedTreeHelper(b, otherNode->key, *(otherNode->value));
+        }
+    }
+    //Erase the moved subtree from a associated tree
+    for (auto it = movedSubtree->assRangeTree->begin(); it != movedSubtree->assRangeTree->end(); it++) {
+        LeafNode* movedNode = it.node;
+        eraseFromAssociatedTreeHelper(a, movedNode->key);
+    }
+}
+
+/**
+ * @brief Update the associated trees after a rotation: nothing to
+ * do in the first dimension
+ *
+ * @param[in] a Rotated node
+ * @param[in] b New node in the position of the rotated node
+ * @param[in] movedSubtree Subtree which is no longer a descendant of a
+ * @param[in] otherSubtree Subtree which is now also a descendant of b
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::updateAssociatedTreesAfterRotationHelper(
+        Node* a,
+        Node* b,
+        Node* movedSubtree,
+        Node* otherSubtree,
+        std::false_type)
+{
+    CG3_SUPPRESS_WARNING(a);
+    CG3_SUPPRESS_WARNING(b);
+    CG3_SUPPRESS_WARNING(movedSubtree);
+    CG3_SUPPRESS_WARNING(otherSubtree);
+}
+
+
+
+
+/* ----- AVL HELPERS FOR RANGE TREE ----- */
+
+/**
+ * @brief Rebalance with left/right rotations to make the
+ * FixedDimensionRangeTree satisfy the AVL constraints
+ *
+ * @param[in] node Starting node
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::rebalanceRangeTreeHelper(
+        Node* node)
+{
+    //Null handler
+    if (node == nullptr)
+        return;
+
+    //Not balanced node
+    Node* n = node;
+    int balanceFactor = (int)(getHeightHelper(n->right) - getHeightHelper(n->left));
+
+    //Climb on parents to find the not balanced node
+    while (n != nullptr && balanceFactor >= -1 && balanceFactor <= 1) {
+        n = n->parent;
+
+        if (n != nullptr) {
+            //Compute balance factor
+            balanceFactor = (int)(getHeightHelper(n->right) - getHeightHelper(n->left));
+
+            assert(balanceFactor <= 2 && balanceFactor >= -2);
+        }
+    }
+
+
+    if (n != nullptr) {
+        assert(balanceFactor == 2 || balanceFactor == -2);
+        if (balanceFactor < -1) {
+            Node* leftleft = n->left->left;
+            Node* leftright = n->left->right;
+
+            //Left left case
+            if (getHeightHelper(leftleft) >= getHeightHelper(leftright)) {
+                n = rightRotateRangeTreeHelper(n);
+            }
+            //Left right case
+            else {
+                n->left = leftRotateRangeTreeHelper(n->left);
+                n = rightRotateRangeTreeHelper(n);
+            }
+        }
+        else if (balanceFactor > 1) {
+            Node* rightright = n->right->right;
+            Node* rightleft = n->right->left;
+
+            //Right right case
+            if (getHeightHelper(rightright) >= getHeightHelper(rightleft)) {
+                n = leftRotateRangeTreeHelper(n);
+            }
+            //Left right case
+            else {
+                n->right = rightRotateRangeTreeHelper(n->right);
+                n = leftRotateRangeTreeHelper(n);
+            }
+        }
+
+
+        //Set root
+        if (n->parent == nullptr) {
+            this->root = n;
+        }
+
+        //Update heights on parents and rebalance them if needed
+        updateHeightAndRebalanceRangeTreeHelper(n->parent);
+
+    }
+}
+
+
+
+/**
+ * @brief Update heights climbing on the parents and then
+ * rebalance them if needed
+ *
+ * @param[in] node Starting node
+ * @param[in] node Root node of the BST
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTree<D,K,T,C>::updateHeightAndRebalanceRangeTreeHelper(
+        Node* node)
+{
+    internal::updateHeightHelper(node);
+    this->rebalanceRangeTreeHelper(node);
+}
+
+
+
+/**
+ * @brief Left rotation
+ *
+ * @param[in] a Node to be rotated
+ * @return New node in the position of the original node after the rotation
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::Node* FixedDimensionRangeTree<D,K,T,C>::leftRotateRangeTreeHelper(Node* a)
+{
+    //Rotate left
+    Node* b = internal::leftRotateHelper(a);
+
+    //Update associated trees
+    this->updateAssociatedTreesAfterRotationHelper(a, b, b->right, a->left, HasAssociatedRangeTree());
+
+    return b;
+}
+
+/**
+ * @brief Right rotation
+ *
+ * @param[in] a Node to be rotated
+ * @return New node in the position of the original node after the rotation
+ */
+template <int D, class K, class T, class C>
+typename FixedDimensionRangeTree<D,K,T,C>::Node* FixedDimensionRangeTree<D,K,T,C>::rightRotateRangeTreeHelper(Node* a)
+{
+    //Rotate right
+    Node* b = internal::rightRotateHelper(a);
+
+    //Update associated trees
+    this->updateAssociatedTreesAfterRotationHelper(a, b, b->left, a->right, HasAssociatedRangeTree());
+
+    return b;
+}
+
+
+
+}
@@ -9,7 +9,13 @@
 
 #include "tree_common.h"
 
+#include "bstleaf_helpers.h"
+#include "bstinner_helpers.h"
+
+#include "nodes/avl_node.h"
+
 #include <vector>
+#include <memory>
 
 namespace cg3 {
 
@@ -38,6 +44,72 @@ inline Node* leftRotateHelper(Node* a);
 template <class Node>
 inline Node* rightRotateHelper(Node* a);
 
+
+/* Subtree size helpers */
+
+template <class Node>
+inline void updateNodeSizeHelper(Node* node);
+
+template <class K, class T>
+inline void updateNodeSizeHelper(AVLNode<K,T>* node);
+
+template <class Node>
+inline TreeSize getSizeHelper(const Node* node);
+
+template <class Node>
+inline void updateSizeHelper(Node* node);
+
+template <class Node>
+inline TreeSize computeSizeHelper(Node* node);
+
+
+/* Order statistic helpers */
+
+template <class Node, class K, class C>
+inline TreeSize rankHelperLeaf(const K& key, Node* rootNode, C& comparator);
+
+template <class Node, class K, class C>
+inline TreeSize rankHelperInner(const K& key, Node* rootNode, C& comparator);
+
+template <class Node>
+inline Node* selectHelperLeaf(TreeSize index, Node* rootNode);
+
+template <class Node>
+inline Node* selectHelperInner(TreeSize index, Node* rootNode);
+
+
+/* Split/join helpers */
+
+template <class Node>
+inline Node* joinHelper(Node* leftRoot, Node* middleNode, Node* rightRoot);
+
+template <class Node, class NodePool>
+inline Node* joinHelperLeaf(Node* leftRoot, Node* rightRoot, NodePool& nodePool);
+
+template <class Node>
+inline Node* joinHelperInner(Node* leftRoot, Node* rightRoot);
+
+template <class Node, class K, class C, class NodePool>
+inline void splitHelperLeaf(
+        const K& key,
+        Node* rootNode,
+        Node*& leftRoot, Node*& rightRoot,
+        NodePool& nodePool,
+        C& comparator);
+
+template <class Node, class K, class C>
+inline void splitHelperInner(
+        const K& key,
+        Node* rootNode,
+        Node*& leftRoot, Node*& rightRoot,
+        C& comparator);
+
+template <class Node, class NodePool>
+inline void joinNodePoolsHelper(
+        std::shared_ptr<NodePool>& nodePool,
+        std::shared_ptr<NodePool>& otherNodePool,
+        Node*& otherRootNode);
+
 }
 
 }
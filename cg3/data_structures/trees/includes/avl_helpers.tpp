@@ -8,6 +8,8 @@
 
 #include "assert.h"
 
+#include "cg3/cg3lib.h"
+
 namespace cg3 {
 
 namespace internal {
@@ -177,6 +179,10 @@ Node* leftRotateHelper(Node* a)
     //Update heights
     updateHeightHelper(a);
 
+    //Update the number of entries of the subtrees
+    updateNodeSizeHelper(a);
+    updateNodeSizeHelper(b);
+
     return b;
 }
 
@@ -211,9 +217,552 @@ Node* rightRotateHelper(Node* a)
     //Update heights
     updateHeightHelper(a);
 
+    //Update the number of entries of the subtrees
+    updateNodeSizeHelper(a);
+    updateNodeSizeHelper(b);
+
     return b;
 }
 
+
+
+
+/* ----- SUBTREE SIZE HELPERS ----- */
+
+/**
+ * @brief Update the number of entries of the subtree rooted in a node,
+ * given the ones of its children. Nodes which do not store the number of
+ * entries (e.g. range tree and AABB tree nodes) are not modified.
+ *
+ * @param[in] node Node
+ */
+template <class Node>
+void updateNodeSizeHelper(Node* node)
+{
+    CG3_SUPPRESS_WARNING(node);
+}
+
+/**
+ * @brief Update the number of entries of the subtree rooted in an AVL node,
+ * given the ones of its children
+ *
+ * @param[in] node Node
+ */
+template <class K, class T>
+void updateNodeSizeHelper(AVLNode<K,T>* node)
+{
+    node->size = (node->value != nullptr ? 1 : 0) +
+            getSizeHelper(node->left) +
+            getSizeHelper(node->right);
+}
+
+/**
+ * @brief Get the number of entries of the subtree rooted in a node
+ *
+ * @param[in] node Root node
+ * @return Number of entries of the subtree
+ */
+template <class Node>
+TreeSize getSizeHelper(const Node* node)
+{
+    if (node == nullptr)
+        return 0;
+
+    return node->size;
+}
+
+/**
+ * @brief Update the number of entries of the subtrees climbing on the
+ * parents (the input node is included)
+ *
+ * @param[in] node Starting node
+ */
+template <class Node>
+void updateSizeHelper(Node* node)
+{
+    while (node != nullptr) {
+        updateNodeSizeHelper(node);
+
+        //Next parent
+        node = node->parent;
+    }
+}
+
+/**
+ * @brief Compute the number of entries of all the subtrees of a
+ * subtree (e.g. after the construction of the BST)
+ *
+ * @param[in] node Root node of the subtree
+ * @return Number of entries of the subtree
+ */
+template <class Node>
+TreeSize computeSizeHelper(Node* node)
+{
+    if (node == nullptr)
+        return 0;
+
+    computeSizeHelper(node->left);
+    computeSizeHelper(node->right);
+
+    updateNodeSizeHelper(node);
+
+    return node->size;
+}
+
+
+
+/* ----- ORDER STATISTIC HELPERS ----- */
+
+/**
+ * @brief Get the number of entries with a key lower than a given
+ * key (entries only in the leaves)
+ *
+ * @param[in] key Input key
+ * @param[in] rootNode Root node of the BST
+ * @param[in] comparator Less comparator for keys
+ * @return Number of entries with a lower key
+ */
+template <class Node, class K, class C>
+TreeSize rankHelperLeaf(const K& key, Node* rootNode, C& comparator)
+{
+    TreeSize rank = 0;
+
+    Node* node = rootNode;
+
+    //Travel in the BST until the node is a leaf
+    while (node != nullptr && !node->isLeaf()) {
+        //The keys of the left subtree are all lower than the key of the node
+        if (isLess(node->key, key, comparator)) {
+            rank += getSizeHelper(node->left);
+            node = node->right;
+        }
+        else {
+            node = node->left;
+        }
+    }
+
+    if (node != nullptr && isLess(node->key, key, comparator)) {
+        rank++;
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Get the number of entries with a key lower than a given
+ * key (entries in all the nodes)
+ *
+ * @param[in] key Input key
+ * @param[in] rootNode Root node of the BST
+ * @param[in] comparator Less comparator for keys
+ * @return Number of entries with a lower key
+ */
+template <class Node, class K, class C>
+TreeSize rankHelperInner(const K& key, Node* rootNode, C& comparator)
+{
+    TreeSize rank = 0;
+
+    Node* node = rootNode;
+
+    while (node != nullptr) {
+        //The node and its left subtree are lower than the key
+        if (isLess(node->key, key, comparator)) {
+            rank += getSizeHelper(node->left) + 1;
+            node = node->right;
+        }
+        else {
+            node = node->left;
+        }
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Get the entry in a given position of the BST, in the
+ * order of the keys (entries only in the leaves)
+ *
+ * @param[in] index Position of the entry, starting from 0
+ * @param[in] rootNode Root node of the BST
+ * @return The node of the entry, nullptr if the index is not
+ * lower than the number of entries
+ */
+template <class Node>
+Node* selectHelperLeaf(TreeSize index, Node* rootNode)
+{
+    if (index >= getSizeHelper(rootNode))
+        return nullptr;
+
+    Node* node = rootNode;
+
+    //Travel in the BST until the node is a leaf
+    while (!node->isLeaf()) {
+        TreeSize leftSize = getSizeHelper(node->left);
+
+        if (index < leftSize) {
+            node = node->left;
+        }
+        else {
+            index -= leftSize;
+            node = node->right;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Get the entry in a given position of the BST, in the
+ * order of the keys (entries in all the nodes)
+ *
+ * @param[in] index Position of the entry, starting from 0
+ * @param[in] rootNode Root node of the BST
+ * @return The node of the entry, nullptr if the index is not
+ * lower than the number of entries
+ */
+template <class Node>
+Node* selectHelperInner(TreeSize index, Node* rootNode)
+{
+    Node* node = rootNode;
+
+    while (node != nullptr) {
+        TreeSize leftSize = getSizeHelper(node->left);
+
+        if (index < leftSize) {
+            node = node->left;
+        }
+        else if (index == leftSize) {
+            return node;
+        }
+        else {
+            index -= leftSize + 1;
+            node = node->right;
+        }
+    }
+
+    return nullptr;
+}
+
+
+
+/* ----- SPLIT/JOIN HELPERS ----- */
+
+/**
+ * @brief Join two AVL trees and a node, given that the keys of the left
+ * tree are lower than the key of the node, and the keys of the right tree
+ * are greater than (or equal to, in the trees with entries only in the
+ * leaves) the key of the node.
+ *
+ * The node is attached to the spine of the higher tree, in which the
+ * heights differ at most by one, and then the tree is rebalanced. The
+ * cost is linear in the difference between the heights of the trees.
+ *
+ * @param[in] leftRoot Root of the left tree (it can be nullptr)
+ * @param[in] middleNode Node to be used as middle node
+ * @param[in] rightRoot Root of the right tree (it can be nullptr)
+ * @return Root of the joined tree
+ */
+template <class Node>
+Node* joinHelper(Node* leftRoot, Node* middleNode, Node* rightRoot)
+{
+    TreeSize leftHeight = getHeightHelper(leftRoot);
+    TreeSize rightHeight = getHeightHelper(rightRoot);
+
+    Node* rootNode;
+    Node* parent = nullptr;
+
+    //The left tree is higher: climb down on its right spine
+    if (leftHeight > rightHeight + 1) {
+        Node* node = leftRoot;
+        while (getHeightHelper(node) > rightHeight + 1) {
+            parent = node;
+            node = node->right;
+        }
+
+        middleNode->left = node;
+        middleNode->right = rightRoot;
+        parent->right = middleNode;
+
+        rootNode = leftRoot;
+    }
+    //The right tree is higher: climb down on its left spine
+    else if (rightHeight > leftHeight + 1) {
+        Node* node = rightRoot;
+        while (getHeightHelper(node) > leftHeight + 1) {
+            parent = node;
+            node = node->left;
+        }
+
+        middleNode->left = leftRoot;
+        middleNode->right = node;
+        parent->left = middleNode;
+
+        rootNode = rightRoot;
+    }
+    //The middle node is the new root
+    else {
+        middleNode->left = leftRoot;
+        middleNode->right = rightRoot;
+
+        rootNode = middleNode;
+    }
+
+    //Setting parents
+    middleNode->parent = parent;
+    if (middleNode->left != nullptr)
+        middleNode->left->parent = middleNode;
+    if (middleNode->right != nullptr)
+        middleNode->right->parent = middleNode;
+
+    //Update the number of entries of the subtrees
+    updateSizeHelper(middleNode);
+
+    //Update height and rebalance
+    updateHeightAndRebalanceHelper(middleNode, rootNode);
+
+    return rootNode;
+}
+
+/**
+ * @brief Join two AVL trees with entries only in the leaves, given that
+ * the keys of the left tree are lower than the keys of the right tree
+ *
+ * @param[in] leftRoot Root of the left tree (it can be nullptr)
+ * @param[in] rightRoot Root of the right tree (it can be nullptr)
+ * @param[in] nodePool Pool in which the new inner node is created
+ * @return Root of the joined tree
+ */
+template <class Node, class NodePool>
+Node* joinHelperLeaf(Node* leftRoot, Node* rightRoot, NodePool& nodePool)
+{
+    if (leftRoot == nullptr)
+        return rightRoot;
+    if (rightRoot == nullptr)
+        return leftRoot;
+
+    //The key of the new inner node is the minimum of the right tree
+    Node* middleNode = nodePool.create(getMinimumHelperLeaf(rightRoot)->key);
+
+    return joinHelper(leftRoot, middleNode, rightRoot);
+}
+
+/**
+ * @brief Join two AVL trees with entries in all the nodes, given that
+ * the keys of the left tree are lower than the keys of the right tree
+ *
+ * @param[in] leftRoot Root of the left tree (it can be nullptr)
+ * @param[in] rightRoot Root of the right tree (it can be nullptr)
+ * @return Root of the joined tree
+ */
+template <class Node>
+Node* joinHelperInner(Node* leftRoot, Node* rightRoot)
+{
+    if (leftRoot == nullptr)
+        return rightRoot;
+    if (rightRoot == nullptr)
+        return leftRoot;
+
+    //The minimum of the right tree is the middle node
+    Node* middleNode = getMinimumHelperInner(rightRoot);
+    Node* parent = middleNode->parent;
+
+    //Detach the middle node (it has no left child)
+    replaceSubtreeHelper(middleNode, middleNode->right, rightRoot);
+
+    //Update the right tree
+    updateSizeHelper(parent);
+    updateHeightAndRebalanceHelper(parent, rightRoot);
+
+    middleNode->parent = nullptr;
+    middleNode->left = nullptr;
+    middleNode->right = nullptr;
+
+    return joinHelper(leftRoot, middleNode, rightRoot);
+}
+
+/**
+ * @brief Split an AVL tree with entries only in the leaves in the tree
+ * of the keys lower than a given key and the tree of the keys greater
+ * than or equal to it.
+ *
+ * The inner nodes on the path of the key are reused to join the subtrees,
+ * therefore the cost is logarithmic in the number of entries.
+ *
+ * @param[in] key Input key
+ * @param[in] rootNode Root of the tree to be split
+ * @param[out] leftRoot Root of the tree of the lower keys
+ * @param[out] rightRoot Root of the tree of the greater or equal keys
+ * @param[in] nodePool Pool of the nodes of the tree
+ * @param[in] comparator Less comparator for keys
+ */
+template <class Node, class K, class C, class NodePool>
+void splitHelperLeaf(
+        const K& key,
+        Node* rootNode,
+        Node*& leftRoot, Node*& rightRoot,
+        NodePool& nodePool,
+        C& comparator)
+{
+    leftRoot = nullptr;
+    rightRoot = nullptr;
+
+    if (rootNode == nullptr)
+        return;
+
+    rootNode->parent = nullptr;
+
+    //The leaf is in one of the trees
+    if (rootNode->isLeaf()) {
+        if (isLess(rootNode->key, key, comparator)) {
+            leftRoot = rootNode;
+        }
+        else {
+            rightRoot = rootNode;
+        }
+        return;
+    }
+
+    //Detach the children
+    Node* leftChild = rootNode->left;
+    Node* rightChild = rootNode->right;
+
+    rootNode->left = nullptr;
+    rootNode->right = nullptr;
+    leftChild->parent = nullptr;
+    rightChild->parent = nullptr;
+
+    Node* splitLeftRoot;
+    Node* splitRightRoot;
+
+    //The right subtree contains only greater or equal keys
+    if (!isLess(rootNode->key, key, comparator)) {
+        splitHelperLeaf(key, leftChild, splitLeftRoot, splitRightRoot, nodePool, comparator);
+
+        leftRoot = splitLeftRoot;
+
+        if (splitRightRoot == nullptr) {
+            nodePool.destroy(rootNode);
+            rightRoot = rightChild;
+        }
+        else {
+            rightRoot = joinHelper(splitRightRoot, rootNode, rightChild);
+        }
+    }
+    //The left subtree contains only lower keys
+    else {
+        splitHelperLeaf(key, rightChild, splitLeftRoot, splitRightRoot, nodePool, comparator);
+
+        if (splitLeftRoot == nullptr) {
+            nodePool.destroy(rootNode);
+            leftRoot = leftChild;
+        }
+        else {
+            leftRoot = joinHelper(leftChild, rootNode, splitLeftRoot);
+        }
+
+        rightRoot = splitRightRoot;
+    }
+}
+
+/**
+ * @brief Split an AVL tree with entries in all the nodes in the tree
+ * of the keys lower than a given key and the tree of the keys greater
+ * than or equal to it.
+ *
+ * The nodes on the path of the key are used to join the subtrees,
+ * therefore the cost is logarithmic in the number of entries.
+ *
+ * @param[in] key Input key
+ * @param[in] rootNode Root of the tree to be split
+ * @param[out] leftRoot Root of the tree of the lower keys
+ * @param[out] rightRoot Root of the tree of the greater or equal keys
+ * @param[in] comparator Less comparator for keys
+ */
+template <class Node, class K, class C>
+void splitHelperInner(
+        const K& key,
+        Node* rootNode,
+        Node*& leftRoot, Node*& rightRoot,
+        C& comparator)
+{
+    leftRoot = nullptr;
+    rightRoot = nullptr;
+
+    if (rootNode == nullptr)
+        return;
+
+    //Detach the children
+    Node* leftChild = rootNode->left;
+    Node* rightChild = rootNode->right;
+
+    rootNode->parent = nullptr;
+    rootNode->left = nullptr;
+    rootNode->right = nullptr;
+    if (leftChild != nullptr)
+        leftChild->parent = nullptr;
+    if (rightChild != nullptr)
+        rightChild->parent = nullptr;
+
+    Node* splitLeftRoot;
+    Node* splitRightRoot;
+
+    //The node and its left subtree are in the left tree
+    if (isLess(rootNode->key, key, comparator)) {
+        splitHelperInner(key, rightChild, splitLeftRoot, splitRightRoot, comparator);
+
+        leftRoot = joinHelper(leftChild, rootNode, splitLeftRoot);
+        rightRoot = splitRightRoot;
+    }
+    //The node and its right subtree are in the right tree
+    else {
+        splitHelperInner(key, leftChild, splitLeftRoot, splitRightRoot, comparator);
+
+        leftRoot = splitLeftRoot;
+        rightRoot = joinHelper(splitRightRoot, rootNode, rightChild);
+    }
+}
+
+/**
+ * @brief Make the nodes of a tree, which is going to be joined to
+ * another one, belong to the pool of the other tree.
+ *
+ * Nothing is done if the two trees share the same pool (e.g. they have
+ * been obtained by a split). If the pool of the tree is not shared with
+ * other trees, its memory is moved to the pool of the other tree (or
+ * vice versa), in time linear in the number of its memory blocks.
+ * Otherwise, the nodes are copied.
+ *
+ * @param[out] nodePool Pool of the tree in which the other tree is joined
+ * @param[out] otherNodePool Pool of the other tree
+ * @param[out] otherRootNode Root of the other tree
+ */
+template <class Node, class NodePool>
+void joinNodePoolsHelper(
+        std::shared_ptr<NodePool>& nodePool,
+        std::shared_ptr<NodePool>& otherNodePool,
+        Node*& otherRootNode)
+{
+    //The trees share the same pool (e.g. after a split)
+    if (nodePool == otherNodePool)
+        return;
+
+    //The other pool is used only by the other tree
+    if (otherNodePool.use_count() == 1) {
+        nodePool->splice(*otherNodePool);
+    }
+    //The pool is used only by this tree
+    else if (nodePool.use_count() == 1) {
+        otherNodePool->splice(*nodePool);
+        nodePool = otherNodePool;
+    }
+    //Both the pools are shared with other trees
+    else {
+        Node* newRootNode = copySubtreeHelper(otherRootNode, *nodePool);
+        clearHelper(otherRootNode, *otherNodePool);
+        otherRootNode = newRootNode;
+    }
+}
+
 }
 
 }
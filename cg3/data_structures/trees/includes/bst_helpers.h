@@ -17,12 +17,13 @@ namespace internal {
 
     /* Basic BST operation helpers */
 
-    template <class Node>
-    inline void clearHelper(Node*& rootNode);
+    template <class Node, class NodePool>
+    inline void clearHelper(Node*& rootNode, NodePool& nodePool);
 
-    template <class Node, class T>
+    template <class Node, class NodePool>
     inline Node* copySubtreeHelper(
             const Node* rootNode,
+            NodePool& nodePool,
             Node* parent = nullptr);
 
 
@@ -19,20 +19,21 @@ namespace internal {
  * manually
  *
  * @param[in] rootNode Root of the subtree
+ * @param[in] nodePool Pool of the nodes of the tree
  */
-template <class Node>
-void clearHelper(Node*& rootNode)
+template <class Node, class NodePool>
+void clearHelper(Node*& rootNode, NodePool& nodePool)
 {
     //If it is already empty
     if (rootNode == nullptr)
         return;
 
     //Clear subtrees
-    clearHelper(rootNode->left);
-    clearHelper(rootNode->right);
+    clearHelper(rootNode->left, nodePool);
+    clearHelper(rootNode->right, nodePool);
 
     //Delete data
-    delete rootNode;
+    nodePool.destroy(rootNode);
     rootNode = nullptr;
 }
 
@@ -41,23 +42,23 @@ void clearHelper(Node*& rootNode)
  * the rootNode.
  *
  * @param[in] rootNode Root of the subtree
+ * @param[in] nodePool Pool in which the new nodes are created
  * @returns Copy of the subtree
  */
-template <class Node, class T>
+template <class Node, class NodePool>
 Node* copySubtreeHelper(
         const Node* rootNode,
+        NodePool& nodePool,
         Node* parent)
 {
     if (rootNode == nullptr)
         return nullptr;
 
-    Node* newNode = new Node(*rootNode);
+    Node* newNode = nodePool.copy(rootNode);
 
-    newNode->left = copySubtreeHelper<Node,T>(rootNode->left, newNode);
-    newNode->right = copySubtreeHelper<Node,T>(rootNode->right, newNode);
+    newNode->left = copySubtreeHelper(rootNode->left, nodePool, newNode);
+    newNode->right = copySubtreeHelper(rootNode->right, nodePool, newNode);
     newNode->parent = parent;
-    if (rootNode->value != nullptr)
-        newNode->value = new T(*(rootNode->value));
 
     return newNode;
 }
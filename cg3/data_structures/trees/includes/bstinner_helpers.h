@@ -20,11 +20,11 @@ namespace internal {
 
 /* Basic BST operation helpers */
 
-template <class Node, class K, class C>
-inline Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, C& comparator);
+template <class Node, class K, class C, class NodePool>
+inline Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, NodePool& nodePool, C& comparator);
 
-template <class Node>
-inline Node* eraseNodeHelperInner(Node*& node, Node*& rootNode);
+template <class Node, class NodePool>
+inline Node* eraseNodeHelperInner(Node*& node, Node*& rootNode, NodePool& nodePool);
 
 template <class Node, class K, class C>
 inline Node* findNodeHelperInner(const K& key, Node*& rootNode, C& comparator);
@@ -39,11 +39,12 @@ inline Node* findUpperHelperInner(const K& key, Node*& rootNode, C& comparator);
 
 /* Construction helpers */
 
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 inline TreeSize constructionMedianHelperInner(
         std::vector<Node*>& sortedNodes,
         const TreeSize start, const TreeSize end,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator);
 
 
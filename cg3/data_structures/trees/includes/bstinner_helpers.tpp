@@ -18,11 +18,12 @@ namespace internal {
  *
  * @param[in] newNode Node to be inserted
  * @param[in] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @param[in] comparator Less comparator for keys
  * @return Pointer to the node if the node has been inserted, nullptr otherwise
  */
-template <class Node, class K, class C>
-Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, C& comparator)
+template <class Node, class K, class C, class NodePool>
+Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, NodePool& nodePool, C& comparator)
 {
     //Find the position in the BST in which
     //the new node must be inserted
@@ -64,7 +65,7 @@ Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, C& comparator)
     }
 
     //If the value is already in the BST
-    delete newNode;
+    nodePool.destroy(newNode);
     newNode = nullptr;
 
     return nullptr;
@@ -76,10 +77,11 @@ Node* insertNodeHelperInner(Node*& newNode, Node*& rootNode, C& comparator)
  *
  * @param[in] node Node to be erased
  * @param[in] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @return Node that replaces the erased one (useful for rebalancing)
  */
-template <class Node>
-Node* eraseNodeHelperInner(Node*& node, Node*& rootNode)
+template <class Node, class NodePool>
+Node* eraseNodeHelperInner(Node*& node, Node*& rootNode, NodePool& nodePool)
 {
     //Node that will replace the node to be erased
     Node* y;
@@ -137,7 +139,7 @@ Node* eraseNodeHelperInner(Node*& node, Node*& rootNode)
     Node* replacingNode = y->parent;
 
     //Delete the node
-    delete y;
+    nodePool.destroy(y);
     y = nullptr;
 
     return replacingNode;
@@ -302,14 +304,16 @@ Node* findUpperHelperInner(
  * @param[in] start Start index of the partition of the vector to be inserted
  * @param[in] end End index of the partition of the vector to be inserted
  * @param[out] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @param[in] comparator Less comparator for keys
  * @return Number of entries inserted in the BST
  */
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 TreeSize constructionMedianHelperInner(
         std::vector<Node*>& sortedNodes,
         const TreeSize start, const TreeSize end,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator)
 {
     TreeSize numberOfEntries = 0;
@@ -324,13 +328,12 @@ TreeSize constructionMedianHelperInner(
     Node* node = sortedNodes.at(mid);
 
     //Creating node and inserting it in the root node
-    Node* insertResult = insertNodeHelperInner<Node,K,C>(node, rootNode, comparator);
+    Node* insertResult = insertNodeHelperInner<Node,K,C>(node, rootNode, nodePool, comparator);
     if (insertResult != nullptr) {
         numberOfEntries++;
     }
-    //If it has not been inserted
+    //If it has not been inserted (the node has been destroyed)
     else {
-        delete node;
         node = nullptr;
         sortedNodes[mid] = nullptr;
     }
@@ -340,8 +343,8 @@ TreeSize constructionMedianHelperInner(
     TreeSize secondHalfStart = mid + 1;
 
     //Recursive calls
-    numberOfEntries += constructionMedianHelperInner<Node,K,C>(sortedNodes, start, firstHalfEnd, rootNode, comparator);
-    numberOfEntries += constructionMedianHelperInner<Node,K,C>(sortedNodes, secondHalfStart, end, rootNode, comparator);
+    numberOfEntries += constructionMedianHelperInner<Node,K,C>(sortedNodes, start, firstHalfEnd, rootNode, nodePool, comparator);
+    numberOfEntries += constructionMedianHelperInner<Node,K,C>(sortedNodes, secondHalfStart, end, rootNode, nodePool, comparator);
 
     return numberOfEntries;
 }
@@ -20,11 +20,11 @@ namespace internal {
 
 /* Basic BST operation helpers */
 
-template <class Node, class K, class C>
-inline Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator);
+template <class Node, class K, class C, class NodePool>
+inline Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, NodePool& nodePool, C& comparator);
 
-template <class Node>
-inline Node* eraseNodeHelperLeaf(Node*& node, Node*& rootNode);
+template <class Node, class NodePool>
+inline Node* eraseNodeHelperLeaf(Node*& node, Node*& rootNode, NodePool& nodePool);
 
 template <class Node, class K, class C>
 inline Node* findHelperLeaf(const K& key, Node*& rootNode, C& comparator);
@@ -38,19 +38,27 @@ inline Node* findUpperHelperLeaf(const K& key, Node*& rootNode, C& comparator);
 
 /* Construction helpers */
 
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 inline TreeSize constructionMedianHelperLeaf(
         std::vector<Node*>& sortedNodes,
         const TreeSize start, const TreeSize end,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator);
 
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 inline TreeSize constructionBottomUpHelperLeaf(
         std::vector<Node*>& sortedVec,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator);
 
+template <class Node, class K, class NodePool>
+inline Node* constructionLinkHelperLeaf(
+        std::vector<Node*>& leaves,
+        const TreeSize start, const TreeSize end,
+        NodePool& nodePool);
+
 
 /* Range query helpers */
 
@@ -19,11 +19,12 @@ namespace internal {
  *
  * @param[in] newNode Node to be inserted
  * @param[in] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @param[in] comparator Less comparator for keys
  * @return Pointer to the node if the node has been inserted, nullptr otherwise
  */
-template <class Node, class K, class C>
-Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator)
+template <class Node, class K, class C, class NodePool>
+Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, NodePool& nodePool, C& comparator)
 {
     //If the tree is empty
     if (rootNode == nullptr) {
@@ -51,7 +52,7 @@ Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator)
 
     //If the value is already in the BST
     if (isEqual(node->key, newNode->key, comparator)) {
-        delete newNode;
+        nodePool.destroy(newNode);
         newNode = nullptr;
     }
 
@@ -61,7 +62,7 @@ Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator)
 
         if (isLess(newNode->key, node->key, comparator)) {
             //Create new parent for the two nodes
-            newParent = new Node(node->key);
+            newParent = nodePool.create(node->key);
 
             //Set the children
             newParent->left = newNode;
@@ -69,7 +70,7 @@ Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator)
         }
         else {
             //Create new parent for the two nodes
-            newParent = new Node(newNode->key);
+            newParent = nodePool.create(newNode->key);
 
             //Set the children
             newParent->left = node;
@@ -95,10 +96,11 @@ Node* insertNodeHelperLeaf(Node*& newNode, Node*& rootNode, C& comparator)
  *
  * @param[in] node Node to be erased
  * @param[in] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @return Node that replaces the erased one (useful for rebalancing)
  */
-template <class Node>
-Node* eraseNodeHelperLeaf(Node*& node, Node*& rootNode)
+template <class Node, class NodePool>
+Node* eraseNodeHelperLeaf(Node*& node, Node*& rootNode, NodePool& nodePool)
 {
     Node* replacingChild = nullptr;
 
@@ -126,12 +128,12 @@ Node* eraseNodeHelperLeaf(Node*& node, Node*& rootNode)
         //Replace parent with the child
         replaceSubtreeHelper(parent, replacingChild, rootNode);
 
-        delete parent;
+        nodePool.destroy(parent);
         parent = nullptr;
     }
 
     //Delete the node
-    delete node;
+    nodePool.destroy(node);
     node = nullptr;
 
     return replacingChild;
@@ -281,14 +283,16 @@ Node* findUpperHelperLeaf(
  * @param[in] start Start index of the partition of the vector to be inserted
  * @param[in] end End index of the partition of the vector to be inserted
  * @param[out] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @param[in] comparator Less comparator for keys
  * @return Number of entries inserted in the BST
  */
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 TreeSize constructionMedianHelperLeaf(
         std::vector<Node*>& sortedNodes,
         const TreeSize start, const TreeSize end,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator)
 {
     TreeSize numberOfEntries = 0;
@@ -303,12 +307,11 @@ TreeSize constructionMedianHelperLeaf(
     Node* node = sortedNodes.at(mid);
 
     //Creating node and inserting it in the root node
-    if (insertNodeHelperLeaf(node, rootNode, comparator) != nullptr) {
+    if (insertNodeHelperLeaf<Node,K,C>(node, rootNode, nodePool, comparator) != nullptr) {
         numberOfEntries++;
     }    
-    //If it has not been inserted
+    //If it has not been inserted (the node has been destroyed)
     else {
-        delete node;
         node = nullptr;        
         sortedNodes[mid] = nullptr;
     }
@@ -318,8 +321,8 @@ TreeSize constructionMedianHelperLeaf(
     TreeSize secondHalfStart = mid + 1;
 
     //Recursive calls
-    numberOfEntries += constructionMedianHelperLeaf(sortedNodes, start, firstHalfEnd, rootNode, comparator);
-    numberOfEntries += constructionMedianHelperLeaf(sortedNodes, secondHalfStart, end, rootNode, comparator);
+    numberOfEntries += constructionMedianHelperLeaf<Node,K,C>(sortedNodes, start, firstHalfEnd, rootNode, nodePool, comparator);
+    numberOfEntries += constructionMedianHelperLeaf<Node,K,C>(sortedNodes, secondHalfStart, end, rootNode, nodePool, comparator);
 
     return numberOfEntries;
 }
@@ -331,12 +334,14 @@ TreeSize constructionMedianHelperLeaf(
  *
  * @param[in] sortedVec Sorted vector of entries (pair of keys/values)
  * @param[in] rootNode Root node of the BST
+ * @param[in] nodePool Pool of the nodes of the BST
  * @returns Number of entries inserted in the BST
  */
-template <class Node, class K, class C>
+template <class Node, class K, class C, class NodePool>
 TreeSize constructionBottomUpHelperLeaf(
         std::vector<Node*>& sortedNodes,
         Node*& rootNode,
+        NodePool& nodePool,
         C& comparator)
 {
     TreeSize numberOfEntries = 0;
@@ -358,65 +363,69 @@ TreeSize constructionBottomUpHelperLeaf(
         }
         //If it has not been inserted
         else {
-            delete node;
+            nodePool.destroy(node);
             node = nullptr;            
             sortedNodes[i] = nullptr;
         }
     }
 
 
-    //If there is not an only remaining node
-    while (nodes->size() > 1) {
-
-        //Nodes of the new level
-        std::vector<Node*>* newLevelNodes = new std::vector<Node*>();
+    //Link the leaves: the subtrees of each node have the same number
+    //of leaves (plus or minus one), hence the tree is balanced
+    rootNode = constructionLinkHelperLeaf<Node,K>(*nodes, 0, nodes->size(), nodePool);
+    rootNode->parent = nullptr;
 
-        for (size_t i = 0; i < nodes->size(); i += 2) {
-            Node* node1 = nodes->at(i);
-            Node* node2 = nullptr;
+    //Delete vector of nodes
+    delete nodes;
+    nodes = nullptr;
 
-            //If a second node exists
-            if (i+1 < nodes->size()) {
-                node2 = nodes->at(i+1);
-            }
+    return numberOfEntries;
+}
 
-            //If a second node exists
-            if (node2 != nullptr) {
-                K& key = getMinimumHelperLeaf(node2)->key;
-                Node* parentNode = new Node(key);
 
-                //Setting children conditions
-                parentNode->left = node1;
-                parentNode->right = node2;
 
-                //Setting parent
-                node1->parent = parentNode;
-                node2->parent = parentNode;
 
-                newLevelNodes->push_back(parentNode);
-            }
-            else {
-                newLevelNodes->push_back(node1);
-            }
-        }
+/**
+ * Link the leaves of a balanced BST, creating the inner nodes.
+ * The subtrees of each inner node contain the same number of
+ * leaves (plus or minus one).
+ *
+ * Recursive implementation
+ *
+ * @param[in] leaves Sorted vector of leaves, without duplicates
+ * @param[in] start Start index of the partition of the vector to be linked
+ * @param[in] end End index of the partition of the vector to be linked
+ * @param[in] nodePool Pool of the nodes of the BST
+ * @returns Root of the subtree containing the leaves of the partition
+ */
+template <class Node, class K, class NodePool>
+Node* constructionLinkHelperLeaf(
+        std::vector<Node*>& leaves,
+        const TreeSize start, const TreeSize end,
+        NodePool& nodePool)
+{
+    //Only one leaf
+    if (end - start == 1)
+        return leaves.at(start);
 
+    //Median
+    TreeSize mid = start + (end-start)/2;
 
-        //Delete vector of nodes
-        delete nodes;
-        nodes = nullptr;
+    //The key of the parent is the minimum of the right subtree
+    Node* parentNode = nodePool.create(leaves.at(mid)->key);
 
-        //Replacing the nodes with the node of the new level
-        nodes = newLevelNodes;
-    }
+    Node* node1 = constructionLinkHelperLeaf<Node,K>(leaves, start, mid, nodePool);
+    Node* node2 = constructionLinkHelperLeaf<Node,K>(leaves, mid, end, nodePool);
 
-    rootNode = nodes->at(0);
-    rootNode->parent = nullptr;
+    //Setting children conditions
+    parentNode->left = node1;
+    parentNode->right = node2;
 
-    //Delete vector of nodes
-    delete nodes;
-    nodes = nullptr;
+    //Setting parent
+    node1->parent = parentNode;
+    node2->parent = parentNode;
 
-    return numberOfEntries;
+    return parentNode;
 }
 
 
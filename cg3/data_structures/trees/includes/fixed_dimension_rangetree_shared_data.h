@@ -0,0 +1,79 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_FIXED_DIMENSION_RANGETREE_SHARED_DATA_H
+#define CG3_FIXED_DIMENSION_RANGETREE_SHARED_DATA_H
+
+#include <vector>
+
+#include "nodes/fixed_dimension_rangetree_node.h"
+#include "tree_node_pool.h"
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Data shared by a range tree of dimension D and by all the
+ * associated range trees of the same dimension: the comparator of
+ * the dimension, the node pool and the shared data of the dimension D-1.
+ *
+ * The comparators are therefore stored once, instead of being copied
+ * in each associated range tree.
+ */
+template <int D, class K, class T, class C>
+struct FixedDimensionRangeTreeSharedData {
+
+    /* Constructors */
+
+    FixedDimensionRangeTreeSharedData(const std::vector<C>& customComparators) :
+        comparator(customComparators[D-1]),
+        next(customComparators) {}
+
+    /* The comparators are copied, the node pools are empty */
+    FixedDimensionRangeTreeSharedData(const FixedDimensionRangeTreeSharedData<D,K,T,C>& data) :
+        comparator(data.comparator),
+        next(data.next) {}
+
+
+    /* Fields */
+
+    C comparator;
+
+    TreeNodePool<FixedDimensionRangeTreeNode<D,K,T,C>,T> nodePool;
+
+    FixedDimensionRangeTreeSharedData<D-1,K,T,C> next;
+
+};
+
+/**
+ * @brief Data shared by a range tree of the first dimension and by all
+ * the associated range trees of the first dimension
+ */
+template <class K, class T, class C>
+struct FixedDimensionRangeTreeSharedData<1,K,T,C> {
+
+    /* Constructors */
+
+    FixedDimensionRangeTreeSharedData(const std::vector<C>& customComparators) :
+        comparator(customComparators[0]) {}
+
+    /* The comparator is copied, the node pool is empty */
+    FixedDimensionRangeTreeSharedData(const FixedDimensionRangeTreeSharedData<1,K,T,C>& data) :
+        comparator(data.comparator) {}
+
+
+    /* Fields */
+
+    C comparator;
+
+    TreeNodePool<FixedDimensionRangeTreeNode<1,K,T,C>,T> nodePool;
+
+};
+
+}
+
+}
+
+#endif // CG3_FIXED_DIMENSION_RANGETREE_SHARED_DATA_H
@@ -31,6 +31,8 @@ class TreeGenericIterator {
     template <class T1, class T2, class T3>
     friend class RangeTree;
     template <int T1, class T2, class T3, class T4>
+    friend class FixedDimensionRangeTree;
+    template <int T1, class T2, class T3, class T4, class T5>
     friend class AABBTree;
 
 protected:
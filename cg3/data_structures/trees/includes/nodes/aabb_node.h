@@ -37,12 +37,9 @@ public:
         }
     };
 
-    /* Constructors/Destructor */
+    /* Constructors */
 
-    AABBNode(const K& key, const T& value);
-    AABBNode(const K& key);
-
-    ~AABBNode();
+    AABBNode(const K& key, T* value = nullptr);
 
 
     /* Fields */
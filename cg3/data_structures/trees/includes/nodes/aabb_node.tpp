@@ -10,43 +10,21 @@ namespace cg3 {
 
 namespace internal {
 
-/* --------- CONSTRUCTORS/DESTRUCTOR --------- */
+/* --------- CONSTRUCTORS --------- */
 
 /**
  * @brief Constructor with key and value
  *
  * param[in] key Key of the node
- * param[in] value Value of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
  */
 template <int D, class K, class T>
 AABBNode<D,K,T>::AABBNode(
         const K& key,
-        const T& value)
-{
-    init(key, new T(value));
-}
-
-/**
- * @brief Constructor with only key
- *
- * param[in] key Key of the node
- */
-template <int D, class K, class T>
-AABBNode<D,K,T>::AABBNode(const K& key)
-{
-    init(key, nullptr);
-}
-
-/**
- * @brief Destructor
- */
-template <int D, class K, class T>
-AABBNode<D,K,T>::~AABBNode()
+        T* value)
 {
-    if (this->value != nullptr) {
-        delete this->value;
-        this->value = nullptr;
-    }
+    init(key, value);
 }
 
 
@@ -23,12 +23,9 @@ class AVLNode {
 
 public:
 
-    /* Constructors/Destructor */
+    /* Constructors */
 
-    AVLNode(const K& key, const T& value);
-    AVLNode(const K& key);
-
-    ~AVLNode();
+    AVLNode(const K& key, T* value = nullptr);
 
 
     /* Fields */
@@ -41,6 +38,7 @@ public:
     AVLNode* right;
 
     TreeSize height;
+    TreeSize size;
 
 
     /* Public methods */
@@ -10,43 +10,21 @@ namespace cg3 {
 
 namespace internal {
 
-/* --------- CONSTRUCTORS/DESTRUCTOR --------- */
+/* --------- CONSTRUCTORS --------- */
 
 /**
  * @brief Constructor with key and value
  *
  * param[in] key Key of the node
- * param[in] value Value of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
  */
 template<class K, class T>
 AVLNode<K,T>::AVLNode(
         const K& key,
-        const T& value)
-{
-    init(key, new T(value));
-}
-
-/**
- * @brief Constructor with only key
- *
- * param[in] key Key of the node
- */
-template<class K, class T>
-AVLNode<K,T>::AVLNode(const K& key)
-{
-    init(key, nullptr);
-}
-
-/**
- * @brief Destructor
- */
-template<class K, class T>
-AVLNode<K,T>::~AVLNode()
+        T* value)
 {
-    if (this->value != nullptr) {
-        delete this->value;
-        this->value = nullptr;
-    }
+    init(key, value);
 }
 
 
@@ -85,6 +63,9 @@ void AVLNode<K,T>::init(const K& key, T* value)
     this->parent = nullptr;
 
     this->height = 0;
+
+    //Number of entries (nodes with a value) of the subtree
+    this->size = (value != nullptr ? 1 : 0);
 }
 
 
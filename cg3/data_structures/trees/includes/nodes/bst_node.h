@@ -20,12 +20,9 @@ class BSTNode {
 
 public:
 
-    /* Constructors/Destructor */
+    /* Constructors */
 
-    BSTNode(const K& key, const T& value);
-    BSTNode(const K& key);
-
-    ~BSTNode();
+    BSTNode(const K& key, T* value = nullptr);
 
 
     /* Fields */
@@ -11,44 +11,22 @@ namespace cg3 {
 namespace internal {
 
 
-/* --------- CONSTRUCTORS/DESTRUCTOR --------- */
+/* --------- CONSTRUCTORS --------- */
 
 
 /**
  * @brief Constructor with key and value
  *
  * param[in] key Key of the node
- * param[in] value Value of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
  */
 template<class K, class T>
 BSTNode<K,T>::BSTNode(
         const K& key,
-        const T& value)
-{
-    init(key, new T(value));
-}
-
-/**
- * @brief Constructor with only key
- *
- * param[in] key Key of the node
- */
-template<class K, class T>
-BSTNode<K,T>::BSTNode(const K& key)
-{
-    init(key, nullptr);
-}
-
-/**
- * @brief Destructor
- */
-template<class K, class T>
-BSTNode<K,T>::~BSTNode()
+        T* value)
 {
-    if (this->value != nullptr) {
-        delete this->value;
-        this->value = nullptr;
-    }
+    init(key, value);
 }
 
 
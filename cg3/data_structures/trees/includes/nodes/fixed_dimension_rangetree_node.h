@@ -0,0 +1,113 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef CG3_FIXED_DIMENSION_RANGETREE_NODE_H
+#define CG3_FIXED_DIMENSION_RANGETREE_NODE_H
+
+
+
+namespace cg3 {
+
+
+template <int D, class K, class T, class C>
+class FixedDimensionRangeTree;
+
+
+namespace internal {
+
+/**
+ * @brief The node of the range tree of dimension D, which points to
+ * the associated range tree of dimension D-1
+ *
+ */
+template <int D, class K, class T, class C>
+class FixedDimensionRangeTreeNode {
+
+public:
+
+    /* Constructors/Destructor */
+
+    FixedDimensionRangeTreeNode(const K& key, T* value = nullptr);
+
+    ~FixedDimensionRangeTreeNode();
+
+
+    /* Fields */
+
+    K key;
+    T* value;
+
+    FixedDimensionRangeTree<D-1,K,T,C>* assRangeTree;
+
+    FixedDimensionRangeTreeNode* parent;
+    FixedDimensionRangeTreeNode* left;
+    FixedDimensionRangeTreeNode* right;
+
+    size_t height;
+
+
+    /* Public methods */
+
+    inline bool isLeaf() const;
+
+
+private:
+
+     /* Private methods */
+
+    void init(const K& key, T* value);
+
+};
+
+/**
+ * @brief The node of the range tree of the first dimension, which
+ * has no associated range tree
+ *
+ */
+template <class K, class T, class C>
+class FixedDimensionRangeTreeNode<1,K,T,C> {
+
+public:
+
+    /* Constructors */
+
+    FixedDimensionRangeTreeNode(const K& key, T* value = nullptr);
+
+
+    /* Fields */
+
+    K key;
+    T* value;
+
+    FixedDimensionRangeTreeNode* parent;
+    FixedDimensionRangeTreeNode* left;
+    FixedDimensionRangeTreeNode* right;
+
+    size_t height;
+
+
+    /* Public methods */
+
+    inline bool isLeaf() const;
+
+
+private:
+
+     /* Private methods */
+
+    void init(const K& key, T* value);
+
+};
+
+}
+
+}
+
+#include "../../fixed_dimension_rangetree.h"
+
+#include "fixed_dimension_rangetree_node.tpp"
+
+#endif // CG3_FIXED_DIMENSION_RANGETREE_NODE_H
@@ -0,0 +1,123 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "fixed_dimension_rangetree_node.h"
+
+namespace cg3 {
+
+namespace internal {
+
+
+/* --------- CONSTRUCTORS/DESTRUCTOR --------- */
+
+/**
+ * @brief Constructor with key and value
+ *
+ * param[in] key Key of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTreeNode<D,K,T,C>::FixedDimensionRangeTreeNode(
+        const K& key,
+        T* value)
+{
+    init(key, value);
+}
+
+/**
+ * @brief Constructor with key and value
+ *
+ * param[in] key Key of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
+ */
+template <class K, class T, class C>
+FixedDimensionRangeTreeNode<1,K,T,C>::FixedDimensionRangeTreeNode(
+        const K& key,
+        T* value)
+{
+    init(key, value);
+}
+
+/**
+ * @brief Destructor
+ */
+template <int D, class K, class T, class C>
+FixedDimensionRangeTreeNode<D,K,T,C>::~FixedDimensionRangeTreeNode()
+{
+    if (this->assRangeTree != nullptr) {
+        delete this->assRangeTree;
+        this->assRangeTree = nullptr;
+    }
+}
+
+
+
+/* --------- PRIVATE METHODS --------- */
+
+
+/**
+ * @brief Initialization of the node given key and value
+ */
+template <int D, class K, class T, class C>
+void FixedDimensionRangeTreeNode<D,K,T,C>::init(const K& key, T* value)
+{
+    this->key = key;
+    this->value = value;
+
+    this->left = nullptr;
+    this->right = nullptr;
+
+    this->parent = nullptr;
+
+    this->height = 1;
+
+    this->assRangeTree = nullptr;
+}
+
+/**
+ * @brief Initialization of the node given key and value
+ */
+template <class K, class T, class C>
+void FixedDimensionRangeTreeNode<1,K,T,C>::init(const K& key, T* value)
+{
+    this->key = key;
+    this->value = value;
+
+    this->left = nullptr;
+    this->right = nullptr;
+
+    this->parent = nullptr;
+
+    this->height = 1;
+}
+
+/**
+ * @brief Check if the node is a leaf
+ *
+ * @return True if the node is a leaf
+ */
+template <int D, class K, class T, class C>
+bool FixedDimensionRangeTreeNode<D,K,T,C>::isLeaf() const
+{
+    return (left == nullptr) && (right == nullptr);
+}
+
+/**
+ * @brief Check if the node is a leaf
+ *
+ * @return True if the node is a leaf
+ */
+template <class K, class T, class C>
+bool FixedDimensionRangeTreeNode<1,K,T,C>::isLeaf() const
+{
+    return (left == nullptr) && (right == nullptr);
+}
+
+}
+
+}
@@ -29,8 +29,7 @@ public:
 
     /* Constructors/Destructor */
 
-    RangeTreeNode(const K& key, const T& value);
-    RangeTreeNode(const K& key);
+    RangeTreeNode(const K& key, T* value = nullptr);
 
     ~RangeTreeNode();
 
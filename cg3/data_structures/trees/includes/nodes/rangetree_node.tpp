@@ -15,22 +15,17 @@ namespace internal {
 
 /**
  * @brief Constructor with key and value
+ *
+ * param[in] key Key of the node
+ * param[in] value Value of the node, created by the
+ * node pool of the tree (nullptr for nodes without value)
  */
 template <class K, class T, class C>
 RangeTreeNode<K,T,C>::RangeTreeNode(
         const K& key,
-        const T& value)
+        T* value)
 {
-    init(key, new T(value));
-}
-
-/**
- * @brief Constructor with only key
- */
-template <class K, class T, class C>
-RangeTreeNode<K,T,C>::RangeTreeNode(const K& key)
-{
-    init(key, nullptr);
+    init(key, value);
 }
 
 /**
@@ -39,11 +34,6 @@ RangeTreeNode<K,T,C>::RangeTreeNode(const K& key)
 template <class K, class T, class C>
 RangeTreeNode<K,T,C>::~RangeTreeNode()
 {
-    if (this->value != nullptr) {
-        delete this->value;
-        this->value = nullptr;
-    }
-
     if (this->assRangeTree != nullptr) {
         delete this->assRangeTree;
         this->assRangeTree = nullptr;
@@ -7,6 +7,7 @@
 #include "cg3/geometry/2d/point2d.h"
 
 #include "cg3/data_structures/trees/rangetree.h"
+#include "cg3/data_structures/trees/static_rangetree.h"
 
 namespace cg3 {
 
@@ -51,6 +52,28 @@ public:
         : RangeTree<Pointd>(3, vec, internal::getComparatorsForPoint3D()) {}
 };
 
+/**
+ * Static range tree of 2D points (double components)
+ */
+class StaticRangeTree2D : public StaticRangeTree<Point2Dd> {
+public:
+    StaticRangeTree2D()
+        : StaticRangeTree<Point2Dd>(2, internal::getComparatorsForPoint2D()) {}
+    StaticRangeTree2D(const std::vector<Point2Dd>& vec)
+        : StaticRangeTree<Point2Dd>(2, vec, internal::getComparatorsForPoint2D()) {}
+};
+
+/**
+ * Static range tree of 3D points (double components)
+ */
+class StaticRangeTree3D : public StaticRangeTree<Pointd> {
+public:
+    StaticRangeTree3D()
+        : StaticRangeTree<Pointd>(3, internal::getComparatorsForPoint3D()) {}
+    StaticRangeTree3D(const std::vector<Pointd>& vec)
+        : StaticRangeTree<Pointd>(3, vec, internal::getComparatorsForPoint3D()) {}
+};
+
 }
 
 #endif // CG3_RANGETREE_TYPES_H
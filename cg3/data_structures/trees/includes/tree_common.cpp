@@ -0,0 +1,49 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "tree_common.h"
+
+#include <type_traits>
+
+#include "cg3/data_structures/trees/bstleaf.h"
+#include "cg3/data_structures/trees/bstinner.h"
+#include "cg3/data_structures/trees/avlleaf.h"
+#include "cg3/data_structures/trees/avlinner.h"
+#include "cg3/data_structures/trees/aabbtree.h"
+
+namespace cg3 {
+
+namespace internal {
+
+
+/* ----- COMPILE CHECKS FOR THE DEFAULT COMPARATOR ----- */
+
+/*
+ * Trees with the default comparator type must keep accepting comparator
+ * functions in their constructors.
+ */
+
+static_assert(std::is_convertible<ComparatorFunction<int>, DefaultComparatorType<int>>::value,
+              "The default comparator must be constructible from a comparator function.");
+
+static_assert(std::is_constructible<BSTLeaf<int>, ComparatorFunction<int>>::value,
+              "BSTLeaf must accept a comparator function.");
+static_assert(std::is_constructible<BSTInner<int>, ComparatorFunction<int>>::value,
+              "BSTInner must accept a comparator function.");
+static_assert(std::is_constructible<AVLLeaf<int>, ComparatorFunction<int>>::value,
+              "AVLLeaf must accept a comparator function.");
+static_assert(std::is_constructible<AVLInner<int>, ComparatorFunction<int>>::value,
+              "AVLInner must accept a comparator function.");
+
+static_assert(std::is_constructible<AVLLeaf<int>, std::vector<int>, ComparatorFunction<int>>::value,
+              "AVLLeaf must accept a comparator function with a vector of keys.");
+static_assert(std::is_constructible<AVLInner<int>, std::vector<int>, ComparatorFunction<int>>::value,
+              "AVLInner must accept a comparator function with a vector of keys.");
+
+static_assert(std::is_constructible<AABBTree<1,int>, AABBValueExtractorFunction<int>, ComparatorFunction<int>>::value,
+              "AABBTree must accept a comparator function.");
+
+}
+
+}
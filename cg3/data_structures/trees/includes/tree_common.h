@@ -1,6 +1,7 @@
 #ifndef CG3_TREECOMMON_H
 #define CG3_TREECOMMON_H
 
+#include <cstddef>
 #include <utility>
 
 namespace cg3 {
@@ -10,7 +11,21 @@ namespace cg3 {
     typedef unsigned long long int TreeSize;
 
     template <class K>
-    using DefaultComparatorType = bool(*)(const K& key1, const K& key2);
+    using ComparatorFunction = bool(*)(const K& key1, const K& key2);
+
+    template <class K>
+    class KeyComparator;
+
+    template <class K>
+    using DefaultComparatorType = KeyComparator<K>;
+
+
+    /* Types */
+
+    enum AABBValueType { MIN, MAX };
+
+    template <class K>
+    using AABBValueExtractorFunction = double (*)(const K& key, const AABBValueType& valueType, const int& dim);
 
 
 namespace internal {
@@ -22,6 +37,21 @@ namespace internal {
         return key1 < key2;
     }
 
+    /**
+     * Default value of a comparator of type C, used when no comparator is given
+     * to a tree: the default comparator function for function pointers, a default
+     * constructed object for any other callable type.
+     */
+    template <class K, class C>
+    struct DefaultComparatorValue {
+        static inline C get() { return C(); }
+    };
+
+    template <class K>
+    struct DefaultComparatorValue<K, ComparatorFunction<K>> {
+        static inline ComparatorFunction<K> get() { return &defaultComparator<K>; }
+    };
+
 
 
     /* Comparator functions */
@@ -68,6 +98,34 @@ namespace internal {
     }
 
 
+    /* Key overlap checkers */
+
+    template <class K, class F>
+    inline bool checkKeyOverlap(
+            const K& a,
+            const K& b,
+            const F& keyOverlapChecker)
+    {
+        return keyOverlapChecker(a,b);
+    }
+    template <class K>
+    inline bool checkKeyOverlap(
+            const K& a,
+            const K& b,
+            bool (* const& keyOverlapChecker)(const K&, const K&))
+    {
+        return keyOverlapChecker == nullptr || keyOverlapChecker(a,b);
+    }
+    template <class K>
+    inline bool checkKeyOverlap(
+            const K&,
+            const K&,
+            const std::nullptr_t&)
+    {
+        return true;
+    }
+
+
     /* Utilities */
 
     /** Comparator for pairs (needed for std::sort) */
@@ -95,6 +153,38 @@ namespace internal {
 
 }
 
+
+/**
+ * @brief Default comparator of the trees: it compares the keys with the operator <,
+ * which is inlined in the tree algorithms.
+ *
+ * It can be implicitly constructed from a comparator function, so that the trees
+ * using the default comparator type still accept custom comparator functions.
+ * Trees can also use any other callable type (functors or lambdas) as comparator,
+ * passing it as template argument C.
+ */
+template <class K>
+class KeyComparator {
+
+public:
+
+    KeyComparator(const ComparatorFunction<K> function = nullptr) :
+        function(function == &internal::defaultComparator<K> ? nullptr : function)
+    { }
+
+    inline bool operator()(const K& key1, const K& key2) const
+    {
+        if (function == nullptr)
+            return key1 < key2;
+        return function(key1, key2);
+    }
+
+private:
+
+    ComparatorFunction<K> function;
+
+};
+
 }
 
 
@@ -0,0 +1,70 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_TREENODEPOOL_H
+#define CG3_TREENODEPOOL_H
+
+#include <cg3/utilities/memory_pool.h>
+
+namespace cg3 {
+
+namespace internal {
+
+/**
+ * @brief Allocator of the nodes of a tree and of their values
+ *
+ * Nodes and values are created in two cg3::MemoryPool, therefore they are
+ * stored in contiguous blocks of memory and an insertion does not call
+ * the global allocator unless a new block is needed.
+ * The pool does not know the structure of the tree: clear() must be called
+ * with the root of the tree, and the nodes of the tree must be all and only the
+ * nodes created by the pool.
+ */
+template <class Node, class T>
+class TreeNodePool
+{
+
+public:
+
+    /* Constructors */
+
+    TreeNodePool();
+
+
+    /* Public methods */
+
+    template <class K>
+    inline Node* create(const K& key);
+    template <class K>
+    inline Node* create(const K& key, const T& value);
+
+    inline Node* copy(const Node* node);
+
+    inline void destroy(Node* node);
+
+    void reserve(size_t nNodes, size_t nValues);
+
+    void clear(Node*& rootNode);
+
+    inline void swap(TreeNodePool<Node,T>& other);
+
+    inline void splice(TreeNodePool<Node,T>& other);
+
+
+private:
+
+    /* Private fields */
+
+    MemoryPool<Node> nodes;
+    MemoryPool<T> values;
+
+};
+
+}
+
+}
+
+#include "tree_node_pool.tpp"
+
+#endif // CG3_TREENODEPOOL_H
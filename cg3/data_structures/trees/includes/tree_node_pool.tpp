@@ -0,0 +1,173 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "tree_node_pool.h"
+
+#include <vector>
+#include <type_traits>
+
+namespace cg3 {
+
+namespace internal {
+
+/* Number of nodes in the first block of a pool */
+static const size_t treeNodePoolMinBlockSize = 16;
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor. No memory is allocated until the first node
+ * is created.
+ */
+template <class Node, class T>
+TreeNodePool<Node,T>::TreeNodePool() :
+    nodes(treeNodePoolMinBlockSize),
+    values(treeNodePoolMinBlockSize)
+{
+
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Create a node without value (inner node of the trees which save
+ * the values in the leaves)
+ *
+ * @param[in] key Key of the node
+ * @return The new node
+ */
+template <class Node, class T> template <class K>
+Node* TreeNodePool<Node,T>::create(const K& key)
+{
+    return nodes.create(key);
+}
+
+/**
+ * @brief Create a node with a value
+ *
+ * @param[in] key Key of the node
+ * @param[in] value Value of the node
+ * @return The new node
+ */
+template <class Node, class T> template <class K>
+Node* TreeNodePool<Node,T>::create(const K& key, const T& value)
+{
+    return nodes.create(key, values.create(value));
+}
+
+/**
+ * @brief Create a copy of a node. The value is copied as well, while
+ * the pointers to parent and children are the ones of the input node.
+ *
+ * @param[in] node Node to be copied
+ * @return The new node
+ */
+template <class Node, class T>
+Node* TreeNodePool<Node,T>::copy(const Node* node)
+{
+    Node* newNode = nodes.create(*node);
+    if (node->value != nullptr)
+        newNode->value = values.create(*(node->value));
+    return newNode;
+}
+
+/**
+ * @brief Destroy a node and its value
+ *
+ * @param[in] node Node created by this pool
+ */
+template <class Node, class T>
+void TreeNodePool<Node,T>::destroy(Node* node)
+{
+    if (node->value != nullptr)
+        values.destroy(node->value);
+    nodes.destroy(node);
+}
+
+/**
+ * @brief Make sure that the given number of nodes and values can be created
+ * without allocating other memory
+ *
+ * @param[in] nNodes Number of nodes
+ * @param[in] nValues Number of values
+ */
+template <class Node, class T>
+void TreeNodePool<Node,T>::reserve(size_t nNodes, size_t nValues)
+{
+    nodes.reserve(nodes.size() + nNodes);
+    values.reserve(values.size() + nValues);
+}
+
+/**
+ * @brief Destroy all the nodes of the tree and release the memory.
+ *
+ * Nodes are visited only if keys, values or nodes have a destructor to
+ * be called: otherwise the cost is linear in the number of blocks.
+ *
+ * @param[out] rootNode Root of the tree, set to nullptr
+ */
+template <class Node, class T>
+void TreeNodePool<Node,T>::clear(Node*& rootNode)
+{
+    if (!std::is_trivially_destructible<Node>::value ||
+            !std::is_trivially_destructible<T>::value)
+    {
+        std::vector<Node*> stack;
+        if (rootNode != nullptr)
+            stack.push_back(rootNode);
+
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+
+            if (node->left != nullptr)
+                stack.push_back(node->left);
+            if (node->right != nullptr)
+                stack.push_back(node->right);
+
+            if (node->value != nullptr)
+                values.destroyWithoutRecycle(node->value);
+            nodes.destroyWithoutRecycle(node);
+        }
+    }
+
+    nodes.clear();
+    values.clear();
+
+    rootNode = nullptr;
+}
+
+/**
+ * @brief Swap the pool with another one
+ *
+ * @param[out] other Pool to be swapped with this object
+ */
+template <class Node, class T>
+void TreeNodePool<Node,T>::swap(TreeNodePool<Node,T>& other)
+{
+    nodes.swap(other.nodes);
+    values.swap(other.values);
+}
+
+/**
+ * @brief Move all the nodes and values of another pool into this pool.
+ * Their addresses do not change, therefore a tree whose nodes have been
+ * created by the other pool can be linked to the trees of this pool.
+ * The other pool is left empty.
+ *
+ * @param[out] other Pool whose nodes are moved
+ */
+template <class Node, class T>
+void TreeNodePool<Node,T>::splice(TreeNodePool<Node,T>& other)
+{
+    nodes.splice(other.nodes);
+    values.splice(other.values);
+}
+
+}
+
+}
@@ -8,6 +8,7 @@
 #define CG3_RANGETREE_H
 
 #include <vector>
+#include <memory>
 #include <algorithm>
 
 #include "includes/tree_common.h"
@@ -18,6 +19,7 @@
 #include "includes/iterators/tree_rangebased_iterators.h"
 
 #include "includes/nodes/rangetree_node.h"
+#include "includes/tree_node_pool.h"
 
 
 namespace cg3 {
@@ -32,6 +34,8 @@ namespace cg3 {
  * Use pointers as template arguments if it is needed to save memory. This choice has
  * been made because we prefer to allow the user, if needed, to easily implement range
  * searches in just a subset of the dimensions of the object.
+ * The nodes of a range tree and of all its associated range trees are created
+ * in a single node pool.
  *
  */
 template <class K, class T = K, class C = DefaultComparatorType<K>>
@@ -45,6 +49,8 @@ public:
 
     typedef internal::RangeTreeNode<K,T,C> Node;
 
+    typedef internal::TreeNodePool<Node,T> NodePool;
+
     typedef DefaultComparatorType<K> DefaultComparator;
 
     typedef TreeGenericIterator<RangeTree<K,T,C>, Node> generic_iterator;
@@ -160,6 +166,15 @@ protected:
     C comparator;
     std::vector<C> customComparators;
 
+    std::shared_ptr<NodePool> nodePool;
+
+
+    /* Protected constructors */
+
+    explicit RangeTree(const unsigned int dim,
+              const std::vector<C>& customComparators,
+              const std::shared_ptr<NodePool>& nodePool);
+
 
     /* Protected methods */
 
@@ -31,7 +31,8 @@ RangeTree<K,T,C>::RangeTree(
         const std::vector<C>& customComparators) :
     dim(dimension),
     comparator(customComparators[dimension-1]),
-    customComparators(customComparators)
+    customComparators(customComparators),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
 }
@@ -51,7 +52,8 @@ RangeTree<K,T,C>::RangeTree(
         const std::vector<C>& customComparators) :
     dim(dimension),
     comparator(customComparators[dimension-1]),
-    customComparators(customComparators)
+    customComparators(customComparators),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -73,7 +75,8 @@ RangeTree<K,T,C>::RangeTree(
         const std::vector<C>& customComparators) :
     dim(dimension),
     comparator(customComparators[dimension-1]),
-    customComparators(customComparators)
+    customComparators(customComparators),
+    nodePool(std::make_shared<NodePool>())
 {
     this->initialize();
     this->construction(vec);
@@ -87,7 +90,8 @@ template <class K, class T, class C>
 RangeTree<K,T,C>::RangeTree(const RangeTree<K,T,C>& bst) :
     dim(bst.dim),
     comparator(bst.comparator),
-    customComparators(bst.customComparators)
+    customComparators(bst.customComparators),
+    nodePool(std::make_shared<NodePool>())
 {
     this->root = this->copyRangeTreeSubtree(bst.root);
     this->entries = bst.entries;
@@ -101,13 +105,36 @@ template <class K, class T, class C>
 RangeTree<K,T,C>::RangeTree(RangeTree<K,T,C>&& bst) :
     dim(bst.dim),
     comparator(bst.comparator),
-    customComparators(bst.customComparators)
+    customComparators(bst.customComparators),
+    nodePool(bst.nodePool)
 {
     this->root = bst.root;
     bst.root = nullptr;
     this->entries = bst.entries;
 }
 
+/**
+ * @brief Constructor of an associated range tree, which creates its
+ * nodes in the node pool of the range tree of the next dimension
+ *
+ * @param[in] dimension Dimension of the range tree
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree
+ * @param[in] nodePool Node pool shared with the other range trees
+ */
+template <class K, class T, class C>
+RangeTree<K,T,C>::RangeTree(
+        const unsigned int dimension,
+        const std::vector<C>& customComparators,
+        const std::shared_ptr<NodePool>& nodePool) :
+    dim(dimension),
+    comparator(customComparators[dimension-1]),
+    customComparators(customComparators),
+    nodePool(nodePool)
+{
+    this->initialize();
+}
+
 /**
  * @brief Destructor
  */
@@ -160,13 +187,14 @@ void RangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
 
     //Sort the collection
-    internal::PairComparator<K,T> pairComparator(comparator);
+    internal::PairComparator<K,T,C> pairComparator(comparator);
     std::sort(sortedVec.begin(), sortedVec.end(), pairComparator);
 
     //Create nodes
+    nodePool->reserve(2*sortedVec.size()-1, sortedVec.size());
     std::vector<Node*> sortedNodes;
     for (std::pair<K,T>& pair : sortedVec) {
-        Node* node = new Node(pair.first, pair.second);
+        Node* node = nodePool->create(pair.first, pair.second);
         sortedNodes.push_back(node);
     }
 
@@ -174,6 +202,7 @@ void RangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
     this->entries = internal::constructionBottomUpHelperLeaf<Node,K,C>(
                 sortedNodes,
                 this->root,
+                *nodePool,
                 comparator);
 
     //Update the height of nodes and create their AABBs
@@ -226,10 +255,10 @@ typename RangeTree<K,T,C>::iterator RangeTree<K,T,C>::insert(
         const K& key, const T& value)
 {
     //Create new node
-    Node* newNode = new Node(key, value);
+    Node* newNode = nodePool->create(key, value);
 
     //Insert node
-    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, comparator);
+    Node* result = internal::insertNodeHelperLeaf<Node,K,C>(newNode, this->root, *nodePool, comparator);
 
     //If node has been inserted
     if (result != nullptr) {
@@ -296,7 +325,7 @@ bool RangeTree<K,T,C>::erase(const K& key)
         this->eraseFromParentAssociatedTreesHelper(node->parent, node->key);
 
         //Erase node
-        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root);
+        Node* replacingNode = internal::eraseNodeHelperLeaf(node, this->root, *nodePool);
 
 
         //Update height and rebalance
@@ -343,8 +372,9 @@ typename RangeTree<K,T,C>::iterator RangeTree<K,T,C>::find(const K& key)
 template <class K, class T, class C>
 void RangeTree<K,T,C>::clear()
 {
-    //Clear entire tree
-    internal::clearHelper(this->root);
+    //Clear entire tree (nodes are destroyed one by one: the pool
+    //is shared with the associated range trees)
+    internal::clearHelper(this->root, *nodePool);
 
     //Decreasing entries
     this->entries = 0;
@@ -663,6 +693,7 @@ void RangeTree<K,T,C>::swap(RangeTree<K,T,C>& bst)
     swap(this->comparator, bst.comparator);
     swap(this->customComparators, bst.customComparators);
     swap(this->dim, bst.dim);
+    swap(this->nodePool, bst.nodePool);
 }
 
 
@@ -699,16 +730,18 @@ typename RangeTree<K,T,C>::Node* RangeTree<K,T,C>::copyRangeTreeSubtree(
     if (rootNode == nullptr)
         return nullptr;
 
-    Node* newNode = new Node(*rootNode);
+    Node* newNode = nodePool->copy(rootNode);
 
     newNode->left = this->copyRangeTreeSubtree(rootNode->left, newNode);
     newNode->right = this->copyRangeTreeSubtree(rootNode->right, newNode);
     newNode->parent = parent;
-    if (rootNode->value != nullptr)
-        newNode->value = new T(*(rootNode->value));
 
-    if (rootNode->assRangeTree != nullptr)
-        newNode->assRangeTree = new RangeTree<K,T,C>(*(rootNode->assRangeTree));
+    if (rootNode->assRangeTree != nullptr) {
+        const RangeTree<K,T,C>* assRangeTree = rootNode->assRangeTree;
+        newNode->assRangeTree = new RangeTree<K,T,C>(this->dim-1, this->customComparators, this->nodePool);
+        newNode->assRangeTree->root = newNode->assRangeTree->copyRangeTreeSubtree(assRangeTree->root);
+        newNode->assRangeTree->entries = assRangeTree->entries;
+    }
 
     return newNode;
 }
@@ -824,7 +857,7 @@ void RangeTree<K,T,C>::createAssociatedTreeHelper(
         Node *node)
 {
     if (dim > 1) {
-        node->assRangeTree = new RangeTree<K,T,C>(this->dim-1, this->customComparators);
+        node->assRangeTree = new RangeTree<K,T,C>(this->dim-1, this->customComparators, this->nodePool);
     }
 }
 
@@ -0,0 +1,194 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_STATICRANGETREE_H
+#define CG3_STATICRANGETREE_H
+
+#include <vector>
+#include <utility>
+
+#include "includes/tree_common.h"
+
+namespace cg3 {
+
+/**
+ * @brief A static multi-dimensional layered range tree
+ *
+ * Differently from RangeTree, the tree cannot be modified after its construction,
+ * and it is stored in few contiguous arrays of indices instead of nodes and
+ * associated range trees allocated one by one.
+ *
+ * The comparators have the same meaning they have in RangeTree: the first level of
+ * the tree is ordered by the comparator of the last dimension, its associated trees
+ * by the comparator of the previous dimension, and so on.
+ * The last two dimensions are stored in a layered tree with fractional cascading:
+ * each node stores its keys ordered on the first dimension, together with the
+ * position that each key would have in the children. Therefore a query needs only
+ * one binary search in that layer, and it costs O(log^(d-1)(n) + k) instead of
+ * O(log^d(n) + k).
+ *
+ * Duplicates are allowed. Keys and values are stored once, in the order given in
+ * the construction, while the layers only contain their indices.
+ * The queries do not modify the tree and can be executed concurrently: the batch
+ * queries are executed in parallel if OpenMP is available.
+ */
+template <class K, class T = K, class C = DefaultComparatorType<K>>
+class StaticRangeTree
+{
+
+public:
+
+    /* Constructors */
+
+    explicit StaticRangeTree(const unsigned int dim,
+              const std::vector<C>& customComparators);
+    explicit StaticRangeTree(const unsigned int dim,
+              const std::vector<std::pair<K,T>>& vec,
+              const std::vector<C>& customComparators);
+    explicit StaticRangeTree(const unsigned int dim,
+              const std::vector<K>& vec,
+              const std::vector<C>& customComparators);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    size_t size() const;
+    bool empty() const;
+
+    void clear();
+
+
+    /* Queries */
+
+    template <class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out) const;
+
+    void batchRangeQuery(
+            const std::vector<std::pair<K,K>>& ranges,
+            std::vector<std::vector<T>>& results) const;
+
+
+protected:
+
+    /* Types */
+
+    /**
+     * @brief Layer of the tree, containing the keys of a subset in a dimension.
+     * The keys of the layer are identified by their position (from 0 to size-1)
+     * in the ids sorted on the dimension of the layer.
+     */
+    struct Layer {
+        unsigned int dim;
+        unsigned int size;
+        size_t sortedOffset;    //Ids sorted on the dimension (sortedIds)
+        size_t cascadeOffset;   //dim == 2: first cascading array (cascadeIds/cascadeLeft)
+        size_t nodesOffset;     //dim > 2: first node with associated layer (associatedNodes)
+    };
+
+    /**
+     * @brief Node of a layer with dimension greater than 2, stored in preorder. The
+     * left child follows its parent.
+     */
+    struct AssociatedNode {
+        unsigned int layer;
+        unsigned int right;
+    };
+
+
+    /* Protected fields */
+
+    unsigned int dim;
+    std::vector<C> customComparators;
+
+    std::vector<K> keys;
+    std::vector<T> values;
+
+    std::vector<Layer> layers;
+
+    std::vector<unsigned int> sortedIds;
+    std::vector<unsigned int> cascadeIds;
+    std::vector<unsigned int> cascadeLeft;
+    std::vector<AssociatedNode> associatedNodes;
+
+
+    /* Construction helpers */
+
+    void build();
+
+    unsigned int buildLayerHelper(
+            const unsigned int layerDim,
+            const std::vector<std::vector<unsigned int>>& orders,
+            std::vector<unsigned char>& flags);
+
+    void buildCascadeHelper(
+            const Layer& layer,
+            const unsigned int lo, const unsigned int hi,
+            const unsigned int depth,
+            std::vector<unsigned char>& flags);
+
+    void buildAssociatedNodeHelper(
+            const unsigned int layerDim,
+            const std::vector<std::vector<unsigned int>>& orders,
+            const unsigned int lo, const unsigned int hi,
+            std::vector<AssociatedNode>& nodes,
+            std::vector<unsigned char>& flags);
+
+
+    /* Query helpers */
+
+    void rangeQueryHelper(
+            const unsigned int layerIndex,
+            const K& start, const K& end,
+            std::vector<unsigned int>& out) const;
+
+    void cascadeQueryHelper(
+            const Layer& layer,
+            const unsigned int qa, const unsigned int qb,
+            const unsigned int lo, const unsigned int hi,
+            const unsigned int depth,
+            const unsigned int pos,
+            const K& start, const K& end,
+            std::vector<unsigned int>& out) const;
+
+    void associatedNodeQueryHelper(
+            const Layer& layer,
+            const unsigned int qa, const unsigned int qb,
+            const unsigned int lo, const unsigned int hi,
+            const unsigned int nodeIndex,
+            const K& start, const K& end,
+            std::vector<unsigned int>& out) const;
+
+    void scanHelper(
+            const Layer& layer,
+            const unsigned int from, const unsigned int to,
+            const K& start, const K& end,
+            std::vector<unsigned int>& out) const;
+
+    inline unsigned int lowerBoundHelper(
+            const unsigned int* ids,
+            const unsigned int n,
+            const K& key,
+            const C& comparator) const;
+
+    inline unsigned int upperBoundHelper(
+            const unsigned int* ids,
+            const unsigned int n,
+            const K& key,
+            const C& comparator) const;
+
+};
+
+}
+
+
+#include "static_rangetree.tpp"
+
+#include "includes/rangetree_types.h"
+
+#endif // CG3_STATICRANGETREE_H
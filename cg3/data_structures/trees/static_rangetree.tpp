@@ -0,0 +1,633 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "static_rangetree.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace cg3 {
+
+namespace internal {
+
+/* Nodes with fewer keys have no children in the layers: their keys are checked one by one */
+static const unsigned int staticRangeTreeMinNodeSize = 16;
+
+}
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] dimension Dimension of the range tree
+ * @param[in] customComparators Comparators for each dimension
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const unsigned int dimension,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs)
+ *
+ * @param[in] dimension Dimension of the range tree
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customComparators Comparators for each dimension
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const unsigned int dimension,
+        const std::vector<std::pair<K,T>>& vec,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of keys
+ *
+ * @param[in] dimension Dimension of the range tree
+ * @param[in] vec Vector of keys
+ * @param[in] customComparators Comparators for each dimension
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const unsigned int dimension,
+        const std::vector<K>& vec,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the range tree given the keys.
+ * The value of each entry is the key itself.
+ * A clear operation is performed before the construction.
+ *
+ * @param[in] vec Vector of keys
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::construction(const std::vector<K>& vec)
+{
+    this->clear();
+
+    keys = vec;
+    values.assign(vec.begin(), vec.end());
+
+    this->build();
+}
+
+/**
+ * @brief Construction of the range tree given the entries.
+ * A clear operation is performed before the construction.
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    keys.reserve(vec.size());
+    values.reserve(vec.size());
+    for (const std::pair<K,T>& pair : vec) {
+        keys.push_back(pair.first);
+        values.push_back(pair.second);
+    }
+
+    this->build();
+}
+
+/**
+ * @brief Get the number of entries in the range tree
+ *
+ * @return Number of entries
+ */
+template <class K, class T, class C>
+size_t StaticRangeTree<K,T,C>::size() const
+{
+    return keys.size();
+}
+
+/**
+ * @brief Check if the range tree is empty
+ *
+ * @return True if the range tree is empty
+ */
+template <class K, class T, class C>
+bool StaticRangeTree<K,T,C>::empty() const
+{
+    return keys.empty();
+}
+
+/**
+ * @brief Clear the range tree, deleting all its elements
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::clear()
+{
+    keys.clear();
+    values.clear();
+    layers.clear();
+    sortedIds.clear();
+    cascadeIds.clear();
+    cascadeLeft.clear();
+    associatedNodes.clear();
+}
+
+
+
+/* --------- QUERIES --------- */
+
+/**
+ * @brief Get all the values whose keys are in the range [start, end]
+ * in every dimension
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Output iterator for the values
+ */
+template <class K, class T, class C>
+template <class OutputIterator>
+void StaticRangeTree<K,T,C>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out) const
+{
+    if (layers.empty())
+        return;
+
+    std::vector<unsigned int> ids;
+    this->rangeQueryHelper(0, start, end, ids);
+
+    for (unsigned int id : ids) {
+        *out = values[id];
+        out++;
+    }
+}
+
+/**
+ * @brief Execute a range query for each of the given ranges. The queries
+ * are executed in parallel if OpenMP is available.
+ *
+ * @param[in] ranges Vector of pairs of start/end keys
+ * @param[out] results For each range, the values whose keys are in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::batchRangeQuery(
+        const std::vector<std::pair<K,K>>& ranges,
+        std::vector<std::vector<T>>& results) const
+{
+    results.clear();
+    results.resize(ranges.size());
+
+    if (layers.empty())
+        return;
+
+    #pragma omp parallel
+    {
+        std::vector<unsigned int> ids;
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < (int) ranges.size(); i++) {
+            ids.clear();
+            this->rangeQueryHelper(0, ranges[i].first, ranges[i].second, ids);
+
+            results[i].reserve(ids.size());
+            for (unsigned int id : ids)
+                results[i].push_back(values[id]);
+        }
+    }
+}
+
+
+
+/* --------- CONSTRUCTION HELPERS --------- */
+
+/**
+ * @brief Build the layers of the tree for the stored keys
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::build()
+{
+    if (keys.empty())
+        return;
+
+    //Ids of the keys sorted on each dimension
+    std::vector<std::vector<unsigned int>> orders(dim);
+    for (unsigned int d = 0; d < dim; d++) {
+        const C& comparator = customComparators[d];
+        orders[d].resize(keys.size());
+        std::iota(orders[d].begin(), orders[d].end(), 0);
+        std::stable_sort(orders[d].begin(), orders[d].end(),
+                         [&](unsigned int a, unsigned int b) {
+            return comparator(keys[a], keys[b]);
+        });
+    }
+
+    std::vector<unsigned char> flags(keys.size(), 0);
+
+    this->buildLayerHelper(dim, orders, flags);
+}
+
+/**
+ * @brief Build a layer of the tree and, recursively, its associated layers
+ *
+ * @param[in] layerDim Dimension of the layer
+ * @param[in] orders Ids of the keys of the layer sorted on each dimension
+ * (at least layerDim vectors)
+ * @param[in] flags Support vector, with a flag for each key
+ * @return The index of the layer
+ */
+template <class K, class T, class C>
+unsigned int StaticRangeTree<K,T,C>::buildLayerHelper(
+        const unsigned int layerDim,
+        const std::vector<std::vector<unsigned int>>& orders,
+        std::vector<unsigned char>& flags)
+{
+    const std::vector<unsigned int>& sorted = orders[layerDim-1];
+
+    Layer layer;
+    layer.dim = layerDim;
+    layer.size = (unsigned int) sorted.size();
+    layer.sortedOffset = sortedIds.size();
+    layer.cascadeOffset = 0;
+    layer.nodesOffset = 0;
+
+    sortedIds.insert(sortedIds.end(), sorted.begin(), sorted.end());
+
+    //Layer with fractional cascading: an array of ids sorted on the
+    //first dimension for each depth of the tree
+    if (layerDim == 2) {
+        unsigned int height = 1;
+        for (unsigned int s = layer.size; s >= internal::staticRangeTreeMinNodeSize; s = (s + 1) / 2)
+            height++;
+
+        layer.cascadeOffset = cascadeIds.size();
+        cascadeIds.resize(cascadeIds.size() + (size_t) height * layer.size);
+        cascadeLeft.resize(cascadeIds.size());
+
+        std::copy(orders[0].begin(), orders[0].end(), cascadeIds.begin() + layer.cascadeOffset);
+
+        this->buildCascadeHelper(layer, 0, layer.size, 0, flags);
+    }
+
+    unsigned int layerIndex = (unsigned int) layers.size();
+    layers.push_back(layer);
+
+    //Layer with associated layers
+    if (layerDim > 2) {
+        std::vector<AssociatedNode> nodes;
+        this->buildAssociatedNodeHelper(layerDim, orders, 0, layer.size, nodes, flags);
+
+        layers[layerIndex].nodesOffset = associatedNodes.size();
+        associatedNodes.insert(associatedNodes.end(), nodes.begin(), nodes.end());
+    }
+
+    return layerIndex;
+}
+
+/**
+ * @brief Build the cascading arrays of the children of a node, if it is not
+ * a small node: the ids of the node are split between its children, keeping
+ * their order, and for each position of the node the number of preceding ids
+ * that are in the left child is saved.
+ *
+ * @param[in] layer Layer
+ * @param[in] lo First position of the node
+ * @param[in] hi Last position of the node (excluded)
+ * @param[in] depth Depth of the node
+ * @param[in] flags Support vector, with a flag for each key
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::buildCascadeHelper(
+        const Layer& layer,
+        const unsigned int lo, const unsigned int hi,
+        const unsigned int depth,
+        std::vector<unsigned char>& flags)
+{
+    if (hi - lo < internal::staticRangeTreeMinNodeSize)
+        return;
+
+    const unsigned int mid = (lo + hi) / 2;
+
+    const unsigned int* sorted = &sortedIds[layer.sortedOffset];
+    for (unsigned int p = lo; p < hi; p++)
+        flags[sorted[p]] = (p < mid ? 1 : 0);
+
+    const size_t offset = layer.cascadeOffset + (size_t) depth * layer.size;
+    const unsigned int* ids = &cascadeIds[offset];
+    unsigned int* nextIds = &cascadeIds[offset + layer.size];
+    unsigned int* left = &cascadeLeft[offset];
+
+    unsigned int l = lo, r = mid;
+    for (unsigned int p = lo; p < hi; p++) {
+        left[p] = l - lo;
+        if (flags[ids[p]])
+            nextIds[l++] = ids[p];
+        else
+            nextIds[r++] = ids[p];
+    }
+
+    this->buildCascadeHelper(layer, lo, mid, depth + 1, flags);
+    this->buildCascadeHelper(layer, mid, hi, depth + 1, flags);
+}
+
+/**
+ * @brief Build the associated layer of a node and, recursively, the ones of
+ * its descendants. Nodes are saved in preorder.
+ *
+ * @param[in] layerDim Dimension of the layer of the node
+ * @param[in] orders Ids of the keys of the node sorted on each dimension
+ * @param[in] lo First position of the node
+ * @param[in] hi Last position of the node (excluded)
+ * @param[out] nodes Nodes of the layer
+ * @param[in] flags Support vector, with a flag for each key
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::buildAssociatedNodeHelper(
+        const unsigned int layerDim,
+        const std::vector<std::vector<unsigned int>>& orders,
+        const unsigned int lo, const unsigned int hi,
+        std::vector<AssociatedNode>& nodes,
+        std::vector<unsigned char>& flags)
+{
+    if (hi - lo < internal::staticRangeTreeMinNodeSize)
+        return;
+
+    const unsigned int nodeIndex = (unsigned int) nodes.size();
+    nodes.push_back(AssociatedNode());
+
+    const unsigned int layer = this->buildLayerHelper(layerDim-1, orders, flags);
+    nodes[nodeIndex].layer = layer;
+    nodes[nodeIndex].right = nodeIndex;
+
+    const unsigned int mid = (lo + hi) / 2;
+
+    //The right child is not smaller than the left one
+    if (hi - mid < internal::staticRangeTreeMinNodeSize)
+        return;
+
+    //Split the ids of the node between the children
+    const std::vector<unsigned int>& sorted = orders[layerDim-1];
+    for (unsigned int i = 0; i < sorted.size(); i++)
+        flags[sorted[i]] = (i < mid - lo ? 1 : 0);
+
+    std::vector<std::vector<unsigned int>> leftOrders(layerDim), rightOrders(layerDim);
+    for (unsigned int d = 0; d < layerDim; d++) {
+        leftOrders[d].reserve(mid - lo);
+        rightOrders[d].reserve(hi - mid);
+        for (unsigned int id : orders[d]) {
+            if (flags[id])
+                leftOrders[d].push_back(id);
+            else
+                rightOrders[d].push_back(id);
+        }
+    }
+
+    this->buildAssociatedNodeHelper(layerDim, leftOrders, lo, mid, nodes, flags);
+    nodes[nodeIndex].right = (unsigned int) nodes.size();
+    this->buildAssociatedNodeHelper(layerDim, rightOrders, mid, hi, nodes, flags);
+}
+
+
+
+/* --------- QUERY HELPERS --------- */
+
+/**
+ * @brief Range query helper on a layer
+ *
+ * @param[in] layerIndex Index of the layer
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Ids of the keys in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::rangeQueryHelper(
+        const unsigned int layerIndex,
+        const K& start, const K& end,
+        std::vector<unsigned int>& out) const
+{
+    const Layer& layer = layers[layerIndex];
+    const unsigned int* sorted = &sortedIds[layer.sortedOffset];
+    const C& comparator = customComparators[layer.dim-1];
+
+    //Positions of the range in the dimension of the layer
+    const unsigned int qa = lowerBoundHelper(sorted, layer.size, start, comparator);
+    const unsigned int qb = upperBoundHelper(sorted, layer.size, end, comparator);
+
+    if (qa >= qb)
+        return;
+
+    if (layer.dim == 1) {
+        out.insert(out.end(), sorted + qa, sorted + qb);
+    }
+    else if (layer.dim == 2) {
+        //The only binary search on the first dimension
+        const unsigned int pos = lowerBoundHelper(
+                    &cascadeIds[layer.cascadeOffset], layer.size, start, customComparators[0]);
+
+        this->cascadeQueryHelper(layer, qa, qb, 0, layer.size, 0, pos, start, end, out);
+    }
+    else {
+        this->associatedNodeQueryHelper(layer, qa, qb, 0, layer.size, 0, start, end, out);
+    }
+}
+
+/**
+ * @brief Range query helper on a node of a layer with fractional cascading
+ *
+ * @param[in] layer Layer
+ * @param[in] qa First position of the range in the layer
+ * @param[in] qb Last position of the range in the layer (excluded)
+ * @param[in] lo First position of the node
+ * @param[in] hi Last position of the node (excluded)
+ * @param[in] depth Depth of the node
+ * @param[in] pos Position, relative to the node, of the first id which is not
+ * less than the start key in the first dimension
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Ids of the keys in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::cascadeQueryHelper(
+        const Layer& layer,
+        const unsigned int qa, const unsigned int qb,
+        const unsigned int lo, const unsigned int hi,
+        const unsigned int depth,
+        const unsigned int pos,
+        const K& start, const K& end,
+        std::vector<unsigned int>& out) const
+{
+    if (hi <= qa || lo >= qb)
+        return;
+
+    const size_t offset = layer.cascadeOffset + (size_t) depth * layer.size;
+
+    //Node contained in the range: report ids until the end key
+    if (qa <= lo && hi <= qb) {
+        const C& comparator = customComparators[0];
+        for (unsigned int p = lo + pos; p < hi; p++) {
+            const unsigned int id = cascadeIds[offset + p];
+            if (comparator(end, keys[id]))
+                break;
+            out.push_back(id);
+        }
+        return;
+    }
+
+    //Small node without children
+    if (hi - lo < internal::staticRangeTreeMinNodeSize) {
+        this->scanHelper(layer, std::max(lo, qa), std::min(hi, qb), start, end, out);
+        return;
+    }
+
+    const unsigned int mid = (lo + hi) / 2;
+    const unsigned int leftPos = (pos < hi - lo ? cascadeLeft[offset + lo + pos] : mid - lo);
+
+    this->cascadeQueryHelper(layer, qa, qb, lo, mid, depth + 1, leftPos, start, end, out);
+    this->cascadeQueryHelper(layer, qa, qb, mid, hi, depth + 1, pos - leftPos, start, end, out);
+}
+
+/**
+ * @brief Range query helper on a node of a layer with associated layers
+ *
+ * @param[in] layer Layer
+ * @param[in] qa First position of the range in the layer
+ * @param[in] qb Last position of the range in the layer (excluded)
+ * @param[in] lo First position of the node
+ * @param[in] hi Last position of the node (excluded)
+ * @param[in] nodeIndex Index of the node in the layer
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Ids of the keys in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::associatedNodeQueryHelper(
+        const Layer& layer,
+        const unsigned int qa, const unsigned int qb,
+        const unsigned int lo, const unsigned int hi,
+        const unsigned int nodeIndex,
+        const K& start, const K& end,
+        std::vector<unsigned int>& out) const
+{
+    if (hi <= qa || lo >= qb)
+        return;
+
+    //Small node without associated layer
+    if (hi - lo < internal::staticRangeTreeMinNodeSize) {
+        this->scanHelper(layer, std::max(lo, qa), std::min(hi, qb), start, end, out);
+        return;
+    }
+
+    const AssociatedNode& node = associatedNodes[layer.nodesOffset + nodeIndex];
+
+    //Node contained in the range: search in the next dimension
+    if (qa <= lo && hi <= qb) {
+        this->rangeQueryHelper(node.layer, start, end, out);
+        return;
+    }
+
+    const unsigned int mid = (lo + hi) / 2;
+
+    this->associatedNodeQueryHelper(layer, qa, qb, lo, mid, nodeIndex + 1, start, end, out);
+    this->associatedNodeQueryHelper(layer, qa, qb, mid, hi, node.right, start, end, out);
+}
+
+/**
+ * @brief Check one by one the keys in the given positions of a layer, which
+ * are in the range in the dimension of the layer
+ *
+ * @param[in] layer Layer
+ * @param[in] from First position
+ * @param[in] to Last position (excluded)
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Ids of the keys in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::scanHelper(
+        const Layer& layer,
+        const unsigned int from, const unsigned int to,
+        const K& start, const K& end,
+        std::vector<unsigned int>& out) const
+{
+    const unsigned int* sorted = &sortedIds[layer.sortedOffset];
+    for (unsigned int p = from; p < to; p++) {
+        const K& key = keys[sorted[p]];
+
+        bool inRange = true;
+        for (unsigned int d = 0; d < layer.dim - 1 && inRange; d++) {
+            const C& comparator = customComparators[d];
+            inRange = !comparator(key, start) && !comparator(end, key);
+        }
+
+        if (inRange)
+            out.push_back(sorted[p]);
+    }
+}
+
+/**
+ * @brief Get the position of the first id whose key is not less than the
+ * given key
+ *
+ * @param[in] ids Ids sorted on the comparator
+ * @param[in] n Number of ids
+ * @param[in] key Key
+ * @param[in] comparator Comparator
+ * @return The position of the id
+ */
+template <class K, class T, class C>
+unsigned int StaticRangeTree<K,T,C>::lowerBoundHelper(
+        const unsigned int* ids,
+        const unsigned int n,
+        const K& key,
+        const C& comparator) const
+{
+    return (unsigned int) (std::lower_bound(
+                ids, ids + n, key,
+                [&](unsigned int id, const K& k) {
+        return comparator(keys[id], k);
+    }) - ids);
+}
+
+/**
+ * @brief Get the position of the first id whose key is greater than the
+ * given key
+ *
+ * @param[in] ids Ids sorted on the comparator
+ * @param[in] n Number of ids
+ * @param[in] key Key
+ * @param[in] comparator Comparator
+ * @return The position of the id
+ */
+template <class K, class T, class C>
+unsigned int StaticRangeTree<K,T,C>::upperBoundHelper(
+        const unsigned int* ids,
+        const unsigned int n,
+        const K& key,
+        const C& comparator) const
+{
+    return (unsigned int) (std::upper_bound(
+                ids, ids + n, key,
+                [&](const K& k, unsigned int id) {
+        return comparator(k, keys[id]);
+    }) - ids);
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_TRIANGLE_BVH_H
+#define CG3_TRIANGLE_BVH_H
+
+#include <cg3/geometry/bounding_box.h>
+#include <cg3/geometry/triangle.h>
+
+#include "bvh.h"
+
+#ifdef  CG3_DCEL_DEFINED
+#include <cg3/meshes/dcel/dcel.h>
+#endif
+
+#ifdef  CG3_EIGENMESH_DEFINED
+namespace cg3 {
+class SimpleEigenMesh;
+}
+#endif
+
+namespace cg3 {
+
+/**
+ * @brief A static BVH of the triangles of a mesh, which allows to make fast
+ * intersection and distance queries without CGAL.
+ *
+ * Every triangle is identified by an id: the id of the face for a Dcel (polygonal faces
+ * are triangulated, and all their triangles have the id of the face), the index of the
+ * face for a SimpleEigenMesh and the index in the vector for a vector of triangles.
+ */
+class TriangleBVH
+{
+public:
+    TriangleBVH();
+    TriangleBVH(const std::vector<Triangle3Dd>& triangles);
+    #ifdef  CG3_DCEL_DEFINED
+    TriangleBVH(const Dcel& d);
+    #endif
+    #ifdef  CG3_EIGENMESH_DEFINED
+    TriangleBVH(const SimpleEigenMesh& m);
+    #endif
+
+    unsigned int numberTriangles() const;
+    BoundingBox boundingBox() const;
+
+    template <class OutputIterator>
+    void aabbOverlapQuery(const BoundingBox& b, OutputIterator out) const;
+    bool aabbOverlapCheck(const BoundingBox& b) const;
+
+    template <class OutputIterator>
+    void intersectedTriangles(const Pointd& p1, const Pointd& p2, OutputIterator out) const;
+    int numberIntersectedPrimitives(const Pointd& p1, const Pointd& p2) const;
+    bool nearestIntersection(const Pointd& origin, const Vec3& direction, Pointd& intersection) const;
+    bool nearestIntersection(const Pointd& origin, const Vec3& direction, Pointd& intersection, unsigned int& id) const;
+
+    double squaredDistance(const Pointd& p) const;
+    Pointd nearestPoint(const Pointd& p) const;
+    Pointd nearestPoint(const Pointd& p, unsigned int& id) const;
+
+private:
+    typedef struct {
+        Pointd v1, v2, v3;
+    } Primitive;
+
+    struct AABBValueExtractor {
+        inline double operator()(
+                const Primitive& t,
+                const AABBValueType& valueType,
+                const int& dim) const;
+    };
+
+    typedef BVH<3, Primitive, unsigned int, AABBValueExtractor> Tree;
+
+    Tree tree;
+};
+
+namespace internal {
+
+bool rayTriangleIntersection(
+        const Pointd& origin,
+        const Vec3& direction,
+        const Pointd& v1,
+        const Pointd& v2,
+        const Pointd& v3,
+        double& t);
+
+Pointd nearestPointOnTriangle(
+        const Pointd& p,
+        const Pointd& a,
+        const Pointd& b,
+        const Pointd& c);
+
+} //namespace cg3::internal
+
+} //namespace cg3
+
+#include "triangle_bvh.tpp"
+
+#endif // CG3_TRIANGLE_BVH_H
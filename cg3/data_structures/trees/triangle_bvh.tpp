@@ -0,0 +1,336 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "triangle_bvh.h"
+
+#include <iterator>
+#include <limits>
+
+#ifdef  CG3_EIGENMESH_DEFINED
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#endif
+
+namespace cg3 {
+
+inline TriangleBVH::TriangleBVH() :
+    tree(AABBValueExtractor())
+{
+}
+
+/**
+ * @brief Builds the BVH of a vector of triangles. The id of a triangle is its index
+ * in the vector.
+ */
+inline TriangleBVH::TriangleBVH(const std::vector<Triangle3Dd>& triangles) :
+    tree(AABBValueExtractor())
+{
+    std::vector<std::pair<Primitive, unsigned int>> primitives(triangles.size());
+    for (unsigned int i = 0; i < triangles.size(); i++) {
+        primitives[i].first.v1 = triangles[i].v1();
+        primitives[i].first.v2 = triangles[i].v2();
+        primitives[i].first.v3 = triangles[i].v3();
+        primitives[i].second = i;
+    }
+    tree.construction(primitives);
+}
+
+#ifdef  CG3_DCEL_DEFINED
+/**
+ * @brief Builds the BVH of the faces of a Dcel. Faces with more than three vertices
+ * are triangulated with a fan of triangles around their first vertex. The id of a
+ * triangle is the id of its face.
+ */
+inline TriangleBVH::TriangleBVH(const Dcel& d) :
+    tree(AABBValueExtractor())
+{
+    std::vector<std::pair<Primitive, unsigned int>> primitives;
+    primitives.reserve(d.numberFaces());
+    for (const Dcel::Face* f : d.faceIterator()) {
+        const Dcel::HalfEdge* first = f->outerHalfEdge();
+        std::pair<Primitive, unsigned int> p;
+        p.first.v1 = first->fromVertex()->coordinate();
+        p.second = f->id();
+        for (const Dcel::HalfEdge* he = first->next(); he->next() != first; he = he->next()) {
+            p.first.v2 = he->fromVertex()->coordinate();
+            p.first.v3 = he->toVertex()->coordinate();
+            primitives.push_back(p);
+        }
+    }
+    tree.construction(primitives);
+}
+#endif
+
+#ifdef  CG3_EIGENMESH_DEFINED
+/**
+ * @brief Builds the BVH of the faces of a SimpleEigenMesh. The id of a triangle is the
+ * index of its face.
+ */
+inline TriangleBVH::TriangleBVH(const SimpleEigenMesh& m) :
+    tree(AABBValueExtractor())
+{
+    std::vector<std::pair<Primitive, unsigned int>> primitives(m.numberFaces());
+    for (unsigned int i = 0; i < m.numberFaces(); i++) {
+        Pointi f = m.face(i);
+        primitives[i].first.v1 = m.vertex(f.x());
+        primitives[i].first.v2 = m.vertex(f.y());
+        primitives[i].first.v3 = m.vertex(f.z());
+        primitives[i].second = i;
+    }
+    tree.construction(primitives);
+}
+#endif
+
+inline unsigned int TriangleBVH::numberTriangles() const
+{
+    return tree.size();
+}
+
+/**
+ * @brief Returns the bounding box of all the triangles.
+ */
+inline BoundingBox TriangleBVH::boundingBox() const
+{
+    if (tree.empty())
+        return BoundingBox();
+    const Tree::AABB& aabb = tree.nodes()[0].aabb;
+    return BoundingBox(
+                Pointd(aabb.min[0], aabb.min[1], aabb.min[2]),
+                Pointd(aabb.max[0], aabb.max[1], aabb.max[2]));
+}
+
+/**
+ * @brief Returns the ids of the triangles whose bounding box overlaps with the given
+ * bounding box. Polygonal Dcel faces may be returned more than once.
+ * @param[in] b: the query bounding box
+ * @param[out] out: output iterator for the ids
+ */
+template <class OutputIterator>
+inline void TriangleBVH::aabbOverlapQuery(const BoundingBox& b, OutputIterator out) const
+{
+    Tree::AABB aabb;
+    for (unsigned int i = 0; i < 3; i++) {
+        aabb.min[i] = b.min()[i];
+        aabb.max[i] = b.max()[i];
+    }
+    tree.aabbOverlapQuery(aabb, out);
+}
+
+/**
+ * @brief Checks if the given bounding box overlaps with the bounding box of a triangle.
+ */
+inline bool TriangleBVH::aabbOverlapCheck(const BoundingBox& b) const
+{
+    Tree::AABB aabb;
+    for (unsigned int i = 0; i < 3; i++) {
+        aabb.min[i] = b.min()[i];
+        aabb.max[i] = b.max()[i];
+    }
+    return tree.aabbOverlapCheck(aabb);
+}
+
+/**
+ * @brief Returns the ids of the triangles intersected by the ray starting from p1 and
+ * passing through p2.
+ * @param[in] p1: origin of the ray
+ * @param[in] p2: another point of the ray
+ * @param[out] out: output iterator for the ids
+ */
+template <class OutputIterator>
+inline void TriangleBVH::intersectedTriangles(const Pointd& p1, const Pointd& p2, OutputIterator out) const
+{
+    const Vec3 dir = p2 - p1;
+    tree.rayQuery(
+                std::array<double, 3>{{p1.x(), p1.y(), p1.z()}},
+                std::array<double, 3>{{dir.x(), dir.y(), dir.z()}},
+                [&](const Primitive& t, double& param) {
+                    return internal::rayTriangleIntersection(p1, dir, t.v1, t.v2, t.v3, param);
+                },
+                out);
+}
+
+/**
+ * @brief Returns the number of triangles intersected by the ray starting from p1 and
+ * passing through p2.
+ */
+inline int TriangleBVH::numberIntersectedPrimitives(const Pointd& p1, const Pointd& p2) const
+{
+    std::vector<unsigned int> ids;
+    intersectedTriangles(p1, p2, std::back_inserter(ids));
+    return ids.size();
+}
+
+/**
+ * @brief Computes the first intersection between a ray and the triangles.
+ * @param[in] origin: origin of the ray
+ * @param[in] direction: direction of the ray
+ * @param[out] intersection: the intersection nearest to the origin
+ * @return false if the ray does not intersect any triangle
+ */
+inline bool TriangleBVH::nearestIntersection(
+        const Pointd& origin,
+        const Vec3& direction,
+        Pointd& intersection) const
+{
+    unsigned int id;
+    return nearestIntersection(origin, direction, intersection, id);
+}
+
+/**
+ * @brief Computes the first intersection between a ray and the triangles.
+ * @param[in] origin: origin of the ray
+ * @param[in] direction: direction of the ray
+ * @param[out] intersection: the intersection nearest to the origin
+ * @param[out] id: the id of the intersected triangle
+ * @return false if the ray does not intersect any triangle
+ */
+inline bool TriangleBVH::nearestIntersection(
+        const Pointd& origin,
+        const Vec3& direction,
+        Pointd& intersection,
+        unsigned int& id) const
+{
+    double t;
+    int i = tree.nearestRayQuery(
+                std::array<double, 3>{{origin.x(), origin.y(), origin.z()}},
+                std::array<double, 3>{{direction.x(), direction.y(), direction.z()}},
+                [&](const Primitive& tr, double& param) {
+                    return internal::rayTriangleIntersection(origin, direction, tr.v1, tr.v2, tr.v3, param);
+                },
+                t);
+    if (i < 0)
+        return false;
+    intersection = origin + direction * t;
+    id = tree.value(i);
+    return true;
+}
+
+/**
+ * @brief Returns the squared distance between a point and the nearest triangle.
+ * @return the squared distance, std::numeric_limits<double>::max() if there are no triangles
+ */
+inline double TriangleBVH::squaredDistance(const Pointd& p) const
+{
+    unsigned int id;
+    Pointd nearest = nearestPoint(p, id);
+    if (id == std::numeric_limits<unsigned int>::max())
+        return std::numeric_limits<double>::max();
+    return (nearest - p).lengthSquared();
+}
+
+/**
+ * @brief Returns the point on the triangles nearest to the given point.
+ */
+inline Pointd TriangleBVH::nearestPoint(const Pointd& p) const
+{
+    unsigned int id;
+    return nearestPoint(p, id);
+}
+
+/**
+ * @brief Returns the point on the triangles nearest to the given point.
+ * @param[in] p: the query point
+ * @param[out] id: the id of the triangle which contains the nearest point,
+ * std::numeric_limits<unsigned int>::max() if there are no triangles
+ * @return the nearest point, p itself if there are no triangles
+ */
+inline Pointd TriangleBVH::nearestPoint(const Pointd& p, unsigned int& id) const
+{
+    id = std::numeric_limits<unsigned int>::max();
+    double d;
+    int i = tree.nearestPointQuery(
+                std::array<double, 3>{{p.x(), p.y(), p.z()}},
+                [&](const Primitive& t) {
+                    return (internal::nearestPointOnTriangle(p, t.v1, t.v2, t.v3) - p).lengthSquared();
+                },
+                d);
+    if (i < 0)
+        return p;
+    const Primitive& t = tree.key(i);
+    id = tree.value(i);
+    return internal::nearestPointOnTriangle(p, t.v1, t.v2, t.v3);
+}
+
+inline double TriangleBVH::AABBValueExtractor::operator()(
+        const Primitive& t,
+        const AABBValueType& valueType,
+        const int& dim) const
+{
+    if (valueType == MIN)
+        return std::min(std::min(t.v1[dim-1], t.v2[dim-1]), t.v3[dim-1]);
+    return std::max(std::max(t.v1[dim-1], t.v2[dim-1]), t.v3[dim-1]);
+}
+
+/**
+ * @brief Computes the intersection between a ray and a triangle (Moller-Trumbore).
+ * @param[out] t: parameter of the intersection point (origin + t * direction)
+ * @return true if the ray intersects the triangle with t >= 0
+ */
+inline bool internal::rayTriangleIntersection(
+        const Pointd& origin,
+        const Vec3& direction,
+        const Pointd& v1,
+        const Pointd& v2,
+        const Pointd& v3,
+        double& t)
+{
+    Vec3 e1 = v2 - v1, e2 = v3 - v1;
+    Vec3 pvec = direction.cross(e2);
+    double det = e1.dot(pvec);
+    if (det == 0)
+        return false;
+    double invDet = 1.0 / det;
+    Vec3 tvec = origin - v1;
+    double u = tvec.dot(pvec) * invDet;
+    if (u < 0 || u > 1)
+        return false;
+    Vec3 qvec = tvec.cross(e1);
+    double v = direction.dot(qvec) * invDet;
+    if (v < 0 || u + v > 1)
+        return false;
+    t = e2.dot(qvec) * invDet;
+    return t >= 0;
+}
+
+/**
+ * @brief Computes the point of the triangle abc nearest to p, checking in which Voronoi
+ * region of the triangle (vertices, edges or interior) p lies.
+ */
+inline Pointd internal::nearestPointOnTriangle(
+        const Pointd& p,
+        const Pointd& a,
+        const Pointd& b,
+        const Pointd& c)
+{
+    Vec3 ab = b - a, ac = c - a, ap = p - a;
+    double d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if (d1 <= 0 && d2 <= 0)
+        return a;
+
+    Vec3 bp = p - b;
+    double d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if (d3 >= 0 && d4 <= d3)
+        return b;
+
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0)
+        return a + ab * (d1 / (d1 - d3));
+
+    Vec3 cp = p - c;
+    double d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if (d6 >= 0 && d5 <= d6)
+        return c;
+
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0)
+        return a + ac * (d2 / (d2 - d6));
+
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    double denom = 1.0 / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+} //namespace cg3
@@ -8,6 +8,7 @@
 #include "marching_cubes.h"
 
 #include <cg3/data_structures/arrays/arrays.h>
+#include <cg3/utilities/system.h>
 
 namespace cg3 {
 
@@ -272,7 +273,241 @@ static const Array2D<int> triTable = {
     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}    //255
 };
 
+} //namespace cg3::internal
 
+#ifdef CG3_EIGENMESH_DEFINED
+
+namespace internal {
+
+//Corners of a cube, as offsets from its minimum grid vertex
+static const unsigned int cornerOffsets[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+    {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}
+};
+
+//Edges of a cube: offset of the grid vertex which owns the edge, and direction of
+//the edge (0 = x, 1 = y, 2 = z). Each grid vertex owns its edges towards +x, +y, +z.
+static const unsigned int edgeOwners[12][4] = {
+    {0, 0, 0, 0}, {1, 0, 0, 1}, {0, 1, 0, 0}, {0, 0, 0, 1},
+    {0, 0, 1, 0}, {1, 0, 1, 1}, {0, 1, 1, 0}, {0, 0, 1, 1},
+    {0, 0, 0, 2}, {1, 0, 0, 2}, {1, 1, 0, 2}, {0, 1, 0, 2}
+};
+
+typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> MarchingCubesVertices;
+typedef Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor> MarchingCubesFaces;
+
+/**
+ * @brief Enumerates the edges crossed by the isosurface which are owned by the grid
+ * vertices of the slice i (the vertices with first index i), in a fixed order.
+ * @param[in] values: values of the field
+ * @param[in] sizes: number of grid vertices along x, y, z
+ * @param[in] isovalue: value of the isosurface
+ * @param[in] i: slice
+ * @param[in] firstId: id of the first crossed edge of the slice
+ * @param[out] ids: if not null, id of each crossed edge, in position (j * sizeZ + k) * 3 + direction
+ * @param[out] vertices: if not null, the vertex of each crossed edge is written in the row id,
+ * in grid coordinates
+ * @return the number of crossed edges
+ */
+inline unsigned int sliceCrossedEdges(
+        const double* values,
+        const unsigned long int sizes[],
+        double isovalue,
+        unsigned int i,
+        unsigned int firstId,
+        unsigned int* ids,
+        MarchingCubesVertices* vertices)
+{
+    const unsigned long int strides[3] = {sizes[1] * sizes[2], sizes[2], 1};
+
+    unsigned int id = firstId;
+    for (unsigned int j = 0; j < sizes[1]; j++) {
+        for (unsigned int k = 0; k < sizes[2]; k++) {
+            const unsigned long int index = i * strides[0] + j * strides[1] + k;
+            const unsigned int position[3] = {i, j, k};
+            const double value = values[index];
+            const bool inside = value < isovalue;
+
+            for (unsigned int d = 0; d < 3; d++) {
+                if (position[d] + 1 >= sizes[d])
+                    continue;
+
+                const double other = values[index + strides[d]];
+                if ((other < isovalue) != inside) {
+                    if (ids != nullptr)
+                        ids[(j * sizes[2] + k) * 3 + d] = id;
+
+                    if (vertices != nullptr) {
+                        double t = (isovalue - value) / (other - value);
+                        vertices->row(id) << (double) i, (double) j, (double) k;
+                        (*vertices)(id, d) += t;
+                    }
+                    id++;
+                }
+            }
+        }
+    }
+    return id - firstId;
+}
+
+/**
+ * @brief Index in the triangle table of the cube with minimum grid vertex (i, j, k):
+ * the bit c is set if the corner c is below the isovalue
+ */
+inline unsigned int cubeIndex(
+        const double* values,
+        const unsigned long int sizes[],
+        double isovalue,
+        unsigned int i,
+        unsigned int j,
+        unsigned int k)
+{
+    unsigned int index = 0;
+    for (unsigned int c = 0; c < 8; c++) {
+        unsigned long int position =
+                ((i + cornerOffsets[c][0]) * sizes[1] + j + cornerOffsets[c][1]) * sizes[2] +
+                k + cornerOffsets[c][2];
+        if (values[position] < isovalue)
+            index |= 1 << c;
+    }
+    return index;
 }
 
+} //namespace cg3::internal
+
+/**
+ * @brief Extracts the isosurface of a scalar field sampled on a regular grid.
+ *
+ * The grid is processed in slabs of constant first index, in parallel. Each vertex
+ * of the output lies on a grid edge crossed by the isosurface and is identified
+ * by that edge: the vertices are numbered slab by slab with a prefix sum, so that
+ * cubes sharing an edge share the vertex, without any map on the coordinates.
+ * The output does not depend on the number of threads.
+ * @param[in] field: values of the field, the grid vertex (i, j, k) has
+ * coordinates origin + (i, j, k) * unit
+ * @param[in] isovalue: value of the isosurface
+ * @param[in] origin: coordinates of the grid vertex (0, 0, 0)
+ * @param[in] unit: distance between two adjacent grid vertices
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the triangle mesh of the isosurface, with faces oriented towards the
+ * values greater than the isovalue
+ */
+SimpleEigenMesh marchingCubes(
+        const Array3D<double>& field,
+        double isovalue,
+        const Pointd& origin,
+        double unit,
+        unsigned int nThreads)
+{
+    if (nThreads == 0)
+        nThreads = maxNumberOfThreads();
+
+    const unsigned long int sizes[3] = {field.sizeX(), field.sizeY(), field.sizeZ()};
+    if (sizes[0] < 2 || sizes[1] < 2 || sizes[2] < 2)
+        return SimpleEigenMesh();
+
+    const double* values = &field(0, 0, 0);
+    const unsigned int nSlices = (unsigned int) sizes[0];
+
+    //Number of triangles of each configuration
+    unsigned int numberTriangles[256];
+    for (unsigned int c = 0; c < 256; c++) {
+        numberTriangles[c] = 0;
+        while (numberTriangles[c] < 5 && internal::triTable(c, numberTriangles[c] * 3) != -1)
+            numberTriangles[c]++;
+    }
+
+    //Crossed edges owned by each slice, and triangles of the cubes of each slice
+    std::vector<unsigned int> vertexOffsets(nSlices + 1, 0);
+    std::vector<unsigned int> faceOffsets(nSlices + 1, 0);
+
+    #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+    for (int i = 0; i < (int) nSlices; i++) {
+        vertexOffsets[i + 1] = internal::sliceCrossedEdges(values, sizes, isovalue, i, 0, nullptr, nullptr);
+
+        if (i + 1 < (int) nSlices) {
+            unsigned int n = 0;
+            for (unsigned int j = 0; j + 1 < sizes[1]; j++) {
+                for (unsigned int k = 0; k + 1 < sizes[2]; k++) {
+                    n += numberTriangles[internal::cubeIndex(values, sizes, isovalue, i, j, k)];
+                }
+            }
+            faceOffsets[i + 1] = n;
+        }
+    }
+
+    for (unsigned int i = 0; i < nSlices; i++) {
+        vertexOffsets[i + 1] += vertexOffsets[i];
+        faceOffsets[i + 1] += faceOffsets[i];
+    }
+
+    internal::MarchingCubesVertices vertices(vertexOffsets[nSlices], 3);
+    internal::MarchingCubesFaces faces(faceOffsets[nSlices], 3);
+
+    #pragma omp parallel num_threads(nThreads)
+    {
+        //Ids of the crossed edges of the slice and of the next one
+        const unsigned long int sliceSize = sizes[1] * sizes[2] * 3;
+        std::vector<unsigned int> ids(2 * sliceSize);
+
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < (int) nSlices; i++) {
+            internal::sliceCrossedEdges(
+                        values, sizes, isovalue, i, vertexOffsets[i], ids.data(), &vertices);
+
+            if (i + 1 == (int) nSlices)
+                continue;
+
+            internal::sliceCrossedEdges(
+                        values, sizes, isovalue, i + 1, vertexOffsets[i + 1], ids.data() + sliceSize, nullptr);
+
+            unsigned int f = faceOffsets[i];
+            for (unsigned int j = 0; j + 1 < sizes[1]; j++) {
+                for (unsigned int k = 0; k + 1 < sizes[2]; k++) {
+                    unsigned int c = internal::cubeIndex(values, sizes, isovalue, i, j, k);
+
+                    for (unsigned int t = 0; t < numberTriangles[c]; t++) {
+                        unsigned int v[3];
+                        for (unsigned int l = 0; l < 3; l++) {
+                            const unsigned int* edge = internal::edgeOwners[internal::triTable(c, t * 3 + l)];
+                            v[l] = ids[edge[0] * sliceSize + ((j + edge[1]) * sizes[2] + k + edge[2]) * 3 + edge[3]];
+                        }
+                        faces.row(f) << v[0], v[2], v[1];
+                        f++;
+                    }
+                }
+            }
+        }
+    }
+
+    //From grid to world coordinates
+    vertices *= unit;
+    vertices.rowwise() += Eigen::RowVector3d(origin.x(), origin.y(), origin.z());
+
+    return SimpleEigenMesh(vertices, faces);
+}
+
+/**
+ * @brief Extracts the isosurface of a scalar field stored in a regular lattice.
+ * @param[in] lattice: values of the field on the vertices of the lattice
+ * @param[in] isovalue: value of the isosurface
+ * @param[in] nThreads: number of threads, 0 to use all the available ones
+ * @return the triangle mesh of the isosurface
+ * @see marchingCubes(const Array3D<double>&, double, const Pointd&, double, unsigned int)
+ */
+SimpleEigenMesh marchingCubes(
+        const RegularLattice<double>& lattice,
+        double isovalue,
+        unsigned int nThreads)
+{
+    return marchingCubes(
+                lattice.vertexPropertiesArray(),
+                isovalue,
+                lattice.boundingBox().min(),
+                lattice.unitLength(),
+                nThreads);
+}
+
+#endif
+
 }
@@ -10,11 +10,23 @@
 
 #ifdef CG3_EIGENMESH_DEFINED
 
+#include <cg3/meshes/eigenmesh/simpleeigenmesh.h>
+#include <cg3/data_structures/arrays/array3d.h>
+#include <cg3/development/data_structures/lattices/regular_lattice.h>
+
 namespace cg3 {
 
-/**
- * @todo
- */
+SimpleEigenMesh marchingCubes(
+        const Array3D<double>& field,
+        double isovalue = 0,
+        const Pointd& origin = Pointd(),
+        double unit = 1,
+        unsigned int nThreads = 0);
+
+SimpleEigenMesh marchingCubes(
+        const RegularLattice<double>& lattice,
+        double isovalue = 0,
+        unsigned int nThreads = 0);
 
 }
 
@@ -26,6 +26,8 @@ public:
     unsigned int resZ() const;
 
     const cg3::BoundingBox& boundingBox() const;
+    double unitLength() const;
+    const cg3::Array3D<VT>& vertexPropertiesArray() const;
 
     cg3::Pointd nearestVertex(const cg3::Pointd& p) const;
     const VT& vertexProperty(const cg3::Pointd& p) const;
@@ -56,12 +56,24 @@ const BoundingBox &RegularLattice<VT>::boundingBox() const
     return bb;
 }
 
+template<class VT>
+double RegularLattice<VT>::unitLength() const
+{
+    return unit;
+}
+
+template<class VT>
+const Array3D<VT>& RegularLattice<VT>::vertexPropertiesArray() const
+{
+    return vertexProperties;
+}
+
 template<class VT>
 Pointd RegularLattice<VT>::nearestVertex(const Pointd &p) const
 {
-    return cg3::Pointd(bb.getMinX() + getIndexOfCoordinateX(p.x())*unit,
-                       bb.getMinY() + getIndexOfCoordinateY(p.y())*unit,
-                       bb.getMinZ() + getIndexOfCoordinateZ(p.z())*unit);
+    return cg3::Pointd(bb.minX() + getIndexOfCoordinateX(p.x())*unit,
+                       bb.minY() + getIndexOfCoordinateY(p.y())*unit,
+                       bb.minZ() + getIndexOfCoordinateZ(p.z())*unit);
 }
 
 template<class VT>
@@ -122,29 +134,29 @@ Pointd RegularLattice<VT>::getPoint(
         unsigned int j,
         unsigned int k) const
 {
-    return cg3::Pointd(bb.getMinX() + i*unit,
-                       bb.getMinY() + j*unit,
-                       bb.getMinZ() + k*unit);
+    return cg3::Pointd(bb.minX() + i*unit,
+                       bb.minY() + j*unit,
+                       bb.minZ() + k*unit);
 }
 
 template<class VT>
 int RegularLattice<VT>::getIndexOfCoordinateX(double x) const
 {
-    double deltax = x - bb.getMinX();
+    double deltax = x - bb.minX();
     return (deltax * (mresX-1)) / bb.lengthX();
 }
 
 template<class VT>
 int RegularLattice<VT>::getIndexOfCoordinateY(double y) const
 {
-    double deltay = y - bb.getMinY();
+    double deltay = y - bb.minY();
     return (deltay * (mresY-1)) / bb.lengthY();
 }
 
 template<class VT>
 int RegularLattice<VT>::getIndexOfCoordinateZ(double z) const
 {
-    double deltaz = z - bb.getMinZ();
+    double deltaz = z - bb.minZ();
     return (deltaz * (mresZ-1)) / bb.lengthZ();
 }
 
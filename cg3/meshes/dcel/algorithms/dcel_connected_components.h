@@ -17,6 +17,24 @@ std::vector< std::set<const Dcel::Face*> > connectedComponents(
         InputIterator first,
         InputIterator last);
 
+template <typename InputIterator>
+unsigned int connectedComponentsLabels(
+        InputIterator first,
+        InputIterator last,
+        std::vector<int>& faceLabels);
+
+unsigned int connectedComponentsLabels(
+        const Dcel& d,
+        std::vector<int>& faceLabels);
+
+namespace internal {
+
+unsigned int labelConnectedComponents(
+        const std::vector<const Dcel::Face*>& faces,
+        std::vector<int>& faceLabels);
+
+} //namespace cg3::dcelAlgorithms::internal
+
 #ifdef CG3_OLD_NAMES_COMPATIBILITY
 template <typename InputIterator>
 inline std::vector< std::set<const Dcel::Face*> > getConnectedComponents(
@@ -6,38 +6,114 @@
  */
 
 #include "dcel_connected_components.h"
-#include "dcel_flooding.h"
-
-#include <cg3/utilities/set.h>
 
 namespace cg3 {
 namespace dcelAlgorithms {
 
+/**
+ * @brief Computes the connected components of a set of faces: two faces belong to the
+ * same component if they are connected by a path of adjacent faces of the set.
+ * @param[in] first, last: the range of faces (const Dcel::Face*) of the set
+ * @return a set of faces for every connected component, sorted by the position in the
+ * range of their first face
+ */
 template <typename InputIterator>
 std::vector< std::set<const Dcel::Face*> > connectedComponents(
         InputIterator first,
         InputIterator last)
 {
-    struct Comp{
-        const std::set<const Dcel::Face*> &cf;
-        Comp(const std::set<const Dcel::Face*> &cf) : cf(cf) {}
-        bool operator()(const Dcel::Face* f) {
-            return cf.find(f) != cf.end();
-        }
-    };
+    std::vector<const Dcel::Face*> faces;
+    for (; first != last; ++first)
+        faces.push_back(*first);
+    std::vector<int> faceLabels;
+    unsigned int nComponents = internal::labelConnectedComponents(faces, faceLabels);
 
-    std::vector< std::set<const Dcel::Face*> > connectedComp;
-    std::set<const Dcel::Face*> containedFaces(first, last);
-
-    while (containedFaces.size() > 0){
-        Comp comp(containedFaces);
-        const Dcel::Face* f = *(containedFaces.begin());
-        std::set<const Dcel::Face*> cc = floodBFS(f, comp);
-        connectedComp.push_back(cc);
-        containedFaces = difference(containedFaces, cc);
+    std::vector< std::set<const Dcel::Face*> > connectedComp(nComponents);
+    for (const Dcel::Face* f : faces) {
+        if (f != nullptr)
+            connectedComp[faceLabels[f->id()]].insert(f);
     }
     return connectedComp;
 }
 
+/**
+ * @brief Labels the connected components of a set of faces in linear time.
+ * @param[in] first, last: the range of faces (const Dcel::Face*) of the set
+ * @param[out] faceLabels: indexed by face id, the label (from 0 to the number of
+ * components - 1) of the component of every face of the set, -1 for faces which
+ * are not in the set
+ * @return the number of connected components
+ */
+template <typename InputIterator>
+unsigned int connectedComponentsLabels(
+        InputIterator first,
+        InputIterator last,
+        std::vector<int>& faceLabels)
+{
+    std::vector<const Dcel::Face*> faces;
+    for (; first != last; ++first)
+        faces.push_back(*first);
+    return internal::labelConnectedComponents(faces, faceLabels);
+}
+
+/**
+ * @brief Labels the connected components of all the faces of a Dcel in linear time.
+ * @param[in] d: the Dcel
+ * @param[out] faceLabels: indexed by face id, the label of the component of every face,
+ * -1 for ids of deleted faces
+ * @return the number of connected components
+ */
+inline unsigned int connectedComponentsLabels(
+        const Dcel& d,
+        std::vector<int>& faceLabels)
+{
+    return connectedComponentsLabels(d.faceBegin(), d.faceEnd(), faceLabels);
+}
+
+/**
+ * @brief Visits every face of the set once, with a flooding from every face not yet
+ * labeled; faces of the set are marked in a vector indexed by their id instead of
+ * being searched in std::sets.
+ */
+inline unsigned int internal::labelConnectedComponents(
+        const std::vector<const Dcel::Face*>& faces,
+        std::vector<int>& faceLabels)
+{
+    unsigned int size = 0;
+    for (const Dcel::Face* f : faces) {
+        if (f != nullptr && f->id() >= size)
+            size = f->id() + 1;
+    }
+    std::vector<bool> contained(size, false);
+    for (const Dcel::Face* f : faces) {
+        if (f != nullptr)
+            contained[f->id()] = true;
+    }
+    faceLabels.assign(size, -1);
+
+    int nComponents = 0;
+    std::vector<const Dcel::Face*> stack;
+    for (const Dcel::Face* seed : faces) {
+        if (seed == nullptr || faceLabels[seed->id()] >= 0)
+            continue;
+        faceLabels[seed->id()] = nComponents;
+        stack.push_back(seed);
+        while (stack.size() > 0) {
+            const Dcel::Face* f = stack.back();
+            stack.pop_back();
+            for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()) {
+                const Dcel::Face* adjacent = he->twin() != nullptr ? he->twin()->face() : nullptr;
+                if (adjacent != nullptr && adjacent->id() < size &&
+                        contained[adjacent->id()] && faceLabels[adjacent->id()] < 0) {
+                    faceLabels[adjacent->id()] = nComponents;
+                    stack.push_back(adjacent);
+                }
+            }
+        }
+        nComponents++;
+    }
+    return nComponents;
+}
+
 } //namespace cg3::dcelAlgorithms
-} //namesoace cg3
+} //namespace cg3
@@ -82,6 +82,7 @@ namespace cg3 {
 class Dcel::Face {
 
     friend class Dcel;
+    friend class MemoryPool<Dcel::Face>;
 
 public:
 
@@ -56,16 +56,6 @@ Dcel::HalfEdge::HalfEdge() :
 }
 #endif
 
-/**
- * \~Italian
- * @brief Distruttore vuoto.
- *
- * La classe Dcel dovrà occuparsi di eliminare tutti i riferimenti in essa contenuti (e quindi contenuti di conseguenza anche nella classe Dcel::HalfEdge).
- */
-Dcel::HalfEdge::~HalfEdge(void)
-{
-}
-
 bool Dcel::HalfEdge::isConvex() const {
     if ((face()->normal()) == (twin()->face()->normal()))
         return true;
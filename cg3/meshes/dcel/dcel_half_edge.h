@@ -50,6 +50,7 @@ namespace cg3 {
 class Dcel::HalfEdge
 {
     friend class Dcel;
+    friend class MemoryPool<Dcel::HalfEdge>;
 
 public:
 
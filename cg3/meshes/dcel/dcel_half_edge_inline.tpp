@@ -9,6 +9,23 @@
 
 namespace cg3 {
 
+/**************
+ * Destructor *
+ **************/
+
+/**
+ * \~Italian
+ * @brief Distruttore vuoto.
+ *
+ * La classe Dcel dovrà occuparsi di eliminare tutti i riferimenti in essa contenuti (e quindi contenuti di conseguenza anche nella classe Dcel::HalfEdge).
+ *
+ * È inline affinché la distruzione di tutti gli elementi della Dcel (che sono contenuti in
+ * una cg3::MemoryPool) non richieda una chiamata a funzione per ogni elemento.
+ */
+inline Dcel::HalfEdge::~HalfEdge(void)
+{
+}
+
 /*************************
  * Public Inline Methods *
  *************************/
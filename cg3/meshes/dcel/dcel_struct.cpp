@@ -56,6 +56,7 @@ Dcel::Dcel() :
  */
 Dcel::Dcel(const Dcel& dcel)
 {
+    this->reserve(dcel.nVertices, dcel.nHalfEdges, dcel.nFaces);
     this->unusedVids = dcel.unusedVids;
     this->unusedHeids = dcel.unusedHeids;
     this->unusedFids = dcel.unusedFids;
@@ -63,9 +64,8 @@ Dcel::Dcel(const Dcel& dcel)
     this->nHalfEdges = dcel.nHalfEdges;
     this->nFaces = dcel.nFaces;
     this->bBox = dcel.bBox;
-    std::map<const Dcel::Vertex*, Dcel::Vertex*> mapVertices;
-    std::map<const Dcel::HalfEdge*, Dcel::HalfEdge*> mapHalfEdges;
-    std::map<const Dcel::Face*, Dcel::Face*> mapFaces;
+    // every copied element keeps its id: the element of this Dcel corresponding
+    // to an element of dcel is found in O(1) in the vectors of this Dcel
     this->vertices.resize(dcel.vertices.size(), nullptr);
     #ifdef NDEBUG
     this->vertexCoordinates.resize(dcel.vertexCoordinates.size(), Pointd());
@@ -80,7 +80,6 @@ Dcel::Dcel(const Dcel& dcel)
         v->setCardinality(ov->cardinality());
         v->setNormal(ov->normal());
         v->setColor(ov->color());
-        mapVertices[ov] = v;
     }
 
     this->halfEdges.resize(dcel.halfEdges.size(), nullptr);
@@ -88,9 +87,8 @@ Dcel::Dcel(const Dcel& dcel)
         Dcel::HalfEdge* he = this->addHalfEdge(ohe->id());
         he->setId(ohe->id());
         he->setFlag(ohe->flag());
-        he->setFromVertex(mapVertices[ohe->fromVertex()]);
-        he->setToVertex(mapVertices[ohe->toVertex()]);
-        mapHalfEdges[ohe] = he;
+        he->setFromVertex(ohe->fromVertex() ? this->vertices[ohe->fromVertex()->id()] : nullptr);
+        he->setToVertex(ohe->toVertex() ? this->vertices[ohe->toVertex()->id()] : nullptr);
     }
 
     this->faces.resize(dcel.faces.size(), nullptr);
@@ -105,24 +103,23 @@ Dcel::Dcel(const Dcel& dcel)
         f->setFlag(of->flag());
         f->setNormal(of->normal());
         f->setArea(of->area());
-        f->setOuterHalfEdge(mapHalfEdges[of->outerHalfEdge()]);
+        f->setOuterHalfEdge(of->outerHalfEdge() ? this->halfEdges[of->outerHalfEdge()->id()] : nullptr);
         for (Dcel::Face::ConstInnerHalfEdgeIterator heit = of->innerHalfEdgeBegin(); heit != of->innerHalfEdgeEnd(); ++heit){
-            f->addInnerHalfEdge(mapHalfEdges[*heit]);
+            f->addInnerHalfEdge(*heit ? this->halfEdges[(*heit)->id()] : nullptr);
         }
-        mapFaces[of] = f;
     }
 
     for (const Dcel::HalfEdge* ohe : dcel.halfEdgeIterator()) {
-        Dcel::HalfEdge* he = mapHalfEdges[ohe];
-        he->setNext(mapHalfEdges[ohe->next()]);
-        he->setPrev(mapHalfEdges[ohe->prev()]);
-        he->setTwin(mapHalfEdges[ohe->twin()]);
-        he->setFace(mapFaces[ohe->face()]);
+        Dcel::HalfEdge* he = this->halfEdges[ohe->id()];
+        he->setNext(ohe->next() ? this->halfEdges[ohe->next()->id()] : nullptr);
+        he->setPrev(ohe->prev() ? this->halfEdges[ohe->prev()->id()] : nullptr);
+        he->setTwin(ohe->twin() ? this->halfEdges[ohe->twin()->id()] : nullptr);
+        he->setFace(ohe->face() ? this->faces[ohe->face()->id()] : nullptr);
     }
 
     for (const Dcel::Vertex* ov : dcel.vertexIterator()) {
-        Dcel::Vertex * v = mapVertices[ov];
-        v->setIncidentHalfEdge(mapHalfEdges[ov->incidentHalfEdge()]);
+        Dcel::Vertex * v = this->vertices[ov->id()];
+        v->setIncidentHalfEdge(ov->incidentHalfEdge() ? this->halfEdges[ov->incidentHalfEdge()->id()] : nullptr);
     }
 }
 
@@ -138,6 +135,9 @@ Dcel::Dcel(Dcel&& dcel)
     nHalfEdges = std::move(dcel.nHalfEdges);
     nFaces = std::move(dcel.nFaces);
     bBox = std::move(dcel.bBox);
+    vertexPool = std::move(dcel.vertexPool);
+    halfEdgePool = std::move(dcel.halfEdgePool);
+    facePool = std::move(dcel.facePool);
     #ifdef NDEBUG
     vertexCoordinates = std::move(dcel.vertexCoordinates);
     vertexNormals = std::move(dcel.vertexNormals);
@@ -184,18 +184,19 @@ Dcel::Dcel(const cinolib::Trimesh<> &trimesh)
  * @brief Distruttore della Dcel.
  *
  * Elimina tutti gli elementi contenuti nelle liste dei vertici, degli half edge e delle facce della Dcel.
+ * La memoria degli elementi viene liberata dalle MemoryPool, un blocco alla volta.
  */
 Dcel::~Dcel()
 {
     for (unsigned int i=0; i<vertices.size(); i++)
         if (vertices[i]!= nullptr)
-            delete vertices[i];
+            vertexPool.destroyWithoutRecycle(vertices[i]);
     for (unsigned int i=0; i<halfEdges.size(); i++)
         if (halfEdges[i] != nullptr)
-            delete halfEdges[i];
+            halfEdgePool.destroyWithoutRecycle(halfEdges[i]);
     for (unsigned int i=0; i<faces.size(); i++)
         if (faces[i] != nullptr)
-            delete faces[i];
+            facePool.destroyWithoutRecycle(faces[i]);
 }
 
 /******************
@@ -298,11 +299,12 @@ bool Dcel::saveOnObj(const std::string& fileNameObj) const
  * @warning Utilizza Dcel::Face::ConstIncidentHalfEdgeIterator
  *
  * @param[in] fileNamePly: il nome del file su cui verrà salvata la mesh, \b con \b l'estensione \b ply.
+ * @param[in] format: formato del file, ascii (default) o binario (little o big endian).
  *
  * @par Complessità:
  *      \e O(numVertices) + \e O(numFaces) + \e O(numHalfEdges)
  */
-bool Dcel::saveOnPly(const std::string& fileNamePly) const
+bool Dcel::saveOnPly(const std::string& fileNamePly, io::FileFormat format) const
 {
     std::vector<double> vertices;
     std::vector<double> verticesNormals;
@@ -316,7 +318,7 @@ bool Dcel::saveOnPly(const std::string& fileNamePly) const
     int mode = io::NORMAL_VERTICES | io::COLOR_FACES;
     return saveMeshOnPly(fileNamePly, numberVertices(), numberFaces(), vertices.data(),
                          faces.data(), meshType, mode, verticesNormals.data(),
-                         io::RGB, internal::dummyVectorFloat.data(), faceColors.data(), faceSizes.data());
+                         io::RGB, internal::dummyVectorFloat.data(), faceColors.data(), faceSizes.data(), format);
 }
 
 void Dcel::saveOnDcelFile(const std::string& fileNameDcel) const
@@ -344,9 +346,9 @@ void Dcel::saveOnDcelFile(const std::string& fileNameDcel) const
 Dcel::Vertex *Dcel::addVertex(const Pointd& p, const Vec3& n, const Color& c)
 {
     #ifdef NDEBUG
-    Vertex* last= new Vertex(*this);
+    Vertex* last= vertexPool.create(*this);
     #else
-    Vertex* last= new Vertex();
+    Vertex* last= vertexPool.create();
     #endif
     if (unusedVids.size() == 0) {
         last->setId(nVertices);
@@ -362,10 +364,10 @@ Dcel::Vertex *Dcel::addVertex(const Pointd& p, const Vec3& n, const Color& c)
         #endif
     }
     else {
-        int vid = *(unusedVids.begin());
+        int vid = unusedVids.back();
         last->setId(vid);
         vertices[vid] = last;
-        unusedVids.erase(vid);
+        unusedVids.pop_back();
         #ifdef NDEBUG
         vertexCoordinates[vid] = p;
         vertexNormals[vid] = n;
@@ -395,9 +397,9 @@ Dcel::Vertex *Dcel::addVertex(const Pointd& p, const Vec3& n, const Color& c)
 Dcel::HalfEdge* Dcel::addHalfEdge()
 {
     #ifdef NDEBUG
-    HalfEdge* last = new HalfEdge(*this);
+    HalfEdge* last = halfEdgePool.create(*this);
     #else
-    HalfEdge* last = new HalfEdge();
+    HalfEdge* last = halfEdgePool.create();
     #endif
     if (unusedHeids.size() == 0){
         last->setId(nHalfEdges);
@@ -405,11 +407,11 @@ Dcel::HalfEdge* Dcel::addHalfEdge()
         //halfEdgeLinks.push_back({-1, -1, -1, -1, -1, -1});
     }
     else {
-        int heid = *(unusedHeids.begin());
+        int heid = unusedHeids.back();
         last->setId(heid);
         halfEdges[heid] = last;
         //halfEdgeLinks[heid] = {-1, -1, -1, -1, -1, -1};
-        unusedHeids.erase(heid);
+        unusedHeids.pop_back();
     }
     nHalfEdges++;
     return last;
@@ -429,9 +431,9 @@ Dcel::HalfEdge* Dcel::addHalfEdge()
 Dcel::Face* Dcel::addFace(const Vec3& n, const Color& c)
 {
     #ifdef NDEBUG
-    Face* last = new Face(*this);
+    Face* last = facePool.create(*this);
     #else
-    Face* last = new Face();
+    Face* last = facePool.create();
     #endif
     if (unusedFids.size() == 0){
         last->setId(nFaces);
@@ -445,10 +447,10 @@ Dcel::Face* Dcel::addFace(const Vec3& n, const Color& c)
         #endif
     }
     else {
-        int fid = *(unusedFids.begin());
+        int fid = unusedFids.back();
         last->setId(fid);
         faces[fid] = last;
-        unusedFids.erase(fid);
+        unusedFids.pop_back();
         #ifdef NDEBUG
         faceNormals[fid] = n;
         faceColors[fid] = c;
@@ -496,10 +498,10 @@ bool Dcel::deleteVertex(Dcel::Vertex* v)
         } while (he != v->_incidentHalfEdge);
     }
     vertices[v->_id]=nullptr;
-    unusedVids.insert(v->_id);
+    unusedVids.push_back(v->_id);
     nVertices--;
 
-    delete v;
+    vertexPool.destroy(v);
     return true;
 }
 
@@ -573,10 +575,10 @@ bool Dcel::deleteHalfEdge(HalfEdge* he)
     if (he->_fromVertex != nullptr)
         if (he->_fromVertex->_incidentHalfEdge == he) he->_fromVertex->_incidentHalfEdge = nullptr;
     halfEdges[he->_id] = nullptr;
-    unusedHeids.insert(he->_id);
+    unusedHeids.push_back(he->_id);
     nHalfEdges--;
 
-    delete he;
+    halfEdgePool.destroy(he);
     return true;
 }
 
@@ -613,9 +615,9 @@ bool Dcel::deleteFace(Face* f)
         } while (he != f->_innerHalfEdges[i]);
     }
     faces[f->id()]=nullptr;
-    unusedFids.insert(f->id());
+    unusedFids.push_back(f->id());
     nFaces--;
-    delete f;
+    facePool.destroy(f);
     return true;
 }
 
@@ -771,35 +773,93 @@ void Dcel::translate(const cg3::Vec3& c)
  * di componenti, e soprattutto se non si sono memorizzati riferimenti alle componenti mediante
  * vecchi id.
  *
+ * @see compact()
  * @par Complessità:
  *      \e O(numVertices \e + \e NumHalfEdges \e + \e NumFaces)
  */
 void Dcel::recalculateIds()
 {
-    nVertices = 0;
-    for (unsigned int i = 0; i < vertices.size(); i++){
-        vertices[nVertices] = vertices[i];
-        if (vertices[i] != nullptr) nVertices++;
-    }
-    unusedVids.clear();
-    vertices.resize(nVertices);
+    compact();
+}
 
-    nHalfEdges = 0;
-    for (unsigned int i = 0; i < halfEdges.size(); i++){
-        halfEdges[nHalfEdges] = halfEdges[i];
-        if (halfEdges[i] != nullptr) nHalfEdges++;
+/**
+ * @brief Renumbers densely the vertices, the half edges and the faces of the Dcel.
+ *
+ * After the deletion of some elements, the vectors of the Dcel contain holes which
+ * are skipped by the iterators and reused by the next insertions. This function moves
+ * every surviving element in the first free position (preserving the relative order of the elements),
+ * updates its id and removes all the holes. Pointers to the elements remain valid, ids
+ * stored before the call do not.
+ *
+ * No memory is allocated.
+ *
+ * @par Complexity:
+ *      \e O(numVertices \e + \e NumHalfEdges \e + \e NumFaces \e + \e NumDeletedElements)
+ */
+void Dcel::compact()
+{
+    if (!unusedVids.empty()) {
+        unsigned int nv = 0;
+        for (unsigned int i = 0; i < vertices.size(); i++){
+            if (vertices[i] != nullptr) {
+                if (i != nv) {
+                    vertices[nv] = vertices[i];
+                    vertices[nv]->setId(nv);
+                    #ifdef NDEBUG
+                    vertexCoordinates[nv] = vertexCoordinates[i];
+                    vertexNormals[nv] = vertexNormals[i];
+                    vertexColors[nv] = vertexColors[i];
+                    #endif
+                }
+                nv++;
+            }
+        }
+        vertices.resize(nv);
+        #ifdef NDEBUG
+        vertexCoordinates.resize(nv);
+        vertexNormals.resize(nv);
+        vertexColors.resize(nv);
+        #endif
+        unusedVids.clear();
     }
-    unusedHeids.clear();
-    halfEdges.resize(nHalfEdges);
 
-    nFaces = 0;
-    for (unsigned int i = 0; i < faces.size(); i++){
-        faces[nFaces] = faces[i];
-        if (faces[i] != nullptr) nFaces++;
+    if (!unusedHeids.empty()) {
+        unsigned int nhe = 0;
+        for (unsigned int i = 0; i < halfEdges.size(); i++){
+            if (halfEdges[i] != nullptr) {
+                if (i != nhe) {
+                    halfEdges[nhe] = halfEdges[i];
+                    halfEdges[nhe]->setId(nhe);
+                }
+                nhe++;
+            }
+        }
+        halfEdges.resize(nhe);
+        unusedHeids.clear();
     }
-    unusedFids.clear();
-    faces.resize(nFaces);
 
+    if (!unusedFids.empty()) {
+        unsigned int nf = 0;
+        for (unsigned int i = 0; i < faces.size(); i++){
+            if (faces[i] != nullptr) {
+                if (i != nf) {
+                    faces[nf] = faces[i];
+                    faces[nf]->setId(nf);
+                    #ifdef NDEBUG
+                    faceNormals[nf] = faceNormals[i];
+                    faceColors[nf] = faceColors[i];
+                    #endif
+                }
+                nf++;
+            }
+        }
+        faces.resize(nf);
+        #ifdef NDEBUG
+        faceNormals.resize(nf);
+        faceColors.resize(nf);
+        #endif
+        unusedFids.clear();
+    }
 }
 
 /**
@@ -817,6 +877,34 @@ void Dcel::resetFaceColors()
         f->setColor(Color(128,128,128));
 }
 
+/**
+ * @brief Allocates the memory needed to store the given number of elements.
+ *
+ * The vertices, half edges and faces that will be added until the Dcel contains the given
+ * number of elements will be placed in a single block of memory, and no reallocation of the
+ * internal vectors will be necessary.
+ *
+ * @param[in] nVertices: total number of vertices that the Dcel will contain
+ * @param[in] nHalfEdges: total number of half edges that the Dcel will contain
+ * @param[in] nFaces: total number of faces that the Dcel will contain
+ */
+void Dcel::reserve(unsigned int nVertices, unsigned int nHalfEdges, unsigned int nFaces)
+{
+    vertices.reserve(nVertices);
+    halfEdges.reserve(nHalfEdges);
+    faces.reserve(nFaces);
+    vertexPool.reserve(nVertices);
+    halfEdgePool.reserve(nHalfEdges);
+    facePool.reserve(nFaces);
+    #ifdef NDEBUG
+    vertexCoordinates.reserve(nVertices);
+    vertexNormals.reserve(nVertices);
+    vertexColors.reserve(nVertices);
+    faceNormals.reserve(nFaces);
+    faceColors.reserve(nFaces);
+    #endif
+}
+
 /**
  * \~Italian
  * @brief Funzione che cancella tutti i dati contenuti nella Dcel.
@@ -832,13 +920,16 @@ void Dcel::clear()
 {
     for (unsigned int i=0; i<vertices.size(); i++)
         if (vertices[i] != nullptr)
-            delete vertices[i];
+            vertexPool.destroyWithoutRecycle(vertices[i]);
     for (unsigned int i=0; i<halfEdges.size(); i++)
         if (halfEdges[i] != nullptr)
-            delete halfEdges[i];
+            halfEdgePool.destroyWithoutRecycle(halfEdges[i]);
     for (unsigned int i=0; i<faces.size(); i++)
         if (faces[i] != nullptr)
-            delete faces[i];
+            facePool.destroyWithoutRecycle(faces[i]);
+    vertexPool.clear();
+    halfEdgePool.clear();
+    facePool.clear();
     vertices.clear();
     halfEdges.clear();
     faces.clear();
@@ -1078,11 +1169,11 @@ bool Dcel::loadFromFile(const std::string& filename)
  */
 bool Dcel::loadFromObj(const std::string& filename)
 {
-    std::list<double> coords, vnorm;
-    std::list<unsigned int> faces, fsizes;
+    std::vector<double> coords, vnorm;
+    std::vector<unsigned int> faces, fsizes;
     io::MeshType meshType;
     int mode;
-    std::list<Color> vcolor, fcolor;
+    std::vector<Color> vcolor, fcolor;
 
     if (loadMeshFromObj(filename, coords, faces, meshType, mode, vnorm, vcolor, fcolor, fsizes)){
         clear();
@@ -1110,15 +1201,15 @@ bool Dcel::loadFromObj(const std::string& filename)
  */
 bool Dcel::loadFromPly(const std::string& filename)
 {
-    std::list<double> coords, vnorm;
-    std::list<unsigned int> faces, fsizes;
+    std::vector<double> coords, vnorm;
+    std::vector<unsigned int> faces, fsizes;
     io::MeshType meshType;
     int mode;
-    std::list<Color> vcolor, fcolor;
+    std::vector<Color> vcolor, fcolor;
 
     if (loadMeshFromPly(filename, coords, faces, meshType, mode, vnorm, vcolor, fcolor, fsizes)){
         clear();
-        afterLoadFile(coords, faces, mode, vnorm,vcolor, fcolor, fsizes);
+        afterLoadFile(coords, faces, mode, vnorm, vcolor, fcolor, fsizes);
         return true;
     }
     else
@@ -1154,6 +1245,9 @@ void Dcel::swap(Dcel& d)
     std::swap(nHalfEdges, d.nHalfEdges);
     std::swap(nFaces, d.nFaces);
     std::swap(bBox, d.bBox);
+    vertexPool.swap(d.vertexPool);
+    halfEdgePool.swap(d.halfEdgePool);
+    facePool.swap(d.facePool);
 
     #ifdef NDEBUG
     std::swap(vertexCoordinates, d.vertexCoordinates);
@@ -1176,9 +1270,18 @@ void Dcel::swap(Dcel& d)
     #endif
 }
 
+/**
+ * @brief Serializes the Dcel on a binary file.
+ *
+ * The attributes of vertices, half edges and faces are gathered in few contiguous
+ * arrays, each one written with a single call: the number of I/O calls does not
+ * depend on the size of the Dcel.
+ *
+ * @param[in] binaryFile: the file on which the Dcel is serialized
+ */
 void Dcel::serialize(std::ofstream& binaryFile) const
 {
-    cg3::serialize("cg3Dcel", binaryFile);
+    cg3::serialize("cg3DcelBlocks", binaryFile);
     //BB
     bBox.serialize(binaryFile);
     //N
@@ -1189,57 +1292,86 @@ void Dcel::serialize(std::ofstream& binaryFile) const
     cg3::serialize(unusedVids, binaryFile);
     cg3::serialize(unusedHeids, binaryFile);
     cg3::serialize(unusedFids, binaryFile);
+
     //Vertices
+    std::vector<unsigned int> ids;
+    std::vector<int> ints;
+    std::vector<double> doubles;
+    std::vector<unsigned char> colors;
+    ids.reserve(nVertices);
+    ints.reserve(nVertices*3);
+    doubles.reserve(nVertices*6);
+    colors.reserve(nVertices*4);
     for (const Dcel::Vertex* v : vertexIterator()){
-        int heid = -1;
-        if (v->incidentHalfEdge() != nullptr) heid = v->incidentHalfEdge()->id();
-
-        cg3::serialize(v->id(), binaryFile);
-        v->coordinate().serialize(binaryFile);
-        v->normal().serialize(binaryFile);
-        cg3::serialize(v->color(), binaryFile);
-        cg3::serialize(heid, binaryFile);
-        cg3::serialize(v->cardinality(), binaryFile);
-        cg3::serialize(v->flag(), binaryFile);
+        const Pointd& p = v->coordinate();
+        Vec3 n = v->normal();
+        Color c = v->color();
+        ids.push_back(v->id());
+        ints.push_back(v->incidentHalfEdge() != nullptr ? (int)v->incidentHalfEdge()->id() : -1);
+        ints.push_back(v->cardinality());
+        ints.push_back(v->flag());
+        doubles.insert(doubles.end(), {p.x(), p.y(), p.z(), n.x(), n.y(), n.z()});
+        colors.insert(colors.end(), {(unsigned char)c.red(), (unsigned char)c.green(), (unsigned char)c.blue(), (unsigned char)c.alpha()});
     }
+    cg3::serialize(ids, binaryFile);
+    cg3::serialize(ints, binaryFile);
+    cg3::serialize(doubles, binaryFile);
+    cg3::serialize(colors, binaryFile);
+
     //HalfEdges
+    ids.clear();
+    ints.clear();
+    ints.reserve(nHalfEdges*7);
     for (const Dcel::HalfEdge* he : halfEdgeIterator()){
-        int fv = -1; if (he->fromVertex() != nullptr) fv = he->fromVertex()->id();
-        int tv = -1; if (he->toVertex() != nullptr) tv = he->toVertex()->id();
-        int tw = -1; if (he->twin() != nullptr) tw = he->twin()->id();
-        int prev = -1; if (he->prev() != nullptr) prev = he->prev()->id();
-        int next = -1; if (he->next() != nullptr) next = he->next()->id();
-        int face = -1; if (he->face() != nullptr) face = he->face()->id();
-
-        cg3::serialize(he->id(), binaryFile);
-        cg3::serialize(fv, binaryFile);
-        cg3::serialize(tv, binaryFile);
-        cg3::serialize(tw, binaryFile);
-        cg3::serialize(prev, binaryFile);
-        cg3::serialize(next, binaryFile);
-        cg3::serialize(face, binaryFile);
-        cg3::serialize(he->flag(), binaryFile);
+        ids.push_back(he->id());
+        ints.push_back(he->fromVertex() != nullptr ? (int)he->fromVertex()->id() : -1);
+        ints.push_back(he->toVertex() != nullptr ? (int)he->toVertex()->id() : -1);
+        ints.push_back(he->twin() != nullptr ? (int)he->twin()->id() : -1);
+        ints.push_back(he->prev() != nullptr ? (int)he->prev()->id() : -1);
+        ints.push_back(he->next() != nullptr ? (int)he->next()->id() : -1);
+        ints.push_back(he->face() != nullptr ? (int)he->face()->id() : -1);
+        ints.push_back(he->flag());
     }
+    cg3::serialize(ids, binaryFile);
+    cg3::serialize(ints, binaryFile);
+
     //Faces
+    std::vector<int> innerHalfEdges;
+    ids.clear();
+    ints.clear();
+    doubles.clear();
+    colors.clear();
     for (const Dcel::Face* f : faceIterator()){
-        int ohe = -1; if (f->outerHalfEdge() != nullptr) ohe = f->outerHalfEdge()->id();
-        cg3::serialize(f->id(), binaryFile);
-        cg3::serialize(ohe, binaryFile);
-        f->normal().serialize(binaryFile);
-        cg3::serialize(f->color(), binaryFile);
-        cg3::serialize(f->area(), binaryFile);
-        cg3::serialize(f->flag(), binaryFile);
-        cg3::serialize(f->numberInnerHalfEdges(), binaryFile);
-
+        Vec3 n = f->normal();
+        Color c = f->color();
+        ids.push_back(f->id());
+        ints.push_back(f->outerHalfEdge() != nullptr ? (int)f->outerHalfEdge()->id() : -1);
+        ints.push_back(f->flag());
+        ints.push_back(f->numberInnerHalfEdges());
+        doubles.insert(doubles.end(), {n.x(), n.y(), n.z(), f->area()});
+        colors.insert(colors.end(), {(unsigned char)c.red(), (unsigned char)c.green(), (unsigned char)c.blue(), (unsigned char)c.alpha()});
         for (Dcel::Face::ConstInnerHalfEdgeIterator heit = f->innerHalfEdgeBegin(); heit != f->innerHalfEdgeEnd(); ++heit){
             const Dcel::HalfEdge* he = *heit;
-            int idhe = -1; if (he != nullptr) idhe = he->id();
-            cg3::serialize(idhe, binaryFile);
+            innerHalfEdges.push_back(he != nullptr ? (int)he->id() : -1);
         }
-
     }
+    cg3::serialize(ids, binaryFile);
+    cg3::serialize(ints, binaryFile);
+    cg3::serialize(doubles, binaryFile);
+    cg3::serialize(colors, binaryFile);
+    cg3::serialize(innerHalfEdges, binaryFile);
 }
 
+/**
+ * @brief Deserializes a Dcel from a binary file.
+ *
+ * Both the block format written by serialize() and the format written by the previous
+ * versions of the library are supported.
+ *
+ * @param[in] binaryFile: the file from which the Dcel is deserialized
+ * @throws std::ios_base::failure if the file does not contain a valid Dcel; in this
+ * case, the position of the stream is restored
+ */
 void Dcel::deserialize(std::ifstream& binaryFile)
 {
     int begin = binaryFile.tellg();
@@ -1248,110 +1380,12 @@ void Dcel::deserialize(std::ifstream& binaryFile)
         std::string s;
         cg3::deserialize(s, binaryFile);
 
-        if (s != "cg3Dcel")
-            throw std::ios_base::failure("Mismatching String: " + s + " != cg3Dcel");
-        //BB
-
-        tmp.bBox.deserialize(binaryFile);
-        cg3::deserialize(tmp.nVertices, binaryFile);
-        cg3::deserialize(tmp.nHalfEdges, binaryFile);
-        cg3::deserialize(tmp.nFaces, binaryFile);
-        cg3::deserialize(tmp.unusedVids, binaryFile);
-        cg3::deserialize(tmp.unusedHeids, binaryFile);
-        cg3::deserialize(tmp.unusedFids, binaryFile);
-
-        //Vertices
-        tmp.vertices.resize(tmp.nVertices+tmp.unusedVids.size(), nullptr);
-        #ifdef NDEBUG
-        tmp.vertexCoordinates.resize(tmp.nVertices+tmp.unusedVids.size(), Pointd());
-        tmp.vertexNormals.resize(tmp.nVertices+tmp.unusedVids.size(), Vec3());
-        tmp.vertexColors.resize(tmp.nVertices+tmp.unusedVids.size(), Color());
-        #endif
-        std::map<int, int> vert;
-
-        for (unsigned int i = 0; i < tmp.nVertices; i++){
-            int id, heid;
-            Pointd coord; Vec3 norm; Color color;
-            int c, f;
-            cg3::deserialize(id, binaryFile);
-            coord.deserialize(binaryFile);
-            norm.deserialize(binaryFile);
-            cg3::deserialize(color, binaryFile);
-            cg3::deserialize(heid, binaryFile);
-            cg3::deserialize(c, binaryFile);
-            cg3::deserialize(f, binaryFile);
-
-            Dcel::Vertex* v = tmp.addVertex(id);
-            v->setCardinality(c);
-            v->setCoordinate(coord);
-            v->setNormal(norm);
-            v->setFlag(f);
-            vert[id] = heid;
-        }
-        //HalfEdges
-        tmp.halfEdges.resize(tmp.nHalfEdges+tmp.unusedHeids.size(), nullptr);
-        std::map<int, std::array<int, 6> > edges;
-
-        for (unsigned int i = 0; i < tmp.nHalfEdges; i++){
-            int id, fv, tv, tw, prev, next, face, flag;
-            cg3::deserialize(id, binaryFile);
-            cg3::deserialize(fv, binaryFile);
-            cg3::deserialize(tv, binaryFile);
-            cg3::deserialize(tw, binaryFile);
-            cg3::deserialize(prev, binaryFile);
-            cg3::deserialize(next, binaryFile);
-            cg3::deserialize(face, binaryFile);
-            cg3::deserialize(flag, binaryFile);
-            Dcel::HalfEdge* he = tmp.addHalfEdge(id);
-            he->setFlag(flag);
-            edges[id] = {fv, tv, tw, prev, next, face};
-        }
-
-        //Faces
-        tmp.faces.resize(tmp.nFaces+tmp.unusedFids.size(), nullptr);
-        #ifdef NDEBUG
-        tmp.faceNormals.resize(tmp.nFaces+tmp.unusedFids.size(), Vec3());
-        tmp.faceColors.resize(tmp.nFaces+tmp.unusedFids.size(), Color());
-        #endif
-        for (unsigned int i = 0; i < tmp.nFaces; i++){
-            int id, ohe, /*cr, cg, cb,*/ flag, nihe;
-            double /*nx, ny, nz,*/ area;
-            Color color;
-            Vec3 norm;
-            cg3::deserialize(id, binaryFile);
-            cg3::deserialize(ohe, binaryFile);
-            norm.deserialize(binaryFile);
-            cg3::deserialize(color, binaryFile);
-            cg3::deserialize(area, binaryFile);
-            cg3::deserialize(flag, binaryFile);
-            cg3::deserialize(nihe, binaryFile);
-
-
-            Dcel::Face* f = tmp.addFace(id);
-            f->setColor(color);
-            f->setNormal(norm);
-            f->setArea(area);
-            f->setFlag(flag);
-            f->setOuterHalfEdge(tmp.halfEdge(ohe));
-            for (int j = 0; j < nihe; j++){
-                int idhe;
-                cg3::deserialize(idhe, binaryFile);
-                f->addInnerHalfEdge(tmp.halfEdge(idhe));
-            }
-        }
-
-        for (Dcel::Vertex* v : tmp.vertexIterator()){
-            v->setIncidentHalfEdge(tmp.halfEdge(vert[v->id()]));
-        }
-        for (Dcel::HalfEdge* he : tmp.halfEdgeIterator()){
-            std::array<int, 6> a = edges[he->id()];
-            he->setFromVertex(tmp.vertex(a[0]));
-            he->setToVertex(tmp.vertex(a[1]));
-            he->setTwin(tmp.halfEdge(a[2]));
-            he->setPrev(tmp.halfEdge(a[3]));
-            he->setNext(tmp.halfEdge(a[4]));
-            he->setFace(tmp.face(a[5]));
-        }
+        if (s == "cg3DcelBlocks")
+            tmp.deserializeBlocks(binaryFile);
+        else if (s == "cg3Dcel")
+            tmp.deserializeElements(binaryFile);
+        else
+            throw std::ios_base::failure("Mismatching String: " + s + " != cg3DcelBlocks");
 
         *this = std::move(tmp);
     }
@@ -1400,9 +1434,9 @@ Dcel& Dcel::operator = (Dcel dcel)
 Dcel::Vertex*Dcel::addVertex(int id)
 {
     #ifdef NDEBUG
-    Vertex* last= new Vertex(*this);
+    Vertex* last= vertexPool.create(*this);
     #else
-    Vertex* last= new Vertex();
+    Vertex* last= vertexPool.create();
     #endif
     last->setId(id);
     vertices[id] = last;
@@ -1421,9 +1455,9 @@ Dcel::Vertex*Dcel::addVertex(int id)
 Dcel::HalfEdge*Dcel::addHalfEdge(int id)
 {
     #ifdef NDEBUG
-    HalfEdge* last = new HalfEdge(*this);
+    HalfEdge* last = halfEdgePool.create(*this);
     #else
-    HalfEdge* last = new HalfEdge();
+    HalfEdge* last = halfEdgePool.create();
     #endif
     last->setId(id);
     halfEdges[id] = last;
@@ -1442,9 +1476,9 @@ Dcel::HalfEdge*Dcel::addHalfEdge(int id)
 Dcel::Face*Dcel::addFace(int id)
 {
     #ifdef NDEBUG
-    Face* last = new Face(*this);
+    Face* last = facePool.create(*this);
     #else
-    Face* last = new Face();
+    Face* last = facePool.create();
     #endif
     last->setId(id);
     faces[id] = last;
@@ -1582,27 +1616,32 @@ void Dcel::toStdVectors(std::vector<double>& vertices, std::vector<double>& vert
     }
 }
 
+/**
+ * @brief Creates the vertices and the faces of a mesh loaded from file.
+ *
+ * All the arrays are contiguous: coords and vnorm contain three values for each vertex,
+ * faces contains the indices of the vertices of all the faces, one face after the other,
+ * and fsizes contains the number of vertices of each face.
+ */
 void Dcel::afterLoadFile(
-        const std::list<double> &coords,
-        const std::list<unsigned int> &faces,
+        const std::vector<double> &coords,
+        const std::vector<unsigned int> &faces,
         int mode,
-        const std::list<double> &vnorm,
-        const std::list<Color> &vcolor,
-        const std::list<Color> &fcolor,
-        const std::list<unsigned int> &fsizes)
+        const std::vector<double> &vnorm,
+        const std::vector<Color> &vcolor,
+        const std::vector<Color> &fcolor,
+        const std::vector<unsigned int> &fsizes)
 {
+    unsigned int nv = (unsigned int)coords.size() / 3;
     std::vector<Vertex*> vertices;
+    std::vector<Face*> newFaces;
 
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
+    reserve(nv, (unsigned int)faces.size(), (unsigned int)fsizes.size());
+    vertices.reserve(nv);
 
     bool first = true;
-
-    std::list<double>::const_iterator vnit = vnorm.begin();
-    std::list<Color>::const_iterator vcit = vcolor.begin();
-    for (std::list<double>::const_iterator it = coords.begin(); it != coords.end(); ){
-        double x = *(it++), y = *(it++), z = *(it++);
-        Pointd coord(x,y,z);
+    for (unsigned int i = 0; i < nv; i++){
+        Pointd coord(coords[i*3], coords[i*3+1], coords[i*3+2]);
         if (first) {
             bBox.setMin(coord);
             bBox.setMax(coord);
@@ -1616,37 +1655,66 @@ void Dcel::afterLoadFile(
         vertices.push_back(vid);
 
         if (mode & io::NORMAL_VERTICES){
-            Vec3 norm;
-            norm.setX(*(vnit++));
-            norm.setY(*(vnit++));
-            norm.setZ(*(vnit++));
-            vid->setNormal(norm);
+            vid->setNormal(Vec3(vnorm[i*3], vnorm[i*3+1], vnorm[i*3+2]));
         }
         if (mode & io::COLOR_VERTICES){
-            vid->setColor(*(vcit++));
+            vid->setColor(vcolor[i]);
         }
     }
 
-    std::list<unsigned int>::const_iterator fit = faces.begin();
-    std::list<Color>::const_iterator fcit = fcolor.begin();
-    for (std::list<unsigned int>::const_iterator fsit = fsizes.begin(); fsit != fsizes.end(); ++fsit){
+    buildFaces(vertices, faces, fsizes, newFaces);
 
-        unsigned int thisSize = *fsit;
-        std::vector<unsigned int> nid;
-        nid.reserve(thisSize);
-        for (unsigned int i = 0; i < thisSize; i++){
-            nid.push_back(*(fit++));
-        }
-        nid.push_back(nid[0]);
+    if (mode & io::COLOR_FACES){
+        for (unsigned int i = 0; i < newFaces.size(); i++)
+            newFaces[i]->setColor(fcolor[i]);
+    }
 
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
+    if (! (mode & io::NORMAL_VERTICES))
+        updateVertexNormals();
+}
+
+/**
+ * @brief Creates the faces and the half edges of a polygon mesh whose vertices are already
+ * contained in the Dcel.
+ *
+ * Twins are matched without any map: the half edges are sorted by the (smallest, largest)
+ * indices of their two vertices with two counting sorts, so that half edges lying on the same
+ * edge become adjacent, and every half edge is paired with one of opposite direction of the same
+ * run. Only contiguous arrays are used, and the cost does not depend on the valence of the
+ * vertices.
+ *
+ * @param[in] vertices: vertices of the mesh, indexed by the values contained in faces
+ * @param[in] faces: indices of the vertices of all the faces, one face after the other
+ * @param[in] fsizes: number of vertices of every face
+ * @param[out] newFaces: the created faces, in the same order of fsizes
+ * @par Complexity:
+ *      \e O(NumVertices \e + \e NumHalfEdges)
+ */
+void Dcel::buildFaces(
+        const std::vector<Vertex*>& vertices,
+        const std::vector<unsigned int>& faces,
+        const std::vector<unsigned int>& fsizes,
+        std::vector<Face*>& newFaces)
+{
+    unsigned int nhe = (unsigned int)faces.size();
+    std::vector<HalfEdge*> newHalfEdges;
+    std::vector<unsigned int> heTo(nhe);
+
+    newFaces.clear();
+    newFaces.reserve(fsizes.size());
+    newHalfEdges.reserve(nhe);
+
+    unsigned int fit = 0;
+    for (unsigned int f = 0; f < fsizes.size(); f++){
+        unsigned int thisSize = fsizes[f];
         Face* fid = addFace();
         HalfEdge* prev = nullptr;
         HalfEdge* first = nullptr;
 
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
+        for (unsigned int i = 0; i < thisSize; i++){
+            unsigned int from = faces[fit + i];
+            unsigned int to = faces[fit + (i+1) % thisSize];
+            HalfEdge* eid = addHalfEdge();
             if (i==0) {
                 first = eid;
                 fid->setOuterHalfEdge(eid);
@@ -1655,43 +1723,301 @@ void Dcel::afterLoadFile(
                 eid->setPrev(prev);
                 prev->setNext(eid);
             }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
+            vertices[from]->setIncidentHalfEdge(eid);
+            eid->setFromVertex(vertices[from]);
+            vertices[from]->incrementCardinality();
+            eid->setToVertex(vertices[to]);
             eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
+
+            heTo[newHalfEdges.size()] = to;
+            newHalfEdges.push_back(eid);
+            prev = eid;
+        }
+        prev->setNext(first);
+        first->setPrev(prev);
+
+        fid->updateNormal();
+        fid->updateArea();
+
+        newFaces.push_back(fid);
+        fit += thisSize;
+    }
+
+    //two counting sorts (by largest and then, stably, by smallest vertex) place the
+    //half edges with the same pair of vertices next to each other, in index order
+    std::vector<unsigned int> offsets(vertices.size() + 1);
+    auto countingSort = [&](const std::vector<unsigned int>& in, std::vector<unsigned int>& out, bool smallest){
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (unsigned int i : in)
+            offsets[(smallest ? std::min(faces[i], heTo[i]) : std::max(faces[i], heTo[i])) + 1]++;
+        for (unsigned int v = 0; v < vertices.size(); v++)
+            offsets[v+1] += offsets[v];
+        for (unsigned int i : in)
+            out[offsets[smallest ? std::min(faces[i], heTo[i]) : std::max(faces[i], heTo[i])]++] = i;
+    };
+    std::vector<unsigned int> sorted(nhe), byMax(nhe);
+    for (unsigned int i = 0; i < nhe; i++)
+        sorted[i] = i;
+    countingSort(sorted, byMax, false);
+    countingSort(byMax, sorted, true);
+
+    //inside every run of half edges sharing the same vertices, the k-th half edge going
+    //from the smallest to the largest vertex is the twin of the k-th going backwards
+    for (unsigned int begin = 0, end; begin < nhe; begin = end){
+        unsigned int lo = std::min(faces[sorted[begin]], heTo[sorted[begin]]);
+        unsigned int hi = std::max(faces[sorted[begin]], heTo[sorted[begin]]);
+        end = begin + 1;
+        while (end < nhe &&
+               std::min(faces[sorted[end]], heTo[sorted[end]]) == lo &&
+               std::max(faces[sorted[end]], heTo[sorted[end]]) == hi)
+            end++;
+
+        unsigned int forward = begin, backward = begin;
+        while (true){
+            if (lo == hi) //degenerate half edges are paired in order
+                backward = forward + 1;
+            else {
+                while (forward < end && faces[sorted[forward]] != lo)
+                    forward++;
+                while (backward < end && faces[sorted[backward]] != hi)
+                    backward++;
             }
+            if (forward >= end || backward >= end)
+                break;
+            HalfEdge* he1 = newHalfEdges[sorted[forward]];
+            HalfEdge* he2 = newHalfEdges[sorted[backward]];
+            he1->setTwin(he2);
+            he2->setTwin(he1);
+            if (lo == hi)
+                forward += 2;
             else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
+                forward++;
+                backward++;
             }
-            prev = eid;
         }
-        eid->setNext(first);
-        first->setPrev(eid);
+    }
+}
 
-        if (mode & io::COLOR_FACES){
-            Color c = *(fcit++);
-            fid->setColor(c);
-        }
-        else
-            fid->setColor(Color(128, 128, 128));
+/**
+ * @brief Reads the block format written by serialize() (after the "cg3DcelBlocks" string)
+ * in this Dcel, which must be empty.
+ *
+ * Elements are linked directly by id: no map between ids and elements is needed.
+ *
+ * @throws std::ios_base::failure if the blocks are not consistent
+ */
+void Dcel::deserializeBlocks(std::ifstream& binaryFile)
+{
+    std::vector<unsigned int> vids, heids, fids;
+    std::vector<int> vints, heints, fints, innerHalfEdges;
+    std::vector<double> vdoubles, fdoubles;
+    std::vector<unsigned char> vcolors, fcolors;
+
+    bBox.deserialize(binaryFile);
+    cg3::deserialize(nVertices, binaryFile);
+    cg3::deserialize(nHalfEdges, binaryFile);
+    cg3::deserialize(nFaces, binaryFile);
+    cg3::deserialize(unusedVids, binaryFile);
+    cg3::deserialize(unusedHeids, binaryFile);
+    cg3::deserialize(unusedFids, binaryFile);
+    cg3::deserialize(vids, binaryFile);
+    cg3::deserialize(vints, binaryFile);
+    cg3::deserialize(vdoubles, binaryFile);
+    cg3::deserialize(vcolors, binaryFile);
+    cg3::deserialize(heids, binaryFile);
+    cg3::deserialize(heints, binaryFile);
+    cg3::deserialize(fids, binaryFile);
+    cg3::deserialize(fints, binaryFile);
+    cg3::deserialize(fdoubles, binaryFile);
+    cg3::deserialize(fcolors, binaryFile);
+    cg3::deserialize(innerHalfEdges, binaryFile);
+
+    if (vids.size() != nVertices || vints.size() != vids.size()*3 ||
+            vdoubles.size() != vids.size()*6 || vcolors.size() != vids.size()*4 ||
+            heids.size() != nHalfEdges || heints.size() != heids.size()*7 ||
+            fids.size() != nFaces || fints.size() != fids.size()*3 ||
+            fdoubles.size() != fids.size()*4 || fcolors.size() != fids.size()*4)
+        throw std::ios_base::failure("Mismatching sizes of the Dcel blocks");
+
+    reserve(nVertices, nHalfEdges, nFaces);
 
-        fid->updateNormal();
-        fid->updateArea();
+    //Vertices
+    vertices.resize(nVertices+unusedVids.size(), nullptr);
+    #ifdef NDEBUG
+    vertexCoordinates.resize(vertices.size(), Pointd());
+    vertexNormals.resize(vertices.size(), Vec3());
+    vertexColors.resize(vertices.size(), Color());
+    #endif
+    for (unsigned int i = 0; i < nVertices; i++){
+        if (vids[i] >= vertices.size() || vertices[vids[i]] != nullptr)
+            throw std::ios_base::failure("Wrong id of a Dcel vertex");
+        Dcel::Vertex* v = addVertex(vids[i]);
+        v->setCoordinate(Pointd(vdoubles[6*i], vdoubles[6*i+1], vdoubles[6*i+2]));
+        v->setNormal(Vec3(vdoubles[6*i+3], vdoubles[6*i+4], vdoubles[6*i+5]));
+        v->setColor(Color(vcolors[4*i], vcolors[4*i+1], vcolors[4*i+2], vcolors[4*i+3]));
+        v->setCardinality(vints[3*i+1]);
+        v->setFlag(vints[3*i+2]);
     }
 
-    if (! (mode & io::NORMAL_VERTICES))
-        updateVertexNormals();
+    //HalfEdges
+    halfEdges.resize(nHalfEdges+unusedHeids.size(), nullptr);
+    for (unsigned int i = 0; i < nHalfEdges; i++){
+        if (heids[i] >= halfEdges.size() || halfEdges[heids[i]] != nullptr)
+            throw std::ios_base::failure("Wrong id of a Dcel half edge");
+        Dcel::HalfEdge* he = addHalfEdge(heids[i]);
+        he->setFlag(heints[7*i+6]);
+    }
+
+    //Faces
+    faces.resize(nFaces+unusedFids.size(), nullptr);
+    #ifdef NDEBUG
+    faceNormals.resize(faces.size(), Vec3());
+    faceColors.resize(faces.size(), Color());
+    #endif
+    size_t inner = 0;
+    for (unsigned int i = 0; i < nFaces; i++){
+        if (fids[i] >= faces.size() || faces[fids[i]] != nullptr)
+            throw std::ios_base::failure("Wrong id of a Dcel face");
+        unsigned int nInner = fints[3*i+2];
+        if (inner + nInner > innerHalfEdges.size())
+            throw std::ios_base::failure("Mismatching sizes of the Dcel blocks");
+        Dcel::Face* f = addFace(fids[i]);
+        f->setColor(Color(fcolors[4*i], fcolors[4*i+1], fcolors[4*i+2], fcolors[4*i+3]));
+        f->setNormal(Vec3(fdoubles[4*i], fdoubles[4*i+1], fdoubles[4*i+2]));
+        f->setArea(fdoubles[4*i+3]);
+        f->setFlag(fints[3*i+1]);
+        f->setOuterHalfEdge(halfEdge(fints[3*i]));
+        for (unsigned int j = 0; j < nInner; j++)
+            f->addInnerHalfEdge(halfEdge(innerHalfEdges[inner++]));
+    }
+
+    for (unsigned int i = 0; i < nVertices; i++){
+        vertices[vids[i]]->setIncidentHalfEdge(halfEdge(vints[3*i]));
+    }
+    for (unsigned int i = 0; i < nHalfEdges; i++){
+        const int* a = &heints[7*i];
+        Dcel::HalfEdge* he = halfEdges[heids[i]];
+        he->setFromVertex(vertex(a[0]));
+        he->setToVertex(vertex(a[1]));
+        he->setTwin(halfEdge(a[2]));
+        he->setPrev(halfEdge(a[3]));
+        he->setNext(halfEdge(a[4]));
+        he->setFace(face(a[5]));
+    }
+}
+
+/**
+ * @brief Reads the format written by the previous versions of serialize() (after the
+ * "cg3Dcel" string), in which every attribute of every element is serialized by itself,
+ * in this Dcel, which must be empty.
+ */
+void Dcel::deserializeElements(std::ifstream& binaryFile)
+{
+    std::set<int> uvids, uheids, ufids; //unused ids were stored in sets
+    bBox.deserialize(binaryFile);
+    cg3::deserialize(nVertices, binaryFile);
+    cg3::deserialize(nHalfEdges, binaryFile);
+    cg3::deserialize(nFaces, binaryFile);
+    cg3::deserialize(uvids, binaryFile);
+    cg3::deserialize(uheids, binaryFile);
+    cg3::deserialize(ufids, binaryFile);
+    unusedVids.assign(uvids.begin(), uvids.end());
+    unusedHeids.assign(uheids.begin(), uheids.end());
+    unusedFids.assign(ufids.begin(), ufids.end());
+    reserve(nVertices, nHalfEdges, nFaces);
+
+    //Vertices
+    vertices.resize(nVertices+unusedVids.size(), nullptr);
+    #ifdef NDEBUG
+    vertexCoordinates.resize(nVertices+unusedVids.size(), Pointd());
+    vertexNormals.resize(nVertices+unusedVids.size(), Vec3());
+    vertexColors.resize(nVertices+unusedVids.size(), Color());
+    #endif
+    std::map<int, int> vert;
+
+    for (unsigned int i = 0; i < nVertices; i++){
+        int id, heid;
+        Pointd coord; Vec3 norm; Color color;
+        int c, f;
+        cg3::deserialize(id, binaryFile);
+        coord.deserialize(binaryFile);
+        norm.deserialize(binaryFile);
+        cg3::deserialize(color, binaryFile);
+        cg3::deserialize(heid, binaryFile);
+        cg3::deserialize(c, binaryFile);
+        cg3::deserialize(f, binaryFile);
+
+        Dcel::Vertex* v = addVertex(id);
+        v->setCardinality(c);
+        v->setCoordinate(coord);
+        v->setNormal(norm);
+        v->setColor(color);
+        v->setFlag(f);
+        vert[id] = heid;
+    }
+    //HalfEdges
+    halfEdges.resize(nHalfEdges+unusedHeids.size(), nullptr);
+    std::map<int, std::array<int, 6> > edges;
+
+    for (unsigned int i = 0; i < nHalfEdges; i++){
+        int id, fv, tv, tw, prev, next, face, flag;
+        cg3::deserialize(id, binaryFile);
+        cg3::deserialize(fv, binaryFile);
+        cg3::deserialize(tv, binaryFile);
+        cg3::deserialize(tw, binaryFile);
+        cg3::deserialize(prev, binaryFile);
+        cg3::deserialize(next, binaryFile);
+        cg3::deserialize(face, binaryFile);
+        cg3::deserialize(flag, binaryFile);
+        Dcel::HalfEdge* he = addHalfEdge(id);
+        he->setFlag(flag);
+        edges[id] = {fv, tv, tw, prev, next, face};
+    }
+
+    //Faces
+    faces.resize(nFaces+unusedFids.size(), nullptr);
+    #ifdef NDEBUG
+    faceNormals.resize(nFaces+unusedFids.size(), Vec3());
+    faceColors.resize(nFaces+unusedFids.size(), Color());
+    #endif
+    for (unsigned int i = 0; i < nFaces; i++){
+        int id, ohe, flag, nihe;
+        double area;
+        Color color;
+        Vec3 norm;
+        cg3::deserialize(id, binaryFile);
+        cg3::deserialize(ohe, binaryFile);
+        norm.deserialize(binaryFile);
+        cg3::deserialize(color, binaryFile);
+        cg3::deserialize(area, binaryFile);
+        cg3::deserialize(flag, binaryFile);
+        cg3::deserialize(nihe, binaryFile);
+
+        Dcel::Face* f = addFace(id);
+        f->setColor(color);
+        f->setNormal(norm);
+        f->setArea(area);
+        f->setFlag(flag);
+        f->setOuterHalfEdge(halfEdge(ohe));
+        for (int j = 0; j < nihe; j++){
+            int idhe;
+            cg3::deserialize(idhe, binaryFile);
+            f->addInnerHalfEdge(halfEdge(idhe));
+        }
+    }
+
+    for (Dcel::Vertex* v : vertexIterator()){
+        v->setIncidentHalfEdge(halfEdge(vert[v->id()]));
+    }
+    for (Dcel::HalfEdge* he : halfEdgeIterator()){
+        std::array<int, 6> a = edges[he->id()];
+        he->setFromVertex(vertex(a[0]));
+        he->setToVertex(vertex(a[1]));
+        he->setTwin(halfEdge(a[2]));
+        he->setPrev(halfEdge(a[3]));
+        he->setNext(halfEdge(a[4]));
+        he->setFace(face(a[5]));
+    }
 }
 
 #ifdef  CG3_EIGENMESH_DEFINED
@@ -1700,13 +2026,15 @@ void Dcel::copyFrom(const SimpleEigenMesh& eigenMesh)
     clear();
 
     std::vector<Vertex*> vertices;
+    std::vector<unsigned int> faces;
+    std::vector<unsigned int> fsizes(eigenMesh.numberFaces(), 3);
+    std::vector<Face*> newFaces;
 
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
+    reserve(eigenMesh.numberVertices(), eigenMesh.numberFaces()*3, eigenMesh.numberFaces());
+    vertices.reserve(eigenMesh.numberVertices());
 
     bool first = true;
 
-
     for (unsigned int i = 0; i < eigenMesh.numberVertices(); i++) {
 
         Pointd coord = eigenMesh.vertex(i);
@@ -1730,59 +2058,15 @@ void Dcel::copyFrom(const SimpleEigenMesh& eigenMesh)
         vertices.push_back(vid);
     }
 
+    faces.reserve(eigenMesh.numberFaces()*3);
     for (unsigned int i = 0; i < eigenMesh.numberFaces(); i++) {
-
-        std::vector<int> nid;
         Pointi ff = eigenMesh.face(i);
-        nid.push_back(ff.x());
-        nid.push_back(ff.y());
-        nid.push_back(ff.z());
-        nid.push_back(nid[0]);
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
-
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
-            }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
-            }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-        fid->setColor(Color(128, 128, 128));
-
-        fid->updateNormal();
-        fid->updateArea();
+        faces.push_back(ff.x());
+        faces.push_back(ff.y());
+        faces.push_back(ff.z());
     }
+
+    buildFaces(vertices, faces, fsizes, newFaces);
 }
 
 void Dcel::copyFrom(const EigenMesh& eigenMesh)
@@ -1805,13 +2089,15 @@ void Dcel::copyFrom(const cinolib::Trimesh<> &trimesh)
     clear();
 
     std::vector<Vertex*> vertices;
+    std::vector<unsigned int> faces;
+    std::vector<unsigned int> fsizes(trimesh.num_polys(), 3);
+    std::vector<Face*> newFaces;
 
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
+    reserve(trimesh.num_verts(), trimesh.num_polys()*3, trimesh.num_polys());
+    vertices.reserve(trimesh.num_verts());
 
     bool first = true;
 
-
     for (unsigned int i = 0; i < (unsigned int)trimesh.num_verts(); i++) {
 
         Pointd coord(trimesh.vert(i));
@@ -1835,59 +2121,14 @@ void Dcel::copyFrom(const cinolib::Trimesh<> &trimesh)
         vertices.push_back(vid);
     }
 
+    faces.reserve(trimesh.num_polys()*3);
     for (unsigned int i = 0; i < (unsigned int)trimesh.num_polys(); i++) {
-
-        std::vector<int> nid;
-        Pointi ff(trimesh.poly_vert_id(i, 0), trimesh.poly_vert_id(i, 1), trimesh.poly_vert_id(i, 2));
-        nid.push_back(ff.x());
-        nid.push_back(ff.y());
-        nid.push_back(ff.z());
-        nid.push_back(nid[0]);
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
-
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
-            }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
-            }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-        fid->setColor(Color(128, 128, 128));
-
-        fid->updateNormal();
-        fid->updateArea();
+        faces.push_back(trimesh.poly_vert_id(i, 0));
+        faces.push_back(trimesh.poly_vert_id(i, 1));
+        faces.push_back(trimesh.poly_vert_id(i, 2));
     }
+
+    buildFaces(vertices, faces, fsizes, newFaces);
 }
 
 #endif //CG3_CINOLIB_DEFINED
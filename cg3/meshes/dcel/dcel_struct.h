@@ -10,6 +10,7 @@
 
 #include <cg3/geometry/bounding_box.h>
 #include <cg3/utilities/color.h>
+#include <cg3/utilities/memory_pool.h>
 #include <cg3/meshes/mesh.h>
 
 #ifdef  CG3_EIGENMESH_DEFINED
@@ -61,6 +62,12 @@ namespace cg3 {
  * We can do the same thing with Dcel::HalfEdge and Dcel::Face. For const Dcel, you can use const iterators.
  * Dcel::Vertex and Dcel::Face classes have also other type of iterators (which are mostly circular iterators)
  * that allows to access to incident/adjacent elements. See the documentation for all the specific iterators.
+ *
+ * Vertices, half edges and faces are not allocated one by one: they are stored in three
+ * cg3::MemoryPool, which place the elements in contiguous blocks. The address of an element does not
+ * change until it is deleted, and the whole Dcel is freed in \e O(numberBlocks) by clear() and by
+ * the destructor. If the size of the mesh is known before its creation, reserve() allows to allocate
+ * all the elements in a single block.
  */
 
 class Dcel : public SerializableObject, public virtual Mesh
@@ -164,7 +171,7 @@ public:
     Pointd barycenter()                                  const;
     double averageHalfEdgesLength()                      const;
     bool saveOnObj(const std::string& fileNameObj)             const;
-    bool saveOnPly(const std::string& fileNamePly)             const;
+    bool saveOnPly(const std::string& fileNamePly, io::FileFormat format = io::ASCII) const;
     void saveOnDcelFile(const std::string& fileNameDcel)           const;
 
     Vertex* addVertex(const Pointd& p = Pointd(), const Vec3& n = Vec3(), const Color &c = Color(128, 128, 128));
@@ -187,7 +194,9 @@ public:
     void rotate(double matrix[3][3], const Pointd& centroid = Pointd());
     void translate(const Vec3 &c);
     void recalculateIds();
+    void compact();
     void resetFaceColors();
+    void reserve(unsigned int nVertices, unsigned int nHalfEdges, unsigned int nFaces);
     void clear();
     #ifdef  CG3_CGAL_DEFINED
     unsigned int triangulateFace(Dcel::Face* f);
@@ -231,14 +240,19 @@ protected:
     std::vector<Vertex* >   vertices;
     std::vector<HalfEdge* > halfEdges;
     std::vector<Face* >     faces;
-    std::set<int>           unusedVids;
-    std::set<int>           unusedHeids;
-    std::set<int>           unusedFids;
+    std::vector<int>        unusedVids;     /**< @brief Stack of the ids of the deleted vertices */
+    std::vector<int>        unusedHeids;    /**< @brief Stack of the ids of the deleted half edges */
+    std::vector<int>        unusedFids;     /**< @brief Stack of the ids of the deleted faces */
     unsigned int            nVertices;
     unsigned int            nHalfEdges;
     unsigned int            nFaces;
     BoundingBox             bBox;
 
+    //Storage
+    MemoryPool<Vertex>      vertexPool;
+    MemoryPool<HalfEdge>    halfEdgePool;
+    MemoryPool<Face>        facePool;
+
     //Data
     #ifdef NDEBUG
     std::vector<Pointd> vertexCoordinates;
@@ -265,12 +279,21 @@ protected:
             std::vector<float> &faceColors) const;
 
     void afterLoadFile(
-            const std::list<double>& coords,
-            const std::list<unsigned int>& faces,
-            int mode, const std::list<double>& vnorm,
-            const std::list<Color>& vcolor,
-            const std::list<Color>& fcolor,
-            const std::list<unsigned int>& fsizes);
+            const std::vector<double>& coords,
+            const std::vector<unsigned int>& faces,
+            int mode, const std::vector<double>& vnorm,
+            const std::vector<Color>& vcolor,
+            const std::vector<Color>& fcolor,
+            const std::vector<unsigned int>& fsizes);
+
+    void buildFaces(
+            const std::vector<Vertex*>& vertices,
+            const std::vector<unsigned int>& faces,
+            const std::vector<unsigned int>& fsizes,
+            std::vector<Face*>& newFaces);
+
+    void deserializeBlocks(std::ifstream& binaryFile);
+    void deserializeElements(std::ifstream& binaryFile);
 
     #ifdef  CG3_EIGENMESH_DEFINED
     void copyFrom(const SimpleEigenMesh &eigenMesh);
@@ -45,16 +45,6 @@ Dcel::Vertex::Vertex() :
 }
 #endif
 
-/**
- * \~Italian
- * @brief Distruttore vuoto.
- *
- * La classe Dcel dovrà occuparsi di eliminare tutti i riferimenti in essa contenuti (e quindi contenuti di conseguenza anche nella classe Dcel::Vertex).
- */
-Dcel::Vertex::~Vertex(void)
-{
-}
-
 /******************
  * Public Methods *
  ******************/
@@ -45,6 +45,7 @@ namespace cg3 {
 class Dcel::Vertex
 {
     friend class Dcel;
+    friend class MemoryPool<Dcel::Vertex>;
 
 public:
 
@@ -20,6 +20,7 @@ unix:!macx{
 HEADERS += \
     $$PWD/eigenmesh/simpleeigenmesh.h \
     $$PWD/eigenmesh/eigenmesh.h \
+    $$PWD/eigenmesh/mapped_eigenmesh.h \
     $$PWD/eigenmesh/algorithms/eigenmesh_algorithms.h
 
 
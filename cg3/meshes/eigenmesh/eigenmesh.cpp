@@ -6,6 +6,7 @@
  */
 
 #include "eigenmesh.h"
+#include "mapped_eigenmesh.h"
 #include <cg3/io/load_save_file.h>
 
 #ifdef  CG3_DCEL_DEFINED
@@ -302,7 +303,40 @@ std::pair<int, int> EigenMesh::commonVertices(unsigned int f1, unsigned int f2)
     return std::pair<int, int>(-1, -1);
 }
 
-bool EigenMesh::saveOnPly(const std::string &filename) const
+/**
+ * @brief Loads a mesh saved with saveOnBlockFile().
+ *
+ * If the file has been saved by a SimpleEigenMesh, normals are computed and colors are
+ * set to the default ones. All the matrices are copied from the mapped file: use a
+ * MappedEigenMesh to access them without copying.
+ *
+ * @param[in] filename: the block file
+ * @return false if the file cannot be opened or does not contain a mesh
+ */
+bool EigenMesh::loadFromBlockFile(const std::string& filename)
+{
+    clear();
+    MappedEigenMesh m(filename);
+    if (m.isOpen()) {
+        V = m.getVerticesMatrix();
+        F = m.getFacesMatrix();
+        NV = m.getVerticesNormalsMatrix();
+        NF = m.getFacesNormalsMatrix();
+        CV = m.getVerticesColorsMatrix();
+        CF = m.getFacesColorsMatrix();
+    }
+    else {
+        if (!SimpleEigenMesh::loadFromBlockFile(filename))
+            return false;
+        updateColorSizes();
+        updateFaceNormals();
+        updateVerticesNormals();
+    }
+    updateBoundingBox();
+    return true;
+}
+
+bool EigenMesh::saveOnPly(const std::string &filename, io::FileFormat format) const
 {
     int mode = io::NORMAL_VERTICES | io::COLOR_VERTICES | io::COLOR_FACES;
     io::MeshType meshType;
@@ -313,7 +347,7 @@ bool EigenMesh::saveOnPly(const std::string &filename) const
     else
         meshType = io::POLYGON_MESH;
     io::ColorMode colorMode = io::RGB;
-    return saveMeshOnPly(filename, V.rows(), F.rows(), V.data(), F.data(), meshType, mode, NV.data(), colorMode, CV.data(), CF.data());
+    return saveMeshOnPly(filename, V.rows(), F.rows(), V.data(), F.data(), meshType, mode, NV.data(), colorMode, CV.data(), CF.data(), internal::dummyVectorUnsignedInt.data(), format);
 }
 
 bool EigenMesh::saveOnObj(const std::string& filename) const
@@ -330,6 +364,24 @@ bool EigenMesh::saveOnObj(const std::string& filename) const
     return saveMeshOnObj(filename, V.rows(), F.rows(), V.data(), F.data(), meshType, mode, NV.data(), colorMode, CV.data(), CF.data());
 }
 
+/**
+ * @brief Saves the mesh, its normals and its colors on a block file, whose blocks are
+ * aligned in order to be mapped in memory by a MappedEigenMesh.
+ * @param[in] filename: the block file
+ * @return false if the file cannot be written
+ */
+bool EigenMesh::saveOnBlockFile(const std::string& filename) const
+{
+    BlockFileWriter file("cg3EigenMesh");
+    file.addBlock("V", V.data(), V.rows(), 3);
+    file.addBlock("F", F.data(), F.rows(), 3);
+    file.addBlock("NV", NV.data(), NV.rows(), 3);
+    file.addBlock("NF", NF.data(), NF.rows(), 3);
+    file.addBlock("CV", CV.data(), CV.rows(), 3);
+    file.addBlock("CF", CF.data(), CF.rows(), 3);
+    return file.save(filename);
+}
+
 void EigenMesh::merge(EigenMesh& result, const EigenMesh& m1, const EigenMesh& m2)
 {
     SimpleEigenMesh::merge(result, m1, m2);
@@ -66,6 +66,7 @@ public:
     virtual void removeFace(unsigned int f);
     virtual bool loadFromObj(const std::string &filename);
     virtual bool loadFromPly(const std::string &filename);
+    virtual bool loadFromBlockFile(const std::string &filename);
     void setFaceColor(const Color &c, int f = -1);
     void setFaceColor(int red, int green, int blue, int f = -1);
     void setFaceColor(double red, double green, double blue, int f = -1);
@@ -95,8 +96,9 @@ public:
 
     std::pair<int, int> commonVertices(unsigned int f1, unsigned int f2) const;
 
-    virtual bool saveOnPly(const std::string &filename) const;
+    virtual bool saveOnPly(const std::string &filename, io::FileFormat format = io::ASCII) const;
     virtual bool saveOnObj(const std::string &filename) const;
+    virtual bool saveOnBlockFile(const std::string &filename) const;
 
     static void merge(EigenMesh &result, const EigenMesh &m1, const EigenMesh &m2);
     static EigenMesh merge(const EigenMesh &m1, const EigenMesh &m2);
@@ -0,0 +1,292 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_MAPPED_EIGENMESH_H
+#define CG3_MAPPED_EIGENMESH_H
+
+#include <Eigen/Core>
+
+#include <cg3/io/block_file.h>
+#include <cg3/geometry/point.h>
+#include <cg3/utilities/color.h>
+
+namespace cg3 {
+
+/**
+ * @brief The MappedSimpleEigenMesh class is a read-only view of a mesh saved with
+ * SimpleEigenMesh::saveOnBlockFile() or EigenMesh::saveOnBlockFile().
+ *
+ * The file is mapped in memory and the matrices are Eigen::Map of the mapped blocks:
+ * opening a mesh does not read nor copy its vertices and faces, therefore its cost does
+ * not depend on the size of the mesh. The maps are valid until the mesh is closed or
+ * destroyed.
+ */
+class MappedSimpleEigenMesh
+{
+public:
+    typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>> VerticesMatrix;
+    typedef Eigen::Map<const Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor>> FacesMatrix;
+
+    MappedSimpleEigenMesh();
+    MappedSimpleEigenMesh(const std::string& filename);
+    virtual ~MappedSimpleEigenMesh() {}
+
+    virtual bool open(const std::string& filename);
+    bool isOpen() const;
+    virtual void close();
+
+    VerticesMatrix getVerticesMatrix() const;
+    FacesMatrix getFacesMatrix() const;
+
+    unsigned int numberVertices() const;
+    unsigned int numberFaces() const;
+    Pointd vertex(unsigned int i) const;
+    Pointi face(unsigned int i) const;
+
+protected:
+    BlockFile file;
+    const double* vertices;
+    const int* faces;
+    size_t nVertices;
+    size_t nFaces;
+};
+
+/**
+ * @brief The MappedEigenMesh class is a read-only view of a mesh saved with
+ * EigenMesh::saveOnBlockFile(), which gives access also to the normals and colors
+ * of the mesh without copying them.
+ */
+class MappedEigenMesh : public MappedSimpleEigenMesh
+{
+public:
+    typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>> NormalsMatrix;
+    typedef Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>> ColorsMatrix;
+
+    MappedEigenMesh();
+    MappedEigenMesh(const std::string& filename);
+
+    bool open(const std::string& filename);
+    void close();
+
+    NormalsMatrix getVerticesNormalsMatrix() const;
+    NormalsMatrix getFacesNormalsMatrix() const;
+    ColorsMatrix getVerticesColorsMatrix() const;
+    ColorsMatrix getFacesColorsMatrix() const;
+
+    Vec3 vertexNormal(unsigned int v) const;
+    Vec3 faceNormal(unsigned int f) const;
+    Color vertexColor(unsigned int v) const;
+    Color faceColor(unsigned int f) const;
+
+private:
+    const double* verticesNormals;
+    const double* facesNormals;
+    const float* verticesColors;
+    const float* facesColors;
+};
+
+namespace internal {
+
+template <typename T>
+bool mapMeshBlock(
+        const BlockFile& file,
+        const std::string& name,
+        size_t rows,
+        const T*& data);
+
+} //namespace cg3::internal
+
+/**
+ * MappedSimpleEigenMesh
+ */
+
+inline MappedSimpleEigenMesh::MappedSimpleEigenMesh() :
+    vertices(nullptr),
+    faces(nullptr),
+    nVertices(0),
+    nFaces(0)
+{
+}
+
+inline MappedSimpleEigenMesh::MappedSimpleEigenMesh(const std::string& filename) :
+    MappedSimpleEigenMesh()
+{
+    open(filename);
+}
+
+/**
+ * @brief Maps the vertices and the faces of a mesh saved on a block file.
+ * @param[in] filename: a file saved by SimpleEigenMesh::saveOnBlockFile()
+ * or EigenMesh::saveOnBlockFile()
+ * @return false if the file cannot be mapped or does not contain a mesh
+ */
+inline bool MappedSimpleEigenMesh::open(const std::string& filename)
+{
+    MappedSimpleEigenMesh::close();
+    size_t cols;
+    if (!file.open(filename) ||
+            (file.type() != "cg3SimpleEigenMesh" && file.type() != "cg3EigenMesh") ||
+            !file.block("V", vertices, nVertices, cols) || cols != 3 ||
+            !file.block("F", faces, nFaces, cols) || cols != 3) {
+        MappedSimpleEigenMesh::close();
+        return false;
+    }
+    return true;
+}
+
+inline bool MappedSimpleEigenMesh::isOpen() const
+{
+    return file.isOpen();
+}
+
+inline void MappedSimpleEigenMesh::close()
+{
+    file.close();
+    vertices = nullptr;
+    faces = nullptr;
+    nVertices = nFaces = 0;
+}
+
+inline MappedSimpleEigenMesh::VerticesMatrix MappedSimpleEigenMesh::getVerticesMatrix() const
+{
+    return VerticesMatrix(vertices, nVertices, 3);
+}
+
+inline MappedSimpleEigenMesh::FacesMatrix MappedSimpleEigenMesh::getFacesMatrix() const
+{
+    return FacesMatrix(faces, nFaces, 3);
+}
+
+inline unsigned int MappedSimpleEigenMesh::numberVertices() const
+{
+    return nVertices;
+}
+
+inline unsigned int MappedSimpleEigenMesh::numberFaces() const
+{
+    return nFaces;
+}
+
+inline Pointd MappedSimpleEigenMesh::vertex(unsigned int i) const
+{
+    return Pointd(vertices[3*i], vertices[3*i+1], vertices[3*i+2]);
+}
+
+inline Pointi MappedSimpleEigenMesh::face(unsigned int i) const
+{
+    return Pointi(faces[3*i], faces[3*i+1], faces[3*i+2]);
+}
+
+/**
+ * MappedEigenMesh
+ */
+
+inline MappedEigenMesh::MappedEigenMesh() :
+    verticesNormals(nullptr),
+    facesNormals(nullptr),
+    verticesColors(nullptr),
+    facesColors(nullptr)
+{
+}
+
+inline MappedEigenMesh::MappedEigenMesh(const std::string& filename) :
+    MappedEigenMesh()
+{
+    open(filename);
+}
+
+/**
+ * @brief Maps the vertices, the faces, the normals and the colors of a mesh saved on
+ * a block file.
+ * @param[in] filename: a file saved by EigenMesh::saveOnBlockFile()
+ * @return false if the file cannot be mapped or does not contain an EigenMesh
+ */
+inline bool MappedEigenMesh::open(const std::string& filename)
+{
+    close();
+    if (!MappedSimpleEigenMesh::open(filename) || file.type() != "cg3EigenMesh" ||
+            !internal::mapMeshBlock(file, "NV", nVertices, verticesNormals) ||
+            !internal::mapMeshBlock(file, "NF", nFaces, facesNormals) ||
+            !internal::mapMeshBlock(file, "CV", nVertices, verticesColors) ||
+            !internal::mapMeshBlock(file, "CF", nFaces, facesColors)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+inline void MappedEigenMesh::close()
+{
+    MappedSimpleEigenMesh::close();
+    verticesNormals = facesNormals = nullptr;
+    verticesColors = facesColors = nullptr;
+}
+
+inline MappedEigenMesh::NormalsMatrix MappedEigenMesh::getVerticesNormalsMatrix() const
+{
+    return NormalsMatrix(verticesNormals, nVertices, 3);
+}
+
+inline MappedEigenMesh::NormalsMatrix MappedEigenMesh::getFacesNormalsMatrix() const
+{
+    return NormalsMatrix(facesNormals, nFaces, 3);
+}
+
+inline MappedEigenMesh::ColorsMatrix MappedEigenMesh::getVerticesColorsMatrix() const
+{
+    return ColorsMatrix(verticesColors, nVertices, 3);
+}
+
+inline MappedEigenMesh::ColorsMatrix MappedEigenMesh::getFacesColorsMatrix() const
+{
+    return ColorsMatrix(facesColors, nFaces, 3);
+}
+
+inline Vec3 MappedEigenMesh::vertexNormal(unsigned int v) const
+{
+    return Vec3(verticesNormals[3*v], verticesNormals[3*v+1], verticesNormals[3*v+2]);
+}
+
+inline Vec3 MappedEigenMesh::faceNormal(unsigned int f) const
+{
+    return Vec3(facesNormals[3*f], facesNormals[3*f+1], facesNormals[3*f+2]);
+}
+
+inline Color MappedEigenMesh::vertexColor(unsigned int v) const
+{
+    Color c;
+    c.setRedF(verticesColors[3*v]);
+    c.setGreenF(verticesColors[3*v+1]);
+    c.setBlueF(verticesColors[3*v+2]);
+    return c;
+}
+
+inline Color MappedEigenMesh::faceColor(unsigned int f) const
+{
+    Color c;
+    c.setRedF(facesColors[3*f]);
+    c.setGreenF(facesColors[3*f+1]);
+    c.setBlueF(facesColors[3*f+2]);
+    return c;
+}
+
+/**
+ * @brief Maps a block with 3 columns and the given number of rows.
+ * @return false if the file does not contain such a block
+ */
+template <typename T>
+inline bool internal::mapMeshBlock(
+        const BlockFile& file,
+        const std::string& name,
+        size_t rows,
+        const T*& data)
+{
+    size_t r = 0, c = 0;
+    return file.block(name, data, r, c) && r == rows && c == 3;
+}
+
+} //namespace cg3
+
+#endif // CG3_MAPPED_EIGENMESH_H
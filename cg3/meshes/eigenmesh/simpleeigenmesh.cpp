@@ -6,6 +6,7 @@
  */
 
 #include "simpleeigenmesh.h"
+#include "mapped_eigenmesh.h"
 
 #include <cg3/io/load_save_file.h>
 #include <cg3/geometry/transformations.h>
@@ -130,9 +131,30 @@ bool SimpleEigenMesh::loadFromFile(const std::string& filename)
         return false;
 }
 
-bool SimpleEigenMesh::saveOnPly(const std::string& filename) const
+/**
+ * @brief Loads a mesh saved with saveOnBlockFile() (by a SimpleEigenMesh or an EigenMesh).
+ *
+ * The vertices and the faces are copied from the mapped file: use a MappedSimpleEigenMesh
+ * to access them without copying.
+ *
+ * @param[in] filename: the block file
+ * @return false if the file cannot be opened or does not contain a mesh
+ */
+bool SimpleEigenMesh::loadFromBlockFile(const std::string& filename)
 {
-    return saveMeshOnPly(filename, V.rows(), F.rows(), V.data(), F.data());
+    MappedSimpleEigenMesh m(filename);
+    if (!m.isOpen())
+        return false;
+    V = m.getVerticesMatrix();
+    F = m.getFacesMatrix();
+    return true;
+}
+
+bool SimpleEigenMesh::saveOnPly(const std::string& filename, io::FileFormat format) const
+{
+    return saveMeshOnPly(filename, V.rows(), F.rows(), V.data(), F.data(), io::TRIANGLE_MESH, 0,
+                         internal::dummyVectorDouble.data(), io::RGB, internal::dummyVectorFloat.data(),
+                         internal::dummyVectorFloat.data(), internal::dummyVectorUnsignedInt.data(), format);
 }
 
 bool SimpleEigenMesh::saveOnObj(const std::string& filename) const
@@ -140,6 +162,20 @@ bool SimpleEigenMesh::saveOnObj(const std::string& filename) const
     return saveMeshOnObj(filename, V.rows(), F.rows(), V.data(), F.data());
 }
 
+/**
+ * @brief Saves the mesh on a block file, whose vertices and faces are aligned in order
+ * to be mapped in memory by a MappedSimpleEigenMesh.
+ * @param[in] filename: the block file
+ * @return false if the file cannot be written
+ */
+bool SimpleEigenMesh::saveOnBlockFile(const std::string& filename) const
+{
+    BlockFileWriter file("cg3SimpleEigenMesh");
+    file.addBlock("V", V.data(), V.rows(), 3);
+    file.addBlock("F", F.data(), F.rows(), 3);
+    return file.save(filename);
+}
+
 void SimpleEigenMesh::translate(const Vec3& p)
 {
     Eigen::RowVector3d v;
@@ -102,9 +102,11 @@ public:
     virtual bool loadFromObj(const std::string &filename);
     virtual bool loadFromPly(const std::string &filename);
     virtual bool loadFromFile(const std::string &filename);
+    virtual bool loadFromBlockFile(const std::string &filename);
 
-    virtual bool saveOnPly(const std::string &filename) const;
+    virtual bool saveOnPly(const std::string &filename, io::FileFormat format = io::ASCII) const;
     virtual bool saveOnObj(const std::string &filename) const;
+    virtual bool saveOnBlockFile(const std::string &filename) const;
 
     virtual void translate(const Vec3 &p);
     virtual void translate(const Eigen::Vector3d &p);
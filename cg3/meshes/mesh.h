@@ -8,6 +8,7 @@
 #define CG3_MESH_H
 
 #include <cg3/geometry/bounding_box.h>
+#include <cg3/io/load_save_file.h>
 #include <string>
 
 namespace cg3 {
@@ -32,7 +33,7 @@ public:
     virtual bool loadFromPly(const std::string& filename) = 0;
 
     virtual bool saveOnObj(const std::string& filename) const = 0;
-    virtual bool saveOnPly(const std::string& filename) const = 0;
+    virtual bool saveOnPly(const std::string& filename, io::FileFormat format = io::ASCII) const = 0;
 };
 
 } //namespace cg3